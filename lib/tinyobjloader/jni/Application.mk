@@ -1,2 +0,0 @@
-APP_ABI := all
-APP_STL := stlport_static
@@ -1,4 +0,0 @@
-chcp 437
-python kuroga.py config-msvc.py
-call "C:\Program Files (x86)\Microsoft Visual Studio 12.0\VC\vcvarsall.bat" x86_amd64
-ninja
@@ -8,7 +8,9 @@
 #include "../engine/core/ecs/entity_manager.hpp"
 #include "../engine/components/transform_hierarchy_component.hpp"
 #include "../engine/components/render_component.hpp"
-#include "tiny_obj_loader.h"
+#include "../engine/components/mesh_component.hpp"
+#include "../engine/assets/asset_registry.hpp"
+#include "../engine/assets/hot_reload.hpp"
 #include "../engine/gui/imgui.hpp"
 #include "../engine/gui/gui.hpp"
 
@@ -20,6 +22,10 @@ namespace hades
   public:
     EditorState state;
     std::unique_ptr<GUI> gui = std::make_unique<ImGui_GUI>();
+    AssetRegistry assets{"cache"};
+    HotReloader hotReloader{assets};
+    AssetHandle<MappedMesh> mesh;
+    std::vector<AssetHandle<MappedTexture>> textures;
 
     Editor()
     {
@@ -31,65 +37,35 @@ namespace hades
 
     void render(float deltaTime, EntityManager &entityManager, ComponentManager &componentManager)
     {
+      // Frame boundary: nothing from the previous frame reads assets any more
+      assets.apply_reloads();
+
       if (entityManager.getAllEntities().empty())
       {
         const auto id = entityManager.createEntity();
         componentManager.addComponent(id, TransformHierarchyComponent());
 
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        std::string warn;
-        std::string err;
-        bool ret = tinyobj::LoadObj(
-            &attrib,
-            &shapes,
-            &materials,
-            &warn,
-            &err,
+        mesh = assets.acquire_mesh(
             "/Users/adriannenu/Desktop/projects/hades-game-engine/src/tests/backpack/12305_backpack_v2_l3.obj",
-            "/Users/adriannenu/Desktop/projects/hades-game-engine/src/tests/backpack/", // Set material directory to NULL if not used
-            true,                                                                       // triangulate the mesh
-            true                                                                        // default vertex color fallback
-        );
-
-        if (!warn.empty())
-        {
-          std::cout << "WARN: " << warn << std::endl;
-        }
-        if (!err.empty())
-        {
-          std::cerr << "ERR: " << err << std::endl;
-        }
-
-        // Load vertices and indices from the .obj file
-        std::vector<float> vertices;
-        std::vector<uint16_t> indices;
-        for (const auto &shape : shapes)
+            "/Users/adriannenu/Desktop/projects/hades-game-engine/src/tests/backpack/");
+        if (mesh)
         {
-          for (const auto &index : shape.mesh.indices)
-          {
-            // Fill the vertex data (position, texture coords, etc.)
-            vertices.push_back(attrib.vertices[3 * index.vertex_index + 0]);
-            vertices.push_back(attrib.vertices[3 * index.vertex_index + 1]);
-            vertices.push_back(attrib.vertices[3 * index.vertex_index + 2]);
-            if (!attrib.texcoords.empty())
-            {
-              vertices.push_back(attrib.texcoords[2 * index.texcoord_index + 0]);
-              vertices.push_back(attrib.texcoords[2 * index.texcoord_index + 1]);
-            }
-            else
-            {
-              vertices.push_back(0.0f); // No texcoord, default to 0
-              vertices.push_back(0.0f);
-            }
-            indices.push_back(static_cast<uint16_t>(indices.size()));
-          }
+          componentManager.addComponent(id, MeshComponent{0});
+          std::vector<std::string> texture_paths;
+          for (uint32_t i = 0; i < mesh->material_count(); i++)
+            if (mesh->materials()[i].diffuse_texture[0] != '\0')
+              texture_paths.push_back(std::string("/Users/adriannenu/Desktop/projects/hades-game-engine/src/tests/backpack/") + mesh->materials()[i].diffuse_texture);
+          textures.resize(texture_paths.size());
+          JobSystem::get().parallel_for((uint32_t)texture_paths.size(), 1, [&](uint32_t begin, uint32_t end)
+                                        {
+                                          for (uint32_t i = begin; i < end; i++)
+                                            textures[i] = assets.acquire_texture(texture_paths[i]); });
         }
       }
 
       gui.get()->render_frame();
       entities(entityManager, componentManager);
+      residency();
       debug(deltaTime);
     }
 
@@ -141,6 +117,55 @@ namespace hades
       }
     }
 
+    void residency()
+    {
+      ImGui::Begin("Assets");
+      const AssetBudget budget = assets.get_budget();
+      uint64_t cpu_total = 0, gpu_total = 0;
+      for (uint32_t type = 0; type < ASSET_TYPE_COUNT; type++)
+      {
+        const AssetUsage usage = assets.get_usage((AssetType)type);
+        cpu_total += usage.cpu_bytes;
+        gpu_total += usage.gpu_bytes;
+        ImGui::Text("%s: %u resident, %u referenced, CPU %.1f MB, GPU %.1f MB", asset_type_name((AssetType)type),
+                    usage.resident, usage.referenced, usage.cpu_bytes / 1048576.0, usage.gpu_bytes / 1048576.0);
+        ImGui::Text("  %llu loads, %llu hits, %llu evictions, %llu reloads", (unsigned long long)usage.loads, (unsigned long long)usage.hits,
+                    (unsigned long long)usage.evictions, (unsigned long long)usage.reloads);
+      }
+
+      char overlay[64];
+      snprintf(overlay, sizeof(overlay), "CPU %.1f / %.0f MB", cpu_total / 1048576.0, budget.cpu_bytes / 1048576.0);
+      ImGui::ProgressBar(budget.cpu_bytes > 0 ? (float)cpu_total / budget.cpu_bytes : 1.0f, ImVec2(-1.0f, 0.0f), overlay);
+      snprintf(overlay, sizeof(overlay), "GPU %.1f / %.0f MB", gpu_total / 1048576.0, budget.gpu_bytes / 1048576.0);
+      ImGui::ProgressBar(budget.gpu_bytes > 0 ? (float)gpu_total / budget.gpu_bytes : 1.0f, ImVec2(-1.0f, 0.0f), overlay);
+
+      if (ImGui::BeginTable("resident", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+      {
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableSetupColumn("Path");
+        ImGui::TableSetupColumn("Refs");
+        ImGui::TableSetupColumn("CPU KB");
+        ImGui::TableSetupColumn("GPU KB");
+        ImGui::TableHeadersRow();
+        for (const AssetInfo &info : assets.snapshot())
+        {
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(asset_type_name(info.type));
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(info.path.c_str());
+          ImGui::TableNextColumn();
+          ImGui::Text("%u", info.references);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.1f", info.cpu_bytes / 1024.0);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.1f", info.gpu_bytes / 1024.0);
+        }
+        ImGui::EndTable();
+      }
+      ImGui::End();
+    }
+
     void debug(float deltaTime)
     {
       if (!state.showDebugInfo)
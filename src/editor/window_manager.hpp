@@ -23,6 +23,7 @@ namespace hades
     EntityManager entityManager;
     ComponentManager componentManager;
     SystemManager systemManager;
+    std::shared_ptr<RenderSystem> renderSystem;
     Editor editor;
     std::unique_ptr<Renderer> renderer = std::make_unique<VulkanRenderer>();
 
@@ -36,6 +37,7 @@ namespace hades
       // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
       // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite your copy of the keyboard data.
       // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
+      renderer.get()->wait_for_frame();
       SDL_Event event;
       while (SDL_PollEvent(&event))
       {
@@ -61,6 +63,13 @@ namespace hades
       ImGuiIO &io = ImGui::GetIO();
 
       editor.render(io.DeltaTime, entityManager, componentManager);
+      systemManager.updateSystems(io.DeltaTime, componentManager, entityManager);
+      renderer.get()->submit_scene(renderSystem->queue);
+      std::vector<const MappedTexture *> textures;
+      for (const AssetHandle<MappedTexture> &texture : editor.textures)
+        textures.push_back(texture.get());
+      renderer.get()->sync_assets({editor.mesh.get()}, textures);
+      renderer.get()->render_stats();
 
       // Rendering
       ImGui::Render();
@@ -73,7 +82,7 @@ namespace hades
       return 0;
     }
 
-    int init()
+    int init(const RendererSettings &settings = RendererSettings())
     {
       // Setup SDL
       if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER) != 0)
@@ -96,13 +105,14 @@ namespace hades
         return -1;
       }
 
+      renderer.get()->configure(settings);
       renderer.get()->init(window);
 
 
 
       // Register systems
       auto movementSystem = systemManager.registerSystem<MovementSystem>();
-      auto renderSystem = systemManager.registerSystem<RenderSystem>();
+      renderSystem = systemManager.registerSystem<RenderSystem>();
 
       return 0;
     }
@@ -0,0 +1,361 @@
+#ifndef ASSET_COOK_H
+#define ASSET_COOK_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cook_database.hpp"
+#include "mesh/mesh_cooker.hpp"
+#include "texture/texture_cooker.hpp"
+#include "../core/jobs/job_system.hpp"
+
+namespace hades
+{
+  enum CookKind : uint32_t
+  {
+    COOK_MESH = 0,
+    COOK_TEXTURE = 1,
+  };
+
+  // How a material uses a texture decides its colour space and format
+  enum TextureUsage : uint32_t
+  {
+    TEXTURE_USAGE_COLOUR = 0, // map_Kd, map_Ka, map_Ks, map_Ke
+    TEXTURE_USAGE_NORMAL = 1, // map_Bump, bump, norm
+    TEXTURE_USAGE_DATA = 2,   // Everything else: alpha, roughness, displacement...
+  };
+
+  struct CookNode
+  {
+    CookKind kind;
+    std::string source;
+    std::string material_dir;             // Meshes
+    TextureCookSettings texture_settings; // Textures
+    std::string variant;
+    std::vector<std::string> materials; // Meshes: material libraries folded into the cook
+    std::vector<uint32_t> textures;     // Meshes: texture nodes the materials reference
+  };
+
+  // Every cookable asset under a directory and the edges OBJ -> MTL -> texture
+  struct CookGraph
+  {
+    std::vector<CookNode> nodes;
+    std::vector<std::string> missing; // Referenced from a material but not on disk
+
+    static bool is_image(const std::filesystem::path &path)
+    {
+      std::string extension = path.extension().string();
+      std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c)
+                     { return (char)std::tolower(c); });
+      return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+    }
+
+    // Texture references of a material library, with the usage of each
+    static std::vector<std::pair<std::string, TextureUsage>> mtl_textures(const std::string &mtl_path)
+    {
+      std::vector<std::pair<std::string, TextureUsage>> textures;
+      MappedFile file;
+      if (!file.open(mtl_path))
+        return textures;
+      const std::string directory = std::filesystem::path(mtl_path).parent_path().string();
+      const char *line = (const char *)file.data();
+      const char *end = line + file.size();
+      while (line < end)
+      {
+        const char *line_end = (const char *)memchr(line, '\n', end - line);
+        if (line_end == nullptr)
+          line_end = end;
+        while (line < line_end && (*line == ' ' || *line == '\t'))
+          line++;
+        const char *keyword_end = line;
+        while (keyword_end < line_end && *keyword_end != ' ' && *keyword_end != '\t')
+          keyword_end++;
+        const std::string keyword(line, keyword_end);
+        if (keyword.compare(0, 4, "map_") == 0 || keyword == "bump" || keyword == "norm" || keyword == "disp" || keyword == "decal")
+        {
+          // Options such as -bm 0.5 precede the file name, which is always last
+          const char *name_end = line_end;
+          while (name_end > keyword_end && (name_end[-1] == '\r' || name_end[-1] == ' ' || name_end[-1] == '\t'))
+            name_end--;
+          const char *name = name_end;
+          while (name > keyword_end && name[-1] != ' ' && name[-1] != '\t')
+            name--;
+          if (name < name_end)
+          {
+            TextureUsage usage = TEXTURE_USAGE_DATA;
+            if (keyword == "map_Kd" || keyword == "map_Ka" || keyword == "map_Ks" || keyword == "map_Ke")
+              usage = TEXTURE_USAGE_COLOUR;
+            else if (keyword == "map_Bump" || keyword == "map_bump" || keyword == "bump" || keyword == "norm")
+              usage = TEXTURE_USAGE_NORMAL;
+            const std::string texture = (std::filesystem::path(directory) / std::string(name, name_end)).lexically_normal().string();
+            textures.emplace_back(texture, usage);
+          }
+        }
+        line = line_end + 1;
+      }
+      return textures;
+    }
+
+    static TextureCookSettings settings_for(TextureUsage usage, const TextureCookSettings &colour)
+    {
+      TextureCookSettings settings = colour;
+      if (usage != TEXTURE_USAGE_COLOUR)
+        settings.srgb = false;
+      if (usage == TEXTURE_USAGE_NORMAL)
+        settings.format = HTEX_FORMAT_BC5;
+      return settings;
+    }
+
+    static std::string texture_variant(const TextureCookSettings &settings)
+    {
+      return "texture f" + std::to_string(settings.format) + (settings.srgb ? " srgb" : " linear") +
+             " m" + std::to_string(settings.filter) + (settings.generate_mips ? " mips" : "");
+    }
+
+    // Images no material references are cooked as colour textures
+    static CookGraph scan(const std::string &root, const TextureCookSettings &colour = TextureCookSettings(), HMeshVertexFormat vertex_format = HMESH_VERTEX_QUANTIZED_UNORM16)
+    {
+      CookGraph graph;
+      std::vector<std::filesystem::path> objs;
+      std::set<std::string> images;
+      std::error_code ec;
+      for (auto it = std::filesystem::recursive_directory_iterator(root, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+      {
+        if (!it->is_regular_file())
+          continue;
+        const std::filesystem::path &path = it->path();
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c)
+                       { return (char)std::tolower(c); });
+        if (extension == ".obj")
+          objs.push_back(path.lexically_normal());
+        else if (is_image(path))
+          images.insert(path.lexically_normal().string());
+      }
+      std::sort(objs.begin(), objs.end());
+
+      std::map<std::string, uint32_t> texture_nodes; // Source and variant -> node
+      auto texture_node = [&](const std::string &path, const TextureCookSettings &settings)
+      {
+        const std::string variant = texture_variant(settings);
+        const std::string node_key = CookDatabase::key(path, variant);
+        auto found = texture_nodes.find(node_key);
+        if (found != texture_nodes.end())
+          return found->second;
+        CookNode node;
+        node.kind = COOK_TEXTURE;
+        node.source = path;
+        node.texture_settings = settings;
+        node.variant = variant;
+        graph.nodes.push_back(std::move(node));
+        return texture_nodes[node_key] = (uint32_t)graph.nodes.size() - 1;
+      };
+
+      std::set<std::string> referenced;
+      for (const std::filesystem::path &obj : objs)
+      {
+        CookNode node;
+        node.kind = COOK_MESH;
+        node.source = obj.string();
+        node.material_dir = obj.parent_path().string() + "/";
+        node.variant = "mesh v" + std::to_string(vertex_format);
+        node.materials = MeshCooker::obj_dependencies(node.source, node.material_dir);
+        std::vector<uint32_t> textures;
+        for (const std::string &mtl : node.materials)
+        {
+          if (!std::filesystem::is_regular_file(mtl))
+          {
+            graph.missing.push_back(mtl);
+            continue;
+          }
+          for (const auto &texture : mtl_textures(mtl))
+          {
+            if (!std::filesystem::is_regular_file(texture.first))
+            {
+              graph.missing.push_back(texture.first);
+              continue;
+            }
+            referenced.insert(texture.first);
+            textures.push_back(texture_node(texture.first, settings_for(texture.second, colour)));
+          }
+        }
+        std::sort(textures.begin(), textures.end());
+        textures.erase(std::unique(textures.begin(), textures.end()), textures.end());
+        node.textures = std::move(textures);
+        graph.nodes.push_back(std::move(node));
+      }
+
+      for (const std::string &image : images)
+        if (referenced.count(image) == 0)
+          texture_node(image, colour);
+
+      std::sort(graph.missing.begin(), graph.missing.end());
+      graph.missing.erase(std::unique(graph.missing.begin(), graph.missing.end()), graph.missing.end());
+      return graph;
+    }
+  };
+
+  struct CookOptions
+  {
+    std::string cache_dir = "cache";
+    HMeshVertexFormat vertex_format = HMESH_VERTEX_QUANTIZED_UNORM16;
+    bool force = false;   // Ignore the database and cache and cook everything
+    bool verbose = false; // Print per-asset cook stats
+  };
+
+  struct CookSummary
+  {
+    uint32_t cooked = 0;
+    uint32_t up_to_date = 0;
+    uint32_t failed = 0;
+    uint32_t pruned = 0; // Outputs of sources that disappeared
+    std::vector<std::string> failures;
+  };
+
+  // Brings the cache up to date with a graph. A node whose recorded input
+  // stamps and cooker version still match is skipped without reading its
+  // sources; otherwise its cache key is rehashed and it is cooked only when
+  // the key changed. Nodes are checked in parallel, one job each. Identical
+  // sources share a cache key and output, so the nodes left to cook are
+  // grouped by output and each group is cooked once. The cookers spread
+  // their own work over the same pool.
+  inline CookSummary cook_graph(const CookGraph &graph, CookDatabase &database, const CookOptions &options, JobSystem &jobs = JobSystem::get())
+  {
+    enum Outcome : uint32_t
+    {
+      OUTCOME_UP_TO_DATE,
+      OUTCOME_COOKED,
+      OUTCOME_FAILED,
+      OUTCOME_STALE, // Key changed, cook pending
+    };
+    std::vector<Outcome> outcomes(graph.nodes.size(), OUTCOME_FAILED);
+    std::vector<CookRecord> records(graph.nodes.size());
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.cache_dir, ec);
+    MeshCooker meshes(MeshCooker::cache_dir_in(options.cache_dir), options.vertex_format);
+    TextureCooker textures(TextureCooker::cache_dir_in(options.cache_dir));
+    meshes.set_verbose(options.verbose);
+    textures.set_verbose(options.verbose);
+
+    JobCounter counter;
+    for (uint32_t i = 0; i < graph.nodes.size(); i++)
+      jobs.run([&, i]
+               {
+                 const CookNode &node = graph.nodes[i];
+                 const uint32_t version = node.kind == COOK_MESH ? MESH_COOKER_VERSION : TEXTURE_COOKER_VERSION;
+                 const CookRecord *previous = options.force ? nullptr : database.find(CookDatabase::key(node.source, node.variant));
+                 if (previous != nullptr && previous->cooker_version == version && std::filesystem::is_regular_file(previous->output) &&
+                     std::all_of(previous->inputs.begin(), previous->inputs.end(), [](const CookStamp &stamp)
+                                 { return stamp.current(); }))
+                 {
+                   records[i] = *previous;
+                   outcomes[i] = OUTCOME_UP_TO_DATE;
+                   return;
+                 }
+
+                 // Stamp before hashing so an edit made while cooking is seen next run
+                 CookRecord &record = records[i];
+                 record.source = node.source;
+                 record.variant = node.variant;
+                 record.cooker_version = version;
+                 std::vector<std::string> inputs = {node.source};
+                 inputs.insert(inputs.end(), node.materials.begin(), node.materials.end());
+                 for (const std::string &input : inputs)
+                 {
+                   CookStamp stamp;
+                   if (CookStamp::take(input, stamp))
+                     record.inputs.push_back(stamp);
+                 }
+
+                 if (node.kind == COOK_MESH)
+                 {
+                   record.hash = MeshCooker::hash_obj(node.source, node.material_dir, options.vertex_format);
+                   if (record.hash == 0)
+                     return;
+                   record.output = meshes.cooked_path(record.hash);
+                 }
+                 else
+                 {
+                   MappedFile source;
+                   if (!source.open(node.source))
+                     return;
+                   record.hash = TextureCooker::hash_texture(source.data(), source.size(), node.texture_settings);
+                   record.output = textures.cooked_path(record.hash);
+                 }
+                 const bool current = !options.force && previous != nullptr && previous->hash == record.hash && std::filesystem::is_regular_file(record.output);
+                 outcomes[i] = current ? OUTCOME_UP_TO_DATE : OUTCOME_STALE; },
+               counter);
+    jobs.wait(counter);
+
+    std::map<std::string, std::vector<uint32_t>> groups; // Output -> nodes cooking into it
+    for (uint32_t i = 0; i < graph.nodes.size(); i++)
+      if (outcomes[i] == OUTCOME_STALE)
+        groups[records[i].output].push_back(i);
+    for (const auto &entry : groups)
+      jobs.run([&, group = &entry]
+               {
+                 const CookNode &node = graph.nodes[group->second[0]];
+                 std::error_code remove_error;
+                 if (options.force)
+                   std::filesystem::remove(group->first, remove_error);
+                 const bool ok = node.kind == COOK_MESH ? meshes.load_obj(node.source, node.material_dir).has_value()
+                                                        : textures.load(node.source, node.texture_settings, jobs).has_value();
+                 for (uint32_t i : group->second)
+                   outcomes[i] = ok ? OUTCOME_COOKED : OUTCOME_FAILED; },
+               counter);
+    jobs.wait(counter);
+
+    // Merge on this thread; the database was read-only while jobs ran
+    CookSummary summary;
+    std::set<std::string> live;
+    for (uint32_t i = 0; i < graph.nodes.size(); i++)
+    {
+      const CookNode &node = graph.nodes[i];
+      live.insert(CookDatabase::key(node.source, node.variant));
+      switch (outcomes[i])
+      {
+      case OUTCOME_UP_TO_DATE:
+        summary.up_to_date++;
+        database.put(records[i]);
+        break;
+      case OUTCOME_COOKED:
+        summary.cooked++;
+        database.put(records[i]);
+        break;
+      case OUTCOME_FAILED:
+      case OUTCOME_STALE:
+        summary.failed++;
+        summary.failures.push_back(node.source);
+        database.erase(CookDatabase::key(node.source, node.variant));
+        break;
+      }
+    }
+
+    // Drop records of sources that are gone, and their outputs unless another record shares them
+    std::vector<std::string> stale;
+    for (const auto &entry : database.records())
+      if (live.count(entry.first) == 0)
+        stale.push_back(entry.first);
+    for (const std::string &record_key : stale)
+    {
+      const std::string output = database.find(record_key)->output;
+      database.erase(record_key);
+      const bool shared = std::any_of(database.records().begin(), database.records().end(), [&](const auto &entry)
+                                      { return entry.second.output == output; });
+      if (!shared)
+        std::filesystem::remove(output, ec);
+      summary.pruned++;
+    }
+    return summary;
+  }
+}
+
+#endif
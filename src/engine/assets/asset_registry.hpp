@@ -0,0 +1,530 @@
+#ifndef ASSET_REGISTRY_H
+#define ASSET_REGISTRY_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mesh/mesh_cooker.hpp"
+#include "texture/texture_cooker.hpp"
+#include "../core/hash/hash.hpp"
+#include "../core/io/file_watcher.hpp"
+#include "../core/jobs/job_system.hpp"
+
+namespace hades
+{
+  enum AssetType : uint32_t
+  {
+    ASSET_MESH = 0,
+    ASSET_TEXTURE = 1,
+    ASSET_TYPE_COUNT = 2,
+  };
+
+  inline const char *asset_type_name(AssetType type)
+  {
+    switch (type)
+    {
+    case ASSET_MESH:
+      return "Mesh";
+    case ASSET_TEXTURE:
+      return "Texture";
+    default:
+      return "Unknown";
+    }
+  }
+
+  // Memory the registry may keep resident. Referenced assets are never
+  // evicted, so the totals can exceed the budget while they are in use.
+  struct AssetBudget
+  {
+    uint64_t cpu_bytes = 512ull << 20;
+    uint64_t gpu_bytes = 1024ull << 20;
+  };
+
+  struct AssetUsage
+  {
+    uint32_t resident = 0;
+    uint32_t referenced = 0;
+    uint64_t cpu_bytes = 0; // Mapped cooked files
+    uint64_t gpu_bytes = 0; // Size of the data the renderer uploads
+    uint64_t loads = 0;
+    uint64_t hits = 0; // Acquires served by an asset that was already resident
+    uint64_t evictions = 0;
+    uint64_t reloads = 0;
+  };
+
+  struct AssetInfo
+  {
+    uint64_t key;
+    AssetType type;
+    std::string path;
+    uint32_t references;
+    uint64_t cpu_bytes;
+    uint64_t gpu_bytes;
+    uint32_t generation; // Bumped every time a reload swaps in new contents
+  };
+
+  class AssetRegistry;
+
+  // Counted reference to a resident asset. The asset stays loaded and its
+  // address stable while any handle to it exists; handles must not outlive
+  // the registry that issued them.
+  template <typename T>
+  class AssetHandle
+  {
+  private:
+    AssetRegistry *registry = nullptr;
+    uint64_t asset_key = 0;
+    const T *asset = nullptr;
+
+    friend class AssetRegistry;
+    AssetHandle(AssetRegistry *registry, uint64_t key, const T *asset) : registry(registry), asset_key(key), asset(asset) {}
+
+  public:
+    AssetHandle() = default;
+    AssetHandle(const AssetHandle &other);
+    AssetHandle(AssetHandle &&other) noexcept;
+    AssetHandle &operator=(AssetHandle other) noexcept;
+    ~AssetHandle() { reset(); }
+
+    void reset();
+
+    explicit operator bool() const { return asset != nullptr; }
+    const T *get() const { return asset; }
+    const T *operator->() const { return asset; }
+    const T &operator*() const { return *asset; }
+    uint64_t key() const { return asset_key; }
+  };
+
+  // Central owner of loaded assets. Assets are keyed by a hash of their type
+  // and normalized path (plus cook settings for textures), so every load of
+  // the same file shares one copy. Unreferenced assets stay resident for
+  // reuse and are evicted least recently released first once either memory
+  // budget is exceeded.
+  class AssetRegistry
+  {
+  private:
+    struct Entry
+    {
+      AssetType type;
+      std::string path;
+      uint32_t references = 0;
+      bool loading = true;
+      bool failed = false;
+      uint64_t cpu_bytes = 0;
+      uint64_t gpu_bytes = 0;
+      std::optional<MappedMesh> mesh;
+      std::optional<MappedTexture> texture;
+      std::list<uint64_t>::iterator lru; // Valid while unreferenced
+      std::function<bool(Entry &)> load;
+      std::vector<std::string> dependencies; // Source files, absolute and normalized
+      uint32_t generation = 0;
+      bool reloading = false;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable loaded;
+    std::unordered_map<uint64_t, std::unique_ptr<Entry>> entries;
+    std::list<uint64_t> lru; // Unreferenced resident assets, most recently released first
+    AssetBudget budget;
+    AssetUsage usage[ASSET_TYPE_COUNT];
+    std::unordered_multimap<std::string, uint64_t> dependents; // Source file -> assets cooked from it
+    uint64_t dependency_version = 0;
+    std::vector<std::pair<uint64_t, std::unique_ptr<Entry>>> staged; // Re-cooked assets waiting for apply_reloads
+    MeshCooker mesh_cooker;
+    TextureCooker texture_cooker;
+
+    template <typename T>
+    friend class AssetHandle;
+
+    static uint64_t make_key(AssetType type, const std::string &path, uint64_t seed = 0)
+    {
+      return hash64(path, hash_combine(type, seed));
+    }
+
+    static std::string normalize(const std::string &path)
+    {
+      return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    void add_dependents_locked(uint64_t key, const Entry &entry)
+    {
+      for (const std::string &dependency : entry.dependencies)
+        dependents.emplace(dependency, key);
+      dependency_version++;
+    }
+
+    void remove_dependents_locked(uint64_t key, const Entry &entry)
+    {
+      for (const std::string &dependency : entry.dependencies)
+      {
+        auto range = dependents.equal_range(dependency);
+        for (auto it = range.first; it != range.second; ++it)
+          if (it->second == key)
+          {
+            dependents.erase(it);
+            break;
+          }
+      }
+    }
+
+    void retain_locked(Entry &entry)
+    {
+      if (entry.references++ == 0 && !entry.loading && !entry.failed)
+      {
+        lru.erase(entry.lru);
+        usage[entry.type].referenced++;
+      }
+    }
+
+    void release_locked(uint64_t key)
+    {
+      auto it = entries.find(key);
+      if (it == entries.end())
+        return;
+      Entry &entry = *it->second;
+      if (--entry.references > 0)
+        return;
+      if (entry.failed)
+      {
+        entries.erase(it); // Failures are not cached, the next acquire retries
+        return;
+      }
+      usage[entry.type].referenced--;
+      lru.push_front(key);
+      entry.lru = lru.begin();
+      enforce_budget_locked();
+    }
+
+    uint64_t total_cpu_bytes_locked() const
+    {
+      uint64_t total = 0;
+      for (const AssetUsage &type_usage : usage)
+        total += type_usage.cpu_bytes;
+      return total;
+    }
+
+    uint64_t total_gpu_bytes_locked() const
+    {
+      uint64_t total = 0;
+      for (const AssetUsage &type_usage : usage)
+        total += type_usage.gpu_bytes;
+      return total;
+    }
+
+    void enforce_budget_locked()
+    {
+      while (!lru.empty() && (total_cpu_bytes_locked() > budget.cpu_bytes || total_gpu_bytes_locked() > budget.gpu_bytes))
+      {
+        const uint64_t key = lru.back();
+        lru.pop_back();
+        auto it = entries.find(key);
+        AssetUsage &type_usage = usage[it->second->type];
+        type_usage.resident--;
+        type_usage.cpu_bytes -= it->second->cpu_bytes;
+        type_usage.gpu_bytes -= it->second->gpu_bytes;
+        type_usage.evictions++;
+        remove_dependents_locked(key, *it->second);
+        entries.erase(it);
+      }
+    }
+
+    // Returns the entry for key with a reference held, loading it through
+    // load when it is not resident. Concurrent acquires of an asset that is
+    // still loading wait for the first one instead of loading it again.
+    Entry *acquire(uint64_t key, AssetType type, const std::string &path, std::function<bool(Entry &)> load)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      auto it = entries.find(key);
+      if (it != entries.end())
+      {
+        Entry &entry = *it->second;
+        if (entry.type != type || entry.path != path)
+        {
+          std::cerr << "ERR: asset key collision between " << entry.path << " and " << path << std::endl;
+          return nullptr;
+        }
+        retain_locked(entry);
+        loaded.wait(lock, [&]
+                    { return !entry.loading; });
+        if (entry.failed)
+        {
+          release_locked(key);
+          return nullptr;
+        }
+        usage[type].hits++;
+        return &entry;
+      }
+
+      Entry &entry = *entries.emplace(key, std::make_unique<Entry>()).first->second;
+      entry.type = type;
+      entry.path = path;
+      entry.references = 1;
+      entry.load = std::move(load);
+      lock.unlock();
+      const bool ok = entry.load(entry);
+      lock.lock();
+
+      entry.loading = false;
+      entry.failed = !ok;
+      if (ok)
+      {
+        AssetUsage &type_usage = usage[type];
+        type_usage.resident++;
+        type_usage.referenced++;
+        type_usage.loads++;
+        type_usage.cpu_bytes += entry.cpu_bytes;
+        type_usage.gpu_bytes += entry.gpu_bytes;
+        add_dependents_locked(key, entry);
+        enforce_budget_locked();
+      }
+      loaded.notify_all();
+      if (!ok)
+      {
+        release_locked(key);
+        return nullptr;
+      }
+      return &entry;
+    }
+
+  public:
+    explicit AssetRegistry(const std::string &cache_dir, AssetBudget budget = AssetBudget())
+        : budget(budget),
+          mesh_cooker(MeshCooker::cache_dir_in(cache_dir)),
+          texture_cooker(TextureCooker::cache_dir_in(cache_dir)) {}
+
+    AssetRegistry(const AssetRegistry &) = delete;
+    AssetRegistry &operator=(const AssetRegistry &) = delete;
+
+    AssetHandle<MappedMesh> acquire_mesh(const std::string &obj_path, const std::string &material_dir)
+    {
+      const std::string path = normalize(obj_path);
+      const uint64_t key = make_key(ASSET_MESH, path);
+      Entry *entry = acquire(key, ASSET_MESH, path, [this, obj_path, material_dir](Entry &out)
+                             {
+                               out.mesh = mesh_cooker.load_obj(obj_path, material_dir);
+                               if (!out.mesh)
+                                 return false;
+                               out.dependencies.push_back(FileWatcher::normalize(obj_path));
+                               for (const std::string &library : MeshCooker::obj_dependencies(obj_path, material_dir))
+                                 out.dependencies.push_back(FileWatcher::normalize(library));
+                               out.cpu_bytes = out.mesh->size_bytes();
+                               out.gpu_bytes = (uint64_t)out.mesh->vertex_count() * out.mesh->header().vertex_stride + out.mesh->index_size_bytes();
+                               return true; });
+      if (entry == nullptr)
+        return AssetHandle<MappedMesh>();
+      return AssetHandle<MappedMesh>(this, key, &*entry->mesh);
+    }
+
+    AssetHandle<MappedTexture> acquire_texture(const std::string &image_path, const TextureCookSettings &settings = TextureCookSettings())
+    {
+      const std::string path = normalize(image_path);
+      const uint32_t packed[4] = {settings.format, settings.srgb ? 1u : 0u, settings.filter, settings.generate_mips ? 1u : 0u};
+      const uint64_t key = make_key(ASSET_TEXTURE, path, hash64(packed, sizeof(packed)));
+      Entry *entry = acquire(key, ASSET_TEXTURE, path, [this, image_path, settings](Entry &out)
+                             {
+                               out.texture = texture_cooker.load(image_path, settings);
+                               if (!out.texture)
+                                 return false;
+                               out.dependencies.push_back(FileWatcher::normalize(image_path));
+                               out.cpu_bytes = out.texture->size_bytes();
+                               for (uint32_t level = 0; level < out.texture->mip_count(); level++)
+                                 out.gpu_bytes += out.texture->mip(level).size;
+                               return true; });
+      if (entry == nullptr)
+        return AssetHandle<MappedTexture>();
+      return AssetHandle<MappedTexture>(this, key, &*entry->texture);
+    }
+
+    void set_budget(AssetBudget new_budget)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      budget = new_budget;
+      enforce_budget_locked();
+    }
+
+    AssetBudget get_budget() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return budget;
+    }
+
+    AssetUsage get_usage(AssetType type) const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return usage[type];
+    }
+
+    // Evicts every unreferenced asset regardless of the budget
+    void purge()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const AssetBudget saved = budget;
+      budget = AssetBudget{0, 0};
+      enforce_budget_locked();
+      budget = saved;
+    }
+
+    bool is_resident(uint64_t key) const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = entries.find(key);
+      return it != entries.end() && !it->second->loading && !it->second->failed;
+    }
+
+    // Re-cooks every resident asset built from path on the job system. The
+    // results are staged rather than swapped in, so nothing the current
+    // frame reads changes under it. Returns the number of jobs started.
+    uint32_t reload_dependents(const std::string &path, JobCounter &counter, JobSystem &jobs = JobSystem::get())
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      uint32_t scheduled = 0;
+      auto range = dependents.equal_range(FileWatcher::normalize(path));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        Entry &entry = *entries.at(it->second);
+        if (entry.loading || entry.reloading)
+          continue;
+        entry.reloading = true;
+        const uint64_t key = it->second;
+        const AssetType type = entry.type;
+        std::function<bool(Entry &)> load = entry.load;
+        jobs.run([this, key, type, load]
+                 {
+                   auto fresh = std::make_unique<Entry>();
+                   fresh->type = type;
+                   const bool ok = load(*fresh);
+                   std::lock_guard<std::mutex> lock(mutex);
+                   auto found = entries.find(key);
+                   if (found != entries.end())
+                     found->second->reloading = false;
+                   if (ok)
+                     staged.emplace_back(key, std::move(fresh)); },
+                 counter);
+        scheduled++;
+      }
+      return scheduled;
+    }
+
+    // Swaps staged reloads into their entries. Call between frames: handles
+    // keep their addresses but see the new contents from here on. Reloads
+    // that cooked to identical output are dropped. Returns the number applied.
+    uint32_t apply_reloads()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      uint32_t applied = 0;
+      for (auto &[key, fresh] : staged)
+      {
+        auto it = entries.find(key);
+        if (it == entries.end() || it->second->loading)
+          continue; // Evicted while re-cooking
+        Entry &entry = *it->second;
+        const uint64_t old_hash = entry.mesh ? entry.mesh->source_hash() : entry.texture->source_hash();
+        const uint64_t new_hash = fresh->mesh ? fresh->mesh->source_hash() : fresh->texture->source_hash();
+        if (old_hash == new_hash)
+          continue;
+
+        AssetUsage &type_usage = usage[entry.type];
+        type_usage.cpu_bytes = type_usage.cpu_bytes - entry.cpu_bytes + fresh->cpu_bytes;
+        type_usage.gpu_bytes = type_usage.gpu_bytes - entry.gpu_bytes + fresh->gpu_bytes;
+        type_usage.reloads++;
+        remove_dependents_locked(key, entry);
+        entry.mesh = std::move(fresh->mesh);
+        entry.texture = std::move(fresh->texture);
+        entry.cpu_bytes = fresh->cpu_bytes;
+        entry.gpu_bytes = fresh->gpu_bytes;
+        entry.dependencies = std::move(fresh->dependencies);
+        add_dependents_locked(key, entry);
+        entry.generation++;
+        applied++;
+      }
+      staged.clear();
+      enforce_budget_locked();
+      return applied;
+    }
+
+    // Every source file a resident asset was cooked from; changes whenever
+    // get_dependency_version() does
+    std::vector<std::string> dependency_paths() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::vector<std::string> paths;
+      for (auto it = dependents.begin(); it != dependents.end(); it = dependents.equal_range(it->first).second)
+        paths.push_back(it->first);
+      return paths;
+    }
+
+    uint64_t get_dependency_version() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return dependency_version;
+    }
+
+    uint32_t generation(uint64_t key) const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = entries.find(key);
+      return it != entries.end() ? it->second->generation : 0;
+    }
+
+    std::vector<AssetInfo> snapshot() const
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::vector<AssetInfo> infos;
+      infos.reserve(entries.size());
+      for (const auto &[key, entry] : entries)
+        if (!entry->loading && !entry->failed)
+          infos.push_back(AssetInfo{key, entry->type, entry->path, entry->references, entry->cpu_bytes, entry->gpu_bytes, entry->generation});
+      return infos;
+    }
+  };
+
+  template <typename T>
+  AssetHandle<T>::AssetHandle(const AssetHandle &other) : registry(other.registry), asset_key(other.asset_key), asset(other.asset)
+  {
+    if (registry != nullptr)
+    {
+      std::lock_guard<std::mutex> lock(registry->mutex);
+      registry->retain_locked(*registry->entries.at(asset_key));
+    }
+  }
+
+  template <typename T>
+  AssetHandle<T>::AssetHandle(AssetHandle &&other) noexcept : registry(other.registry), asset_key(other.asset_key), asset(other.asset)
+  {
+    other.registry = nullptr;
+    other.asset = nullptr;
+  }
+
+  template <typename T>
+  AssetHandle<T> &AssetHandle<T>::operator=(AssetHandle other) noexcept
+  {
+    std::swap(registry, other.registry);
+    std::swap(asset_key, other.asset_key);
+    std::swap(asset, other.asset);
+    return *this;
+  }
+
+  template <typename T>
+  void AssetHandle<T>::reset()
+  {
+    if (registry != nullptr)
+    {
+      std::lock_guard<std::mutex> lock(registry->mutex);
+      registry->release_locked(asset_key);
+    }
+    registry = nullptr;
+    asset = nullptr;
+  }
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef COOK_DATABASE_H
+#define COOK_DATABASE_H
+
+#include <charconv>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../core/io/atomic_file.hpp"
+#include "../core/io/mapped_file.hpp"
+
+namespace hades
+{
+  constexpr uint32_t COOK_DATABASE_VERSION = 1;
+
+  // Size and modification time of a file folded into a cook. While every
+  // stamp of a record still matches, the cook is current without rehashing.
+  struct CookStamp
+  {
+    std::string path;
+    uint64_t size = 0;
+    int64_t mtime = 0; // Ticks of the file clock
+
+    static bool take(const std::string &path, CookStamp &stamp)
+    {
+      std::error_code ec;
+      const uint64_t size = std::filesystem::file_size(path, ec);
+      if (ec)
+        return false;
+      const auto time = std::filesystem::last_write_time(path, ec);
+      if (ec)
+        return false;
+      stamp.path = path;
+      stamp.size = size;
+      stamp.mtime = (int64_t)time.time_since_epoch().count();
+      return true;
+    }
+
+    bool current() const
+    {
+      CookStamp now;
+      return take(path, now) && now.size == size && now.mtime == mtime;
+    }
+  };
+
+  struct CookRecord
+  {
+    std::string source;
+    std::string variant; // Cook settings; one source may be cooked several ways
+    uint32_t cooker_version = 0;
+    uint64_t hash = 0; // Cache key the output is named after
+    std::string output;
+    std::vector<CookStamp> inputs; // Every file folded into hash
+  };
+
+  // Persistent record of what hades_cook produced, stored next to the cooked
+  // files as tab separated text:
+  //
+  //   hades-cook-db <version>
+  //   R <cooker version> <hash> <input count> <source> <variant> <output>
+  //   I <size> <mtime> <path>          (input count times)
+  class CookDatabase
+  {
+  private:
+    std::map<std::string, CookRecord> entries;
+
+    static std::vector<std::string> split(const std::string &line)
+    {
+      std::vector<std::string> fields;
+      std::string field;
+      std::istringstream stream(line);
+      while (std::getline(stream, field, '\t'))
+        fields.push_back(field);
+      return fields;
+    }
+
+    // Whole field as a number; false on garbage, trailing text or overflow
+    template <typename T>
+    static bool parse(const std::string &field, T &value, int base = 10)
+    {
+      const char *end = field.data() + field.size();
+      const std::from_chars_result result = std::from_chars(field.data(), end, value, base);
+      return result.ec == std::errc() && result.ptr == end && !field.empty();
+    }
+
+    bool parse_records(std::istringstream &stream)
+    {
+      std::string line;
+      while (std::getline(stream, line))
+      {
+        std::vector<std::string> fields = split(line);
+        CookRecord record;
+        size_t input_count;
+        if (fields.size() != 7 || fields[0] != "R" || !parse(fields[1], record.cooker_version) || !parse(fields[2], record.hash, 16) ||
+            !parse(fields[3], input_count))
+          return false;
+        record.source = fields[4];
+        record.variant = fields[5];
+        record.output = fields[6];
+        for (size_t i = 0; i < input_count; i++)
+        {
+          std::vector<std::string> input;
+          CookStamp stamp;
+          if (!std::getline(stream, line) || (input = split(line)).size() != 4 || input[0] != "I" || !parse(input[1], stamp.size) ||
+              !parse(input[2], stamp.mtime))
+            return false;
+          stamp.path = input[3];
+          record.inputs.push_back(std::move(stamp));
+        }
+        entries[key(record.source, record.variant)] = std::move(record);
+      }
+      return true;
+    }
+
+  public:
+    static std::string key(const std::string &source, const std::string &variant)
+    {
+      return source + '\t' + variant;
+    }
+
+    // A missing database is an empty one; a malformed one is discarded so
+    // the next run re-cooks everything instead of trusting it
+    bool load(const std::string &path)
+    {
+      entries.clear();
+      MappedFile file;
+      if (!file.open(path))
+        return true;
+      std::istringstream stream(std::string((const char *)file.data(), file.size()));
+      std::string line;
+      char expected[32];
+      snprintf(expected, sizeof(expected), "hades-cook-db %u", COOK_DATABASE_VERSION);
+      if (!std::getline(stream, line) || line != expected || !parse_records(stream))
+      {
+        entries.clear();
+        return false;
+      }
+      return true;
+    }
+
+    bool save(const std::string &path) const
+    {
+      std::ostringstream out;
+      out << "hades-cook-db " << COOK_DATABASE_VERSION << '\n';
+      for (const auto &entry : entries)
+      {
+        const CookRecord &record = entry.second;
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016" PRIx64, record.hash);
+        out << "R\t" << record.cooker_version << '\t' << hash << '\t' << record.inputs.size() << '\t'
+            << record.source << '\t' << record.variant << '\t' << record.output << '\n';
+        for (const CookStamp &input : record.inputs)
+          out << "I\t" << input.size << '\t' << input.mtime << '\t' << input.path << '\n';
+      }
+      const std::string text = out.str();
+      return write_file_atomic(path, std::vector<uint8_t>(text.begin(), text.end()));
+    }
+
+    const CookRecord *find(const std::string &record_key) const
+    {
+      auto found = entries.find(record_key);
+      return found == entries.end() ? nullptr : &found->second;
+    }
+
+    void put(CookRecord record)
+    {
+      std::string record_key = key(record.source, record.variant);
+      entries[std::move(record_key)] = std::move(record);
+    }
+
+    void erase(const std::string &record_key) { entries.erase(record_key); }
+    const std::map<std::string, CookRecord> &records() const { return entries; }
+  };
+}
+
+#endif
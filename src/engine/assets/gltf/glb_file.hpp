@@ -0,0 +1,245 @@
+#ifndef GLB_FILE_H
+#define GLB_FILE_H
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <string>
+#include <vector>
+
+#include "../../core/io/mapped_file.hpp"
+#include "../../core/text/json_reader.hpp"
+
+// Binary glTF 2.0 (.glb)
+//
+// [12 byte header][JSON chunk][BIN chunk]
+//
+// The JSON chunk is parsed in place and accessors resolve to pointers into
+// the mapped BIN chunk, so vertex and index data is never copied on load.
+namespace hades
+{
+  constexpr uint32_t GLB_MAGIC = 0x46546c67; // "glTF"
+  constexpr uint32_t GLB_VERSION = 2;
+  constexpr uint32_t GLB_CHUNK_JSON = 0x4e4f534a;
+  constexpr uint32_t GLB_CHUNK_BIN = 0x004e4942;
+
+  enum GltfComponentType : uint32_t
+  {
+    GLTF_BYTE = 5120,
+    GLTF_UNSIGNED_BYTE = 5121,
+    GLTF_SHORT = 5122,
+    GLTF_UNSIGNED_SHORT = 5123,
+    GLTF_UNSIGNED_INT = 5125,
+    GLTF_FLOAT = 5126,
+  };
+
+  inline uint32_t gltf_component_size(uint32_t component_type)
+  {
+    switch (component_type)
+    {
+    case GLTF_BYTE:
+    case GLTF_UNSIGNED_BYTE:
+      return 1;
+    case GLTF_SHORT:
+    case GLTF_UNSIGNED_SHORT:
+      return 2;
+    case GLTF_UNSIGNED_INT:
+    case GLTF_FLOAT:
+      return 4;
+    default:
+      return 0;
+    }
+  }
+
+  inline uint32_t gltf_component_count(std::string_view type)
+  {
+    if (type == "SCALAR")
+      return 1;
+    if (type == "VEC2")
+      return 2;
+    if (type == "VEC3")
+      return 3;
+    if (type == "VEC4")
+      return 4;
+    if (type == "MAT4")
+      return 16;
+    return 0;
+  }
+
+  // Strided elements of T read straight from the mapped file. Elements may be
+  // unaligned, so they are fetched with memcpy rather than dereferenced.
+  template <typename T>
+  class StridedView
+  {
+  private:
+    const uint8_t *bytes = nullptr;
+    uint32_t element_count = 0;
+    uint32_t byte_stride = 0;
+
+  public:
+    StridedView() = default;
+    StridedView(const uint8_t *bytes, uint32_t count, uint32_t stride) : bytes(bytes), element_count(count), byte_stride(stride) {}
+
+    bool valid() const { return bytes != nullptr; }
+    uint32_t size() const { return element_count; }
+    uint32_t stride() const { return byte_stride; }
+    const uint8_t *data() const { return bytes; }
+
+    T operator[](uint32_t i) const
+    {
+      T value;
+      memcpy(&value, bytes + (size_t)i * byte_stride, sizeof(T));
+      return value;
+    }
+
+    // Direct pointer when the elements are tightly packed and aligned for T
+    const T *packed() const
+    {
+      if (byte_stride != sizeof(T) || (uintptr_t)bytes % alignof(T) != 0)
+        return nullptr;
+      return (const T *)bytes;
+    }
+  };
+
+  struct GlbAccessor
+  {
+    const uint8_t *data = nullptr; // First element, inside the BIN chunk
+    uint32_t count = 0;
+    uint32_t stride = 0;
+    uint32_t component_type = 0;
+    uint32_t components = 0;
+    bool normalized = false;
+
+    bool valid() const { return data != nullptr; }
+    uint32_t element_size() const { return gltf_component_size(component_type) * components; }
+
+    // Typed view; invalid unless T has exactly the size of one element of the
+    // expected component type (e.g. std::array<float, 3> for a VEC3 FLOAT accessor)
+    template <typename T>
+    StridedView<T> view(uint32_t expected_component_type) const
+    {
+      if (!valid() || component_type != expected_component_type || sizeof(T) != element_size())
+        return StridedView<T>();
+      return StridedView<T>(data, count, stride);
+    }
+  };
+
+  class GlbFile
+  {
+  private:
+    MappedFile file;
+    JsonValue root;
+    const uint8_t *bin_ptr = nullptr;
+    uint64_t bin_length = 0;
+
+    // Element positions of the top level arrays, found once on open
+    std::vector<JsonValue> accessor_values;
+    std::vector<JsonValue> buffer_view_values;
+    std::vector<JsonValue> mesh_values;
+    std::vector<JsonValue> node_values;
+    std::vector<JsonValue> material_values;
+
+    static void collect(JsonValue array, std::vector<JsonValue> &out)
+    {
+      for (JsonValue element : array)
+        out.push_back(element);
+    }
+
+  public:
+    static std::optional<GlbFile> open(const std::string &path)
+    {
+      GlbFile glb;
+      if (!glb.file.open(path) || glb.file.size() < 20)
+        return std::nullopt;
+
+      const uint8_t *bytes = glb.file.data();
+      uint32_t header[3];
+      memcpy(header, bytes, sizeof(header));
+      if (header[0] != GLB_MAGIC || header[1] != GLB_VERSION || header[2] > glb.file.size())
+        return std::nullopt;
+
+      uint64_t offset = 12;
+      bool has_json = false;
+      while (offset + 8 <= header[2])
+      {
+        uint32_t chunk[2];
+        memcpy(chunk, bytes + offset, sizeof(chunk));
+        const uint64_t chunk_begin = offset + 8;
+        if (chunk_begin + chunk[0] > header[2])
+          return std::nullopt;
+        if (chunk[1] == GLB_CHUNK_JSON && !has_json)
+        {
+          glb.root = JsonValue::parse((const char *)bytes + chunk_begin, chunk[0]);
+          has_json = true;
+        }
+        else if (chunk[1] == GLB_CHUNK_BIN && glb.bin_ptr == nullptr)
+        {
+          glb.bin_ptr = bytes + chunk_begin;
+          glb.bin_length = chunk[0];
+        }
+        offset = chunk_begin + ((chunk[0] + 3u) & ~3u);
+      }
+      if (!glb.root.is_object())
+        return std::nullopt;
+
+      collect(glb.root["accessors"], glb.accessor_values);
+      collect(glb.root["bufferViews"], glb.buffer_view_values);
+      collect(glb.root["meshes"], glb.mesh_values);
+      collect(glb.root["nodes"], glb.node_values);
+      collect(glb.root["materials"], glb.material_values);
+      return glb;
+    }
+
+    const JsonValue &json() const { return root; }
+    const uint8_t *bin() const { return bin_ptr; }
+    uint64_t bin_size() const { return bin_length; }
+
+    uint32_t mesh_count() const { return (uint32_t)mesh_values.size(); }
+    uint32_t node_count() const { return (uint32_t)node_values.size(); }
+    uint32_t material_count() const { return (uint32_t)material_values.size(); }
+    JsonValue mesh(uint32_t index) const { return index < mesh_values.size() ? mesh_values[index] : JsonValue(); }
+    JsonValue node(uint32_t index) const { return index < node_values.size() ? node_values[index] : JsonValue(); }
+    JsonValue material(uint32_t index) const { return index < material_values.size() ? material_values[index] : JsonValue(); }
+
+    // Resolves an accessor into the BIN chunk. Accessors without a buffer
+    // view, sparse accessors and buffers other than the embedded one come
+    // back invalid, as do any that would read past their buffer view.
+    GlbAccessor accessor(uint64_t index) const
+    {
+      GlbAccessor result;
+      if (index >= accessor_values.size() || bin_ptr == nullptr)
+        return result;
+      const JsonValue accessor = accessor_values[index];
+      const uint64_t view_index = accessor["bufferView"].as_uint(UINT64_MAX);
+      if (view_index >= buffer_view_values.size() || accessor["sparse"].valid())
+        return result;
+      const JsonValue view = buffer_view_values[view_index];
+      if (view["buffer"].as_uint(UINT64_MAX) != 0)
+        return result;
+
+      const uint32_t component_type = (uint32_t)accessor["componentType"].as_uint();
+      const uint32_t components = gltf_component_count(accessor["type"].as_string());
+      const uint64_t element_size = (uint64_t)gltf_component_size(component_type) * components;
+      const uint64_t count = accessor["count"].as_uint();
+      const uint64_t stride = view["byteStride"].as_uint(element_size);
+      const uint64_t view_offset = view["byteOffset"].as_uint();
+      const uint64_t view_length = view["byteLength"].as_uint();
+      const uint64_t accessor_offset = accessor["byteOffset"].as_uint();
+      if (element_size == 0 || stride < element_size || stride > 252 || count == 0 || count > UINT32_MAX)
+        return result;
+      if (view_offset + view_length > bin_length || accessor_offset + stride * (count - 1) + element_size > view_length)
+        return result;
+
+      result.data = bin_ptr + view_offset + accessor_offset;
+      result.count = (uint32_t)count;
+      result.stride = (uint32_t)stride;
+      result.component_type = component_type;
+      result.components = components;
+      result.normalized = accessor["normalized"].as_bool();
+      return result;
+    }
+  };
+}
+
+#endif
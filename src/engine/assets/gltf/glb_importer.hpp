@@ -0,0 +1,273 @@
+#ifndef GLB_IMPORTER_H
+#define GLB_IMPORTER_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "glb_file.hpp"
+#include "../mesh/mesh_data.hpp"
+#include "../../components/mesh_component.hpp"
+#include "../../components/transform_component.hpp"
+#include "../../components/transform_hierarchy_component.hpp"
+#include "../../core/ecs/component_manager.hpp"
+#include "../../core/ecs/entity_manager.hpp"
+
+namespace hades
+{
+  constexpr uint32_t GLTF_MODE_TRIANGLES = 4;
+
+  // Splits a column-major affine matrix into translation, rotation and scale
+  inline void decompose_matrix(const float *m, TransformComponent &transform)
+  {
+    for (int axis = 0; axis < 3; axis++)
+    {
+      transform.translation[axis] = m[12 + axis];
+      transform.scale[axis] = std::sqrt(m[axis * 4] * m[axis * 4] + m[axis * 4 + 1] * m[axis * 4 + 1] + m[axis * 4 + 2] * m[axis * 4 + 2]);
+    }
+    float r[3][3]; // r[column][row], scale removed
+    for (int column = 0; column < 3; column++)
+      for (int row = 0; row < 3; row++)
+        r[column][row] = transform.scale[column] > 0.0f ? m[column * 4 + row] / transform.scale[column] : 0.0f;
+
+    // Shepperd's method: branch on the largest diagonal term for stability
+    float *q = transform.rotation;
+    const float trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0.0f)
+    {
+      const float s = std::sqrt(trace + 1.0f) * 2.0f;
+      q[3] = 0.25f * s;
+      q[0] = (r[1][2] - r[2][1]) / s;
+      q[1] = (r[2][0] - r[0][2]) / s;
+      q[2] = (r[0][1] - r[1][0]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+      const float s = std::sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]) * 2.0f;
+      q[3] = (r[1][2] - r[2][1]) / s;
+      q[0] = 0.25f * s;
+      q[1] = (r[1][0] + r[0][1]) / s;
+      q[2] = (r[2][0] + r[0][2]) / s;
+    }
+    else if (r[1][1] > r[2][2])
+    {
+      const float s = std::sqrt(1.0f + r[1][1] - r[0][0] - r[2][2]) * 2.0f;
+      q[3] = (r[2][0] - r[0][2]) / s;
+      q[0] = (r[1][0] + r[0][1]) / s;
+      q[1] = 0.25f * s;
+      q[2] = (r[2][1] + r[1][2]) / s;
+    }
+    else
+    {
+      const float s = std::sqrt(1.0f + r[2][2] - r[0][0] - r[1][1]) * 2.0f;
+      q[3] = (r[0][1] - r[1][0]) / s;
+      q[0] = (r[2][0] + r[0][2]) / s;
+      q[1] = (r[2][1] + r[1][2]) / s;
+      q[2] = 0.25f * s;
+    }
+  }
+
+  inline void read_floats(JsonValue array, float *out, size_t count)
+  {
+    size_t i = 0;
+    for (JsonValue value : array)
+    {
+      if (i == count)
+        break;
+      out[i] = value.as_float(out[i]);
+      i++;
+    }
+  }
+
+  // Creates one entity per glTF node with its local transform and links them
+  // through TransformHierarchyComponent. Nodes with a mesh also get a
+  // MeshComponent. Returns the entity of every node, in node order.
+  inline std::vector<Entity::EntityId> import_glb_nodes(const GlbFile &glb, EntityManager &entityManager, ComponentManager &componentManager)
+  {
+    std::vector<Entity::EntityId> entities(glb.node_count());
+    std::vector<TransformHierarchyComponent> hierarchy(glb.node_count());
+    for (uint32_t i = 0; i < glb.node_count(); i++)
+    {
+      entities[i] = entityManager.createEntity();
+      const JsonValue node = glb.node(i);
+
+      TransformComponent transform;
+      const JsonValue matrix = node["matrix"];
+      if (matrix.is_array())
+      {
+        float m[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+        read_floats(matrix, m, 16);
+        decompose_matrix(m, transform);
+      }
+      else
+      {
+        read_floats(node["translation"], transform.translation, 3);
+        read_floats(node["rotation"], transform.rotation, 4);
+        read_floats(node["scale"], transform.scale, 3);
+      }
+      componentManager.addComponent(entities[i], transform);
+
+      const uint64_t mesh = node["mesh"].as_uint(UINT64_MAX);
+      if (mesh < glb.mesh_count())
+        componentManager.addComponent(entities[i], MeshComponent{(uint32_t)mesh});
+    }
+
+    // Malformed files can list a node as its own ancestor; such links are dropped
+    std::vector<uint32_t> parents(glb.node_count(), UINT32_MAX);
+    for (uint32_t i = 0; i < glb.node_count(); i++)
+      for (JsonValue child : glb.node(i)["children"])
+      {
+        const uint64_t index = child.as_uint(UINT64_MAX);
+        if (index >= entities.size() || parents[index] != UINT32_MAX)
+          continue;
+        uint32_t ancestor = i;
+        while (ancestor != index && ancestor != UINT32_MAX)
+          ancestor = parents[ancestor];
+        if (ancestor == index)
+          continue;
+        parents[index] = i;
+        hierarchy[i].addChild(entities[index]);
+        hierarchy[index].setParent(entities[i]);
+      }
+    for (uint32_t i = 0; i < glb.node_count(); i++)
+      componentManager.addComponent(entities[i], hierarchy[i]);
+    return entities;
+  }
+
+  // Reads a float attribute of up to four components, accepting normalized
+  // integer encodings as allowed by the spec for texture coordinates
+  inline bool read_attribute(const GlbAccessor &accessor, uint32_t components, uint32_t i, float *out)
+  {
+    if (accessor.components != components)
+      return false;
+    const uint8_t *element = accessor.data + (size_t)i * accessor.stride;
+    for (uint32_t c = 0; c < components; c++)
+    {
+      switch (accessor.component_type)
+      {
+      case GLTF_FLOAT:
+        memcpy(&out[c], element + c * 4, 4);
+        break;
+      case GLTF_UNSIGNED_SHORT:
+      {
+        uint16_t value;
+        memcpy(&value, element + c * 2, 2);
+        out[c] = accessor.normalized ? value / 65535.0f : value;
+        break;
+      }
+      case GLTF_UNSIGNED_BYTE:
+        out[c] = accessor.normalized ? element[c] / 255.0f : element[c];
+        break;
+      default:
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Converts the triangle primitives of one glTF mesh into a MeshData with a
+  // submesh per primitive, ready for the mesh cooker
+  inline bool import_glb_mesh(const GlbFile &glb, uint32_t mesh_index, MeshData &mesh)
+  {
+    const JsonValue source = glb.mesh(mesh_index);
+    if (!source.valid())
+      return false;
+
+    mesh = MeshData();
+    for (uint32_t i = 0; i < glb.material_count(); i++)
+    {
+      const JsonValue material = glb.material(i);
+      MeshMaterial dst;
+      dst.name = std::string(material["name"].as_string());
+      float base_color[4] = {1, 1, 1, 1};
+      read_floats(material["pbrMetallicRoughness"]["baseColorFactor"], base_color, 4);
+      memcpy(dst.diffuse, base_color, sizeof(dst.diffuse));
+      mesh.materials.push_back(dst);
+    }
+    const uint32_t default_material = (uint32_t)mesh.materials.size();
+    bool uses_default_material = false;
+
+    for (JsonValue primitive : source["primitives"])
+    {
+      if (primitive["mode"].as_uint(GLTF_MODE_TRIANGLES) != GLTF_MODE_TRIANGLES)
+        continue;
+      const JsonValue attributes = primitive["attributes"];
+      const GlbAccessor positions = glb.accessor(attributes["POSITION"].as_uint(UINT64_MAX));
+      const StridedView<std::array<float, 3>> position_view = positions.view<std::array<float, 3>>(GLTF_FLOAT);
+      if (!position_view.valid())
+        return false;
+      const GlbAccessor normals = glb.accessor(attributes["NORMAL"].as_uint(UINT64_MAX));
+      const GlbAccessor texcoords = glb.accessor(attributes["TEXCOORD_0"].as_uint(UINT64_MAX));
+
+      Submesh submesh;
+      submesh.index_offset = (uint32_t)mesh.indices.size();
+      submesh.base_vertex = (uint32_t)mesh.vertices.size();
+      submesh.vertex_count = positions.count;
+      const uint64_t material = primitive["material"].as_uint(UINT64_MAX);
+      submesh.material = material < default_material ? (uint32_t)material : default_material;
+      uses_default_material |= submesh.material == default_material;
+
+      for (uint32_t v = 0; v < positions.count; v++)
+      {
+        MeshVertex vertex = {};
+        memcpy(vertex.position, position_view[v].data(), sizeof(vertex.position));
+        if (normals.valid() && normals.count == positions.count)
+          read_attribute(normals, 3, v, vertex.normal);
+        if (texcoords.valid() && texcoords.count == positions.count)
+          read_attribute(texcoords, 2, v, vertex.uv);
+        submesh.bounds.expand(vertex.position);
+        mesh.bounds.expand(vertex.position);
+        mesh.vertices.push_back(vertex);
+      }
+
+      const JsonValue indices_value = primitive["indices"];
+      if (indices_value.valid())
+      {
+        const GlbAccessor indices = glb.accessor(indices_value.as_uint(UINT64_MAX));
+        if (!indices.valid() || indices.components != 1)
+          return false;
+        for (uint32_t i = 0; i < indices.count; i++)
+        {
+          const uint8_t *element = indices.data + (size_t)i * indices.stride;
+          uint32_t index;
+          if (indices.component_type == GLTF_UNSIGNED_INT)
+            memcpy(&index, element, 4);
+          else if (indices.component_type == GLTF_UNSIGNED_SHORT)
+          {
+            uint16_t narrow;
+            memcpy(&narrow, element, 2);
+            index = narrow;
+          }
+          else if (indices.component_type == GLTF_UNSIGNED_BYTE)
+            index = *element;
+          else
+            return false;
+          if (index >= positions.count)
+            return false;
+          mesh.indices.push_back(submesh.base_vertex + index);
+        }
+      }
+      else
+      {
+        for (uint32_t i = 0; i < positions.count; i++)
+          mesh.indices.push_back(submesh.base_vertex + i);
+      }
+      submesh.index_count = (uint32_t)mesh.indices.size() - submesh.index_offset;
+      mesh.submeshes.push_back(submesh);
+    }
+
+    if (uses_default_material)
+    {
+      MeshMaterial fallback;
+      fallback.name = "default";
+      mesh.materials.push_back(fallback);
+    }
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "asset_registry.hpp"
+#include "../core/io/file_watcher.hpp"
+#include "../core/jobs/job_system.hpp"
+
+namespace hades
+{
+  // Watches the source files of every resident asset and re-cooks the assets
+  // built from a file after it changes. Watching and cooking happen off the
+  // frame loop; the frame loop only calls AssetRegistry::apply_reloads() at
+  // a frame boundary to swap the results in.
+  //
+  // Editors often save in several steps (truncate, write, rename), so a file
+  // is only reloaded once it has been quiet for quiet_period.
+  class HotReloader
+  {
+  private:
+    AssetRegistry &registry;
+    JobSystem &jobs;
+    std::chrono::milliseconds quiet_period;
+    JobCounter counter;
+    std::atomic<bool> running{true};
+    std::thread thread;
+
+    void watch_loop()
+    {
+      FileWatcher watcher;
+      uint64_t watched_version = UINT64_MAX;
+      std::unordered_map<std::string, std::chrono::steady_clock::time_point> pending; // File -> last change
+      while (running.load(std::memory_order_relaxed))
+      {
+        const uint64_t version = registry.get_dependency_version();
+        if (version != watched_version)
+        {
+          for (const std::string &path : registry.dependency_paths())
+            watcher.watch(path);
+          watched_version = version;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        for (const std::string &path : watcher.poll(50))
+          pending[path] = now;
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+          if (std::chrono::steady_clock::now() - it->second < quiet_period)
+          {
+            ++it;
+            continue;
+          }
+          registry.reload_dependents(it->first, counter, jobs);
+          it = pending.erase(it);
+        }
+      }
+    }
+
+  public:
+    explicit HotReloader(AssetRegistry &registry, JobSystem &jobs = JobSystem::get(), std::chrono::milliseconds quiet_period = std::chrono::milliseconds(100))
+        : registry(registry), jobs(jobs), quiet_period(quiet_period)
+    {
+      thread = std::thread([this]
+                           { watch_loop(); });
+    }
+
+    ~HotReloader()
+    {
+      running.store(false, std::memory_order_relaxed);
+      thread.join();
+      jobs.wait(counter);
+    }
+
+    HotReloader(const HotReloader &) = delete;
+    HotReloader &operator=(const HotReloader &) = delete;
+  };
+}
+
+#endif
@@ -0,0 +1,569 @@
+#ifndef HMESH_H
+#define HMESH_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mesh_data.hpp"
+#include "mesh_indexing.hpp"
+#include "vertex_quantization.hpp"
+#include "../../core/io/atomic_file.hpp"
+#include "../../core/io/mapped_file.hpp"
+
+// Cooked mesh format (.hmesh)
+//
+// [HMeshHeader][HMeshSection x section_count][section payloads...]
+//
+// Every payload starts on an HMESH_ALIGNMENT boundary so the mapped file can be
+// read in place. All values are little endian.
+//
+// Vertices are either full MeshVertex floats or QuantizedVertex, as recorded
+// in the header's vertex_format. Quantized files also carry the ranges the
+// vertex stage needs to decode them.
+//
+// The index section is a byte stream: each submesh stores 16-bit or 32-bit
+// indices relative to its base_vertex, starting at a 4-byte aligned offset.
+// LOD levels of a submesh share its vertex range and index width.
+//
+// Level 0 of every submesh is also split into meshlets. Meshlet vertices are
+// relative to the submesh base_vertex; meshlet triangles are byte triplets
+// into the meshlet's vertex list, starting at a 4-byte aligned offset.
+namespace hades
+{
+  constexpr uint32_t HMESH_MAGIC = 0x48534d48; // "HMSH"
+  constexpr uint32_t HMESH_VERSION = 5;
+  constexpr uint64_t HMESH_ALIGNMENT = 16;
+
+  enum HMeshSectionType : uint32_t
+  {
+    HMESH_SECTION_VERTICES = 1,
+    HMESH_SECTION_INDICES = 2,
+    HMESH_SECTION_SUBMESHES = 3,
+    HMESH_SECTION_MATERIALS = 4,
+    HMESH_SECTION_LODS = 5,
+    HMESH_SECTION_MESHLETS = 6,
+    HMESH_SECTION_MESHLET_VERTICES = 7,
+    HMESH_SECTION_MESHLET_TRIANGLES = 8,
+    HMESH_SECTION_VERTEX_QUANTIZATION = 9,
+  };
+
+  enum HMeshVertexFormat : uint32_t
+  {
+    HMESH_VERTEX_FLOAT = 0,             // MeshVertex
+    HMESH_VERTEX_QUANTIZED_UNORM16 = 1, // QuantizedVertex, unorm16 positions
+    HMESH_VERTEX_QUANTIZED_HALF = 2,    // QuantizedVertex, half float positions
+  };
+
+  struct HMeshHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_hash; // Content hash of the source asset this file was cooked from
+    uint64_t file_size;
+    uint32_t vertex_count;
+    uint32_t vertex_stride;
+    uint32_t vertex_format; // HMeshVertexFormat
+    uint32_t reserved;
+    uint32_t index_count; // Total indices over all submeshes, whatever their width
+    uint32_t submesh_count;
+    uint32_t material_count;
+    uint32_t section_count;
+    float bounds_min[3];
+    float bounds_max[3];
+  };
+
+  struct HMeshSection
+  {
+    uint32_t type;
+    uint32_t count;
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  struct HMeshSubmesh
+  {
+    uint32_t index_offset; // Byte offset into the index section
+    uint32_t index_count;
+    uint32_t index_size; // 2 or 4 bytes
+    uint32_t base_vertex;
+    uint32_t vertex_count;
+    uint32_t material;
+    uint32_t lod_offset; // First entry of the LOD table belonging to this submesh
+    uint32_t lod_count;  // Levels below level 0, ordered from finest to coarsest
+    uint32_t meshlet_offset;
+    uint32_t meshlet_count;
+    float bounds_min[3];
+    float bounds_max[3];
+  };
+
+  struct HMeshLod
+  {
+    uint32_t level;
+    uint32_t index_offset; // Byte offset into the index section
+    uint32_t index_count;
+    float error; // Object space deviation from level 0
+  };
+
+  struct HMeshMeshlet
+  {
+    uint32_t vertex_offset;   // First entry in the meshlet vertex section
+    uint32_t triangle_offset; // Byte offset into the meshlet triangle section
+    uint32_t vertex_count;
+    uint32_t triangle_count;
+    float center[3];
+    float radius;
+    float cone_apex[3];
+    float cone_cutoff; // 1 when the cluster cannot be backface culled
+    float cone_axis[3];
+    uint32_t reserved;
+  };
+
+  struct HMeshVertexQuantization
+  {
+    float position_offset[3];
+    float position_scale[3];
+    float uv_offset[2];
+    float uv_scale[2];
+  };
+
+  struct HMeshMaterial
+  {
+    char name[64];
+    char diffuse_texture[256];
+    float diffuse[3];
+    uint32_t reserved;
+  };
+
+  static_assert(std::is_trivially_copyable<HMeshHeader>::value, "HMeshHeader must be trivially copyable");
+  static_assert(sizeof(HMeshHeader) == 80, "HMeshHeader layout changed");
+  static_assert(sizeof(HMeshSection) == 24, "HMeshSection layout changed");
+  static_assert(sizeof(HMeshSubmesh) == 64, "HMeshSubmesh layout changed");
+  static_assert(sizeof(HMeshLod) == 16, "HMeshLod layout changed");
+  static_assert(sizeof(HMeshMeshlet) == 64, "HMeshMeshlet layout changed");
+  static_assert(sizeof(HMeshVertexQuantization) == 40, "HMeshVertexQuantization layout changed");
+  static_assert(sizeof(HMeshMaterial) == 336, "HMeshMaterial layout changed");
+  static_assert(sizeof(MeshVertex) == 32, "MeshVertex layout changed");
+
+  inline uint64_t hmesh_align(uint64_t value)
+  {
+    return (value + HMESH_ALIGNMENT - 1) & ~(HMESH_ALIGNMENT - 1);
+  }
+
+  class HMeshWriter
+  {
+  private:
+    struct PendingSection
+    {
+      uint32_t type;
+      uint32_t count;
+      const void *data;
+      uint64_t size;
+    };
+    std::vector<PendingSection> sections;
+
+  public:
+    void add_section(uint32_t type, uint32_t count, const void *data, uint64_t size)
+    {
+      sections.push_back(PendingSection{type, count, data, size});
+    }
+
+    // Lays out the header, section table and payloads into one contiguous buffer
+    std::vector<uint8_t> build(HMeshHeader header) const
+    {
+      header.magic = HMESH_MAGIC;
+      header.version = HMESH_VERSION;
+      header.section_count = (uint32_t)sections.size();
+
+      std::vector<HMeshSection> table(sections.size());
+      uint64_t offset = hmesh_align(sizeof(HMeshHeader) + sizeof(HMeshSection) * sections.size());
+      for (size_t i = 0; i < sections.size(); i++)
+      {
+        table[i].type = sections[i].type;
+        table[i].count = sections[i].count;
+        table[i].offset = offset;
+        table[i].size = sections[i].size;
+        offset = hmesh_align(offset + sections[i].size);
+      }
+      header.file_size = offset;
+
+      std::vector<uint8_t> bytes(offset, 0);
+      memcpy(bytes.data(), &header, sizeof(header));
+      if (!table.empty())
+        memcpy(bytes.data() + sizeof(header), table.data(), sizeof(HMeshSection) * table.size());
+      for (size_t i = 0; i < sections.size(); i++)
+        if (sections[i].size > 0)
+          memcpy(bytes.data() + table[i].offset, sections[i].data, sections[i].size);
+      return bytes;
+    }
+  };
+
+  inline void copy_fixed_string(char *dst, size_t capacity, const std::string &src)
+  {
+    const size_t length = src.size() < capacity - 1 ? src.size() : capacity - 1;
+    memcpy(dst, src.data(), length);
+    dst[length] = '\0';
+  }
+
+  // Appends indices relative to base_vertex at a 4-byte aligned offset and returns that offset
+  inline uint32_t append_indices(std::vector<uint8_t> &index_bytes, const uint32_t *indices, uint32_t count, uint32_t base_vertex, uint32_t index_size)
+  {
+    const uint32_t offset = (uint32_t)((index_bytes.size() + 3) & ~(size_t)3);
+    index_bytes.resize(offset + (size_t)index_size * count, 0);
+    uint8_t *out = index_bytes.data() + offset;
+    for (uint32_t j = 0; j < count; j++)
+    {
+      const uint32_t local = indices[j] - base_vertex;
+      if (index_size == 2)
+      {
+        const uint16_t narrow = (uint16_t)local;
+        memcpy(out + j * 2, &narrow, 2);
+      }
+      else
+      {
+        memcpy(out + j * 4, &local, 4);
+      }
+    }
+    return offset;
+  }
+
+  inline bool is_quantized_vertex_format(uint32_t vertex_format)
+  {
+    return vertex_format == HMESH_VERTEX_QUANTIZED_UNORM16 || vertex_format == HMESH_VERTEX_QUANTIZED_HALF;
+  }
+
+  inline VertexPositionEncoding position_encoding(uint32_t vertex_format)
+  {
+    return vertex_format == HMESH_VERTEX_QUANTIZED_HALF ? VERTEX_POSITION_HALF : VERTEX_POSITION_UNORM16;
+  }
+
+  // report, when given, receives the quantization error of quantized formats
+  inline bool write_hmesh(const MeshData &mesh, uint64_t source_hash, const std::string &path,
+                          HMeshVertexFormat vertex_format = HMESH_VERTEX_FLOAT, VertexQuantizationReport *report = nullptr)
+  {
+    std::vector<HMeshSubmesh> submeshes(mesh.submeshes.size());
+    std::vector<HMeshLod> lods(mesh.lods.size());
+    std::vector<uint8_t> index_bytes;
+    for (size_t i = 0; i < mesh.submeshes.size(); i++)
+    {
+      const Submesh &src = mesh.submeshes[i];
+      HMeshSubmesh &dst = submeshes[i];
+      memset(&dst, 0, sizeof(dst));
+      dst.index_size = index_size_for_vertex_count(src.vertex_count);
+      dst.index_offset = append_indices(index_bytes, mesh.indices.data() + src.index_offset, src.index_count, src.base_vertex, dst.index_size);
+      dst.index_count = src.index_count;
+      dst.base_vertex = src.base_vertex;
+      dst.vertex_count = src.vertex_count;
+      dst.material = src.material;
+      dst.lod_offset = (uint32_t)lods.size();
+      for (size_t l = 0; l < mesh.lods.size(); l++)
+      {
+        const MeshLod &lod = mesh.lods[l];
+        if (lod.submesh != i)
+          continue;
+        if (dst.lod_count == 0)
+          dst.lod_offset = (uint32_t)l;
+        dst.lod_count++;
+        lods[l].level = lod.level;
+        lods[l].index_offset = append_indices(index_bytes, mesh.indices.data() + lod.index_offset, lod.index_count, src.base_vertex, dst.index_size);
+        lods[l].index_count = lod.index_count;
+        lods[l].error = lod.error;
+      }
+      dst.meshlet_offset = src.meshlet_offset;
+      dst.meshlet_count = src.meshlet_count;
+      memcpy(dst.bounds_min, src.bounds.min, sizeof(dst.bounds_min));
+      memcpy(dst.bounds_max, src.bounds.max, sizeof(dst.bounds_max));
+    }
+
+    std::vector<HMeshMeshlet> meshlets(mesh.meshlets.size());
+    for (size_t i = 0; i < mesh.meshlets.size(); i++)
+    {
+      const Meshlet &src = mesh.meshlets[i];
+      HMeshMeshlet &dst = meshlets[i];
+      memset(&dst, 0, sizeof(dst));
+      dst.vertex_offset = src.vertex_offset;
+      dst.triangle_offset = src.triangle_offset;
+      dst.vertex_count = src.vertex_count;
+      dst.triangle_count = src.triangle_count;
+      memcpy(dst.center, src.bounds.center, sizeof(dst.center));
+      dst.radius = src.bounds.radius;
+      memcpy(dst.cone_apex, src.bounds.cone_apex, sizeof(dst.cone_apex));
+      dst.cone_cutoff = src.bounds.cone_cutoff;
+      memcpy(dst.cone_axis, src.bounds.cone_axis, sizeof(dst.cone_axis));
+    }
+
+    std::vector<HMeshMaterial> materials(mesh.materials.size());
+    for (size_t i = 0; i < mesh.materials.size(); i++)
+    {
+      HMeshMaterial &dst = materials[i];
+      memset(&dst, 0, sizeof(dst));
+      copy_fixed_string(dst.name, sizeof(dst.name), mesh.materials[i].name);
+      copy_fixed_string(dst.diffuse_texture, sizeof(dst.diffuse_texture), mesh.materials[i].diffuse_texture);
+      memcpy(dst.diffuse, mesh.materials[i].diffuse, sizeof(dst.diffuse));
+    }
+
+    HMeshHeader header;
+    memset(&header, 0, sizeof(header));
+    header.source_hash = source_hash;
+    header.vertex_count = (uint32_t)mesh.vertices.size();
+    header.vertex_stride = sizeof(MeshVertex);
+    header.vertex_format = vertex_format;
+    header.index_count = (uint32_t)mesh.indices.size();
+    header.submesh_count = (uint32_t)submeshes.size();
+    header.material_count = (uint32_t)materials.size();
+    memcpy(header.bounds_min, mesh.bounds.min, sizeof(header.bounds_min));
+    memcpy(header.bounds_max, mesh.bounds.max, sizeof(header.bounds_max));
+
+    HMeshWriter writer;
+    std::vector<QuantizedVertex> quantized;
+    HMeshVertexQuantization decode;
+    if (is_quantized_vertex_format(vertex_format))
+    {
+      VertexQuantization quantization;
+      const VertexQuantizationReport quantization_report = quantize_vertices(mesh, position_encoding(vertex_format), quantization, quantized);
+      if (report != nullptr)
+        *report = quantization_report;
+      memcpy(decode.position_offset, quantization.position_offset, sizeof(decode.position_offset));
+      memcpy(decode.position_scale, quantization.position_scale, sizeof(decode.position_scale));
+      memcpy(decode.uv_offset, quantization.uv_offset, sizeof(decode.uv_offset));
+      memcpy(decode.uv_scale, quantization.uv_scale, sizeof(decode.uv_scale));
+      header.vertex_stride = sizeof(QuantizedVertex);
+      writer.add_section(HMESH_SECTION_VERTICES, header.vertex_count, quantized.data(), sizeof(QuantizedVertex) * quantized.size());
+      writer.add_section(HMESH_SECTION_VERTEX_QUANTIZATION, 1, &decode, sizeof(decode));
+    }
+    else
+    {
+      writer.add_section(HMESH_SECTION_VERTICES, header.vertex_count, mesh.vertices.data(), sizeof(MeshVertex) * mesh.vertices.size());
+    }
+    writer.add_section(HMESH_SECTION_INDICES, header.index_count, index_bytes.data(), index_bytes.size());
+    writer.add_section(HMESH_SECTION_SUBMESHES, header.submesh_count, submeshes.data(), sizeof(HMeshSubmesh) * submeshes.size());
+    writer.add_section(HMESH_SECTION_MATERIALS, header.material_count, materials.data(), sizeof(HMeshMaterial) * materials.size());
+    writer.add_section(HMESH_SECTION_LODS, (uint32_t)lods.size(), lods.data(), sizeof(HMeshLod) * lods.size());
+    writer.add_section(HMESH_SECTION_MESHLETS, (uint32_t)meshlets.size(), meshlets.data(), sizeof(HMeshMeshlet) * meshlets.size());
+    writer.add_section(HMESH_SECTION_MESHLET_VERTICES, (uint32_t)mesh.meshlet_vertices.size(), mesh.meshlet_vertices.data(), sizeof(uint32_t) * mesh.meshlet_vertices.size());
+    writer.add_section(HMESH_SECTION_MESHLET_TRIANGLES, (uint32_t)mesh.meshlet_triangles.size(), mesh.meshlet_triangles.data(), mesh.meshlet_triangles.size());
+    return write_file_atomic(path, writer.build(header));
+  }
+
+  // Zero-copy view of a cooked mesh. Every accessor points into the mapping;
+  // nothing is parsed or copied after open() validates the layout.
+  class MappedMesh
+  {
+  private:
+    MappedFile file;
+    const HMeshHeader *header_ptr = nullptr;
+    const MeshVertex *vertex_ptr = nullptr;
+    const QuantizedVertex *quantized_ptr = nullptr;
+    const HMeshVertexQuantization *quantization_ptr = nullptr;
+    const uint8_t *index_ptr = nullptr;
+    uint64_t index_bytes = 0;
+    const HMeshSubmesh *submesh_ptr = nullptr;
+    const HMeshMaterial *material_ptr = nullptr;
+    const HMeshLod *lod_ptr = nullptr;
+    uint32_t lod_total = 0;
+    const HMeshMeshlet *meshlet_ptr = nullptr;
+    uint32_t meshlet_total = 0;
+    const uint32_t *meshlet_vertex_ptr = nullptr;
+    uint32_t meshlet_vertex_total = 0;
+    const uint8_t *meshlet_triangle_ptr = nullptr;
+    uint32_t meshlet_triangle_bytes = 0;
+
+    // Element count recorded in a section's table entry, 0 when absent
+    uint32_t section_count(uint32_t type) const
+    {
+      const HMeshSection *section = find_section(type);
+      return section != nullptr ? section->count : 0;
+    }
+
+    const HMeshSection *find_section(uint32_t type) const
+    {
+      const HMeshSection *table = (const HMeshSection *)(file.data() + sizeof(HMeshHeader));
+      for (uint32_t i = 0; i < header_ptr->section_count; i++)
+        if (table[i].type == type)
+          return &table[i];
+      return nullptr;
+    }
+
+    // Returns nullptr if the section is missing, misaligned or does not hold count elements of element_size
+    const void *section_data(uint32_t type, uint64_t element_size, uint64_t count) const
+    {
+      const HMeshSection *section = find_section(type);
+      if (section == nullptr || section->size != element_size * count)
+        return nullptr;
+      if (section->offset % HMESH_ALIGNMENT != 0 || section->offset + section->size > file.size())
+        return nullptr;
+      return file.data() + section->offset;
+    }
+
+  public:
+    static std::optional<MappedMesh> open(const std::string &path)
+    {
+      MappedMesh mesh;
+      if (!mesh.file.open(path) || mesh.file.size() < sizeof(HMeshHeader))
+        return std::nullopt;
+
+      mesh.header_ptr = (const HMeshHeader *)mesh.file.data();
+      const HMeshHeader &header = *mesh.header_ptr;
+      if (header.magic != HMESH_MAGIC || header.version != HMESH_VERSION || header.file_size != mesh.file.size())
+        return std::nullopt;
+      if (header.vertex_format == HMESH_VERTEX_FLOAT)
+      {
+        if (header.vertex_stride != sizeof(MeshVertex))
+          return std::nullopt;
+      }
+      else if (!is_quantized_vertex_format(header.vertex_format) || header.vertex_stride != sizeof(QuantizedVertex))
+      {
+        return std::nullopt;
+      }
+      if (sizeof(HMeshHeader) + sizeof(HMeshSection) * (uint64_t)header.section_count > mesh.file.size())
+        return std::nullopt;
+
+      const void *vertex_data = mesh.section_data(HMESH_SECTION_VERTICES, header.vertex_stride, header.vertex_count);
+      if (vertex_data == nullptr)
+        return std::nullopt;
+      if (header.vertex_format == HMESH_VERTEX_FLOAT)
+      {
+        mesh.vertex_ptr = (const MeshVertex *)vertex_data;
+      }
+      else
+      {
+        mesh.quantized_ptr = (const QuantizedVertex *)vertex_data;
+        mesh.quantization_ptr = (const HMeshVertexQuantization *)mesh.section_data(HMESH_SECTION_VERTEX_QUANTIZATION, sizeof(HMeshVertexQuantization), 1);
+        if (mesh.quantization_ptr == nullptr)
+          return std::nullopt;
+      }
+      const HMeshSection *index_section = mesh.find_section(HMESH_SECTION_INDICES);
+      if (index_section == nullptr || index_section->count != header.index_count)
+        return std::nullopt;
+      mesh.index_bytes = index_section->size;
+      mesh.index_ptr = (const uint8_t *)mesh.section_data(HMESH_SECTION_INDICES, 1, index_section->size);
+      mesh.submesh_ptr = (const HMeshSubmesh *)mesh.section_data(HMESH_SECTION_SUBMESHES, sizeof(HMeshSubmesh), header.submesh_count);
+      mesh.material_ptr = (const HMeshMaterial *)mesh.section_data(HMESH_SECTION_MATERIALS, sizeof(HMeshMaterial), header.material_count);
+      mesh.lod_total = mesh.section_count(HMESH_SECTION_LODS);
+      mesh.lod_ptr = (const HMeshLod *)mesh.section_data(HMESH_SECTION_LODS, sizeof(HMeshLod), mesh.lod_total);
+      mesh.meshlet_total = mesh.section_count(HMESH_SECTION_MESHLETS);
+      mesh.meshlet_ptr = (const HMeshMeshlet *)mesh.section_data(HMESH_SECTION_MESHLETS, sizeof(HMeshMeshlet), mesh.meshlet_total);
+      mesh.meshlet_vertex_total = mesh.section_count(HMESH_SECTION_MESHLET_VERTICES);
+      mesh.meshlet_vertex_ptr = (const uint32_t *)mesh.section_data(HMESH_SECTION_MESHLET_VERTICES, sizeof(uint32_t), mesh.meshlet_vertex_total);
+      mesh.meshlet_triangle_bytes = mesh.section_count(HMESH_SECTION_MESHLET_TRIANGLES);
+      mesh.meshlet_triangle_ptr = (const uint8_t *)mesh.section_data(HMESH_SECTION_MESHLET_TRIANGLES, 1, mesh.meshlet_triangle_bytes);
+      if (!mesh.index_ptr || !mesh.submesh_ptr || !mesh.material_ptr || !mesh.lod_ptr)
+        return std::nullopt;
+      if (!mesh.meshlet_ptr || !mesh.meshlet_vertex_ptr || !mesh.meshlet_triangle_ptr)
+        return std::nullopt;
+
+      for (uint32_t i = 0; i < header.submesh_count; i++)
+      {
+        const HMeshSubmesh &submesh = mesh.submesh_ptr[i];
+        if (submesh.index_size != 2 && submesh.index_size != 4)
+          return std::nullopt;
+        if (submesh.index_offset % submesh.index_size != 0 || submesh.index_offset + (uint64_t)submesh.index_count * submesh.index_size > mesh.index_bytes)
+          return std::nullopt;
+        if ((uint64_t)submesh.base_vertex + submesh.vertex_count > header.vertex_count)
+          return std::nullopt;
+        if ((uint64_t)submesh.lod_offset + submesh.lod_count > mesh.lod_total)
+          return std::nullopt;
+        for (uint32_t l = 0; l < submesh.lod_count; l++)
+        {
+          const HMeshLod &lod = mesh.lod_ptr[submesh.lod_offset + l];
+          if (lod.index_offset % submesh.index_size != 0 || lod.index_offset + (uint64_t)lod.index_count * submesh.index_size > mesh.index_bytes)
+            return std::nullopt;
+        }
+        if ((uint64_t)submesh.meshlet_offset + submesh.meshlet_count > mesh.meshlet_total)
+          return std::nullopt;
+        for (uint32_t m = 0; m < submesh.meshlet_count; m++)
+        {
+          const HMeshMeshlet &meshlet = mesh.meshlet_ptr[submesh.meshlet_offset + m];
+          if (meshlet.vertex_count > MESHLET_MAX_VERTICES || meshlet.triangle_count > MESHLET_MAX_TRIANGLES)
+            return std::nullopt;
+          if ((uint64_t)meshlet.vertex_offset + meshlet.vertex_count > mesh.meshlet_vertex_total)
+            return std::nullopt;
+          if ((uint64_t)meshlet.triangle_offset + meshlet.triangle_count * 3ull > mesh.meshlet_triangle_bytes)
+            return std::nullopt;
+          for (uint32_t v = 0; v < meshlet.vertex_count; v++)
+            if (mesh.meshlet_vertex_ptr[meshlet.vertex_offset + v] >= submesh.vertex_count)
+              return std::nullopt;
+        }
+      }
+      return mesh;
+    }
+
+    const HMeshHeader &header() const { return *header_ptr; }
+    uint64_t source_hash() const { return header_ptr->source_hash; }
+
+    uint32_t vertex_count() const { return header_ptr->vertex_count; }
+    uint32_t vertex_format() const { return header_ptr->vertex_format; }
+
+    // Float vertices; nullptr when the file stores a quantized format
+    const MeshVertex *vertices() const { return vertex_ptr; }
+
+    // Quantized vertices and their decode ranges; nullptr for float files
+    const QuantizedVertex *quantized_vertices() const { return quantized_ptr; }
+    const HMeshVertexQuantization *vertex_quantization() const { return quantization_ptr; }
+
+    // Full precision copy of one vertex whatever the stored format
+    MeshVertex decode_vertex(uint32_t index) const
+    {
+      if (vertex_ptr != nullptr)
+        return vertex_ptr[index];
+      VertexQuantization quantization;
+      memcpy(quantization.position_offset, quantization_ptr->position_offset, sizeof(quantization.position_offset));
+      memcpy(quantization.position_scale, quantization_ptr->position_scale, sizeof(quantization.position_scale));
+      memcpy(quantization.uv_offset, quantization_ptr->uv_offset, sizeof(quantization.uv_offset));
+      memcpy(quantization.uv_scale, quantization_ptr->uv_scale, sizeof(quantization.uv_scale));
+      return dequantize_vertex(quantized_ptr[index], quantization, position_encoding(header_ptr->vertex_format));
+    }
+
+    const uint8_t *index_data() const { return index_ptr; }
+    uint32_t index_count() const { return header_ptr->index_count; }
+
+    // Submesh-local indices, 16 or 32 bits wide depending on submesh.index_size
+    const void *submesh_indices(const HMeshSubmesh &submesh) const { return index_ptr + submesh.index_offset; }
+
+    // Absolute vertex index of the i-th index of a submesh
+    uint32_t vertex_index(const HMeshSubmesh &submesh, uint32_t i) const
+    {
+      const uint8_t *src = index_ptr + submesh.index_offset + (size_t)i * submesh.index_size;
+      if (submesh.index_size == 2)
+      {
+        uint16_t narrow;
+        memcpy(&narrow, src, 2);
+        return submesh.base_vertex + narrow;
+      }
+      uint32_t wide;
+      memcpy(&wide, src, 4);
+      return submesh.base_vertex + wide;
+    }
+
+    const HMeshSubmesh *submeshes() const { return submesh_ptr; }
+    uint32_t submesh_count() const { return header_ptr->submesh_count; }
+
+    // LOD levels of a submesh, finest first; submesh.lod_count entries
+    const HMeshLod *submesh_lods(const HMeshSubmesh &submesh) const { return lod_ptr + submesh.lod_offset; }
+
+    // Level 0 clusters of a submesh; submesh.meshlet_count entries
+    const HMeshMeshlet *submesh_meshlets(const HMeshSubmesh &submesh) const { return meshlet_ptr + submesh.meshlet_offset; }
+    const HMeshMeshlet *meshlets() const { return meshlet_ptr; }
+    uint32_t meshlet_count() const { return meshlet_total; }
+
+    // Submesh-local vertex indices referenced by meshlets
+    const uint32_t *meshlet_vertices() const { return meshlet_vertex_ptr; }
+
+    // Byte triplets indexing into a meshlet's vertex list
+    const uint8_t *meshlet_triangles() const { return meshlet_triangle_ptr; }
+
+    const HMeshMaterial *materials() const { return material_ptr; }
+    uint32_t material_count() const { return header_ptr->material_count; }
+
+    uint64_t index_size_bytes() const { return index_bytes; }
+
+    size_t size_bytes() const { return file.size(); }
+  };
+}
+
+#endif
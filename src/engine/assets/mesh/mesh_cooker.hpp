@@ -0,0 +1,183 @@
+#ifndef MESH_COOKER_H
+#define MESH_COOKER_H
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "hmesh.hpp"
+#include "mesh_data.hpp"
+#include "mesh_indexing.hpp"
+#include "mesh_lod.hpp"
+#include "mesh_optimizer.hpp"
+#include "meshlet_builder.hpp"
+#include "obj_importer.hpp"
+#include "../../core/hash/hash.hpp"
+#include "../../core/io/mapped_file.hpp"
+
+namespace hades
+{
+  // Bump whenever the cooked output for the same source would change
+  constexpr uint32_t MESH_COOKER_VERSION = 6;
+
+  struct MeshCookReport
+  {
+    MeshOptimizeReport optimize;
+    VertexQuantizationReport quantization;
+  };
+
+  // Cooks OBJ files into .hmesh once and serves later loads straight from the
+  // cache. Cached files are named after the content hash of the OBJ, the MTL
+  // files it references, the vertex format and the cooker version, so any
+  // edit re-cooks and each vertex format keeps its own file.
+  class MeshCooker
+  {
+  private:
+    std::string cache_dir;
+    HMeshVertexFormat vertex_format;
+    bool verbose = false;
+
+    static uint64_t hash_file(const std::string &path, uint64_t seed)
+    {
+      MappedFile file;
+      if (!file.open(path))
+        return seed;
+      return hash64(file.data(), file.size(), seed);
+    }
+
+  public:
+    explicit MeshCooker(std::string cache_dir, HMeshVertexFormat vertex_format = HMESH_VERTEX_QUANTIZED_UNORM16)
+        : cache_dir(std::move(cache_dir)), vertex_format(vertex_format) {}
+
+    // Print optimization and quantization stats for every mesh cooked
+    void set_verbose(bool verbose) { this->verbose = verbose; }
+
+    // Where meshes go under the cache root shared by the runtime and hades_cook
+    static std::string cache_dir_in(const std::string &cache_root)
+    {
+      return (std::filesystem::path(cache_root) / "meshes").string();
+    }
+
+    // Material libraries an OBJ references, resolved against material_dir
+    static std::vector<std::string> obj_dependencies(const MappedFile &file, const std::string &material_dir)
+    {
+      std::vector<std::string> dependencies;
+      const char *text = (const char *)file.data();
+      const char *end = text + file.size();
+      const char *line = text;
+      while (line < end)
+      {
+        const char *line_end = (const char *)memchr(line, '\n', end - line);
+        if (line_end == nullptr)
+          line_end = end;
+        if (line_end - line > 7 && strncmp(line, "mtllib", 6) == 0 && (line[6] == ' ' || line[6] == '\t'))
+        {
+          const char *name = line + 7;
+          const char *name_end = line_end;
+          while (name < name_end && (*name == ' ' || *name == '\t'))
+            name++;
+          while (name_end > name && (name_end[-1] == '\r' || name_end[-1] == ' ' || name_end[-1] == '\t'))
+            name_end--;
+          dependencies.push_back(material_dir + std::string(name, name_end));
+        }
+        line = line_end + 1;
+      }
+      return dependencies;
+    }
+
+    static std::vector<std::string> obj_dependencies(const std::string &obj_path, const std::string &material_dir)
+    {
+      MappedFile file;
+      if (!file.open(obj_path))
+        return {};
+      return obj_dependencies(file, material_dir);
+    }
+
+    static uint64_t hash_obj(const std::string &obj_path, const std::string &material_dir, HMeshVertexFormat vertex_format)
+    {
+      MappedFile file;
+      if (!file.open(obj_path))
+        return 0;
+
+      const uint32_t packed[2] = {MESH_COOKER_VERSION, vertex_format};
+      uint64_t hash = hash64(file.data(), file.size(), hash64(packed, sizeof(packed)));
+
+      // Fold in every material library the OBJ references
+      for (const std::string &dependency : obj_dependencies(file, material_dir))
+        hash = hash_file(dependency, hash);
+      return hash;
+    }
+
+    // Processing applied to every imported mesh before it is written out
+    static MeshCookReport cook(MeshData &mesh)
+    {
+      MeshCookReport report;
+      weld_mesh(mesh);
+      report.optimize = optimize_mesh(mesh);
+      generate_lods(mesh);
+      build_mesh_meshlets(mesh);
+      return report;
+    }
+
+    std::string cooked_path(uint64_t hash) const
+    {
+      char name[32];
+      snprintf(name, sizeof(name), "%016" PRIx64 ".hmesh", hash);
+      return (std::filesystem::path(cache_dir) / name).string();
+    }
+
+    std::optional<MappedMesh> load_obj(const std::string &obj_path, const std::string &material_dir)
+    {
+      const uint64_t hash = hash_obj(obj_path, material_dir, vertex_format);
+      if (hash == 0)
+      {
+        std::cerr << "ERR: cannot open " << obj_path << std::endl;
+        return std::nullopt;
+      }
+
+      const std::string path = cooked_path(hash);
+      if (auto cached = MappedMesh::open(path))
+      {
+        if (cached->source_hash() == hash && cached->vertex_format() == vertex_format)
+          return cached;
+      }
+
+      MeshData mesh;
+      if (!import_obj(obj_path, material_dir, mesh))
+        return std::nullopt;
+      MeshCookReport report = cook(mesh);
+
+      std::error_code ec;
+      std::filesystem::create_directories(cache_dir, ec);
+      if (!write_hmesh(mesh, hash, path, vertex_format, &report.quantization))
+      {
+        // The name is a content hash, so a file another writer put in place
+        // first is as good as ours
+        if (auto cached = MappedMesh::open(path))
+        {
+          if (cached->source_hash() == hash && cached->vertex_format() == vertex_format)
+            return cached;
+        }
+        std::cerr << "ERR: failed to write " << path << std::endl;
+        return std::nullopt;
+      }
+
+      if (verbose)
+        printf("[mesh cooker] %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %zu LOD levels, %zu meshlets\n", obj_path.c_str(),
+               report.optimize.before.acmr(), report.optimize.after.acmr(),
+               report.optimize.before.atvr(), report.optimize.after.atvr(), mesh.lods.size(), mesh.meshlets.size());
+      if (verbose && is_quantized_vertex_format(vertex_format))
+        printf("[mesh cooker] %s: vertices %zu -> %zu bytes, max error position %g, normal %.4f deg, uv %g\n", obj_path.c_str(),
+               report.quantization.bytes_before, report.quantization.bytes_after, report.quantization.max_position_error,
+               report.quantization.max_normal_error, report.quantization.max_uv_error);
+      return MappedMesh::open(path);
+    }
+  };
+}
+
+#endif
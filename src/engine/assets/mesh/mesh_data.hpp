@@ -0,0 +1,111 @@
+#ifndef MESH_DATA_H
+#define MESH_DATA_H
+
+#include <cfloat>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hades
+{
+  struct MeshVertex
+  {
+    float position[3];
+    float normal[3];
+    float uv[2];
+  };
+
+  struct MeshBounds
+  {
+    float min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float max[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    void expand(const float *point)
+    {
+      for (int axis = 0; axis < 3; axis++)
+      {
+        if (point[axis] < min[axis])
+          min[axis] = point[axis];
+        if (point[axis] > max[axis])
+          max[axis] = point[axis];
+      }
+    }
+
+    bool empty() const
+    {
+      return min[0] > max[0];
+    }
+  };
+
+  // A range of the index stream drawn with a single material. Indices are
+  // absolute, but always fall inside [base_vertex, base_vertex + vertex_count).
+  struct Submesh
+  {
+    uint32_t index_offset = 0;
+    uint32_t index_count = 0;
+    uint32_t base_vertex = 0;
+    uint32_t vertex_count = 0;
+    uint32_t material = 0;
+    uint32_t meshlet_offset = 0;
+    uint32_t meshlet_count = 0;
+    MeshBounds bounds;
+  };
+
+  // A simplified version of a submesh. It indexes the submesh's own vertex
+  // range; error is the object space distance it may deviate from level 0.
+  struct MeshLod
+  {
+    uint32_t submesh = 0;
+    uint32_t level = 0;
+    uint32_t index_offset = 0;
+    uint32_t index_count = 0;
+    float error = 0.0f;
+  };
+
+  constexpr uint32_t MESHLET_MAX_VERTICES = 64;
+  constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+
+  struct MeshletBounds
+  {
+    float center[3];
+    float radius;
+    float cone_apex[3];
+    float cone_cutoff; // sin of the normal cone half angle; 1 disables backface culling
+    float cone_axis[3];
+  };
+
+  // A cluster of at most MESHLET_MAX_VERTICES vertices and MESHLET_MAX_TRIANGLES
+  // triangles. Its vertices are listed in MeshData::meshlet_vertices (relative
+  // to the submesh base_vertex) and its triangles as byte triplets into that list.
+  struct Meshlet
+  {
+    uint32_t vertex_offset = 0;
+    uint32_t triangle_offset = 0; // Byte offset into MeshData::meshlet_triangles, 4-byte aligned
+    uint32_t vertex_count = 0;
+    uint32_t triangle_count = 0;
+    MeshletBounds bounds = {};
+  };
+
+  struct MeshMaterial
+  {
+    std::string name;
+    std::string diffuse_texture;
+    float diffuse[3] = {1.0f, 1.0f, 1.0f};
+  };
+
+  // Editable CPU-side mesh produced by importers and consumed by the mesh cooker
+  struct MeshData
+  {
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Submesh> submeshes;
+    std::vector<MeshLod> lods; // Sorted by submesh, then level; level 0 is the submesh itself
+    std::vector<MeshMaterial> materials;
+    std::vector<Meshlet> meshlets; // Level 0 clusters, grouped by submesh
+    std::vector<uint32_t> meshlet_vertices;
+    std::vector<uint8_t> meshlet_triangles;
+    MeshBounds bounds;
+  };
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef MESH_INDEXING_H
+#define MESH_INDEXING_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "mesh_data.hpp"
+
+namespace hades
+{
+  // Largest vertex count a submesh may have and still use 16-bit indices.
+  // 0xffff is left free so it never collides with the primitive restart value.
+  constexpr uint32_t MAX_INDEX16_VERTICES = 0xffff;
+
+  inline uint32_t index_size_for_vertex_count(uint32_t vertex_count)
+  {
+    return vertex_count <= MAX_INDEX16_VERTICES ? 2 : 4;
+  }
+
+  // Open addressing table mapping vertex contents to their first occurrence
+  class VertexWeldTable
+  {
+  private:
+    static constexpr uint32_t EMPTY = 0xffffffffu;
+    std::vector<uint32_t> slots;
+    uint32_t mask = 0;
+
+    static uint32_t hash_vertex(const MeshVertex &vertex)
+    {
+      uint32_t words[sizeof(MeshVertex) / 4];
+      memcpy(words, &vertex, sizeof(words));
+      uint32_t hash = 0x811c9dc5u;
+      for (uint32_t word : words)
+      {
+        // murmur3 style word mixing
+        word *= 0xcc9e2d51u;
+        word = (word << 15) | (word >> 17);
+        word *= 0x1b873593u;
+        hash ^= word;
+        hash = (hash << 13) | (hash >> 19);
+        hash = hash * 5 + 0xe6546b64u;
+      }
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6bu;
+      hash ^= hash >> 13;
+      return hash;
+    }
+
+  public:
+    explicit VertexWeldTable(size_t expected_count)
+    {
+      size_t capacity = 16;
+      while (capacity < expected_count * 2)
+        capacity *= 2;
+      slots.assign(capacity, EMPTY);
+      mask = (uint32_t)capacity - 1;
+    }
+
+    // Returns the index of an identical vertex already in `vertices`, or inserts `candidate`
+    uint32_t find_or_insert(const std::vector<MeshVertex> &vertices, const MeshVertex &vertex, uint32_t candidate)
+    {
+      uint32_t slot = hash_vertex(vertex) & mask;
+      for (;;)
+      {
+        const uint32_t existing = slots[slot];
+        if (existing == EMPTY)
+        {
+          slots[slot] = candidate;
+          return candidate;
+        }
+        if (memcmp(&vertices[existing], &vertex, sizeof(MeshVertex)) == 0)
+          return existing;
+        slot = (slot + 1) & mask; // linear probing
+      }
+    }
+  };
+
+  // -0.0 and 0.0 compare equal but hash differently; fold them together before welding
+  inline MeshVertex canonical_vertex(const MeshVertex &vertex)
+  {
+    MeshVertex result = vertex;
+    float *values = (float *)&result;
+    for (size_t i = 0; i < sizeof(MeshVertex) / sizeof(float); i++)
+      if (values[i] == 0.0f)
+        values[i] = 0.0f;
+    return result;
+  }
+
+  // Welds bitwise identical position/normal/uv tuples and rewrites the index
+  // stream to reference the compacted vertices. Each submesh gets its own
+  // contiguous vertex range so its indices can be stored relative to
+  // base_vertex, which is what lets small submeshes use 16-bit indices.
+  inline void weld_mesh(MeshData &mesh)
+  {
+    std::vector<MeshVertex> welded;
+    welded.reserve(mesh.vertices.size());
+
+    for (Submesh &submesh : mesh.submeshes)
+    {
+      const uint32_t base_vertex = (uint32_t)welded.size();
+      VertexWeldTable table(submesh.index_count);
+      uint32_t *indices = mesh.indices.data() + submesh.index_offset;
+      for (uint32_t i = 0; i < submesh.index_count; i++)
+      {
+        const MeshVertex vertex = canonical_vertex(mesh.vertices[indices[i]]);
+        const uint32_t candidate = (uint32_t)welded.size();
+        const uint32_t index = table.find_or_insert(welded, vertex, candidate);
+        if (index == candidate)
+          welded.push_back(vertex);
+        indices[i] = index;
+      }
+      submesh.base_vertex = base_vertex;
+      submesh.vertex_count = (uint32_t)welded.size() - base_vertex;
+    }
+
+    welded.shrink_to_fit();
+    mesh.vertices = std::move(welded);
+  }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "mesh_data.hpp"
+#include "mesh_optimizer.hpp"
+#include "mesh_simplifier.hpp"
+#include "../../core/jobs/job_system.hpp"
+
+namespace hades
+{
+  struct MeshLodSettings
+  {
+    uint32_t level_count = 4;      // Levels generated below level 0
+    float reduction = 0.5f;        // Triangle ratio of each level relative to the previous one
+    float max_relative_error = 0.05f; // Cumulative error limit as a fraction of the mesh bounds diagonal
+  };
+
+  // Builds a LOD chain for every submesh, each level simplified from the one
+  // above it. Submeshes are simplified in parallel on the job system; the
+  // results are appended to mesh.indices and mesh.lods in submesh order.
+  inline void generate_lods(MeshData &mesh, const MeshLodSettings &settings = MeshLodSettings(), JobSystem &jobs = JobSystem::get())
+  {
+    mesh.lods.clear();
+    if (settings.level_count == 0 || mesh.bounds.empty())
+      return;
+
+    double diagonal = 0.0;
+    for (int axis = 0; axis < 3; axis++)
+    {
+      const double extent = mesh.bounds.max[axis] - mesh.bounds.min[axis];
+      diagonal += extent * extent;
+    }
+    const float max_error = (float)std::sqrt(diagonal) * settings.max_relative_error;
+
+    struct SubmeshLods
+    {
+      std::vector<std::vector<uint32_t>> levels;
+      std::vector<float> errors;
+    };
+    std::vector<SubmeshLods> results(mesh.submeshes.size());
+
+    jobs.parallel_for((uint32_t)mesh.submeshes.size(), 1, [&](uint32_t begin, uint32_t end)
+                      {
+      for (uint32_t s = begin; s < end; s++)
+      {
+        const Submesh &submesh = mesh.submeshes[s];
+        std::vector<uint32_t> current(mesh.indices.begin() + submesh.index_offset, mesh.indices.begin() + submesh.index_offset + submesh.index_count);
+        for (uint32_t &index : current)
+          index -= submesh.base_vertex;
+
+        MeshSimplifier simplifier(mesh.vertices.data() + submesh.base_vertex, submesh.vertex_count);
+        float accumulated_error = 0.0f;
+        for (uint32_t level = 1; level <= settings.level_count; level++)
+        {
+          const size_t target = (size_t)(current.size() / 3 * settings.reduction) * 3;
+          if (target < 3)
+            break;
+          float level_error = 0.0f;
+          std::vector<uint32_t> simplified = simplifier.simplify(current, target, max_error - accumulated_error, level_error);
+          // Stop once a level no longer pays for its index memory
+          if (simplified.empty() || simplified.size() > current.size() * 0.9f)
+            break;
+          accumulated_error += level_error;
+          optimize_vertex_cache(simplified.data(), simplified.size(), submesh.vertex_count);
+          results[s].levels.push_back(simplified);
+          results[s].errors.push_back(accumulated_error);
+          current = std::move(simplified);
+        }
+      } });
+
+    for (uint32_t s = 0; s < mesh.submeshes.size(); s++)
+    {
+      const Submesh &submesh = mesh.submeshes[s];
+      for (size_t level = 0; level < results[s].levels.size(); level++)
+      {
+        MeshLod lod;
+        lod.submesh = s;
+        lod.level = (uint32_t)level + 1;
+        lod.index_offset = (uint32_t)mesh.indices.size();
+        lod.index_count = (uint32_t)results[s].levels[level].size();
+        lod.error = results[s].errors[level];
+        for (uint32_t index : results[s].levels[level])
+          mesh.indices.push_back(index + submesh.base_vertex);
+        mesh.lods.push_back(lod);
+      }
+    }
+  }
+}
+
+#endif
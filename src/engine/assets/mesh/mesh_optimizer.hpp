@@ -0,0 +1,368 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "mesh_data.hpp"
+
+namespace hades
+{
+  // Post-transform cache size assumed by the optimizer and by the statistics
+  constexpr uint32_t VERTEX_CACHE_SIZE = 16;
+
+  struct VertexCacheStats
+  {
+    uint32_t triangles = 0;
+    uint32_t vertices = 0;
+    uint32_t misses = 0;
+
+    // Average cache miss ratio: transformed vertices per triangle (0.5 is optimal, 3.0 is worst)
+    float acmr() const { return triangles ? (float)misses / triangles : 0.0f; }
+    // Average transform to vertex ratio: transformed vertices per unique vertex (1.0 is optimal)
+    float atvr() const { return vertices ? (float)misses / vertices : 0.0f; }
+  };
+
+  // Simulates a FIFO post-transform cache over a local index list (indices < vertex_count)
+  inline VertexCacheStats analyze_vertex_cache(const uint32_t *indices, size_t index_count, uint32_t vertex_count, uint32_t cache_size = VERTEX_CACHE_SIZE)
+  {
+    VertexCacheStats stats;
+    stats.triangles = (uint32_t)(index_count / 3);
+
+    std::vector<uint32_t> timestamps(vertex_count, 0);
+    std::vector<bool> seen(vertex_count, false);
+    uint32_t time = cache_size + 1;
+    for (size_t i = 0; i < index_count; i++)
+    {
+      const uint32_t v = indices[i];
+      if (!seen[v])
+      {
+        seen[v] = true;
+        stats.vertices++;
+      }
+      if (time - timestamps[v] > cache_size)
+      {
+        timestamps[v] = time++;
+        stats.misses++;
+      }
+    }
+    return stats;
+  }
+
+  // Triangle adjacency in compressed row form: the triangles using vertex v are
+  // triangles[offsets[v] .. offsets[v] + counts[v])
+  struct TriangleAdjacency
+  {
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+
+    TriangleAdjacency(const uint32_t *indices, size_t index_count, uint32_t vertex_count)
+        : counts(vertex_count, 0), offsets(vertex_count, 0), triangles(index_count)
+    {
+      for (size_t i = 0; i < index_count; i++)
+        counts[indices[i]]++;
+      uint32_t offset = 0;
+      for (uint32_t v = 0; v < vertex_count; v++)
+      {
+        offsets[v] = offset;
+        offset += counts[v];
+      }
+      std::vector<uint32_t> fill = offsets;
+      for (size_t i = 0; i < index_count; i++)
+        triangles[fill[indices[i]]++] = (uint32_t)(i / 3);
+    }
+  };
+
+  // Tipsify (Sander, Nehab, Barczak 2007). Reorders triangles for post-transform
+  // cache locality by fanning around vertices that are still in the cache.
+  // Returns the triangle index of every point where the walk hit a dead end;
+  // those are the hard cluster boundaries used by optimize_overdraw().
+  inline std::vector<uint32_t> optimize_vertex_cache(uint32_t *indices, size_t index_count, uint32_t vertex_count, uint32_t cache_size = VERTEX_CACHE_SIZE)
+  {
+    std::vector<uint32_t> clusters;
+    const size_t triangle_count = index_count / 3;
+    if (triangle_count == 0)
+      return clusters;
+
+    TriangleAdjacency adjacency(indices, index_count, vertex_count);
+    std::vector<uint32_t> live = adjacency.counts;
+    std::vector<uint32_t> cache_time(vertex_count, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint32_t> dead_end;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(index_count);
+
+    uint32_t time = cache_size + 1;
+    uint32_t cursor = 0;
+    int64_t fanning = indices[0];
+    clusters.push_back(0);
+
+    while (fanning >= 0)
+    {
+      candidates.clear();
+      const uint32_t f = (uint32_t)fanning;
+      for (uint32_t a = 0; a < adjacency.counts[f]; a++)
+      {
+        const uint32_t triangle = adjacency.triangles[adjacency.offsets[f] + a];
+        if (emitted[triangle])
+          continue;
+        emitted[triangle] = true;
+        for (uint32_t corner = 0; corner < 3; corner++)
+        {
+          const uint32_t v = indices[triangle * 3 + corner];
+          output.push_back(v);
+          dead_end.push_back(v);
+          candidates.push_back(v);
+          live[v]--;
+          if (time - cache_time[v] > cache_size)
+            cache_time[v] = time++;
+        }
+      }
+
+      // Prefer the candidate that stays in the cache longest after fanning around it
+      int64_t next = -1;
+      int32_t best_priority = -1;
+      for (uint32_t v : candidates)
+      {
+        if (live[v] == 0)
+          continue;
+        int32_t priority = 0;
+        if (time - cache_time[v] + 2 * live[v] <= cache_size)
+          priority = (int32_t)(time - cache_time[v]);
+        if (priority > best_priority)
+        {
+          best_priority = priority;
+          next = v;
+        }
+      }
+
+      if (next < 0)
+      {
+        // Dead end: back up through recently used vertices, then fall back to a linear scan
+        while (!dead_end.empty() && next < 0)
+        {
+          const uint32_t v = dead_end.back();
+          dead_end.pop_back();
+          if (live[v] > 0)
+            next = v;
+        }
+        while (next < 0 && cursor < vertex_count)
+        {
+          if (live[cursor] > 0)
+            next = cursor;
+          cursor++;
+        }
+        if (next >= 0)
+          clusters.push_back((uint32_t)(output.size() / 3));
+      }
+      fanning = next;
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+    return clusters;
+  }
+
+  // Splits hard clusters further wherever the running ACMR already sits within
+  // `threshold` of the cluster's own ACMR, trading a little cache efficiency for
+  // more freedom when sorting for overdraw.
+  inline std::vector<uint32_t> generate_soft_boundaries(const uint32_t *indices, size_t index_count, uint32_t vertex_count, const std::vector<uint32_t> &hard_clusters, float threshold, uint32_t cache_size = VERTEX_CACHE_SIZE)
+  {
+    std::vector<uint32_t> soft;
+    const uint32_t triangle_count = (uint32_t)(index_count / 3);
+    std::vector<uint32_t> timestamps(vertex_count, 0);
+    uint32_t time = cache_size + 1;
+
+    auto count_misses = [&](uint32_t triangle)
+    {
+      uint32_t misses = 0;
+      for (uint32_t corner = 0; corner < 3; corner++)
+      {
+        const uint32_t v = indices[triangle * 3 + corner];
+        if (time - timestamps[v] > cache_size)
+        {
+          timestamps[v] = time++;
+          misses++;
+        }
+      }
+      return misses;
+    };
+
+    for (size_t c = 0; c < hard_clusters.size(); c++)
+    {
+      const uint32_t start = hard_clusters[c];
+      const uint32_t end = c + 1 < hard_clusters.size() ? hard_clusters[c + 1] : triangle_count;
+      if (start >= end)
+        continue;
+
+      // Flushing the simulated cache between clusters models arbitrary cluster order
+      time += cache_size + 1;
+      uint32_t cluster_misses = 0;
+      for (uint32_t t = start; t < end; t++)
+        cluster_misses += count_misses(t);
+      const float target = threshold * (float)cluster_misses / (float)(end - start);
+
+      time += cache_size + 1;
+      uint32_t soft_start = start;
+      uint32_t misses = 0;
+      soft.push_back(start);
+      for (uint32_t t = start; t < end; t++)
+      {
+        misses += count_misses(t);
+        if (t + 1 < end && (float)misses / (float)(t - soft_start + 1) <= target)
+        {
+          soft.push_back(t + 1);
+          soft_start = t + 1;
+          misses = 0;
+          time += cache_size + 1;
+        }
+      }
+    }
+    return soft;
+  }
+
+  // Sorts triangle clusters so outward facing clusters on the hull are drawn
+  // first, letting them occlude the rest of the mesh (Sander et al. 2007).
+  inline void optimize_overdraw(uint32_t *indices, size_t index_count, const MeshVertex *vertices, uint32_t vertex_count, const std::vector<uint32_t> &hard_clusters, float threshold = 1.05f)
+  {
+    const uint32_t triangle_count = (uint32_t)(index_count / 3);
+    if (triangle_count == 0 || hard_clusters.empty())
+      return;
+
+    const std::vector<uint32_t> clusters = generate_soft_boundaries(indices, index_count, vertex_count, hard_clusters, threshold);
+
+    // Area weighted mesh centroid
+    double mesh_centroid[3] = {0, 0, 0};
+    double mesh_area = 0;
+    std::vector<float> cluster_sort_keys(clusters.size());
+    std::vector<double> centroids(clusters.size() * 3, 0.0);
+    std::vector<double> normals(clusters.size() * 3, 0.0);
+    std::vector<double> areas(clusters.size(), 0.0);
+
+    for (size_t c = 0; c < clusters.size(); c++)
+    {
+      const uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangle_count;
+      for (uint32_t t = clusters[c]; t < end; t++)
+      {
+        const float *p0 = vertices[indices[t * 3 + 0]].position;
+        const float *p1 = vertices[indices[t * 3 + 1]].position;
+        const float *p2 = vertices[indices[t * 3 + 2]].position;
+        const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        const double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        const double area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * 0.5;
+        for (int axis = 0; axis < 3; axis++)
+        {
+          const double centre = (p0[axis] + p1[axis] + p2[axis]) / 3.0;
+          centroids[c * 3 + axis] += centre * area;
+          normals[c * 3 + axis] += n[axis];
+          mesh_centroid[axis] += centre * area;
+        }
+        areas[c] += area;
+        mesh_area += area;
+      }
+    }
+    if (mesh_area > 0)
+      for (int axis = 0; axis < 3; axis++)
+        mesh_centroid[axis] /= mesh_area;
+
+    for (size_t c = 0; c < clusters.size(); c++)
+    {
+      double dot = 0;
+      double length = 0;
+      for (int axis = 0; axis < 3; axis++)
+      {
+        const double centre = areas[c] > 0 ? centroids[c * 3 + axis] / areas[c] : 0.0;
+        dot += (centre - mesh_centroid[axis]) * normals[c * 3 + axis];
+        length += normals[c * 3 + axis] * normals[c * 3 + axis];
+      }
+      cluster_sort_keys[c] = length > 0 ? (float)(dot / std::sqrt(length)) : 0.0f;
+    }
+
+    std::vector<uint32_t> order(clusters.size());
+    for (uint32_t c = 0; c < order.size(); c++)
+      order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                     { return cluster_sort_keys[a] > cluster_sort_keys[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(index_count);
+    for (uint32_t c : order)
+    {
+      const uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangle_count;
+      output.insert(output.end(), indices + clusters[c] * 3, indices + end * 3);
+    }
+    std::copy(output.begin(), output.end(), indices);
+  }
+
+  // Renumbers vertices in order of first use so the vertex fetch walks memory
+  // linearly. Returns the remap table (old local index -> new local index).
+  inline std::vector<uint32_t> optimize_vertex_fetch(uint32_t *indices, size_t index_count, MeshVertex *vertices, uint32_t vertex_count)
+  {
+    constexpr uint32_t UNUSED = 0xffffffffu;
+    std::vector<uint32_t> remap(vertex_count, UNUSED);
+    std::vector<MeshVertex> reordered;
+    reordered.reserve(vertex_count);
+    for (size_t i = 0; i < index_count; i++)
+    {
+      uint32_t &slot = remap[indices[i]];
+      if (slot == UNUSED)
+      {
+        slot = (uint32_t)reordered.size();
+        reordered.push_back(vertices[indices[i]]);
+      }
+      indices[i] = slot;
+    }
+    // Vertices no triangle references keep trailing slots so the range size is unchanged
+    for (uint32_t v = 0; v < vertex_count; v++)
+      if (remap[v] == UNUSED)
+      {
+        remap[v] = (uint32_t)reordered.size();
+        reordered.push_back(vertices[v]);
+      }
+    std::copy(reordered.begin(), reordered.end(), vertices);
+    return remap;
+  }
+
+  struct MeshOptimizeReport
+  {
+    VertexCacheStats before;
+    VertexCacheStats after;
+  };
+
+  // Runs cache, overdraw and fetch optimization over every submesh of a welded mesh
+  inline MeshOptimizeReport optimize_mesh(MeshData &mesh)
+  {
+    MeshOptimizeReport report;
+    std::vector<uint32_t> local;
+    for (const Submesh &submesh : mesh.submeshes)
+    {
+      local.assign(mesh.indices.begin() + submesh.index_offset, mesh.indices.begin() + submesh.index_offset + submesh.index_count);
+      for (uint32_t &index : local)
+        index -= submesh.base_vertex;
+      MeshVertex *vertices = mesh.vertices.data() + submesh.base_vertex;
+
+      const VertexCacheStats before = analyze_vertex_cache(local.data(), local.size(), submesh.vertex_count);
+      const std::vector<uint32_t> clusters = optimize_vertex_cache(local.data(), local.size(), submesh.vertex_count);
+      optimize_overdraw(local.data(), local.size(), vertices, submesh.vertex_count, clusters);
+      optimize_vertex_fetch(local.data(), local.size(), vertices, submesh.vertex_count);
+      const VertexCacheStats after = analyze_vertex_cache(local.data(), local.size(), submesh.vertex_count);
+
+      report.before.triangles += before.triangles;
+      report.before.vertices += before.vertices;
+      report.before.misses += before.misses;
+      report.after.triangles += after.triangles;
+      report.after.vertices += after.vertices;
+      report.after.misses += after.misses;
+
+      for (uint32_t i = 0; i < submesh.index_count; i++)
+        mesh.indices[submesh.index_offset + i] = local[i] + submesh.base_vertex;
+    }
+    return report;
+  }
+}
+
+#endif
@@ -0,0 +1,495 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "mesh_data.hpp"
+
+namespace hades
+{
+  // Symmetric 4x4 error quadric (Garland & Heckbert 1997), stored as its upper triangle
+  struct Quadric
+  {
+    double a[10] = {};
+    double weight = 0.0;
+
+    static Quadric from_plane(double nx, double ny, double nz, double d, double w)
+    {
+      Quadric q;
+      q.a[0] = w * nx * nx;
+      q.a[1] = w * nx * ny;
+      q.a[2] = w * nx * nz;
+      q.a[3] = w * nx * d;
+      q.a[4] = w * ny * ny;
+      q.a[5] = w * ny * nz;
+      q.a[6] = w * ny * d;
+      q.a[7] = w * nz * nz;
+      q.a[8] = w * nz * d;
+      q.a[9] = w * d * d;
+      return q;
+    }
+
+    void add(const Quadric &other, bool include_weight = true)
+    {
+      for (int i = 0; i < 10; i++)
+        a[i] += other.a[i];
+      if (include_weight)
+        weight += other.weight;
+    }
+
+    // Weighted mean squared distance of p to the accumulated planes
+    double error(const float *p) const
+    {
+      const double x = p[0], y = p[1], z = p[2];
+      const double value = a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x +
+                           a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y +
+                           a[7] * z * z + 2 * a[8] * z + a[9];
+      return weight > 0 ? std::max(value, 0.0) / weight : std::max(value, 0.0);
+    }
+  };
+
+  // How a vertex may move during simplification
+  enum SimplifyVertexKind : uint8_t
+  {
+    SIMPLIFY_MANIFOLD, // Interior vertex with a single set of attributes, free to collapse
+    SIMPLIFY_BORDER,   // On an open mesh border, may only slide along it
+    SIMPLIFY_SEAM,     // On an attribute seam (two wedges), may only slide along the seam
+    SIMPLIFY_LOCKED,   // Seam ends, corners, non-manifold geometry
+  };
+
+  // Quadric edge-collapse simplifier over one submesh. Vertices always collapse
+  // onto an existing neighbour, so vertex data is never rewritten and the result
+  // indexes the same vertex buffer as the input.
+  class MeshSimplifier
+  {
+  private:
+    const MeshVertex *vertices;
+    uint32_t vertex_count;
+
+    std::vector<uint32_t> position_id; // First vertex sharing this vertex's position
+    std::vector<uint32_t> next_wedge;  // Circular list of vertices sharing a position
+    std::vector<Quadric> quadrics;     // Indexed by position id
+
+    static uint64_t edge_key(uint32_t a, uint32_t b)
+    {
+      return ((uint64_t)a << 32) | b;
+    }
+
+    static bool has_edge(const std::vector<uint64_t> &sorted_edges, uint32_t a, uint32_t b)
+    {
+      return std::binary_search(sorted_edges.begin(), sorted_edges.end(), edge_key(a, b));
+    }
+
+    static void triangle_normal(const float *p0, const float *p1, const float *p2, double *n)
+    {
+      const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+      n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+      n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    }
+
+    void build_positions()
+    {
+      position_id.resize(vertex_count);
+      next_wedge.resize(vertex_count);
+      std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+      buckets.reserve(vertex_count);
+      for (uint32_t v = 0; v < vertex_count; v++)
+      {
+        uint32_t bits[3];
+        memcpy(bits, vertices[v].position, sizeof(bits));
+        const uint64_t key = ((uint64_t)bits[0] * 73856093u) ^ ((uint64_t)bits[1] * 19349663u << 16) ^ ((uint64_t)bits[2] * 83492791u << 32);
+        auto &bucket = buckets[key];
+        uint32_t match = v;
+        for (uint32_t other : bucket)
+          if (memcmp(vertices[other].position, vertices[v].position, sizeof(float) * 3) == 0)
+          {
+            match = other;
+            break;
+          }
+        if (match == v)
+        {
+          bucket.push_back(v);
+          position_id[v] = v;
+          next_wedge[v] = v;
+        }
+        else
+        {
+          position_id[v] = match;
+          next_wedge[v] = next_wedge[match];
+          next_wedge[match] = v;
+        }
+      }
+    }
+
+    void build_quadrics(const std::vector<uint32_t> &indices)
+    {
+      quadrics.assign(vertex_count, Quadric());
+      std::vector<uint64_t> edges;
+      std::vector<uint64_t> position_edges;
+      edges.reserve(indices.size());
+      position_edges.reserve(indices.size());
+      for (size_t i = 0; i < indices.size(); i += 3)
+        for (int e = 0; e < 3; e++)
+        {
+          edges.push_back(edge_key(indices[i + e], indices[i + (e + 1) % 3]));
+          position_edges.push_back(edge_key(position_id[indices[i + e]], position_id[indices[i + (e + 1) % 3]]));
+        }
+      std::sort(edges.begin(), edges.end());
+      std::sort(position_edges.begin(), position_edges.end());
+
+      for (size_t i = 0; i < indices.size(); i += 3)
+      {
+        const float *p[3] = {vertices[indices[i]].position, vertices[indices[i + 1]].position, vertices[indices[i + 2]].position};
+        double n[3];
+        triangle_normal(p[0], p[1], p[2], n);
+        const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length == 0)
+          continue;
+        const double area = length * 0.5;
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+        const double d = -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]);
+        const Quadric plane = Quadric::from_plane(n[0], n[1], n[2], d, area);
+        for (int c = 0; c < 3; c++)
+        {
+          Quadric &q = quadrics[position_id[indices[i + c]]];
+          q.add(plane, false);
+          q.weight += area;
+        }
+
+        // Border and seam edges get a plane perpendicular to the surface so their outline keeps its shape
+        for (int e = 0; e < 3; e++)
+        {
+          const uint32_t a = position_id[indices[i + e]];
+          const uint32_t b = position_id[indices[i + (e + 1) % 3]];
+          double edge_weight = 0.0;
+          if (!has_edge(position_edges, b, a))
+            edge_weight = 10.0;
+          else if (!has_edge(edges, indices[i + (e + 1) % 3], indices[i + e]))
+            edge_weight = 1.0;
+          if (edge_weight == 0.0)
+            continue;
+          const float *pa = p[e];
+          const float *pb = p[(e + 1) % 3];
+          const double edge[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+          double en[3] = {edge[1] * n[2] - edge[2] * n[1], edge[2] * n[0] - edge[0] * n[2], edge[0] * n[1] - edge[1] * n[0]};
+          const double en_length = std::sqrt(en[0] * en[0] + en[1] * en[1] + en[2] * en[2]);
+          if (en_length == 0)
+            continue;
+          en[0] /= en_length;
+          en[1] /= en_length;
+          en[2] /= en_length;
+          const double ed = -(en[0] * pa[0] + en[1] * pa[1] + en[2] * pa[2]);
+          const double edge_length_sq = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+          const Quadric border = Quadric::from_plane(en[0], en[1], en[2], ed, edge_length_sq * edge_weight);
+          quadrics[a].add(border, false);
+          quadrics[b].add(border, false);
+        }
+      }
+    }
+
+    void classify(const std::vector<uint32_t> &indices, std::vector<uint8_t> &kind) const
+    {
+      std::vector<uint64_t> edges;
+      std::vector<uint64_t> position_edges;
+      edges.reserve(indices.size());
+      position_edges.reserve(indices.size());
+      for (size_t i = 0; i < indices.size(); i += 3)
+        for (int e = 0; e < 3; e++)
+        {
+          const uint32_t a = indices[i + e], b = indices[i + (e + 1) % 3];
+          edges.push_back(edge_key(a, b));
+          position_edges.push_back(edge_key(position_id[a], position_id[b]));
+        }
+      std::sort(edges.begin(), edges.end());
+      std::sort(position_edges.begin(), position_edges.end());
+
+      std::vector<uint8_t> open_out(vertex_count, 0), open_in(vertex_count, 0);
+      std::vector<uint8_t> position_open_out(vertex_count, 0), position_open_in(vertex_count, 0);
+      std::vector<bool> used(vertex_count, false);
+      for (size_t i = 0; i < edges.size(); i++)
+      {
+        // Duplicate directed edges mean non-manifold geometry; treat as open so the vertex locks
+        const uint32_t a = (uint32_t)(edges[i] >> 32), b = (uint32_t)edges[i];
+        used[a] = used[b] = true;
+        const bool duplicate = i + 1 < edges.size() && edges[i + 1] == edges[i];
+        if (duplicate || !has_edge(edges, b, a))
+        {
+          open_out[a] = (uint8_t)std::min(open_out[a] + 1, 255);
+          open_in[b] = (uint8_t)std::min(open_in[b] + 1, 255);
+        }
+      }
+      for (size_t i = 0; i < position_edges.size(); i++)
+      {
+        const uint32_t a = (uint32_t)(position_edges[i] >> 32), b = (uint32_t)position_edges[i];
+        const bool duplicate = i + 1 < position_edges.size() && position_edges[i + 1] == position_edges[i];
+        if (duplicate || !has_edge(position_edges, b, a))
+        {
+          position_open_out[a] = (uint8_t)std::min(position_open_out[a] + 1, 255);
+          position_open_in[b] = (uint8_t)std::min(position_open_in[b] + 1, 255);
+        }
+      }
+
+      kind.assign(vertex_count, SIMPLIFY_LOCKED);
+      for (uint32_t v = 0; v < vertex_count; v++)
+      {
+        if (position_id[v] != v)
+          continue;
+
+        uint32_t wedges = 0;
+        uint32_t used_wedges = 0;
+        bool wedges_simple_seam = true;
+        bool wedges_closed = true;
+        uint32_t w = v;
+        do
+        {
+          wedges++;
+          if (used[w])
+            used_wedges++;
+          if (open_out[w] != 0 || open_in[w] != 0)
+            wedges_closed = false;
+          if (used[w] && (open_out[w] != 1 || open_in[w] != 1))
+            wedges_simple_seam = false;
+          w = next_wedge[w];
+        } while (w != v);
+
+        const uint8_t pos_out = position_open_out[v], pos_in = position_open_in[v];
+        uint8_t result = SIMPLIFY_LOCKED;
+        if (used_wedges == 1 && wedges == 1)
+        {
+          if (pos_out == 0 && pos_in == 0 && wedges_closed)
+            result = SIMPLIFY_MANIFOLD;
+          else if (pos_out == 1 && pos_in == 1 && open_out[v] == 1 && open_in[v] == 1)
+            result = SIMPLIFY_BORDER;
+        }
+        else if (used_wedges == 1)
+        {
+          // Unused duplicates of a position do not affect topology
+          if (pos_out == 0 && pos_in == 0 && wedges_closed)
+            result = SIMPLIFY_MANIFOLD;
+        }
+        else if (used_wedges == 2 && wedges == 2 && pos_out == 0 && pos_in == 0 && wedges_simple_seam)
+        {
+          result = SIMPLIFY_SEAM;
+        }
+
+        w = v;
+        do
+        {
+          kind[w] = result;
+          w = next_wedge[w];
+        } while (w != v);
+      }
+    }
+
+    // For seams: the wedge of target's position that the other wedge of source must follow
+    uint32_t seam_partner(uint32_t source, uint32_t target, const std::vector<uint64_t> &edges) const
+    {
+      const uint32_t other = next_wedge[source];
+      uint32_t w = target;
+      do
+      {
+        if (w != target && (has_edge(edges, other, w) || has_edge(edges, w, other)))
+          return w;
+        w = next_wedge[w];
+      } while (w != target);
+      return UINT32_MAX;
+    }
+
+  public:
+    MeshSimplifier(const MeshVertex *vertices, uint32_t vertex_count)
+        : vertices(vertices), vertex_count(vertex_count)
+    {
+      build_positions();
+    }
+
+    // Simplifies `indices` (local to this vertex range) towards target_index_count
+    // without exceeding target_error (object space distance). Returns the new
+    // index list; `result_error` receives the largest error actually introduced.
+    std::vector<uint32_t> simplify(const std::vector<uint32_t> &source, size_t target_index_count, float target_error, float &result_error)
+    {
+      std::vector<uint32_t> indices = source;
+      result_error = 0.0f;
+      build_quadrics(indices);
+
+      std::vector<uint8_t> kind;
+      std::vector<uint32_t> remap(vertex_count);
+      std::vector<bool> pass_locked(vertex_count);
+      const double max_error_sq = (double)target_error * target_error;
+
+      struct Collapse
+      {
+        uint32_t source;
+        uint32_t target;
+        double error;
+      };
+      std::vector<Collapse> collapses;
+
+      while (indices.size() > target_index_count)
+      {
+        classify(indices, kind);
+
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3)
+          for (int e = 0; e < 3; e++)
+            edges.push_back(edge_key(indices[i + e], indices[i + (e + 1) % 3]));
+        std::sort(edges.begin(), edges.end());
+
+        // Triangles around each position, for flip checks
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        for (uint32_t index : indices)
+          adjacency_offsets[position_id[index] + 1]++;
+        for (uint32_t v = 0; v < vertex_count; v++)
+          adjacency_offsets[v + 1] += adjacency_offsets[v];
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+          std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+          for (size_t i = 0; i < indices.size(); i++)
+            adjacency[fill[position_id[indices[i]]]++] = (uint32_t)(i / 3);
+        }
+
+        auto is_open = [&](uint32_t a, uint32_t b)
+        { return !has_edge(edges, b, a); };
+
+        auto can_collapse = [&](uint32_t source, uint32_t target)
+        {
+          if (position_id[source] == position_id[target])
+            return false;
+          switch (kind[source])
+          {
+          case SIMPLIFY_MANIFOLD:
+            return true;
+          case SIMPLIFY_BORDER:
+            // Slide along the border only: the edge must be open in one direction
+            return kind[target] != SIMPLIFY_MANIFOLD && kind[target] != SIMPLIFY_SEAM && (is_open(source, target) || is_open(target, source));
+          case SIMPLIFY_SEAM:
+            return (kind[target] == SIMPLIFY_SEAM || kind[target] == SIMPLIFY_LOCKED) && (is_open(source, target) || is_open(target, source));
+          default:
+            return false;
+          }
+        };
+
+        collapses.clear();
+        for (size_t i = 0; i < indices.size(); i += 3)
+          for (int e = 0; e < 3; e++)
+          {
+            const uint32_t a = indices[i + e], b = indices[i + (e + 1) % 3];
+            const uint32_t directions[2][2] = {{a, b}, {b, a}};
+            for (const auto &direction : directions)
+            {
+              const uint32_t source = direction[0], target = direction[1];
+              if (!can_collapse(source, target))
+                continue;
+              const double error = quadrics[position_id[source]].error(vertices[target].position);
+              if (error <= max_error_sq)
+                collapses.push_back(Collapse{source, target, error});
+            }
+          }
+        if (collapses.empty())
+          break;
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse &x, const Collapse &y)
+                  { return x.error < y.error; });
+
+        for (uint32_t v = 0; v < vertex_count; v++)
+          remap[v] = v;
+        std::fill(pass_locked.begin(), pass_locked.end(), false);
+
+        // Every manifold collapse removes two triangles, border and seam ones at least one
+        size_t triangles_left = indices.size() / 3;
+        const size_t target_triangles = target_index_count / 3;
+        size_t applied = 0;
+        double pass_error = 0.0;
+
+        for (const Collapse &collapse : collapses)
+        {
+          if (triangles_left <= target_triangles)
+            break;
+          const uint32_t source_position = position_id[collapse.source];
+          const uint32_t target_position = position_id[collapse.target];
+          if (pass_locked[source_position] || pass_locked[target_position])
+            continue;
+
+          uint32_t partner = UINT32_MAX;
+          if (kind[collapse.source] == SIMPLIFY_SEAM)
+          {
+            partner = seam_partner(collapse.source, collapse.target, edges);
+            if (partner == UINT32_MAX)
+              continue;
+          }
+
+          // Reject collapses that would flip a surviving triangle
+          const float *target_p = vertices[collapse.target].position;
+          bool flips = false;
+          for (uint32_t a = adjacency_offsets[source_position]; a < adjacency_offsets[source_position + 1] && !flips; a++)
+          {
+            const uint32_t triangle = adjacency[a];
+            const float *before[3];
+            const float *after[3];
+            bool collapses_away = false;
+            for (int c = 0; c < 3; c++)
+            {
+              const uint32_t corner = remap[indices[triangle * 3 + c]];
+              before[c] = vertices[corner].position;
+              after[c] = position_id[corner] == source_position ? target_p : before[c];
+              if (position_id[corner] == target_position)
+                collapses_away = true;
+            }
+            if (collapses_away)
+              continue;
+            double n0[3], n1[3];
+            triangle_normal(before[0], before[1], before[2], n0);
+            triangle_normal(after[0], after[1], after[2], n1);
+            if (n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0)
+              flips = true;
+          }
+          if (flips)
+            continue;
+
+          remap[collapse.source] = collapse.target;
+          if (partner != UINT32_MAX)
+            remap[next_wedge[collapse.source]] = partner;
+          else
+          {
+            // Unused wedges follow along so nothing references the old position
+            for (uint32_t w = next_wedge[collapse.source]; w != collapse.source; w = next_wedge[w])
+              remap[w] = collapse.target;
+          }
+          quadrics[target_position].add(quadrics[source_position]);
+          pass_locked[source_position] = pass_locked[target_position] = true;
+          triangles_left -= kind[collapse.source] == SIMPLIFY_MANIFOLD ? 2 : 1;
+          pass_error = std::max(pass_error, collapse.error);
+          applied++;
+        }
+
+        if (applied == 0)
+          break;
+        result_error = std::max(result_error, (float)std::sqrt(pass_error));
+
+        // Rewrite the index list, dropping triangles that became degenerate
+        size_t write = 0;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+          const uint32_t a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+          if (position_id[a] == position_id[b] || position_id[b] == position_id[c] || position_id[a] == position_id[c])
+            continue;
+          indices[write++] = a;
+          indices[write++] = b;
+          indices[write++] = c;
+        }
+        indices.resize(write);
+      }
+      return indices;
+    }
+  };
+}
+
+#endif
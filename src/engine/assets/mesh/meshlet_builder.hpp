@@ -0,0 +1,267 @@
+#ifndef MESHLET_BUILDER_H
+#define MESHLET_BUILDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "mesh_data.hpp"
+#include "mesh_optimizer.hpp"
+
+namespace hades
+{
+  // Ritter's bounding sphere over a point set
+  inline void compute_bounding_sphere(const float *const *points, size_t count, float *center, float &radius)
+  {
+    center[0] = center[1] = center[2] = 0.0f;
+    radius = 0.0f;
+    if (count == 0)
+      return;
+
+    // Start from the most distant pair among the axis extremes
+    size_t extremes[6] = {0, 0, 0, 0, 0, 0};
+    for (size_t i = 0; i < count; i++)
+      for (int axis = 0; axis < 3; axis++)
+      {
+        if (points[i][axis] < points[extremes[axis * 2]][axis])
+          extremes[axis * 2] = i;
+        if (points[i][axis] > points[extremes[axis * 2 + 1]][axis])
+          extremes[axis * 2 + 1] = i;
+      }
+    float best = -1.0f;
+    const float *a = points[0];
+    const float *b = points[0];
+    for (int axis = 0; axis < 3; axis++)
+    {
+      const float *p0 = points[extremes[axis * 2]];
+      const float *p1 = points[extremes[axis * 2 + 1]];
+      const float d = (p1[0] - p0[0]) * (p1[0] - p0[0]) + (p1[1] - p0[1]) * (p1[1] - p0[1]) + (p1[2] - p0[2]) * (p1[2] - p0[2]);
+      if (d > best)
+      {
+        best = d;
+        a = p0;
+        b = p1;
+      }
+    }
+    for (int axis = 0; axis < 3; axis++)
+      center[axis] = (a[axis] + b[axis]) * 0.5f;
+    radius = std::sqrt(best) * 0.5f;
+
+    // Grow the sphere to enclose every outlier
+    for (size_t i = 0; i < count; i++)
+    {
+      const float *p = points[i];
+      const float d[3] = {p[0] - center[0], p[1] - center[1], p[2] - center[2]};
+      const float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      if (distance > radius)
+      {
+        const float grown = (radius + distance) * 0.5f;
+        const float shift = (grown - radius) / distance;
+        for (int axis = 0; axis < 3; axis++)
+          center[axis] += d[axis] * shift;
+        radius = grown;
+      }
+    }
+  }
+
+  // Bounding sphere and normal cone of a triangle list over absolute vertex indices
+  inline MeshletBounds compute_cluster_bounds(const MeshVertex *vertices, const uint32_t *indices, size_t index_count)
+  {
+    MeshletBounds bounds = {};
+    std::vector<const float *> points(index_count);
+    for (size_t i = 0; i < index_count; i++)
+      points[i] = vertices[indices[i]].position;
+    compute_bounding_sphere(points.data(), points.size(), bounds.center, bounds.radius);
+
+    // Unit triangle normals; degenerate triangles do not constrain the cone
+    std::vector<float> normals;
+    std::vector<size_t> normal_triangles;
+    normals.reserve(index_count);
+    float axis[3] = {0, 0, 0};
+    for (size_t i = 0; i + 2 < index_count; i += 3)
+    {
+      const float *p0 = points[i], *p1 = points[i + 1], *p2 = points[i + 2];
+      const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+      const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      if (length == 0.0f)
+        continue;
+      for (int k = 0; k < 3; k++)
+      {
+        n[k] /= length;
+        axis[k] += n[k];
+        normals.push_back(n[k]);
+      }
+      normal_triangles.push_back(i);
+    }
+
+    const float axis_length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    float min_dot = 1.0f;
+    if (axis_length > 0.0f)
+    {
+      for (int k = 0; k < 3; k++)
+        axis[k] /= axis_length;
+      for (size_t i = 0; i < normals.size(); i += 3)
+        min_dot = std::min(min_dot, normals[i] * axis[0] + normals[i + 1] * axis[1] + normals[i + 2] * axis[2]);
+    }
+    else
+    {
+      min_dot = -1.0f;
+    }
+
+    for (int k = 0; k < 3; k++)
+      bounds.cone_axis[k] = axis[k];
+
+    // Cones wider than ~84 degrees would almost never cull; disable them
+    if (min_dot <= 0.1f)
+    {
+      bounds.cone_cutoff = 1.0f;
+      for (int k = 0; k < 3; k++)
+        bounds.cone_apex[k] = bounds.center[k];
+      return bounds;
+    }
+
+    // Apex: pull the sphere centre back along the axis until it is behind every triangle plane
+    float max_t = 0.0f;
+    for (size_t t = 0; t < normal_triangles.size(); t++)
+    {
+      const float *n = &normals[t * 3];
+      const float *p = points[normal_triangles[t]];
+      const float dc = (p[0] - bounds.center[0]) * n[0] + (p[1] - bounds.center[1]) * n[1] + (p[2] - bounds.center[2]) * n[2];
+      const float dn = axis[0] * n[0] + axis[1] * n[1] + axis[2] * n[2];
+      max_t = std::max(max_t, dc / dn);
+    }
+    for (int k = 0; k < 3; k++)
+      bounds.cone_apex[k] = bounds.center[k] - axis[k] * max_t;
+    bounds.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+    return bounds;
+  }
+
+  // Splits a local index list (relative to vertices) into meshlets appended to
+  // out.meshlets, out.meshlet_vertices and out.meshlet_triangles. Triangles
+  // are added greedily, preferring neighbours that bring in the fewest new
+  // vertices, so each meshlet stays spatially compact.
+  inline void build_meshlets(MeshData &out, const MeshVertex *vertices, uint32_t vertex_count, const uint32_t *indices, size_t index_count)
+  {
+    const uint32_t triangle_count = (uint32_t)(index_count / 3);
+    if (triangle_count == 0)
+      return;
+
+    TriangleAdjacency adjacency(indices, index_count, vertex_count);
+    std::vector<uint32_t> live = adjacency.counts;
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint8_t> slot(vertex_count, 0xff); // Position of a vertex in the current meshlet
+    uint32_t scan = 0;
+
+    Meshlet meshlet;
+    std::vector<uint32_t> meshlet_indices;
+
+    auto flush = [&]()
+    {
+      if (meshlet.triangle_count == 0)
+        return;
+      meshlet.bounds = compute_cluster_bounds(vertices, meshlet_indices.data(), meshlet_indices.size());
+      for (uint32_t i = 0; i < meshlet.vertex_count; i++)
+        slot[out.meshlet_vertices[meshlet.vertex_offset + i]] = 0xff;
+      while (out.meshlet_triangles.size() % 4 != 0)
+        out.meshlet_triangles.push_back(0);
+      out.meshlets.push_back(meshlet);
+      meshlet = Meshlet();
+      meshlet.vertex_offset = (uint32_t)out.meshlet_vertices.size();
+      meshlet.triangle_offset = (uint32_t)out.meshlet_triangles.size();
+      meshlet_indices.clear();
+    };
+
+    meshlet.vertex_offset = (uint32_t)out.meshlet_vertices.size();
+    meshlet.triangle_offset = (uint32_t)out.meshlet_triangles.size();
+
+    for (uint32_t emitted_count = 0; emitted_count < triangle_count; emitted_count++)
+    {
+      // Best unemitted triangle touching the current meshlet
+      uint32_t best = UINT32_MAX;
+      uint32_t best_new_vertices = 4;
+      uint32_t best_live = UINT32_MAX;
+      for (uint32_t i = 0; i < meshlet.vertex_count; i++)
+      {
+        const uint32_t v = out.meshlet_vertices[meshlet.vertex_offset + i];
+        for (uint32_t a = 0; a < adjacency.counts[v]; a++)
+        {
+          const uint32_t triangle = adjacency.triangles[adjacency.offsets[v] + a];
+          if (emitted[triangle])
+            continue;
+          uint32_t new_vertices = 0;
+          uint32_t triangle_live = 0;
+          for (int c = 0; c < 3; c++)
+          {
+            const uint32_t corner = indices[triangle * 3 + c];
+            new_vertices += slot[corner] == 0xff;
+            triangle_live += live[corner];
+          }
+          // Prefer fewer new vertices, then triangles whose vertices have few remaining uses
+          if (new_vertices < best_new_vertices || (new_vertices == best_new_vertices && triangle_live < best_live))
+          {
+            best = triangle;
+            best_new_vertices = new_vertices;
+            best_live = triangle_live;
+          }
+        }
+      }
+      if (best == UINT32_MAX)
+      {
+        while (emitted[scan])
+          scan++;
+        best = scan;
+        best_new_vertices = 0;
+        for (int c = 0; c < 3; c++)
+          best_new_vertices += slot[indices[best * 3 + c]] == 0xff;
+      }
+
+      if (meshlet.vertex_count + best_new_vertices > MESHLET_MAX_VERTICES || meshlet.triangle_count + 1 > MESHLET_MAX_TRIANGLES)
+      {
+        flush();
+        // A fresh meshlet has no neighbours; restart from the earliest unemitted triangle
+        while (emitted[scan])
+          scan++;
+        best = scan;
+      }
+
+      emitted[best] = true;
+      for (int c = 0; c < 3; c++)
+      {
+        const uint32_t corner = indices[best * 3 + c];
+        live[corner]--;
+        if (slot[corner] == 0xff)
+        {
+          slot[corner] = (uint8_t)meshlet.vertex_count++;
+          out.meshlet_vertices.push_back(corner);
+        }
+        out.meshlet_triangles.push_back(slot[corner]);
+        meshlet_indices.push_back(corner);
+      }
+      meshlet.triangle_count++;
+    }
+    flush();
+  }
+
+  // Builds meshlets for level 0 of every submesh
+  inline void build_mesh_meshlets(MeshData &mesh)
+  {
+    mesh.meshlets.clear();
+    mesh.meshlet_vertices.clear();
+    mesh.meshlet_triangles.clear();
+    std::vector<uint32_t> local;
+    for (Submesh &submesh : mesh.submeshes)
+    {
+      local.assign(mesh.indices.begin() + submesh.index_offset, mesh.indices.begin() + submesh.index_offset + submesh.index_count);
+      for (uint32_t &index : local)
+        index -= submesh.base_vertex;
+      submesh.meshlet_offset = (uint32_t)mesh.meshlets.size();
+      build_meshlets(mesh, mesh.vertices.data() + submesh.base_vertex, submesh.vertex_count, local.data(), local.size());
+      submesh.meshlet_count = (uint32_t)mesh.meshlets.size() - submesh.meshlet_offset;
+    }
+  }
+}
+
+#endif
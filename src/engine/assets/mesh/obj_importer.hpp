@@ -0,0 +1,472 @@
+#ifndef OBJ_IMPORTER_H
+#define OBJ_IMPORTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mesh_data.hpp"
+#include "../../core/io/mapped_file.hpp"
+#include "../../core/jobs/job_system.hpp"
+#include "../../core/text/number_parser.hpp"
+
+namespace hades
+{
+  // Bytes of OBJ text handed to one job; chunks end on a line boundary
+  constexpr size_t OBJ_IMPORT_CHUNK_SIZE = 4 << 20;
+
+  enum ObjAttribute : uint32_t
+  {
+    OBJ_POSITION = 0,
+    OBJ_TEXCOORD = 1,
+    OBJ_NORMAL = 2,
+  };
+
+  // One triangle corner as written in the file. Negative (relative) indices
+  // are resolved against the chunk's own element count, so they still need
+  // the chunk's base added once every chunk has been counted.
+  struct ObjCorner
+  {
+    int32_t index[3];
+    uint8_t present; // Bit per ObjAttribute
+    uint8_t relative;
+  };
+
+  // Consecutive faces sharing a group and material. -1 means the state was
+  // inherited from the chunks before this one.
+  struct ObjRun
+  {
+    int32_t group;
+    int32_t material; // Index into ObjChunk::materials
+    uint32_t corner_begin;
+    uint32_t corner_end;
+  };
+
+  struct ObjChunk
+  {
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    std::vector<float> positions;
+    std::vector<float> texcoords;
+    std::vector<float> normals;
+    std::vector<ObjCorner> corners; // Triangulated, three per face
+    std::vector<ObjRun> runs;
+    std::vector<std::string> materials; // usemtl names in order of appearance
+    std::vector<std::string> material_libraries;
+    uint32_t group_count = 0; // o and g statements
+    std::string error;
+
+    // Filled in by the merge
+    uint32_t bases[3] = {0, 0, 0};
+    uint32_t group_base = 0;
+    std::vector<uint32_t> run_destinations;
+  };
+
+  inline const char *obj_skip_spaces(const char *p, const char *end)
+  {
+    while (p < end && (*p == ' ' || *p == '\t'))
+      p++;
+    return p;
+  }
+
+  // True if the line at p starts with keyword followed by whitespace or the end of the line
+  inline bool obj_keyword(const char *p, const char *end, const char *keyword, size_t length)
+  {
+    if ((size_t)(end - p) < length || memcmp(p, keyword, length) != 0)
+      return false;
+    return (size_t)(end - p) == length || p[length] == ' ' || p[length] == '\t' || p[length] == '\r';
+  }
+
+  // Rest of the line without surrounding whitespace
+  inline std::string obj_line_argument(const char *p, const char *end)
+  {
+    p = obj_skip_spaces(p, end);
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+      end--;
+    return std::string(p, end);
+  }
+
+  inline bool obj_parse_floats(const char *&p, const char *end, float *out, int required, int count)
+  {
+    for (int i = 0; i < count; i++)
+    {
+      p = obj_skip_spaces(p, end);
+      if (!parse_float(p, end, out[i]))
+      {
+        if (i < required)
+          return false;
+        out[i] = 0.0f;
+      }
+    }
+    return true;
+  }
+
+  inline bool obj_parse_index(const char *&p, const char *end, ObjChunk &chunk, ObjAttribute attribute, ObjCorner &corner)
+  {
+    int64_t raw;
+    if (!parse_int(p, end, raw) || raw == 0)
+      return false;
+    static const size_t components[3] = {3, 2, 3};
+    const std::vector<float> *arrays[3] = {&chunk.positions, &chunk.texcoords, &chunk.normals};
+    if (raw > 0)
+    {
+      corner.index[attribute] = (int32_t)(raw - 1);
+    }
+    else
+    {
+      corner.index[attribute] = (int32_t)((int64_t)(arrays[attribute]->size() / components[attribute]) + raw);
+      corner.relative |= 1 << attribute;
+    }
+    corner.present |= 1 << attribute;
+    return true;
+  }
+
+  // Parses one chunk into its own buffers; no shared state is touched
+  inline void parse_obj_chunk(ObjChunk &chunk)
+  {
+    int32_t group = -1;
+    int32_t material = -1;
+    std::vector<ObjCorner> polygon;
+
+    const char *line = chunk.begin;
+    while (line < chunk.end && chunk.error.empty())
+    {
+      const char *line_end = (const char *)memchr(line, '\n', chunk.end - line);
+      if (line_end == nullptr)
+        line_end = chunk.end;
+      const char *p = obj_skip_spaces(line, line_end);
+
+      if (obj_keyword(p, line_end, "v", 1))
+      {
+        float position[3];
+        p += 1;
+        if (!obj_parse_floats(p, line_end, position, 3, 3))
+          chunk.error = "malformed vertex position";
+        chunk.positions.insert(chunk.positions.end(), position, position + 3);
+      }
+      else if (obj_keyword(p, line_end, "vt", 2))
+      {
+        float texcoord[2];
+        p += 2;
+        if (!obj_parse_floats(p, line_end, texcoord, 1, 2))
+          chunk.error = "malformed texture coordinate";
+        chunk.texcoords.insert(chunk.texcoords.end(), texcoord, texcoord + 2);
+      }
+      else if (obj_keyword(p, line_end, "vn", 2))
+      {
+        float normal[3];
+        p += 2;
+        if (!obj_parse_floats(p, line_end, normal, 3, 3))
+          chunk.error = "malformed vertex normal";
+        chunk.normals.insert(chunk.normals.end(), normal, normal + 3);
+      }
+      else if (obj_keyword(p, line_end, "f", 1))
+      {
+        polygon.clear();
+        p = obj_skip_spaces(p + 1, line_end);
+        while (p < line_end && *p != '\r' && *p != '#')
+        {
+          ObjCorner corner = {{0, 0, 0}, 0, 0};
+          bool valid = obj_parse_index(p, line_end, chunk, OBJ_POSITION, corner);
+          if (valid && p < line_end && *p == '/')
+          {
+            p++;
+            if (p < line_end && *p != '/')
+              valid = obj_parse_index(p, line_end, chunk, OBJ_TEXCOORD, corner);
+            if (valid && p < line_end && *p == '/')
+            {
+              p++;
+              valid = obj_parse_index(p, line_end, chunk, OBJ_NORMAL, corner);
+            }
+          }
+          if (!valid)
+          {
+            chunk.error = "malformed face";
+            break;
+          }
+          polygon.push_back(corner);
+          p = obj_skip_spaces(p, line_end);
+        }
+
+        if (polygon.size() >= 3)
+        {
+          if (chunk.runs.empty() || chunk.runs.back().group != group || chunk.runs.back().material != material)
+          {
+            const uint32_t begin = (uint32_t)chunk.corners.size();
+            chunk.runs.push_back(ObjRun{group, material, begin, begin});
+          }
+          // Fan triangulation, matching how convex polygons are authored
+          for (size_t i = 1; i + 1 < polygon.size(); i++)
+          {
+            chunk.corners.push_back(polygon[0]);
+            chunk.corners.push_back(polygon[i]);
+            chunk.corners.push_back(polygon[i + 1]);
+          }
+          chunk.runs.back().corner_end = (uint32_t)chunk.corners.size();
+        }
+      }
+      else if (obj_keyword(p, line_end, "o", 1) || obj_keyword(p, line_end, "g", 1))
+      {
+        group = (int32_t)chunk.group_count++;
+      }
+      else if (obj_keyword(p, line_end, "usemtl", 6))
+      {
+        material = (int32_t)chunk.materials.size();
+        chunk.materials.push_back(obj_line_argument(p + 6, line_end));
+      }
+      else if (obj_keyword(p, line_end, "mtllib", 6))
+      {
+        chunk.material_libraries.push_back(obj_line_argument(p + 6, line_end));
+      }
+
+      line = line_end + 1;
+    }
+  }
+
+  // Reads newmtl blocks from an MTL file. Returns false if it cannot be opened.
+  inline bool import_mtl(const std::string &path, std::vector<MeshMaterial> &materials, std::unordered_map<std::string, uint32_t> &material_ids)
+  {
+    MappedFile file;
+    if (!file.open(path))
+      return false;
+
+    const char *text = (const char *)file.data();
+    const char *end = text + file.size();
+    MeshMaterial *current = nullptr;
+    for (const char *line = text; line < end;)
+    {
+      const char *line_end = (const char *)memchr(line, '\n', end - line);
+      if (line_end == nullptr)
+        line_end = end;
+      const char *p = obj_skip_spaces(line, line_end);
+      if (obj_keyword(p, line_end, "newmtl", 6))
+      {
+        MeshMaterial material;
+        material.name = obj_line_argument(p + 6, line_end);
+        material_ids[material.name] = (uint32_t)materials.size();
+        materials.push_back(material);
+        current = &materials.back();
+      }
+      else if (current != nullptr && obj_keyword(p, line_end, "Kd", 2))
+      {
+        p += 2;
+        obj_parse_floats(p, line_end, current->diffuse, 3, 3);
+      }
+      else if (current != nullptr && obj_keyword(p, line_end, "map_Kd", 6))
+      {
+        // Options such as -bm precede the file name, which is always last
+        const std::string argument = obj_line_argument(p + 6, line_end);
+        const size_t space = argument.find_last_of(" \t");
+        current->diffuse_texture = space == std::string::npos ? argument : argument.substr(space + 1);
+      }
+      line = line_end + 1;
+    }
+    return true;
+  }
+
+  // Loads an OBJ into a MeshData. The file is mapped and split at line
+  // boundaries into chunks that job system workers parse independently; a
+  // merge pass then rebases indices and scatters every chunk's faces into one
+  // submesh per (group, material) pair. Faces are fan triangulated and every
+  // corner gets its own vertex; weld_mesh() collapses the duplicates afterwards.
+  inline bool import_obj(const std::string &path, const std::string &material_dir, MeshData &mesh,
+                         JobSystem &jobs = JobSystem::get(), size_t chunk_size = OBJ_IMPORT_CHUNK_SIZE)
+  {
+    MappedFile file;
+    if (!file.open(path))
+    {
+      std::cerr << "ERR: cannot open " << path << std::endl;
+      return false;
+    }
+
+    const char *text = (const char *)file.data();
+    const char *text_end = text + file.size();
+    std::vector<ObjChunk> chunks;
+    for (const char *begin = text; begin < text_end;)
+    {
+      const char *end = begin + std::min(chunk_size, (size_t)(text_end - begin));
+      const char *newline = end < text_end ? (const char *)memchr(end, '\n', text_end - end) : nullptr;
+      end = newline != nullptr ? newline + 1 : text_end;
+      chunks.emplace_back();
+      chunks.back().begin = begin;
+      chunks.back().end = end;
+      begin = end;
+    }
+
+    jobs.parallel_for((uint32_t)chunks.size(), 1, [&](uint32_t begin, uint32_t end)
+                      {
+                        for (uint32_t c = begin; c < end; c++)
+                          parse_obj_chunk(chunks[c]); });
+
+    // Prefix sums give every chunk the global offset of its first element
+    uint32_t totals[3] = {0, 0, 0};
+    uint32_t group_total = 0;
+    for (ObjChunk &chunk : chunks)
+    {
+      if (!chunk.error.empty())
+      {
+        std::cerr << "ERR: " << path << ": " << chunk.error << " near byte " << (chunk.begin - text) << std::endl;
+        return false;
+      }
+      const size_t counts[3] = {chunk.positions.size() / 3, chunk.texcoords.size() / 2, chunk.normals.size() / 3};
+      for (int a = 0; a < 3; a++)
+      {
+        chunk.bases[a] = totals[a];
+        totals[a] += (uint32_t)counts[a];
+      }
+      chunk.group_base = group_total;
+      group_total += chunk.group_count;
+    }
+
+    mesh = MeshData();
+    std::unordered_map<std::string, uint32_t> material_ids;
+    std::vector<std::string> loaded_libraries;
+    for (const ObjChunk &chunk : chunks)
+      for (const std::string &library : chunk.material_libraries)
+      {
+        if (std::find(loaded_libraries.begin(), loaded_libraries.end(), library) != loaded_libraries.end())
+          continue;
+        loaded_libraries.push_back(library);
+        if (!import_mtl(material_dir + library, mesh.materials, material_ids))
+          std::cout << "WARN: material library " << material_dir + library << " not found" << std::endl;
+      }
+    // Faces without a known material share a default material at the end of the table
+    const int32_t default_material = (int32_t)mesh.materials.size();
+
+    // Resolve inherited state and size every (group, material) submesh. Groups
+    // are numbered globally: 0 before the first o/g, then one per statement.
+    std::map<std::pair<uint32_t, int32_t>, uint32_t> submesh_sizes;
+    std::vector<std::vector<std::pair<uint32_t, int32_t>>> run_keys(chunks.size());
+    int32_t material = default_material;
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+      const ObjChunk &chunk = chunks[c];
+      for (const ObjRun &run : chunk.runs)
+      {
+        const uint32_t group = run.group < 0 ? chunk.group_base : chunk.group_base + run.group + 1;
+        if (run.material >= 0)
+        {
+          const auto found = material_ids.find(chunk.materials[run.material]);
+          material = found != material_ids.end() ? (int32_t)found->second : default_material;
+        }
+        run_keys[c].emplace_back(group, material);
+        submesh_sizes[run_keys[c].back()] += run.corner_end - run.corner_begin;
+      }
+      // The last usemtl of this chunk carries into the next one, even without faces after it
+      if (!chunk.materials.empty())
+      {
+        const auto found = material_ids.find(chunk.materials.back());
+        material = found != material_ids.end() ? (int32_t)found->second : default_material;
+      }
+    }
+
+    std::map<std::pair<uint32_t, int32_t>, uint32_t> submesh_cursor;
+    uint32_t corner_total = 0;
+    for (const auto &entry : submesh_sizes)
+    {
+      Submesh submesh;
+      submesh.index_offset = corner_total;
+      submesh.base_vertex = corner_total;
+      submesh.index_count = entry.second;
+      submesh.vertex_count = entry.second;
+      submesh.material = (uint32_t)entry.first.second;
+      mesh.submeshes.push_back(submesh);
+      submesh_cursor[entry.first] = corner_total;
+      corner_total += entry.second;
+    }
+    if (std::any_of(submesh_sizes.begin(), submesh_sizes.end(), [&](const auto &entry)
+                    { return entry.first.second == default_material; }))
+    {
+      MeshMaterial fallback;
+      fallback.name = "default";
+      mesh.materials.push_back(fallback);
+    }
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+      chunks[c].run_destinations.resize(chunks[c].runs.size());
+      for (size_t r = 0; r < chunks[c].runs.size(); r++)
+      {
+        uint32_t &cursor = submesh_cursor[run_keys[c][r]];
+        chunks[c].run_destinations[r] = cursor;
+        cursor += chunks[c].runs[r].corner_end - chunks[c].runs[r].corner_begin;
+      }
+    }
+
+    // Gather the attribute pools so any chunk can reference any element
+    std::vector<float> positions((size_t)totals[OBJ_POSITION] * 3);
+    std::vector<float> texcoords((size_t)totals[OBJ_TEXCOORD] * 2);
+    std::vector<float> normals((size_t)totals[OBJ_NORMAL] * 3);
+    mesh.vertices.resize(corner_total);
+    mesh.indices.resize(corner_total);
+    std::atomic<bool> out_of_range{false};
+    jobs.parallel_for((uint32_t)chunks.size(), 1, [&](uint32_t begin, uint32_t end)
+                      {
+                        for (uint32_t c = begin; c < end; c++)
+                        {
+                          const ObjChunk &chunk = chunks[c];
+                          std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + (size_t)chunk.bases[OBJ_POSITION] * 3);
+                          std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords.begin() + (size_t)chunk.bases[OBJ_TEXCOORD] * 2);
+                          std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + (size_t)chunk.bases[OBJ_NORMAL] * 3);
+                        } });
+    jobs.parallel_for((uint32_t)chunks.size(), 1, [&](uint32_t begin, uint32_t end)
+                      {
+                        for (uint32_t c = begin; c < end; c++)
+                        {
+                          const ObjChunk &chunk = chunks[c];
+                          for (size_t r = 0; r < chunk.runs.size(); r++)
+                          {
+                            uint32_t destination = chunk.run_destinations[r];
+                            for (uint32_t i = chunk.runs[r].corner_begin; i < chunk.runs[r].corner_end; i++, destination++)
+                            {
+                              const ObjCorner &corner = chunk.corners[i];
+                              int64_t index[3];
+                              for (int a = 0; a < 3; a++)
+                              {
+                                index[a] = corner.index[a] + ((corner.relative >> a) & 1 ? (int64_t)chunk.bases[a] : 0);
+                                if (((corner.present >> a) & 1) && (index[a] < 0 || index[a] >= totals[a]))
+                                  out_of_range = true;
+                              }
+                              MeshVertex vertex = {};
+                              if (!out_of_range)
+                              {
+                                memcpy(vertex.position, &positions[index[OBJ_POSITION] * 3], sizeof(vertex.position));
+                                if (corner.present & (1 << OBJ_TEXCOORD))
+                                  memcpy(vertex.uv, &texcoords[index[OBJ_TEXCOORD] * 2], sizeof(vertex.uv));
+                                if (corner.present & (1 << OBJ_NORMAL))
+                                  memcpy(vertex.normal, &normals[index[OBJ_NORMAL] * 3], sizeof(vertex.normal));
+                              }
+                              mesh.vertices[destination] = vertex;
+                              mesh.indices[destination] = destination;
+                            }
+                          }
+                        } });
+    if (out_of_range)
+    {
+      std::cerr << "ERR: " << path << ": face references a missing vertex" << std::endl;
+      return false;
+    }
+
+    jobs.parallel_for((uint32_t)mesh.submeshes.size(), 1, [&](uint32_t begin, uint32_t end)
+                      {
+                        for (uint32_t s = begin; s < end; s++)
+                        {
+                          Submesh &submesh = mesh.submeshes[s];
+                          for (uint32_t v = 0; v < submesh.vertex_count; v++)
+                            submesh.bounds.expand(mesh.vertices[submesh.base_vertex + v].position);
+                        } });
+    for (const Submesh &submesh : mesh.submeshes)
+    {
+      mesh.bounds.expand(submesh.bounds.min);
+      mesh.bounds.expand(submesh.bounds.max);
+    }
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef VERTEX_QUANTIZATION_H
+#define VERTEX_QUANTIZATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "mesh_data.hpp"
+
+namespace hades
+{
+  // 16 byte vertex: positions as 16-bit unorm against the mesh bounds (or half
+  // floats relative to their centre), octahedral snorm16 normals and unorm16
+  // UVs against the mesh UV range. Every component maps onto a normalized
+  // Vulkan vertex format, so the vertex stage decodes with one multiply-add.
+  struct QuantizedVertex
+  {
+    uint16_t position[4]; // w is padding
+    int16_t normal[2];
+    uint16_t uv[2];
+  };
+
+  static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex layout changed");
+
+  enum VertexPositionEncoding : uint32_t
+  {
+    VERTEX_POSITION_UNORM16 = 0,
+    VERTEX_POSITION_HALF = 1,
+  };
+
+  // decoded = offset + stored * scale, where stored is the normalized [0, 1]
+  // value for unorm16 components or the raw value for half floats
+  struct VertexQuantization
+  {
+    float position_offset[3] = {0, 0, 0};
+    float position_scale[3] = {1, 1, 1};
+    float uv_offset[2] = {0, 0};
+    float uv_scale[2] = {1, 1};
+  };
+
+  // Worst case round-trip error over every vertex of a mesh
+  struct VertexQuantizationReport
+  {
+    float max_position_error = 0.0f; // Object space distance
+    float max_normal_error = 0.0f;   // Degrees
+    float max_uv_error = 0.0f;
+    size_t bytes_before = 0;
+    size_t bytes_after = 0;
+  };
+
+  // IEEE binary16 conversion with round to nearest even
+  inline uint16_t float_to_half(float value)
+  {
+    uint32_t bits;
+    memcpy(&bits, &value, 4);
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const uint32_t magnitude = bits & 0x7fffffff;
+
+    if (magnitude >= 0x7f800000)
+      return (uint16_t)(sign | 0x7c00 | (magnitude > 0x7f800000 ? 0x200 : 0));
+    if (magnitude >= 0x477ff000) // Rounds past the largest finite half
+      return (uint16_t)(sign | 0x7c00);
+    if (magnitude < 0x38800000) // Half subnormal or zero
+    {
+      if (magnitude < 0x33000000)
+        return (uint16_t)sign;
+      const uint32_t exponent = magnitude >> 23;
+      const uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+      const uint32_t shift = 126 - exponent;
+      uint32_t half = mantissa >> shift;
+      const uint32_t remainder = mantissa & ((1u << shift) - 1);
+      const uint32_t halfway = 1u << (shift - 1);
+      if (remainder > halfway || (remainder == halfway && (half & 1)))
+        half++;
+      return (uint16_t)(sign | half);
+    }
+    uint32_t half = (magnitude - 0x38000000) >> 13;
+    const uint32_t remainder = magnitude & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+      half++;
+    return (uint16_t)(sign | half);
+  }
+
+  inline float half_to_float(uint16_t half)
+  {
+    const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1f;
+    const uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0x1f)
+      bits = sign | 0x7f800000 | (mantissa << 13);
+    else if (exponent != 0)
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    else if (mantissa == 0)
+      bits = sign;
+    else
+    {
+      // Renormalize the subnormal
+      uint32_t e = 113;
+      uint32_t m = mantissa;
+      while ((m & 0x400) == 0)
+      {
+        m <<= 1;
+        e--;
+      }
+      bits = sign | (e << 23) | ((m & 0x3ff) << 13);
+    }
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+  }
+
+  inline uint16_t quantize_unorm16(float value)
+  {
+    return (uint16_t)std::lround(std::min(std::max(value, 0.0f), 1.0f) * 65535.0f);
+  }
+
+  inline int16_t quantize_snorm16(float value)
+  {
+    return (int16_t)std::lround(std::min(std::max(value, -1.0f), 1.0f) * 32767.0f);
+  }
+
+  // Matches Vulkan's SNORM conversion, which clamps -32768 to -1
+  inline float dequantize_snorm16(int16_t value)
+  {
+    return std::max((float)value / 32767.0f, -1.0f);
+  }
+
+  // Folds a unit vector onto the octahedron and unwraps the lower half
+  inline void octahedral_encode(const float *normal, int16_t *out)
+  {
+    const float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+    if (length == 0.0f)
+    {
+      out[0] = out[1] = 0;
+      return;
+    }
+    float x = normal[0] / length;
+    float y = normal[1] / length;
+    if (normal[2] < 0.0f)
+    {
+      const float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+      const float fy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+      x = fx;
+      y = fy;
+    }
+    out[0] = quantize_snorm16(x);
+    out[1] = quantize_snorm16(y);
+  }
+
+  inline void octahedral_decode(const int16_t *encoded, float *normal)
+  {
+    float x = dequantize_snorm16(encoded[0]);
+    float y = dequantize_snorm16(encoded[1]);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    const float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    const float length = std::sqrt(x * x + y * y + z * z);
+    normal[0] = x / length;
+    normal[1] = y / length;
+    normal[2] = z / length;
+  }
+
+  // Quantization ranges covering every vertex of the mesh
+  inline VertexQuantization compute_vertex_quantization(const MeshData &mesh, VertexPositionEncoding encoding)
+  {
+    VertexQuantization quantization;
+    if (mesh.vertices.empty())
+      return quantization;
+
+    MeshBounds bounds;
+    float uv_min[2] = {FLT_MAX, FLT_MAX};
+    float uv_max[2] = {-FLT_MAX, -FLT_MAX};
+    for (const MeshVertex &vertex : mesh.vertices)
+    {
+      bounds.expand(vertex.position);
+      for (int k = 0; k < 2; k++)
+      {
+        uv_min[k] = std::min(uv_min[k], vertex.uv[k]);
+        uv_max[k] = std::max(uv_max[k], vertex.uv[k]);
+      }
+    }
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+      if (encoding == VERTEX_POSITION_HALF)
+      {
+        // Centring keeps the magnitudes, and so the half precision loss, small
+        quantization.position_offset[axis] = (bounds.min[axis] + bounds.max[axis]) * 0.5f;
+        quantization.position_scale[axis] = 1.0f;
+      }
+      else
+      {
+        quantization.position_offset[axis] = bounds.min[axis];
+        quantization.position_scale[axis] = bounds.max[axis] - bounds.min[axis];
+      }
+    }
+    for (int k = 0; k < 2; k++)
+    {
+      quantization.uv_offset[k] = uv_min[k];
+      quantization.uv_scale[k] = uv_max[k] - uv_min[k];
+    }
+    return quantization;
+  }
+
+  inline QuantizedVertex quantize_vertex(const MeshVertex &vertex, const VertexQuantization &quantization, VertexPositionEncoding encoding)
+  {
+    QuantizedVertex out = {};
+    for (int axis = 0; axis < 3; axis++)
+    {
+      const float local = vertex.position[axis] - quantization.position_offset[axis];
+      if (encoding == VERTEX_POSITION_HALF)
+        out.position[axis] = float_to_half(local);
+      else
+        out.position[axis] = quantization.position_scale[axis] > 0.0f ? quantize_unorm16(local / quantization.position_scale[axis]) : 0;
+    }
+    octahedral_encode(vertex.normal, out.normal);
+    for (int k = 0; k < 2; k++)
+      out.uv[k] = quantization.uv_scale[k] > 0.0f ? quantize_unorm16((vertex.uv[k] - quantization.uv_offset[k]) / quantization.uv_scale[k]) : 0;
+    return out;
+  }
+
+  // CPU mirror of the vertex stage decode
+  inline MeshVertex dequantize_vertex(const QuantizedVertex &vertex, const VertexQuantization &quantization, VertexPositionEncoding encoding)
+  {
+    MeshVertex out;
+    for (int axis = 0; axis < 3; axis++)
+    {
+      const float stored = encoding == VERTEX_POSITION_HALF ? half_to_float(vertex.position[axis]) : vertex.position[axis] / 65535.0f;
+      out.position[axis] = quantization.position_offset[axis] + stored * quantization.position_scale[axis];
+    }
+    octahedral_decode(vertex.normal, out.normal);
+    for (int k = 0; k < 2; k++)
+      out.uv[k] = quantization.uv_offset[k] + vertex.uv[k] / 65535.0f * quantization.uv_scale[k];
+    return out;
+  }
+
+  // Quantizes every vertex and measures the exact error by decoding the result
+  inline VertexQuantizationReport quantize_vertices(const MeshData &mesh, VertexPositionEncoding encoding, VertexQuantization &quantization, std::vector<QuantizedVertex> &out)
+  {
+    VertexQuantizationReport report;
+    quantization = compute_vertex_quantization(mesh, encoding);
+    out.resize(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); i++)
+    {
+      const MeshVertex &source = mesh.vertices[i];
+      out[i] = quantize_vertex(source, quantization, encoding);
+      const MeshVertex decoded = dequantize_vertex(out[i], quantization, encoding);
+
+      float distance = 0.0f;
+      for (int axis = 0; axis < 3; axis++)
+        distance += (decoded.position[axis] - source.position[axis]) * (decoded.position[axis] - source.position[axis]);
+      report.max_position_error = std::max(report.max_position_error, std::sqrt(distance));
+
+      // atan2 of |cross| and dot stays accurate for the tiny angles involved, unlike acos
+      const float *a = source.normal;
+      const float *b = decoded.normal;
+      if (a[0] != 0.0f || a[1] != 0.0f || a[2] != 0.0f)
+      {
+        const float cross[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+        const float sine = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+        const float cosine = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        report.max_normal_error = std::max(report.max_normal_error, std::atan2(sine, cosine) * 57.29577951f);
+      }
+
+      for (int k = 0; k < 2; k++)
+        report.max_uv_error = std::max(report.max_uv_error, std::fabs(decoded.uv[k] - source.uv[k]));
+    }
+    report.bytes_before = mesh.vertices.size() * sizeof(MeshVertex);
+    report.bytes_after = out.size() * sizeof(QuantizedVertex);
+    return report;
+  }
+}
+
+#endif
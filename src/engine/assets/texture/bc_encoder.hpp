@@ -0,0 +1,538 @@
+#ifndef BC_ENCODER_H
+#define BC_ENCODER_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// CPU block compression. Every encoder takes a 4x4 block of RGBA8 texels
+// (64 bytes, row major) and writes one compressed block. Matching decoders
+// are provided so the cooker can measure the error it introduced.
+namespace hades
+{
+  // ---- BC1 (colour, 8 bytes) ----
+
+  inline uint16_t pack_565(const float *color)
+  {
+    const int r = std::min(std::max((int)std::lround(color[0] * 31.0f / 255.0f), 0), 31);
+    const int g = std::min(std::max((int)std::lround(color[1] * 63.0f / 255.0f), 0), 63);
+    const int b = std::min(std::max((int)std::lround(color[2] * 31.0f / 255.0f), 0), 31);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+  }
+
+  inline void unpack_565(uint16_t packed, int *color)
+  {
+    const int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+  }
+
+  // Four-colour palette of a BC1 block in opaque mode
+  inline void bc1_palette(uint16_t c0, uint16_t c1, int palette[4][3])
+  {
+    unpack_565(c0, palette[0]);
+    unpack_565(c1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+  }
+
+  // Picks the nearest palette entry per texel; returns the squared error
+  inline int bc1_select_indices(const uint8_t *texels, uint16_t c0, uint16_t c1, uint32_t &indices)
+  {
+    int palette[4][3];
+    bc1_palette(c0, c1, palette);
+    indices = 0;
+    int total = 0;
+    for (int i = 0; i < 16; i++)
+    {
+      int best = 0, best_error = INT32_MAX;
+      for (int p = 0; p < 4; p++)
+      {
+        int error = 0;
+        for (int c = 0; c < 3; c++)
+          error += (texels[i * 4 + c] - palette[p][c]) * (texels[i * 4 + c] - palette[p][c]);
+        if (error < best_error)
+        {
+          best_error = error;
+          best = p;
+        }
+      }
+      indices |= (uint32_t)best << (i * 2);
+      total += best_error;
+    }
+    return total;
+  }
+
+  inline void bc1_write(uint8_t *out, uint16_t c0, uint16_t c1, uint32_t indices)
+  {
+    memcpy(out, &c0, 2);
+    memcpy(out + 2, &c1, 2);
+    memcpy(out + 4, &indices, 4);
+  }
+
+  // Endpoints along the principal axis of the block's colours, then one
+  // least squares refinement against the resulting index assignment
+  inline void encode_bc1_block(const uint8_t *texels, uint8_t *out)
+  {
+    float mean[3] = {0, 0, 0};
+    for (int i = 0; i < 16; i++)
+      for (int c = 0; c < 3; c++)
+        mean[c] += texels[i * 4 + c] / 16.0f;
+    float covariance[6] = {0, 0, 0, 0, 0, 0}; // rr rg rb gg gb bb
+    for (int i = 0; i < 16; i++)
+    {
+      const float d[3] = {texels[i * 4] - mean[0], texels[i * 4 + 1] - mean[1], texels[i * 4 + 2] - mean[2]};
+      covariance[0] += d[0] * d[0];
+      covariance[1] += d[0] * d[1];
+      covariance[2] += d[0] * d[2];
+      covariance[3] += d[1] * d[1];
+      covariance[4] += d[1] * d[2];
+      covariance[5] += d[2] * d[2];
+    }
+    float axis[3] = {1, 1, 1};
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+      const float next[3] = {covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                             covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                             covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]};
+      const float length = std::max(std::fabs(next[0]), std::max(std::fabs(next[1]), std::fabs(next[2])));
+      if (length == 0.0f)
+        break;
+      for (int c = 0; c < 3; c++)
+        axis[c] = next[c] / length;
+    }
+
+    float min_t = FLT_MAX, max_t = -FLT_MAX;
+    for (int i = 0; i < 16; i++)
+    {
+      const float t = (texels[i * 4] - mean[0]) * axis[0] + (texels[i * 4 + 1] - mean[1]) * axis[1] + (texels[i * 4 + 2] - mean[2]) * axis[2];
+      min_t = std::min(min_t, t);
+      max_t = std::max(max_t, t);
+    }
+    const float axis_length_squared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float e0[3], e1[3];
+    for (int c = 0; c < 3; c++)
+    {
+      e0[c] = mean[c] + axis[c] * max_t / std::max(axis_length_squared, 1e-8f);
+      e1[c] = mean[c] + axis[c] * min_t / std::max(axis_length_squared, 1e-8f);
+    }
+
+    uint16_t c0 = pack_565(e0), c1 = pack_565(e1);
+    if (c0 < c1)
+      std::swap(c0, c1);
+    uint32_t indices;
+    int error = bc1_select_indices(texels, c0, c1, indices);
+
+    // Least squares endpoints for the chosen indices: texel = a * e0 + b * e1
+    if (c0 != c1)
+    {
+      static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+      float aa = 0, bb = 0, ab = 0, ax[3] = {0, 0, 0}, bx[3] = {0, 0, 0};
+      for (int i = 0; i < 16; i++)
+      {
+        const float a = weights[(indices >> (i * 2)) & 3], b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < 3; c++)
+        {
+          ax[c] += a * texels[i * 4 + c];
+          bx[c] += b * texels[i * 4 + c];
+        }
+      }
+      const float determinant = aa * bb - ab * ab;
+      if (std::fabs(determinant) > 1e-6f)
+      {
+        float r0[3], r1[3];
+        for (int c = 0; c < 3; c++)
+        {
+          r0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+          r1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+        }
+        uint16_t r0_packed = pack_565(r0), r1_packed = pack_565(r1);
+        if (r0_packed < r1_packed)
+          std::swap(r0_packed, r1_packed);
+        uint32_t refined_indices;
+        const int refined_error = r0_packed != r1_packed ? bc1_select_indices(texels, r0_packed, r1_packed, refined_indices) : INT32_MAX;
+        if (refined_error < error)
+        {
+          c0 = r0_packed;
+          c1 = r1_packed;
+          indices = refined_indices;
+          error = refined_error;
+        }
+      }
+    }
+    if (c0 == c1)
+      indices = 0; // Equal endpoints select three-colour mode; index 0 is still the endpoint
+    bc1_write(out, c0, c1, indices);
+  }
+
+  // BC2/BC3 colour blocks always interpolate four colours; force_four_colour
+  // ignores the c0 <= c1 switch to three colours and black
+  inline void decode_bc1_block(const uint8_t *block, uint8_t *texels, bool force_four_colour = false)
+  {
+    uint16_t c0, c1;
+    uint32_t indices;
+    memcpy(&c0, block, 2);
+    memcpy(&c1, block + 2, 2);
+    memcpy(&indices, block + 4, 4);
+    int palette[4][3];
+    bc1_palette(c0, c1, palette);
+    const bool three_colour = c0 <= c1 && !force_four_colour;
+    if (three_colour)
+    {
+      // Three colours plus transparent black
+      for (int c = 0; c < 3; c++)
+      {
+        palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+        palette[3][c] = 0;
+      }
+    }
+    for (int i = 0; i < 16; i++)
+    {
+      const int index = (indices >> (i * 2)) & 3;
+      for (int c = 0; c < 3; c++)
+        texels[i * 4 + c] = (uint8_t)palette[index][c];
+      texels[i * 4 + 3] = three_colour && index == 3 ? 0 : 255;
+    }
+  }
+
+  // ---- BC4 (one channel, 8 bytes); BC3 alpha and BC5 use the same block ----
+
+  inline void bc4_palette(int e0, int e1, int palette[8])
+  {
+    palette[0] = e0;
+    palette[1] = e1;
+    if (e0 > e1)
+    {
+      for (int i = 1; i < 7; i++)
+        palette[i + 1] = ((7 - i) * e0 + i * e1) / 7;
+    }
+    else
+    {
+      for (int i = 1; i < 5; i++)
+        palette[i + 1] = ((5 - i) * e0 + i * e1) / 5;
+      palette[6] = 0;
+      palette[7] = 255;
+    }
+  }
+
+  // Encodes channel `channel` of the texels
+  inline void encode_bc4_block(const uint8_t *texels, int channel, uint8_t *out)
+  {
+    int low = 255, high = 0;
+    for (int i = 0; i < 16; i++)
+    {
+      low = std::min(low, (int)texels[i * 4 + channel]);
+      high = std::max(high, (int)texels[i * 4 + channel]);
+    }
+    out[0] = (uint8_t)high;
+    out[1] = (uint8_t)low;
+    uint64_t indices = 0;
+    if (high != low)
+    {
+      int palette[8];
+      bc4_palette(high, low, palette);
+      for (int i = 0; i < 16; i++)
+      {
+        const int value = texels[i * 4 + channel];
+        int best = 0;
+        for (int p = 1; p < 8; p++)
+          if (std::abs(palette[p] - value) < std::abs(palette[best] - value))
+            best = p;
+        indices |= (uint64_t)best << (i * 3);
+      }
+    }
+    for (int b = 0; b < 6; b++)
+      out[2 + b] = (uint8_t)(indices >> (b * 8));
+  }
+
+  inline void decode_bc4_block(const uint8_t *block, int channel, uint8_t *texels)
+  {
+    int palette[8];
+    bc4_palette(block[0], block[1], palette);
+    uint64_t indices = 0;
+    for (int b = 0; b < 6; b++)
+      indices |= (uint64_t)block[2 + b] << (b * 8);
+    for (int i = 0; i < 16; i++)
+      texels[i * 4 + channel] = (uint8_t)palette[(indices >> (i * 3)) & 7];
+  }
+
+  // ---- BC3 (colour + alpha, 16 bytes) and BC5 (two channels, 16 bytes) ----
+
+  inline void encode_bc3_block(const uint8_t *texels, uint8_t *out)
+  {
+    encode_bc4_block(texels, 3, out);
+    encode_bc1_block(texels, out + 8);
+  }
+
+  inline void decode_bc3_block(const uint8_t *block, uint8_t *texels)
+  {
+    decode_bc1_block(block + 8, texels, true);
+    decode_bc4_block(block, 3, texels);
+  }
+
+  inline void encode_bc5_block(const uint8_t *texels, uint8_t *out)
+  {
+    encode_bc4_block(texels, 0, out);
+    encode_bc4_block(texels, 1, out + 8);
+  }
+
+  inline void decode_bc5_block(const uint8_t *block, uint8_t *texels)
+  {
+    for (int i = 0; i < 16; i++)
+    {
+      texels[i * 4 + 2] = 0;
+      texels[i * 4 + 3] = 255;
+    }
+    decode_bc4_block(block, 0, texels);
+    decode_bc4_block(block + 8, 1, texels);
+  }
+
+  // ---- BC7 (RGBA, 16 bytes), mode 6 only ----
+  //
+  // Mode 6 is a single subset with 7-bit RGBA endpoints, a p-bit per endpoint
+  // and 4-bit indices. It handles smooth colour and alpha gradients well and
+  // is the workhorse of most BC7 encoders.
+
+  constexpr int BC7_WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  class BitWriter128
+  {
+  private:
+    uint8_t *bytes;
+    int position = 0;
+
+  public:
+    explicit BitWriter128(uint8_t *bytes) : bytes(bytes) { memset(bytes, 0, 16); }
+
+    void write(uint32_t value, int bits)
+    {
+      for (int i = 0; i < bits; i++, position++)
+        bytes[position >> 3] |= (uint8_t)(((value >> i) & 1) << (position & 7));
+    }
+  };
+
+  class BitReader128
+  {
+  private:
+    const uint8_t *bytes;
+    int position = 0;
+
+  public:
+    explicit BitReader128(const uint8_t *bytes) : bytes(bytes) {}
+
+    uint32_t read(int bits)
+    {
+      uint32_t value = 0;
+      for (int i = 0; i < bits; i++, position++)
+        value |= (uint32_t)((bytes[position >> 3] >> (position & 7)) & 1) << i;
+      return value;
+    }
+  };
+
+  // Quantizes an RGBA endpoint to 7 bits plus a shared p-bit, picking the
+  // p-bit with the smaller error
+  inline void bc7_quantize_endpoint(const float *endpoint, int *quantized, int &pbit)
+  {
+    int best_error = INT32_MAX;
+    for (int p = 0; p < 2; p++)
+    {
+      int candidate[4];
+      int error = 0;
+      for (int c = 0; c < 4; c++)
+      {
+        candidate[c] = std::min(std::max((int)std::lround((endpoint[c] - p) / 2.0f), 0), 127);
+        const int value = (candidate[c] << 1) | p;
+        error += (int)((value - endpoint[c]) * (value - endpoint[c]));
+      }
+      if (error < best_error)
+      {
+        best_error = error;
+        pbit = p;
+        memcpy(quantized, candidate, sizeof(candidate));
+      }
+    }
+  }
+
+  // Quantizes both endpoints and picks the nearest weight per texel;
+  // returns the squared error of the block
+  inline int bc7_fit_mode6(const uint8_t *texels, const float endpoints[2][4], int quantized[2][4], int pbits[2], int indices[16])
+  {
+    int palette[2][4];
+    for (int e = 0; e < 2; e++)
+    {
+      bc7_quantize_endpoint(endpoints[e], quantized[e], pbits[e]);
+      for (int c = 0; c < 4; c++)
+        palette[e][c] = (quantized[e][c] << 1) | pbits[e];
+    }
+    int total = 0;
+    for (int i = 0; i < 16; i++)
+    {
+      int best = 0, best_error = INT32_MAX;
+      for (int w = 0; w < 16; w++)
+      {
+        int error = 0;
+        for (int c = 0; c < 4; c++)
+        {
+          const int value = ((64 - BC7_WEIGHTS4[w]) * palette[0][c] + BC7_WEIGHTS4[w] * palette[1][c] + 32) >> 6;
+          error += (value - texels[i * 4 + c]) * (value - texels[i * 4 + c]);
+        }
+        if (error < best_error)
+        {
+          best_error = error;
+          best = w;
+        }
+      }
+      indices[i] = best;
+      total += best_error;
+    }
+    return total;
+  }
+
+  inline void encode_bc7_block(const uint8_t *texels, uint8_t *out)
+  {
+    float mean[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; i++)
+      for (int c = 0; c < 4; c++)
+        mean[c] += texels[i * 4 + c] / 16.0f;
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; i++)
+      for (int a = 0; a < 4; a++)
+        for (int b = 0; b < 4; b++)
+          covariance[a][b] += (texels[i * 4 + a] - mean[a]) * (texels[i * 4 + b] - mean[b]);
+    float axis[4] = {1, 1, 1, 1};
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+      float next[4] = {0, 0, 0, 0};
+      for (int a = 0; a < 4; a++)
+        for (int b = 0; b < 4; b++)
+          next[a] += covariance[a][b] * axis[b];
+      const float length = std::max(std::max(std::fabs(next[0]), std::fabs(next[1])), std::max(std::fabs(next[2]), std::fabs(next[3])));
+      if (length == 0.0f)
+        break;
+      for (int c = 0; c < 4; c++)
+        axis[c] = next[c] / length;
+    }
+    const float axis_length_squared = std::max(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3], 1e-8f);
+    float min_t = FLT_MAX, max_t = -FLT_MAX;
+    for (int i = 0; i < 16; i++)
+    {
+      float t = 0.0f;
+      for (int c = 0; c < 4; c++)
+        t += (texels[i * 4 + c] - mean[c]) * axis[c];
+      min_t = std::min(min_t, t);
+      max_t = std::max(max_t, t);
+    }
+    float endpoints[2][4];
+    for (int c = 0; c < 4; c++)
+    {
+      endpoints[0][c] = std::min(std::max(mean[c] + axis[c] * min_t / axis_length_squared, 0.0f), 255.0f);
+      endpoints[1][c] = std::min(std::max(mean[c] + axis[c] * max_t / axis_length_squared, 0.0f), 255.0f);
+    }
+
+    int quantized[2][4], pbits[2], indices[16];
+    int error = bc7_fit_mode6(texels, endpoints, quantized, pbits, indices);
+
+    // Least squares endpoints for the chosen weights, kept while they help
+    for (int iteration = 0; iteration < 2 && error > 0; iteration++)
+    {
+      float aa = 0, bb = 0, ab = 0, ax[4] = {0, 0, 0, 0}, bx[4] = {0, 0, 0, 0};
+      for (int i = 0; i < 16; i++)
+      {
+        const float b = BC7_WEIGHTS4[indices[i]] / 64.0f, a = 1.0f - b;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < 4; c++)
+        {
+          ax[c] += a * texels[i * 4 + c];
+          bx[c] += b * texels[i * 4 + c];
+        }
+      }
+      const float determinant = aa * bb - ab * ab;
+      if (std::fabs(determinant) < 1e-6f)
+        break;
+      float refined[2][4];
+      for (int c = 0; c < 4; c++)
+      {
+        refined[0][c] = std::min(std::max((ax[c] * bb - bx[c] * ab) / determinant, 0.0f), 255.0f);
+        refined[1][c] = std::min(std::max((bx[c] * aa - ax[c] * ab) / determinant, 0.0f), 255.0f);
+      }
+      int refined_quantized[2][4], refined_pbits[2], refined_indices[16];
+      const int refined_error = bc7_fit_mode6(texels, refined, refined_quantized, refined_pbits, refined_indices);
+      if (refined_error >= error)
+        break;
+      error = refined_error;
+      memcpy(quantized, refined_quantized, sizeof(quantized));
+      memcpy(pbits, refined_pbits, sizeof(pbits));
+      memcpy(indices, refined_indices, sizeof(indices));
+    }
+
+    // The anchor index drops its top bit, so it must stay below 8
+    if (indices[0] >= 8)
+    {
+      std::swap(quantized[0], quantized[1]);
+      std::swap(pbits[0], pbits[1]);
+      for (int &index : indices)
+        index = 15 - index;
+    }
+
+    BitWriter128 writer(out);
+    writer.write(1 << 6, 7); // Mode 6
+    for (int c = 0; c < 4; c++)
+    {
+      writer.write((uint32_t)quantized[0][c], 7);
+      writer.write((uint32_t)quantized[1][c], 7);
+    }
+    writer.write((uint32_t)pbits[0], 1);
+    writer.write((uint32_t)pbits[1], 1);
+    writer.write((uint32_t)indices[0], 3);
+    for (int i = 1; i < 16; i++)
+      writer.write((uint32_t)indices[i], 4);
+  }
+
+  // Decodes mode 6 blocks; other modes decode as opaque magenta
+  inline void decode_bc7_block(const uint8_t *block, uint8_t *texels)
+  {
+    BitReader128 reader(block);
+    if (reader.read(7) != (1 << 6))
+    {
+      for (int i = 0; i < 16; i++)
+      {
+        texels[i * 4] = 255;
+        texels[i * 4 + 1] = 0;
+        texels[i * 4 + 2] = 255;
+        texels[i * 4 + 3] = 255;
+      }
+      return;
+    }
+    int endpoints[2][4];
+    for (int c = 0; c < 4; c++)
+    {
+      endpoints[0][c] = (int)reader.read(7) << 1;
+      endpoints[1][c] = (int)reader.read(7) << 1;
+    }
+    const int p0 = (int)reader.read(1), p1 = (int)reader.read(1);
+    for (int c = 0; c < 4; c++)
+    {
+      endpoints[0][c] |= p0;
+      endpoints[1][c] |= p1;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+      const int weight = BC7_WEIGHTS4[reader.read(i == 0 ? 3 : 4)];
+      for (int c = 0; c < 4; c++)
+        texels[i * 4 + c] = (uint8_t)(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef HTEX_H
+#define HTEX_H
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../../core/io/atomic_file.hpp"
+#include "../../core/io/mapped_file.hpp"
+
+// Cooked texture format (.htex)
+//
+// [HTexHeader][HTexMip x mip_count][mip payloads...]
+//
+// The mip table is indexed by level (0 is the full resolution image), while
+// the payloads are laid out coarsest level first so a streamer can read a
+// usable low resolution prefix of the file. Every payload starts on an
+// HTEX_ALIGNMENT boundary and is ready for a buffer to image copy.
+namespace hades
+{
+  constexpr uint32_t HTEX_MAGIC = 0x58455448; // "HTEX"
+  constexpr uint32_t HTEX_VERSION = 1;
+  constexpr uint64_t HTEX_ALIGNMENT = 16;
+  constexpr uint32_t HTEX_MAX_MIPS = 16;
+
+  enum HTexFormat : uint32_t
+  {
+    HTEX_FORMAT_RGBA8 = 0,
+    HTEX_FORMAT_BC1 = 1, // RGB, 8 bytes per 4x4 block
+    HTEX_FORMAT_BC3 = 2, // RGBA, 16 bytes per block
+    HTEX_FORMAT_BC5 = 3, // Two channel (normal maps), 16 bytes per block
+    HTEX_FORMAT_BC7 = 4, // RGBA, 16 bytes per block
+  };
+
+  enum HTexFlags : uint32_t
+  {
+    HTEX_FLAG_SRGB = 1, // Colour channels are sRGB encoded
+  };
+
+  struct HTexHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_hash; // Content hash of the source image and cook settings
+    uint64_t file_size;
+    uint32_t format; // HTexFormat
+    uint32_t flags;  // HTexFlags
+    uint32_t width;
+    uint32_t height;
+    uint32_t mip_count;
+    uint32_t reserved;
+  };
+
+  struct HTexMip
+  {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset; // Byte offset of the payload from the start of the file
+    uint64_t size;
+  };
+
+  static_assert(std::is_trivially_copyable<HTexHeader>::value, "HTexHeader must be trivially copyable");
+  static_assert(sizeof(HTexHeader) == 48, "HTexHeader layout changed");
+  static_assert(sizeof(HTexMip) == 24, "HTexMip layout changed");
+
+  inline bool is_block_compressed(uint32_t format)
+  {
+    return format >= HTEX_FORMAT_BC1 && format <= HTEX_FORMAT_BC7;
+  }
+
+  // Bytes per 4x4 block, or per texel for uncompressed formats
+  inline uint32_t htex_block_size(uint32_t format)
+  {
+    switch (format)
+    {
+    case HTEX_FORMAT_RGBA8:
+      return 4;
+    case HTEX_FORMAT_BC1:
+      return 8;
+    case HTEX_FORMAT_BC3:
+    case HTEX_FORMAT_BC5:
+    case HTEX_FORMAT_BC7:
+      return 16;
+    default:
+      return 0;
+    }
+  }
+
+  inline uint64_t htex_mip_size(uint32_t format, uint32_t width, uint32_t height)
+  {
+    if (!is_block_compressed(format))
+      return (uint64_t)width * height * htex_block_size(format);
+    return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * htex_block_size(format);
+  }
+
+  inline uint64_t htex_align(uint64_t value)
+  {
+    return (value + HTEX_ALIGNMENT - 1) & ~(HTEX_ALIGNMENT - 1);
+  }
+
+  // One encoded mip level as produced by the texture cooker
+  struct EncodedMip
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> bytes;
+  };
+
+  inline std::vector<uint8_t> build_htex(const std::vector<EncodedMip> &mips, uint32_t format, uint32_t flags, uint64_t source_hash)
+  {
+    HTexHeader header = {};
+    header.magic = HTEX_MAGIC;
+    header.version = HTEX_VERSION;
+    header.source_hash = source_hash;
+    header.format = format;
+    header.flags = flags;
+    header.width = mips.empty() ? 0 : mips[0].width;
+    header.height = mips.empty() ? 0 : mips[0].height;
+    header.mip_count = (uint32_t)mips.size();
+
+    std::vector<HTexMip> table(mips.size());
+    uint64_t offset = htex_align(sizeof(HTexHeader) + sizeof(HTexMip) * mips.size());
+    for (size_t level = mips.size(); level-- > 0;)
+    {
+      table[level].width = mips[level].width;
+      table[level].height = mips[level].height;
+      table[level].offset = offset;
+      table[level].size = mips[level].bytes.size();
+      offset = htex_align(offset + mips[level].bytes.size());
+    }
+    header.file_size = offset;
+
+    std::vector<uint8_t> bytes(offset, 0);
+    memcpy(bytes.data(), &header, sizeof(header));
+    if (!table.empty())
+      memcpy(bytes.data() + sizeof(header), table.data(), sizeof(HTexMip) * table.size());
+    for (size_t level = 0; level < mips.size(); level++)
+      if (!mips[level].bytes.empty())
+        memcpy(bytes.data() + table[level].offset, mips[level].bytes.data(), mips[level].bytes.size());
+    return bytes;
+  }
+
+  inline bool write_htex(const std::vector<EncodedMip> &mips, uint32_t format, uint32_t flags, uint64_t source_hash, const std::string &path)
+  {
+    return write_file_atomic(path, build_htex(mips, format, flags, source_hash));
+  }
+
+  // Read-only view of a .htex file mapped into memory; mip payloads are
+  // pointers into the mapping.
+  class MappedTexture
+  {
+  private:
+    MappedFile file;
+    const HTexHeader *header_ptr = nullptr;
+    const HTexMip *mip_ptr = nullptr;
+
+  public:
+    static std::optional<MappedTexture> open(const std::string &path)
+    {
+      MappedTexture texture;
+      if (!texture.file.open(path) || texture.file.size() < sizeof(HTexHeader))
+        return std::nullopt;
+
+      texture.header_ptr = (const HTexHeader *)texture.file.data();
+      const HTexHeader &header = *texture.header_ptr;
+      if (header.magic != HTEX_MAGIC || header.version != HTEX_VERSION || header.file_size != texture.file.size())
+        return std::nullopt;
+      if (htex_block_size(header.format) == 0 || header.mip_count == 0 || header.mip_count > HTEX_MAX_MIPS)
+        return std::nullopt;
+      if (sizeof(HTexHeader) + sizeof(HTexMip) * (uint64_t)header.mip_count > texture.file.size())
+        return std::nullopt;
+
+      texture.mip_ptr = (const HTexMip *)(texture.file.data() + sizeof(HTexHeader));
+      for (uint32_t level = 0; level < header.mip_count; level++)
+      {
+        const HTexMip &mip = texture.mip_ptr[level];
+        const uint32_t expected_width = header.width >> level > 0 ? header.width >> level : 1;
+        const uint32_t expected_height = header.height >> level > 0 ? header.height >> level : 1;
+        if (mip.width != expected_width || mip.height != expected_height)
+          return std::nullopt;
+        if (mip.size != htex_mip_size(header.format, mip.width, mip.height))
+          return std::nullopt;
+        if (mip.offset % HTEX_ALIGNMENT != 0 || mip.offset > texture.file.size() || mip.size > texture.file.size() - mip.offset)
+          return std::nullopt;
+      }
+      return texture;
+    }
+
+    uint64_t source_hash() const { return header_ptr->source_hash; }
+    uint32_t format() const { return header_ptr->format; }
+    bool srgb() const { return (header_ptr->flags & HTEX_FLAG_SRGB) != 0; }
+    uint32_t width() const { return header_ptr->width; }
+    uint32_t height() const { return header_ptr->height; }
+    uint32_t mip_count() const { return header_ptr->mip_count; }
+    size_t size_bytes() const { return file.size(); }
+
+    const HTexMip &mip(uint32_t level) const { return mip_ptr[level]; }
+    const uint8_t *mip_data(uint32_t level) const { return file.data() + mip_ptr[level].offset; }
+  };
+}
+
+#endif
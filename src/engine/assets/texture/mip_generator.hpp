@@ -0,0 +1,188 @@
+#ifndef MIP_GENERATOR_H
+#define MIP_GENERATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../../core/jobs/job_system.hpp"
+
+namespace hades
+{
+  // 8-bit RGBA pixels, rows tightly packed
+  struct TextureImage
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+  };
+
+  enum MipFilter : uint32_t
+  {
+    MIP_FILTER_BOX = 0,
+    MIP_FILTER_KAISER = 1,
+  };
+
+  inline float srgb_to_linear(float value)
+  {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+  }
+
+  inline float linear_to_srgb(float value)
+  {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+  }
+
+  inline uint32_t mip_count_for(uint32_t width, uint32_t height)
+  {
+    uint32_t count = 1;
+    while (width > 1 || height > 1)
+    {
+      width = std::max(width >> 1, 1u);
+      height = std::max(height >> 1, 1u);
+      count++;
+    }
+    return count;
+  }
+
+  // Float RGBA image the filters run on; colour is linear when the source is sRGB
+  struct LinearImage
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> texels;
+  };
+
+  inline LinearImage to_linear(const TextureImage &image, bool srgb)
+  {
+    float table[256];
+    for (int i = 0; i < 256; i++)
+      table[i] = srgb ? srgb_to_linear(i / 255.0f) : i / 255.0f;
+
+    LinearImage linear;
+    linear.width = image.width;
+    linear.height = image.height;
+    linear.texels.resize(image.pixels.size());
+    for (size_t i = 0; i < image.pixels.size(); i += 4)
+    {
+      linear.texels[i] = table[image.pixels[i]];
+      linear.texels[i + 1] = table[image.pixels[i + 1]];
+      linear.texels[i + 2] = table[image.pixels[i + 2]];
+      linear.texels[i + 3] = image.pixels[i + 3] / 255.0f; // Alpha is always linear
+    }
+    return linear;
+  }
+
+  inline TextureImage to_8bit(const LinearImage &linear, bool srgb)
+  {
+    TextureImage image;
+    image.width = linear.width;
+    image.height = linear.height;
+    image.pixels.resize(linear.texels.size());
+    for (size_t i = 0; i < linear.texels.size(); i++)
+    {
+      float value = std::min(std::max(linear.texels[i], 0.0f), 1.0f);
+      if (srgb && (i & 3) != 3)
+        value = linear_to_srgb(value);
+      image.pixels[i] = (uint8_t)std::lround(value * 255.0f);
+    }
+    return image;
+  }
+
+  // Zeroth order modified Bessel function of the first kind, for the Kaiser window
+  inline float bessel_i0(float x)
+  {
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (int k = 1; k < 16; k++)
+    {
+      term *= (x * 0.5f / k) * (x * 0.5f / k);
+      sum += term;
+    }
+    return sum;
+  }
+
+  // Normalized 2:1 downsampling weights. Source texel i sits at i + 0.5 and
+  // destination texel x at 2x + 1, so the kernel is symmetric and the same
+  // for every destination texel.
+  inline std::vector<float> downsample_kernel(MipFilter filter)
+  {
+    if (filter == MIP_FILTER_BOX)
+      return {0.5f, 0.5f};
+
+    // Kaiser windowed sinc over three destination texels (six source taps per side)
+    const float alpha = 4.0f;
+    const int radius = 3;
+    std::vector<float> weights;
+    float total = 0.0f;
+    for (int tap = -radius * 2; tap < radius * 2; tap++)
+    {
+      const float distance = (tap + 0.5f) * 0.5f; // In destination texels
+      const float sinc = std::sin(3.14159265f * distance) / (3.14159265f * distance);
+      const float t = distance / radius;
+      const float window = bessel_i0(alpha * std::sqrt(std::max(0.0f, 1.0f - t * t))) / bessel_i0(alpha);
+      weights.push_back(sinc * window);
+      total += weights.back();
+    }
+    for (float &weight : weights)
+      weight /= total;
+    return weights;
+  }
+
+  // Halves one axis of a linear image with a separable kernel, clamping at the edges
+  inline LinearImage downsample_axis(const LinearImage &source, bool horizontal, const std::vector<float> &kernel, JobSystem &jobs)
+  {
+    LinearImage result;
+    result.width = horizontal ? std::max(source.width >> 1, 1u) : source.width;
+    result.height = horizontal ? source.height : std::max(source.height >> 1, 1u);
+    result.texels.assign((size_t)result.width * result.height * 4, 0.0f);
+    const uint32_t source_extent = horizontal ? source.width : source.height;
+    const uint32_t result_extent = horizontal ? result.width : result.height;
+    const int half = (int)kernel.size() / 2;
+
+    jobs.parallel_for(result.height, 16, [&](uint32_t begin, uint32_t end)
+                      {
+                        for (uint32_t y = begin; y < end; y++)
+                          for (uint32_t x = 0; x < result.width; x++)
+                          {
+                            float *out = &result.texels[((size_t)y * result.width + x) * 4];
+                            const uint32_t position = horizontal ? x : y;
+                            if (source_extent == result_extent)
+                            {
+                              // A 1 texel axis cannot shrink further
+                              const float *in = &source.texels[((size_t)y * source.width + x) * 4];
+                              std::copy(in, in + 4, out);
+                              continue;
+                            }
+                            for (size_t k = 0; k < kernel.size(); k++)
+                            {
+                              const int tap = std::min(std::max((int)position * 2 + (int)k - half + 1, 0), (int)source_extent - 1);
+                              const float *in = horizontal ? &source.texels[((size_t)y * source.width + tap) * 4]
+                                                           : &source.texels[((size_t)tap * source.width + x) * 4];
+                              for (int c = 0; c < 4; c++)
+                                out[c] += in[c] * kernel[k];
+                            }
+                          } });
+    return result;
+  }
+
+  // Full mip chain, level 0 first. Filtering happens on linear values so sRGB
+  // textures keep their brightness as they shrink; every level is derived from
+  // the float result of the previous one to avoid compounding 8-bit rounding.
+  inline std::vector<TextureImage> generate_mips(const TextureImage &image, bool srgb, MipFilter filter, JobSystem &jobs = JobSystem::get())
+  {
+    std::vector<TextureImage> mips;
+    mips.push_back(image);
+    const std::vector<float> kernel = downsample_kernel(filter);
+    LinearImage level = to_linear(image, srgb);
+    while (level.width > 1 || level.height > 1)
+    {
+      level = downsample_axis(downsample_axis(level, true, kernel, jobs), false, kernel, jobs);
+      mips.push_back(to_8bit(level, srgb));
+    }
+    return mips;
+  }
+}
+
+#endif
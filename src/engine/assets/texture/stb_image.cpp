@@ -0,0 +1,11 @@
+// The one translation unit that compiles the stb_image decoder; everything
+// else includes stb_image.h for the declarations only.
+#define STB_IMAGE_IMPLEMENTATION
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "stb_image.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
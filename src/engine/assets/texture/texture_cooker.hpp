@@ -0,0 +1,272 @@
+#ifndef TEXTURE_COOKER_H
+#define TEXTURE_COOKER_H
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bc_encoder.hpp"
+#include "htex.hpp"
+#include "mip_generator.hpp"
+#include "../../core/hash/hash.hpp"
+#include "../../core/io/mapped_file.hpp"
+#include "../../core/jobs/job_system.hpp"
+// Compiled once, in stb_image.cpp
+#include "stb_image.h"
+
+namespace hades
+{
+  // Bump whenever the cooked output for the same source would change
+  constexpr uint32_t TEXTURE_COOKER_VERSION = 1;
+
+  struct TextureCookSettings
+  {
+    HTexFormat format = HTEX_FORMAT_BC7;
+    bool srgb = true; // Colour textures; off for normal maps and other data
+    MipFilter filter = MIP_FILTER_KAISER;
+    bool generate_mips = true;
+  };
+
+  struct TextureCookReport
+  {
+    uint64_t bytes_before = 0; // Uncompressed RGBA8 size of the whole chain
+    uint64_t bytes_after = 0;
+    float rmse = 0.0f; // Over every channel of level 0, in 8-bit units
+  };
+
+  inline TextureImage decode_image(const uint8_t *bytes, size_t size)
+  {
+    TextureImage image;
+    int width, height, channels;
+    stbi_uc *pixels = stbi_load_from_memory(bytes, (int)size, &width, &height, &channels, 4);
+    if (pixels == nullptr)
+      return image;
+    image.width = (uint32_t)width;
+    image.height = (uint32_t)height;
+    image.pixels.assign(pixels, pixels + (size_t)width * height * 4);
+    stbi_image_free(pixels);
+    return image;
+  }
+
+  inline void encode_block(uint32_t format, const uint8_t *texels, uint8_t *out)
+  {
+    switch (format)
+    {
+    case HTEX_FORMAT_BC1:
+      encode_bc1_block(texels, out);
+      break;
+    case HTEX_FORMAT_BC3:
+      encode_bc3_block(texels, out);
+      break;
+    case HTEX_FORMAT_BC5:
+      encode_bc5_block(texels, out);
+      break;
+    case HTEX_FORMAT_BC7:
+      encode_bc7_block(texels, out);
+      break;
+    }
+  }
+
+  inline void decode_block(uint32_t format, const uint8_t *block, uint8_t *texels)
+  {
+    switch (format)
+    {
+    case HTEX_FORMAT_BC1:
+      decode_bc1_block(block, texels);
+      break;
+    case HTEX_FORMAT_BC3:
+      decode_bc3_block(block, texels);
+      break;
+    case HTEX_FORMAT_BC5:
+      decode_bc5_block(block, texels);
+      break;
+    case HTEX_FORMAT_BC7:
+      decode_bc7_block(block, texels);
+      break;
+    }
+  }
+
+  // Gathers the 4x4 block at (bx, by), repeating the last row and column for
+  // images whose size is not a multiple of four
+  inline void fetch_block(const TextureImage &image, uint32_t bx, uint32_t by, uint8_t *texels)
+  {
+    for (uint32_t y = 0; y < 4; y++)
+      for (uint32_t x = 0; x < 4; x++)
+      {
+        const uint32_t sx = std::min(bx * 4 + x, image.width - 1);
+        const uint32_t sy = std::min(by * 4 + y, image.height - 1);
+        memcpy(texels + (y * 4 + x) * 4, &image.pixels[((size_t)sy * image.width + sx) * 4], 4);
+      }
+  }
+
+  // Compresses one image, one job per batch of block rows
+  inline EncodedMip encode_image(const TextureImage &image, uint32_t format, JobSystem &jobs = JobSystem::get())
+  {
+    EncodedMip mip;
+    mip.width = image.width;
+    mip.height = image.height;
+    if (!is_block_compressed(format))
+    {
+      mip.bytes = image.pixels;
+      return mip;
+    }
+    const uint32_t blocks_x = (image.width + 3) / 4, blocks_y = (image.height + 3) / 4;
+    const uint32_t block_size = htex_block_size(format);
+    mip.bytes.resize((size_t)blocks_x * blocks_y * block_size);
+    jobs.parallel_for(blocks_y, 4, [&](uint32_t begin, uint32_t end)
+                      {
+                        uint8_t texels[64];
+                        for (uint32_t by = begin; by < end; by++)
+                          for (uint32_t bx = 0; bx < blocks_x; bx++)
+                          {
+                            fetch_block(image, bx, by, texels);
+                            encode_block(format, texels, &mip.bytes[((size_t)by * blocks_x + bx) * block_size]);
+                          } });
+    return mip;
+  }
+
+  // Root mean square error of an encoded image against its source, over the
+  // channels the format stores
+  inline float encoded_rmse(const TextureImage &image, const EncodedMip &mip, uint32_t format)
+  {
+    if (!is_block_compressed(format) || image.pixels.empty())
+      return 0.0f;
+    const uint32_t blocks_x = (image.width + 3) / 4;
+    const uint32_t channels = format == HTEX_FORMAT_BC5 ? 2 : format == HTEX_FORMAT_BC1 ? 3 : 4;
+    double total = 0.0;
+    uint8_t decoded[64];
+    for (uint32_t y = 0; y < image.height; y++)
+      for (uint32_t x = 0; x < image.width; x++)
+      {
+        if ((x & 3) == 0)
+          decode_block(format, &mip.bytes[((size_t)(y / 4) * blocks_x + x / 4) * htex_block_size(format)], decoded);
+        const uint8_t *source = &image.pixels[((size_t)y * image.width + x) * 4];
+        const uint8_t *texel = decoded + ((y & 3) * 4 + (x & 3)) * 4;
+        for (uint32_t c = 0; c < channels; c++)
+          total += (double)(source[c] - texel[c]) * (source[c] - texel[c]);
+      }
+    return (float)std::sqrt(total / ((double)image.width * image.height * channels));
+  }
+
+  // Cooks PNG/JPEG/TGA images into .htex once and serves later loads straight
+  // from the cache. Cached files are named after the content hash of the image,
+  // the cook settings and the cooker version.
+  class TextureCooker
+  {
+  private:
+    std::string cache_dir;
+    bool verbose = false;
+
+  public:
+    explicit TextureCooker(std::string cache_dir) : cache_dir(std::move(cache_dir)) {}
+
+    // Print size and error stats for every texture cooked
+    void set_verbose(bool verbose) { this->verbose = verbose; }
+
+    // Where textures go under the cache root shared by the runtime and hades_cook
+    static std::string cache_dir_in(const std::string &cache_root)
+    {
+      return (std::filesystem::path(cache_root) / "textures").string();
+    }
+
+    static uint64_t hash_texture(const uint8_t *bytes, size_t size, const TextureCookSettings &settings)
+    {
+      const uint32_t packed[5] = {TEXTURE_COOKER_VERSION, settings.format, settings.srgb ? 1u : 0u, settings.filter, settings.generate_mips ? 1u : 0u};
+      return hash64(bytes, size, hash64(packed, sizeof(packed)));
+    }
+
+    std::string cooked_path(uint64_t hash) const
+    {
+      char name[32];
+      snprintf(name, sizeof(name), "%016" PRIx64 ".htex", hash);
+      return (std::filesystem::path(cache_dir) / name).string();
+    }
+
+    // Decodes, filters and compresses one image; the stages fan out over the job system
+    static bool cook(const TextureImage &image, const TextureCookSettings &settings, std::vector<EncodedMip> &mips, TextureCookReport &report, JobSystem &jobs = JobSystem::get())
+    {
+      if (image.pixels.empty())
+        return false;
+      std::vector<TextureImage> levels;
+      if (settings.generate_mips)
+        levels = generate_mips(image, settings.srgb, settings.filter, jobs);
+      else
+        levels.push_back(image);
+
+      mips.clear();
+      report = TextureCookReport();
+      for (const TextureImage &level : levels)
+      {
+        mips.push_back(encode_image(level, settings.format, jobs));
+        report.bytes_before += level.pixels.size();
+        report.bytes_after += mips.back().bytes.size();
+      }
+      report.rmse = encoded_rmse(levels[0], mips[0], settings.format);
+      return true;
+    }
+
+    std::optional<MappedTexture> load(const std::string &image_path, const TextureCookSettings &settings = TextureCookSettings(), JobSystem &jobs = JobSystem::get())
+    {
+      MappedFile source;
+      if (!source.open(image_path))
+      {
+        std::cerr << "ERR: cannot open " << image_path << std::endl;
+        return std::nullopt;
+      }
+      const uint64_t hash = hash_texture(source.data(), source.size(), settings);
+      const std::string path = cooked_path(hash);
+      if (auto cached = MappedTexture::open(path))
+      {
+        if (cached->source_hash() == hash)
+          return cached;
+      }
+
+      const TextureImage image = decode_image(source.data(), source.size());
+      std::vector<EncodedMip> mips;
+      TextureCookReport report;
+      if (!cook(image, settings, mips, report, jobs))
+      {
+        std::cerr << "ERR: cannot decode " << image_path << std::endl;
+        return std::nullopt;
+      }
+
+      std::error_code ec;
+      std::filesystem::create_directories(cache_dir, ec);
+      if (!write_htex(mips, settings.format, settings.srgb ? (uint32_t)HTEX_FLAG_SRGB : 0u, hash, path))
+      {
+        // The name is a content hash, so a file another writer put in place
+        // first is as good as ours
+        if (auto cached = MappedTexture::open(path))
+        {
+          if (cached->source_hash() == hash)
+            return cached;
+        }
+        std::cerr << "ERR: failed to write " << path << std::endl;
+        return std::nullopt;
+      }
+      if (verbose)
+        printf("[texture cooker] %s: %ux%u, %zu mips, %" PRIu64 " -> %" PRIu64 " bytes, RMSE %.2f\n", image_path.c_str(),
+               image.width, image.height, mips.size(), report.bytes_before, report.bytes_after, report.rmse);
+      return MappedTexture::open(path);
+    }
+
+    // Loads several textures at once, one job per texture; each job also
+    // spreads its filtering and compression over the remaining workers
+    std::vector<std::optional<MappedTexture>> load_batch(const std::vector<std::string> &image_paths, const TextureCookSettings &settings = TextureCookSettings(), JobSystem &jobs = JobSystem::get())
+    {
+      std::vector<std::optional<MappedTexture>> textures(image_paths.size());
+      jobs.parallel_for((uint32_t)image_paths.size(), 1, [&](uint32_t begin, uint32_t end)
+                        {
+                          for (uint32_t i = begin; i < end; i++)
+                            textures[i] = load(image_paths[i], settings, jobs); });
+      return textures;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef MESH_COMPONENT_H
+#define MESH_COMPONENT_H
+
+#include <cstdint>
+
+namespace hades
+{
+  // Mesh drawn at an entity, as an index into the meshes of the scene it was imported from
+  struct MeshComponent
+  {
+    uint32_t mesh;
+  };
+}
+
+#endif
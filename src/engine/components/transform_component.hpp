@@ -0,0 +1,15 @@
+#ifndef TRANSFORM_COMPONENT_H
+#define TRANSFORM_COMPONENT_H
+
+namespace hades
+{
+  // Local transform relative to the parent in TransformHierarchyComponent
+  struct TransformComponent
+  {
+    float translation[3] = {0.0f, 0.0f, 0.0f};
+    float rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f}; // Quaternion x, y, z, w
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+  };
+}
+
+#endif
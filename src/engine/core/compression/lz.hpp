@@ -0,0 +1,201 @@
+#ifndef LZ_H
+#define LZ_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Byte-oriented LZ77 block codec using the LZ4 block layout:
+//
+// sequence = [token][literal length bytes][literals][offset u16][match length bytes]
+//
+// The token holds the literal length in its high nibble and the match length
+// minus LZ_MIN_MATCH in its low nibble; a nibble of 15 continues in extra
+// bytes that are summed until one is below 255. The final sequence carries
+// literals only. There is no entropy stage, so decoding is a tight loop of
+// copies. Blocks are independent and their decoded size is stored by the
+// container.
+namespace hades
+{
+  constexpr size_t LZ_MIN_MATCH = 4;
+  constexpr size_t LZ_LAST_LITERALS = 5; // The block always ends in at least this many literals
+  constexpr size_t LZ_MATCH_FIND_LIMIT = 12; // No match may start this close to the end
+  constexpr size_t LZ_MAX_OFFSET = 65535;
+  constexpr uint32_t LZ_HASH_BITS = 14;
+
+  inline size_t lz_compress_bound(size_t size)
+  {
+    return size + size / 255 + 16;
+  }
+
+  inline uint32_t lz_read32(const uint8_t *p)
+  {
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+  }
+
+  inline uint32_t lz_hash(uint32_t sequence)
+  {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+  }
+
+  // Writes a length continuation (the part above 15) and returns false when it does not fit
+  inline bool lz_write_length(uint8_t *dst, size_t capacity, size_t &op, size_t length)
+  {
+    for (; length >= 255; length -= 255)
+    {
+      if (op >= capacity)
+        return false;
+      dst[op++] = 255;
+    }
+    if (op >= capacity)
+      return false;
+    dst[op++] = (uint8_t)length;
+    return true;
+  }
+
+  inline bool lz_write_sequence(uint8_t *dst, size_t capacity, size_t &op, const uint8_t *literals, size_t literal_length, size_t offset, size_t match_length)
+  {
+    if (op >= capacity)
+      return false;
+    uint8_t &token = dst[op++];
+    token = (uint8_t)((literal_length >= 15 ? 15 : literal_length) << 4);
+    if (literal_length >= 15 && !lz_write_length(dst, capacity, op, literal_length - 15))
+      return false;
+    if (literal_length > capacity - op)
+      return false;
+    memcpy(dst + op, literals, literal_length);
+    op += literal_length;
+    if (match_length == 0)
+      return true; // Final literal-only sequence
+
+    if (capacity - op < 2)
+      return false;
+    dst[op++] = (uint8_t)offset;
+    dst[op++] = (uint8_t)(offset >> 8);
+    const size_t code = match_length - LZ_MIN_MATCH;
+    token |= (uint8_t)(code >= 15 ? 15 : code);
+    return code < 15 || lz_write_length(dst, capacity, op, code - 15);
+  }
+
+  // Greedy single-probe compressor. Returns the compressed size, or 0 when
+  // the output does not fit in capacity.
+  inline size_t lz_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity)
+  {
+    size_t op = 0;
+    size_t anchor = 0;
+    if (size > LZ_MATCH_FIND_LIMIT)
+    {
+      std::vector<uint32_t> table((size_t)1 << LZ_HASH_BITS, UINT32_MAX);
+      const size_t match_limit = size - LZ_LAST_LITERALS;
+      const size_t search_limit = size - LZ_MATCH_FIND_LIMIT;
+      size_t ip = 0;
+      while (ip <= search_limit)
+      {
+        const uint32_t sequence = lz_read32(src + ip);
+        const uint32_t hash = lz_hash(sequence);
+        size_t ref = table[hash];
+        table[hash] = (uint32_t)ip;
+        if (ref == UINT32_MAX || ip - ref > LZ_MAX_OFFSET || lz_read32(src + ref) != sequence)
+        {
+          // Skip faster through data that does not compress
+          ip += 1 + ((ip - anchor) >> 6);
+          continue;
+        }
+
+        while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1])
+        {
+          ip--;
+          ref--;
+        }
+        size_t length = LZ_MIN_MATCH;
+        while (ip + length < match_limit && src[ip + length] == src[ref + length])
+          length++;
+        if (!lz_write_sequence(dst, capacity, op, src + anchor, ip - anchor, ip - ref, length))
+          return 0;
+        ip += length;
+        anchor = ip;
+        if (ip - 2 <= search_limit)
+          table[lz_hash(lz_read32(src + ip - 2))] = (uint32_t)(ip - 2);
+      }
+    }
+    if (!lz_write_sequence(dst, capacity, op, src + anchor, size - anchor, 0, 0))
+      return 0;
+    return op;
+  }
+
+  inline bool lz_read_length(const uint8_t *src, size_t size, size_t &ip, size_t &length)
+  {
+    uint8_t byte;
+    do
+    {
+      if (ip >= size)
+        return false;
+      byte = src[ip++];
+      length += byte;
+    } while (byte == 255);
+    return true;
+  }
+
+  // Decodes a block into exactly dst_size bytes. Every length and offset is
+  // checked, so corrupt input fails instead of reading or writing out of bounds.
+  inline bool lz_decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size)
+  {
+    size_t ip = 0;
+    size_t op = 0;
+    for (;;)
+    {
+      if (ip >= size)
+        return false;
+      const uint8_t token = src[ip++];
+      size_t literal_length = token >> 4;
+      if (literal_length == 15 && !lz_read_length(src, size, ip, literal_length))
+        return false;
+      if (literal_length > size - ip || literal_length > dst_size - op)
+        return false;
+      memcpy(dst + op, src + ip, literal_length);
+      ip += literal_length;
+      op += literal_length;
+      if (ip == size)
+        break;
+
+      if (size - ip < 2)
+        return false;
+      const size_t offset = src[ip] | ((size_t)src[ip + 1] << 8);
+      ip += 2;
+      size_t length = token & 15;
+      if (length == 15 && !lz_read_length(src, size, ip, length))
+        return false;
+      length += LZ_MIN_MATCH;
+      if (offset == 0 || offset > op || length > dst_size - op)
+        return false;
+
+      uint8_t *out = dst + op;
+      const uint8_t *match = out - offset;
+      if (offset >= length)
+      {
+        memcpy(out, match, length);
+      }
+      else if (offset >= 8)
+      {
+        // Overlapping, but each 8 byte chunk reads only bytes already written
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8)
+          memcpy(out + i, match + i, 8);
+        for (; i < length; i++)
+          out[i] = match[i];
+      }
+      else
+      {
+        for (size_t i = 0; i < length; i++)
+          out[i] = match[i];
+      }
+      op += length;
+    }
+    return op == dst_size;
+  }
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "entity.hpp"
 #include "component_array.hpp"
+#include "../hash/string_id.hpp"
 #include <memory>
 #include <unordered_map>
 
@@ -11,20 +12,23 @@ namespace hades
   class ComponentManager
   {
   private:
-    std::unordered_map<const char *, std::shared_ptr<void>> componentArrays;
+    std::unordered_map<StringId, std::shared_ptr<void>> componentArrays;
 
   public:
     template <typename T>
     std::shared_ptr<ComponentArray<T>> getComponentArray()
     {
-      const char *typeName = typeid(T).name();
+      constexpr StringId typeId = type_id<T>();
 
-      if (componentArrays.find(typeName) == componentArrays.end())
+      auto found = componentArrays.find(typeId);
+      if (found == componentArrays.end())
       {
-        componentArrays[typeName] = std::make_shared<ComponentArray<T>>();
+        // Interned so tools can print component names from their ids
+        StringId::intern(type_name<T>());
+        found = componentArrays.emplace(typeId, std::make_shared<ComponentArray<T>>()).first;
       }
 
-      return std::static_pointer_cast<ComponentArray<T>>(componentArrays[typeName]);
+      return std::static_pointer_cast<ComponentArray<T>>(found->second);
     }
 
     template <typename T>
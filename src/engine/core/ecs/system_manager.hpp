@@ -1,23 +1,25 @@
 #include "system.hpp"
 #include "component_manager.hpp"
 #include "entity_manager.hpp"
+#include "../hash/string_id.hpp"
 #include <memory>
+#include <unordered_map>
 
 namespace hades
 {
   class SystemManager
   {
   private:
-    std::unordered_map<const char *, std::shared_ptr<System>> systems;
+    std::unordered_map<StringId, std::shared_ptr<System>> systems;
 
   public:
     template <typename T>
     std::shared_ptr<T> registerSystem()
     {
-      const char *typeName = typeid(T).name();
+      const StringId typeId = StringId::intern(type_name<T>());
 
       auto system = std::make_shared<T>();
-      systems[typeName] = system;
+      systems[typeId] = system;
       return system;
     }
 
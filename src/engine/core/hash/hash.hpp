@@ -0,0 +1,287 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HADES_HASH_SSE2 1
+#endif
+
+// Non-cryptographic hashes. Values are stable across runs and platforms of
+// the same build, so they can name cache files and index archives.
+//
+// - fnv1a_64: byte at a time, trivially streamable; kept for callers that
+//   chain tiny fields.
+// - wyhash: multiply-mix hash for short keys, constexpr so string literals
+//   hash at compile time.
+// - hash64: bulk content hash. Short inputs take the wyhash path; longer
+//   ones run eight 64-bit accumulators over 64-byte stripes in the style of
+//   XXH3 (SSE2 when available, identical scalar fallback). It follows the
+//   XXH3 construction but is not bit-compatible with it.
+namespace hades
+{
+  constexpr uint64_t FNV1A_64_OFFSET = 0xcbf29ce484222325ull;
+  constexpr uint64_t FNV1A_64_PRIME = 0x100000001b3ull;
+
+  // 64-bit FNV-1a. Pass a previous result as seed to hash several buffers as one stream.
+  inline uint64_t fnv1a_64(const void *data, size_t size, uint64_t seed = FNV1A_64_OFFSET)
+  {
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++)
+    {
+      hash ^= bytes[i];
+      hash *= FNV1A_64_PRIME;
+    }
+    return hash;
+  }
+
+  constexpr uint64_t fnv1a_64_text(std::string_view text, uint64_t seed = FNV1A_64_OFFSET)
+  {
+    uint64_t hash = seed;
+    for (char c : text)
+    {
+      hash ^= (uint8_t)c;
+      hash *= FNV1A_64_PRIME;
+    }
+    return hash;
+  }
+
+  namespace hash_detail
+  {
+    constexpr uint64_t WY_SECRET[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+    // 64x64 -> 128 bit multiply; a receives the low half, b the high half
+    constexpr void mum(uint64_t &a, uint64_t &b)
+    {
+#if defined(__SIZEOF_INT128__)
+      __extension__ typedef unsigned __int128 uint128;
+      const uint128 product = (uint128)a * b;
+      a = (uint64_t)product;
+      b = (uint64_t)(product >> 64);
+#else
+      const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+      const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+      const uint64_t t = rl + (rm0 << 32);
+      uint64_t carry = t < rl;
+      const uint64_t lo = t + (rm1 << 32);
+      carry += lo < t;
+      a = lo;
+      b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+    }
+
+    constexpr uint64_t mix(uint64_t a, uint64_t b)
+    {
+      mum(a, b);
+      return a ^ b;
+    }
+
+    // Little-endian reads written byte-wise so they work in constant
+    // expressions; compilers fold them into single loads
+    constexpr uint64_t read64(const char *p)
+    {
+      uint64_t value = 0;
+      for (int i = 7; i >= 0; i--)
+        value = (value << 8) | (uint8_t)p[i];
+      return value;
+    }
+
+    constexpr uint64_t read32(const char *p)
+    {
+      return (uint64_t)(uint8_t)p[0] | ((uint64_t)(uint8_t)p[1] << 8) | ((uint64_t)(uint8_t)p[2] << 16) | ((uint64_t)(uint8_t)p[3] << 24);
+    }
+
+    constexpr uint64_t read_small(const char *p, size_t size)
+    {
+      return ((uint64_t)(uint8_t)p[0] << 16) | ((uint64_t)(uint8_t)p[size >> 1] << 8) | (uint8_t)p[size - 1];
+    }
+  }
+
+  constexpr uint64_t wyhash(const char *data, size_t size, uint64_t seed = 0)
+  {
+    using namespace hash_detail;
+    const char *p = data;
+    seed ^= mix(seed ^ WY_SECRET[0], WY_SECRET[1]);
+    uint64_t a = 0, b = 0;
+    if (size <= 16)
+    {
+      if (size >= 4)
+      {
+        a = (read32(p) << 32) | read32(p + ((size >> 3) << 2));
+        b = (read32(p + size - 4) << 32) | read32(p + size - 4 - ((size >> 3) << 2));
+      }
+      else if (size > 0)
+      {
+        a = read_small(p, size);
+      }
+    }
+    else
+    {
+      size_t remaining = size;
+      if (remaining > 48)
+      {
+        uint64_t see1 = seed, see2 = seed;
+        do
+        {
+          seed = mix(read64(p) ^ WY_SECRET[1], read64(p + 8) ^ seed);
+          see1 = mix(read64(p + 16) ^ WY_SECRET[2], read64(p + 24) ^ see1);
+          see2 = mix(read64(p + 32) ^ WY_SECRET[3], read64(p + 40) ^ see2);
+          p += 48;
+          remaining -= 48;
+        } while (remaining > 48);
+        seed ^= see1 ^ see2;
+      }
+      while (remaining > 16)
+      {
+        seed = mix(read64(p) ^ WY_SECRET[1], read64(p + 8) ^ seed);
+        p += 16;
+        remaining -= 16;
+      }
+      a = read64(p + remaining - 16);
+      b = read64(p + remaining - 8);
+    }
+    a ^= WY_SECRET[1];
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ WY_SECRET[0] ^ size, b ^ WY_SECRET[1]);
+  }
+
+  constexpr uint64_t wyhash(std::string_view text, uint64_t seed = 0)
+  {
+    return wyhash(text.data(), text.size(), seed);
+  }
+
+  // Combines two hashes, e.g. a type tag with a path hash
+  constexpr uint64_t hash_combine(uint64_t a, uint64_t b)
+  {
+    return hash_detail::mix(a ^ hash_detail::WY_SECRET[0], b ^ hash_detail::WY_SECRET[1]);
+  }
+
+  namespace hash_detail
+  {
+    constexpr size_t STRIPE = 64;
+    constexpr size_t STRIPES_PER_BLOCK = 16;
+    constexpr size_t LONG_THRESHOLD = 256; // Below this the wyhash path is faster
+    constexpr uint64_t PRIME32_1 = 0x9e3779b1u;
+
+    constexpr uint64_t KEYS[8] = {0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+                                  0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull};
+
+    inline uint64_t load64(const uint8_t *p)
+    {
+      uint64_t value;
+      memcpy(&value, p, 8);
+      return value;
+    }
+
+    inline uint64_t avalanche(uint64_t h)
+    {
+      h ^= h >> 37;
+      h *= 0x165667919e3779f9ull;
+      return h ^ (h >> 32);
+    }
+
+    // keys holds the seeded key schedule twice so a stripe can start at any rotation
+    inline void accumulate_scalar(uint64_t *acc, const uint8_t *stripe, const uint64_t *keys)
+    {
+      for (size_t i = 0; i < 8; i++)
+      {
+        const uint64_t data = load64(stripe + i * 8);
+        const uint64_t key = data ^ keys[i];
+        acc[i ^ 1] += data;
+        acc[i] += (key & 0xffffffffu) * (key >> 32);
+      }
+    }
+
+    inline void scramble_scalar(uint64_t *acc, const uint64_t *keys)
+    {
+      for (size_t i = 0; i < 8; i++)
+        acc[i] = (acc[i] ^ (acc[i] >> 47) ^ keys[i]) * PRIME32_1;
+    }
+
+#ifdef HADES_HASH_SSE2
+    inline void accumulate_sse2(uint64_t *acc, const uint8_t *stripe, const uint64_t *keys)
+    {
+      for (size_t i = 0; i < 4; i++)
+      {
+        __m128i *lanes = (__m128i *)acc + i;
+        const __m128i data = _mm_loadu_si128((const __m128i *)stripe + i);
+        const __m128i key = _mm_xor_si128(data, _mm_loadu_si128((const __m128i *)(keys + i * 2)));
+        // Low half of each 64-bit lane times its high half
+        const __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+        const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        _mm_storeu_si128(lanes, _mm_add_epi64(_mm_loadu_si128(lanes), _mm_add_epi64(product, swapped)));
+      }
+    }
+
+    inline void scramble_sse2(uint64_t *acc, const uint64_t *keys)
+    {
+      const __m128i prime = _mm_set1_epi32((int)PRIME32_1);
+      for (size_t i = 0; i < 4; i++)
+      {
+        __m128i *lanes = (__m128i *)acc + i;
+        __m128i value = _mm_loadu_si128(lanes);
+        value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+        value = _mm_xor_si128(value, _mm_loadu_si128((const __m128i *)(keys + i * 2)));
+        // 64 x 32 bit multiply from two 32 x 32 -> 64 products
+        const __m128i low = _mm_mul_epu32(value, prime);
+        const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(lanes, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+      }
+    }
+#endif
+
+    inline uint64_t hash_long(const uint8_t *data, size_t size, uint64_t seed, bool simd)
+    {
+      uint64_t keys[16];
+      for (size_t i = 0; i < 8; i++)
+        keys[i] = keys[i + 8] = (i & 1) ? KEYS[i] - seed : KEYS[i] + seed;
+      alignas(16) uint64_t acc[8] = {0x00000000c2b2ae3dull, 0x9e3779b185ebca87ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull,
+                                     0x85ebca77c2b2ae63ull, 0x0000000085ebca77ull, 0x27d4eb2f165667c5ull, 0x000000009e3779b1ull};
+#ifdef HADES_HASH_SSE2
+      auto accumulate = simd ? accumulate_sse2 : accumulate_scalar;
+      auto scramble = simd ? scramble_sse2 : scramble_scalar;
+#else
+      (void)simd;
+      auto accumulate = accumulate_scalar;
+      auto scramble = scramble_scalar;
+#endif
+
+      // Every stripe but the last, scrambling after each block; consecutive
+      // stripes see the keys rotated by one lane
+      const size_t stripes = (size - 1) / STRIPE;
+      for (size_t s = 0; s < stripes; s++)
+      {
+        accumulate(acc, data + s * STRIPE, keys + s % 8);
+        if (s % STRIPES_PER_BLOCK == STRIPES_PER_BLOCK - 1)
+          scramble(acc, keys);
+      }
+      // The last 64 bytes, overlapping the previous stripe when size is not a multiple
+      accumulate(acc, data + size - STRIPE, keys + 7);
+
+      uint64_t h = size * 0x9e3779b185ebca87ull;
+      for (size_t i = 0; i < 4; i++)
+        h += mix(acc[2 * i] ^ keys[2 * i + 1], acc[2 * i + 1] ^ keys[2 * i]);
+      return avalanche(h);
+    }
+  }
+
+  inline uint64_t hash64(const void *data, size_t size, uint64_t seed = 0)
+  {
+    if (size < hash_detail::LONG_THRESHOLD)
+      return wyhash((const char *)data, size, seed);
+    return hash_detail::hash_long((const uint8_t *)data, size, seed, true);
+  }
+
+  inline uint64_t hash64(std::string_view text, uint64_t seed = 0)
+  {
+    return hash64(text.data(), text.size(), seed);
+  }
+}
+
+#endif
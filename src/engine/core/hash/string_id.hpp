@@ -0,0 +1,216 @@
+#ifndef STRING_ID_H
+#define STRING_ID_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hash.hpp"
+
+namespace hades
+{
+  // 64-bit name identifier. Compile-time and runtime construction use the
+  // same hash, so "mesh"_sid and a name read from a file compare equal.
+  // Interning records the string so ids can be turned back into names for
+  // tools and logs.
+  class StringId
+  {
+  private:
+    uint64_t id = 0;
+
+  public:
+    constexpr StringId() = default;
+    constexpr explicit StringId(uint64_t value) : id(value) {}
+    constexpr explicit StringId(std::string_view name) : id(wyhash(name)) {}
+
+    constexpr uint64_t value() const { return id; }
+    constexpr bool valid() const { return id != 0; }
+
+    constexpr bool operator==(StringId other) const { return id == other.id; }
+    constexpr bool operator!=(StringId other) const { return id != other.id; }
+    constexpr bool operator<(StringId other) const { return id < other.id; }
+
+    // Interns the name in StringTable::get() and returns its id
+    static StringId intern(std::string_view name);
+    // The interned name, or an empty view for ids that were never interned
+    std::string_view str() const;
+  };
+
+  constexpr StringId operator""_sid(const char *name, size_t size)
+  {
+    return StringId(std::string_view(name, size));
+  }
+
+  // Intern table keyed by StringId. Lookups are lock-free: the slot array is
+  // an open-addressed table of atomic pointers, and growing publishes a new
+  // array instead of rehashing in place. Retired arrays and every interned
+  // string live until the table is destroyed, so a reader holding an old
+  // array or a returned view is never left dangling. Inserts take a mutex.
+  class StringTable
+  {
+  private:
+    struct Entry
+    {
+      uint64_t id;
+      std::string name;
+    };
+
+    struct Slots
+    {
+      std::vector<std::atomic<const Entry *>> entries;
+      uint64_t mask;
+
+      explicit Slots(size_t capacity) : entries(capacity), mask(capacity - 1)
+      {
+        for (auto &entry : entries)
+          entry.store(nullptr, std::memory_order_relaxed);
+      }
+    };
+
+    std::atomic<Slots *> current;
+    std::vector<std::unique_ptr<Slots>> tables; // Every array ever published
+    std::deque<Entry> storage;
+    std::mutex write_mutex;
+    size_t count = 0;
+
+    static void place(Slots &slots, const Entry *entry)
+    {
+      for (uint64_t i = entry->id;; i++)
+      {
+        auto &slot = slots.entries[i & slots.mask];
+        if (slot.load(std::memory_order_relaxed) == nullptr)
+        {
+          slot.store(entry, std::memory_order_release);
+          return;
+        }
+      }
+    }
+
+    const Entry *lookup(uint64_t id) const
+    {
+      const Slots *slots = current.load(std::memory_order_acquire);
+      for (uint64_t i = id;; i++)
+      {
+        const Entry *entry = slots->entries[i & slots->mask].load(std::memory_order_acquire);
+        if (entry == nullptr || entry->id == id)
+          return entry;
+      }
+    }
+
+  public:
+    explicit StringTable(size_t initial_capacity = 1024)
+    {
+      size_t capacity = 16;
+      while (capacity < initial_capacity)
+        capacity *= 2;
+      tables.push_back(std::make_unique<Slots>(capacity));
+      current.store(tables.back().get(), std::memory_order_release);
+    }
+
+    StringTable(const StringTable &) = delete;
+    StringTable &operator=(const StringTable &) = delete;
+
+    static StringTable &get()
+    {
+      static StringTable table;
+      return table;
+    }
+
+    StringId intern(std::string_view name)
+    {
+      const StringId id(name);
+      if (const Entry *entry = lookup(id.value()))
+      {
+        if (entry->name != name)
+          std::cerr << "ERR: string id collision between '" << entry->name << "' and '" << name << "'" << std::endl;
+        return id;
+      }
+
+      std::lock_guard<std::mutex> lock(write_mutex);
+      if (lookup(id.value()) != nullptr)
+        return id; // Interned by another thread meanwhile
+
+      Slots *slots = current.load(std::memory_order_relaxed);
+      if ((count + 1) * 2 > slots->entries.size())
+      {
+        // Keep the load under one half; readers move over on their next lookup
+        auto grown = std::make_unique<Slots>(slots->entries.size() * 2);
+        for (const auto &slot : slots->entries)
+          if (const Entry *entry = slot.load(std::memory_order_relaxed))
+            place(*grown, entry);
+        slots = grown.get();
+        tables.push_back(std::move(grown));
+        current.store(slots, std::memory_order_release);
+      }
+      storage.push_back(Entry{id.value(), std::string(name)});
+      place(*slots, &storage.back());
+      count++;
+      return id;
+    }
+
+    std::string_view find(StringId id) const
+    {
+      const Entry *entry = lookup(id.value());
+      return entry != nullptr ? std::string_view(entry->name) : std::string_view();
+    }
+
+    size_t size()
+    {
+      std::lock_guard<std::mutex> lock(write_mutex);
+      return count;
+    }
+  };
+
+  inline StringId StringId::intern(std::string_view name)
+  {
+    return StringTable::get().intern(name);
+  }
+
+  inline std::string_view StringId::str() const
+  {
+    return StringTable::get().find(*this);
+  }
+
+  // Compiler-generated name of a type, available in constant expressions.
+  // The spelling differs between compilers, so ids built from it are stable
+  // within a build but must not be persisted.
+  template <typename T>
+  constexpr std::string_view type_name()
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr std::string_view signature = __FUNCSIG__;
+    constexpr size_t begin = signature.find("type_name<") + 10;
+    constexpr size_t end = signature.rfind(">(void)");
+#else
+    // "... type_name() [with T = Name; ...]" (GCC) or "... type_name() [T = Name]" (Clang)
+    constexpr std::string_view signature = __PRETTY_FUNCTION__;
+    constexpr size_t begin = signature.find("T = ") + 4;
+    constexpr size_t end = signature.find_first_of(";]", begin);
+#endif
+    return signature.substr(begin, end - begin);
+  }
+
+  template <typename T>
+  constexpr StringId type_id()
+  {
+    return StringId(type_name<T>());
+  }
+}
+
+namespace std
+{
+  template <>
+  struct hash<hades::StringId>
+  {
+    size_t operator()(hades::StringId id) const { return (size_t)id.value(); }
+  };
+}
+
+#endif
@@ -0,0 +1,773 @@
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace hades
+{
+  // Reads are issued in this order. Prefetch reads never take the last half
+  // of the queue depth, so a burst of them cannot delay what is visible now.
+  enum class IoPriority : uint8_t
+  {
+    URGENT = 0,
+    NORMAL = 1,
+    PREFETCH = 2,
+  };
+  constexpr uint32_t IO_PRIORITY_COUNT = 3;
+
+  // Read-only file opened for positional reads
+  class IoFile
+  {
+  private:
+#ifdef _WIN32
+    HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+    int fd = -1;
+#endif
+    uint64_t length = 0;
+
+  public:
+    IoFile() = default;
+
+    IoFile(const IoFile &) = delete;
+    IoFile &operator=(const IoFile &) = delete;
+
+    IoFile(IoFile &&other) noexcept
+    {
+      *this = std::move(other);
+    }
+
+    IoFile &operator=(IoFile &&other) noexcept
+    {
+      if (this != &other)
+      {
+        close();
+#ifdef _WIN32
+        std::swap(handle, other.handle);
+#else
+        std::swap(fd, other.fd);
+#endif
+        std::swap(length, other.length);
+      }
+      return *this;
+    }
+
+    ~IoFile()
+    {
+      close();
+    }
+
+    bool open(const std::string &path)
+    {
+      close();
+#ifdef _WIN32
+      handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (handle == INVALID_HANDLE_VALUE)
+        return false;
+      LARGE_INTEGER file_size;
+      if (!GetFileSizeEx(handle, &file_size))
+      {
+        close();
+        return false;
+      }
+      length = (uint64_t)file_size.QuadPart;
+#else
+      fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0)
+        return false;
+      struct stat st;
+      if (fstat(fd, &st) != 0)
+      {
+        close();
+        return false;
+      }
+      length = (uint64_t)st.st_size;
+#endif
+      return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+      if (handle != INVALID_HANDLE_VALUE)
+        CloseHandle(handle);
+      handle = INVALID_HANDLE_VALUE;
+#else
+      if (fd >= 0)
+        ::close(fd);
+      fd = -1;
+#endif
+      length = 0;
+    }
+
+#ifdef _WIN32
+    bool is_open() const { return handle != INVALID_HANDLE_VALUE; }
+    HANDLE native() const { return handle; }
+#else
+    bool is_open() const { return fd >= 0; }
+    int native() const { return fd; }
+#endif
+    uint64_t size() const { return length; }
+
+    // Blocking positional read. Returns the bytes read (short only at end of
+    // file) or a negative error.
+    int64_t read_at(uint64_t offset, uint8_t *out, uint32_t size) const
+    {
+      uint32_t done = 0;
+      while (done < size)
+      {
+#ifdef _WIN32
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = (DWORD)(offset + done);
+        overlapped.OffsetHigh = (DWORD)((offset + done) >> 32);
+        DWORD got = 0;
+        if (!ReadFile(handle, out + done, size - done, &got, &overlapped))
+          return GetLastError() == ERROR_HANDLE_EOF ? (int64_t)done : -(int64_t)GetLastError();
+#else
+        const ssize_t got = pread(fd, out + done, size - done, (off_t)(offset + done));
+        if (got < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return -(int64_t)errno;
+        }
+#endif
+        if (got == 0)
+          break;
+        done += (uint32_t)got;
+      }
+      return done;
+    }
+  };
+
+  // Fixed-size read buffers carved out of one block. The io_uring backend
+  // registers every slot with the kernel once, so reads into a slot skip the
+  // per-request page pinning. The block can be caller memory, e.g. a
+  // persistently mapped host-visible buffer, so a finished read is already
+  // sitting in upload staging memory.
+  class IoBufferPool
+  {
+  private:
+    uint8_t *memory = nullptr;
+    bool owned = false;
+    size_t slot_bytes = 0;
+    uint32_t count = 0;
+    std::vector<uint32_t> free_slots;
+    std::mutex mutex;
+
+  public:
+    static constexpr size_t ALIGNMENT = 4096;
+
+    IoBufferPool(uint32_t slot_count, size_t slot_size)
+        : slot_bytes((slot_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1)), count(slot_count)
+    {
+      const size_t total = slot_bytes * count;
+#ifdef _WIN32
+      memory = (uint8_t *)_aligned_malloc(total, ALIGNMENT);
+#else
+      memory = (uint8_t *)std::aligned_alloc(ALIGNMENT, total);
+#endif
+      owned = true;
+      for (uint32_t i = count; i > 0; i--)
+        free_slots.push_back(i - 1);
+    }
+
+    IoBufferPool(uint8_t *external, uint32_t slot_count, size_t slot_size)
+        : memory(external), slot_bytes(slot_size), count(slot_count)
+    {
+      for (uint32_t i = count; i > 0; i--)
+        free_slots.push_back(i - 1);
+    }
+
+    IoBufferPool(const IoBufferPool &) = delete;
+    IoBufferPool &operator=(const IoBufferPool &) = delete;
+
+    ~IoBufferPool()
+    {
+      if (!owned)
+        return;
+#ifdef _WIN32
+      _aligned_free(memory);
+#else
+      std::free(memory);
+#endif
+    }
+
+    // Returns -1 when every slot is in use
+    int32_t acquire()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (free_slots.empty())
+        return -1;
+      const uint32_t slot = free_slots.back();
+      free_slots.pop_back();
+      return (int32_t)slot;
+    }
+
+    void release(uint32_t slot)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      free_slots.push_back(slot);
+    }
+
+    uint8_t *slot(uint32_t index) const { return memory + slot_bytes * index; }
+    size_t slot_size() const { return slot_bytes; }
+    uint32_t slot_count() const { return count; }
+    uint8_t *data() const { return memory; }
+  };
+
+  struct IoRead
+  {
+    const IoFile *file = nullptr;
+    uint64_t offset = 0;
+    uint32_t size = 0;
+    uint8_t *destination = nullptr; // Ignored when buffer_slot is set
+    int32_t buffer_slot = -1;       // Slot of the backend's IoBufferPool
+    IoPriority priority = IoPriority::NORMAL;
+    // Bytes read (short only at end of file) or a negative error. Runs on
+    // the thread that calls poll().
+    std::function<void(const IoRead &read, int64_t result)> on_complete;
+  };
+
+  struct IoStats
+  {
+    uint64_t reads = 0;
+    uint64_t bytes = 0;
+    uint64_t failed = 0;
+    uint64_t batches = 0; // Submissions handed to the kernel or the pool
+  };
+
+  // Queues reads by priority and completes them asynchronously. read() may
+  // be called from any thread; submit() and poll() belong to one thread,
+  // which is also where completion callbacks run.
+  class IoBackend
+  {
+  protected:
+    struct Pending
+    {
+      IoRead request;
+      uint32_t done = 0; // Bytes already read by earlier short reads
+    };
+
+    IoBufferPool *buffers;
+    uint32_t depth;
+    std::deque<Pending> queues[IO_PRIORITY_COUNT];
+    std::mutex queue_mutex;
+    uint32_t in_flight = 0;
+    IoStats io_stats;
+
+    IoBackend(IoBufferPool *buffers, uint32_t depth)
+        : buffers(buffers), depth(std::max(depth, 2u)) {}
+
+    uint8_t *destination(const Pending &pending) const
+    {
+      const IoRead &read = pending.request;
+      uint8_t *base = read.buffer_slot >= 0 ? buffers->slot((uint32_t)read.buffer_slot) : read.destination;
+      return base + pending.done;
+    }
+
+    // Highest priority queued read that fits under the in-flight limits
+    bool pop_next(Pending &out, uint32_t active)
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      for (uint32_t p = 0; p < IO_PRIORITY_COUNT; p++)
+      {
+        if (queues[p].empty())
+          continue;
+        const uint32_t limit = p == (uint32_t)IoPriority::PREFETCH ? depth / 2 : depth;
+        if (active >= limit)
+          return false;
+        out = std::move(queues[p].front());
+        queues[p].pop_front();
+        return true;
+      }
+      return false;
+    }
+
+    void requeue_front(Pending pending)
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      queues[(uint32_t)pending.request.priority].push_front(std::move(pending));
+    }
+
+    void complete(Pending &pending, int64_t result)
+    {
+      if (result < 0)
+        io_stats.failed++;
+      else
+        io_stats.bytes += (uint64_t)result;
+      io_stats.reads++;
+      if (pending.request.on_complete)
+        pending.request.on_complete(pending.request, result);
+    }
+
+    static int64_t short_read_result(const Pending &pending, int64_t result)
+    {
+      return result < 0 ? result : (int64_t)pending.done + result;
+    }
+
+  public:
+    virtual ~IoBackend() = default;
+
+    virtual const char *name() const = 0;
+
+    // Hands queued reads to the device, as one batch where possible.
+    // Returns the number of reads issued.
+    virtual uint32_t submit() = 0;
+
+    // Runs callbacks for finished reads, blocking for at least one when wait
+    // is set and reads are outstanding. Returns the number completed.
+    virtual uint32_t poll(bool wait) = 0;
+
+    void read(IoRead request)
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      queues[(uint32_t)request.priority].push_back(Pending{std::move(request), 0});
+    }
+
+    uint32_t queued()
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      return (uint32_t)(queues[0].size() + queues[1].size() + queues[2].size());
+    }
+
+    uint32_t outstanding() const { return in_flight; }
+
+    // Submits and reaps until every queued read has completed
+    void drain()
+    {
+      for (;;)
+      {
+        submit();
+        if (in_flight == 0 && queued() == 0)
+          return;
+        poll(true);
+      }
+    }
+
+    IoBufferPool *buffer_pool() const { return buffers; }
+    const IoStats &stats() const { return io_stats; }
+  };
+
+  // Portable fallback: worker threads issuing blocking positional reads,
+  // always taking the highest priority read that is queued
+  class PreadBackend : public IoBackend
+  {
+  private:
+    struct Done
+    {
+      Pending pending;
+      int64_t result;
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex state_mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::vector<Done> completed;
+    uint32_t active = 0;    // Reads currently on a worker
+    uint32_t released = 0;  // Submitted reads no worker has picked up yet
+    bool stopping = false;
+
+    void worker_main()
+    {
+      std::unique_lock<std::mutex> lock(state_mutex);
+      for (;;)
+      {
+        Pending pending;
+        work_cv.wait(lock, [&]
+                     { return stopping || (released > 0 && pop_next(pending, active)); });
+        if (stopping)
+          return;
+        released--;
+        active++;
+        lock.unlock();
+
+        const int64_t result = pending.request.file->read_at(pending.request.offset + pending.done, destination(pending), pending.request.size - pending.done);
+
+        lock.lock();
+        active--;
+        completed.push_back(Done{std::move(pending), result});
+        done_cv.notify_one();
+        if (released > 0)
+          work_cv.notify_one(); // A read held back by the prefetch limit may fit now
+      }
+    }
+
+  public:
+    PreadBackend(IoBufferPool *buffers, uint32_t depth = 64, uint32_t threads = 4)
+        : IoBackend(buffers, depth)
+    {
+      for (uint32_t i = 0; i < std::max(threads, 1u); i++)
+        workers.emplace_back([this]
+                             { worker_main(); });
+    }
+
+    ~PreadBackend() override
+    {
+      {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+      }
+      work_cv.notify_all();
+      for (std::thread &worker : workers)
+        worker.join();
+    }
+
+    const char *name() const override { return "pread"; }
+
+    uint32_t submit() override
+    {
+      std::lock_guard<std::mutex> lock(state_mutex);
+      const uint32_t queued_reads = queued();
+      if (queued_reads == 0)
+        return 0;
+      const uint32_t added = queued_reads - released;
+      if (added == 0)
+        return 0;
+      released = queued_reads;
+      in_flight += added;
+      io_stats.batches++;
+      work_cv.notify_all();
+      return added;
+    }
+
+    uint32_t poll(bool wait) override
+    {
+      std::vector<Done> finished;
+      {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        if (wait && in_flight > 0)
+          done_cv.wait(lock, [&]
+                       { return !completed.empty(); });
+        finished.swap(completed);
+        in_flight -= (uint32_t)finished.size();
+      }
+      for (Done &done : finished)
+        complete(done.pending, short_read_result(done.pending, done.result));
+      return (uint32_t)finished.size();
+    }
+  };
+
+#ifdef __linux__
+  // io_uring through raw system calls. Every submit() publishes all the reads
+  // that fit into the submission ring and enters the kernel once. Reads into
+  // pool slots use READ_FIXED against the registered buffers.
+  class IoUringBackend : public IoBackend
+  {
+  private:
+    int ring_fd = -1;
+    uint8_t *sq_ring = nullptr;
+    uint8_t *cq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    size_t cq_ring_size = 0;
+    io_uring_sqe *sqes = nullptr;
+    uint32_t sq_entries = 0;
+    uint32_t *sq_head = nullptr;
+    uint32_t *sq_tail = nullptr;
+    uint32_t sq_mask = 0;
+    uint32_t *sq_array = nullptr;
+    uint32_t *cq_head = nullptr;
+    uint32_t *cq_tail = nullptr;
+    uint32_t cq_mask = 0;
+    io_uring_cqe *cqes = nullptr;
+    bool fixed_buffers = false;
+
+    std::vector<Pending> slots; // Indexed by user_data
+    std::vector<uint32_t> free_slots;
+
+    static int enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+    {
+      return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+    }
+
+    // Out of kernel resources or completion space: entries stay in the ring
+    // and go out with the next enter
+    static bool retry_later(int error)
+    {
+      return error == EINTR || error == EAGAIN || error == EBUSY;
+    }
+
+    bool supports_op(uint8_t op) const
+    {
+      std::vector<uint8_t> memory(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+      io_uring_probe *probe = (io_uring_probe *)memory.data();
+      if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, 256) != 0)
+        return false;
+      return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    }
+
+    // The kernel refused the batch outright; reads it has not consumed never
+    // will be, so they complete with the error instead. Returns their count.
+    uint32_t fail_unsubmitted(int error)
+    {
+      const uint32_t head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+      std::vector<uint32_t> failed;
+      for (uint32_t i = head; i != *sq_tail; i++)
+        failed.push_back((uint32_t)sqes[sq_array[i & sq_mask]].user_data);
+      __atomic_store_n(sq_tail, head, __ATOMIC_RELEASE);
+      for (uint32_t slot : failed)
+      {
+        Pending pending = std::move(slots[slot]);
+        free_slots.push_back(slot);
+        in_flight--;
+        complete(pending, -error);
+      }
+      return (uint32_t)failed.size();
+    }
+
+    // Best-effort (IOPRIO_CLASS_BE level 0) for urgent reads, idle class for prefetch
+    static uint16_t kernel_priority(IoPriority priority)
+    {
+      switch (priority)
+      {
+      case IoPriority::URGENT:
+        return (2 << 13) | 0;
+      case IoPriority::PREFETCH:
+        return 3 << 13;
+      default:
+        return (2 << 13) | 4;
+      }
+    }
+
+    bool init(uint32_t entries)
+    {
+      io_uring_params params = {};
+      ring_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+      if (ring_fd < 0)
+        return false;
+
+      sq_entries = params.sq_entries;
+      sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+      cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+      if (single_mmap)
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+      void *sq = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+      if (sq == MAP_FAILED)
+        return false;
+      sq_ring = (uint8_t *)sq;
+      if (single_mmap)
+      {
+        cq_ring = sq_ring;
+      }
+      else
+      {
+        void *cq = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED)
+          return false;
+        cq_ring = (uint8_t *)cq;
+      }
+      void *sqe_memory = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+      if (sqe_memory == MAP_FAILED)
+        return false;
+      sqes = (io_uring_sqe *)sqe_memory;
+
+      sq_head = (uint32_t *)(sq_ring + params.sq_off.head);
+      sq_tail = (uint32_t *)(sq_ring + params.sq_off.tail);
+      sq_mask = *(uint32_t *)(sq_ring + params.sq_off.ring_mask);
+      sq_array = (uint32_t *)(sq_ring + params.sq_off.array);
+      cq_head = (uint32_t *)(cq_ring + params.cq_off.head);
+      cq_tail = (uint32_t *)(cq_ring + params.cq_off.tail);
+      cq_mask = *(uint32_t *)(cq_ring + params.cq_off.ring_mask);
+      cqes = (io_uring_cqe *)(cq_ring + params.cq_off.cqes);
+
+      // Rings predating IORING_OP_READ (5.6) also predate the probe; both
+      // leave reads to the pread pool
+      if (!supports_op(IORING_OP_READ))
+        return false;
+
+      // Registration pins the pages and counts against RLIMIT_MEMLOCK on
+      // older kernels; without it reads into slots fall back to plain READ
+      if (buffers != nullptr)
+      {
+        std::vector<iovec> iovecs(buffers->slot_count());
+        for (uint32_t i = 0; i < iovecs.size(); i++)
+          iovecs[i] = iovec{buffers->slot(i), buffers->slot_size()};
+        fixed_buffers = syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(), (unsigned)iovecs.size()) == 0;
+      }
+      return true;
+    }
+
+    void release_ring()
+    {
+      if (sqes != nullptr)
+        munmap(sqes, sq_entries * sizeof(io_uring_sqe));
+      if (cq_ring != nullptr && cq_ring != sq_ring)
+        munmap(cq_ring, cq_ring_size);
+      if (sq_ring != nullptr)
+        munmap(sq_ring, sq_ring_size);
+      if (ring_fd >= 0)
+        ::close(ring_fd);
+      sqes = nullptr;
+      sq_ring = cq_ring = nullptr;
+      ring_fd = -1;
+    }
+
+  public:
+    IoUringBackend(IoBufferPool *buffers, uint32_t depth = 64)
+        : IoBackend(buffers, depth)
+    {
+      if (!init(this->depth))
+      {
+        release_ring();
+        return;
+      }
+      this->depth = std::min(this->depth, sq_entries);
+      slots.resize(this->depth);
+      for (uint32_t i = this->depth; i > 0; i--)
+        free_slots.push_back(i - 1);
+    }
+
+    ~IoUringBackend() override
+    {
+      // The kernel may still write into destinations; let in-flight reads land
+      while (ring_fd >= 0 && in_flight > 0)
+        poll(true);
+      release_ring();
+    }
+
+    bool valid() const { return ring_fd >= 0; }
+    bool registered_buffers() const { return fixed_buffers; }
+    const char *name() const override { return "io_uring"; }
+
+    uint32_t submit() override
+    {
+      uint32_t tail = *sq_tail;
+      uint32_t added = 0;
+      Pending pending;
+      while (!free_slots.empty() && tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) < sq_entries && pop_next(pending, in_flight))
+      {
+        const uint32_t slot = free_slots.back();
+        free_slots.pop_back();
+        const IoRead &read = pending.request;
+        const uint32_t index = tail & sq_mask;
+        io_uring_sqe &sqe = sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        const bool fixed = fixed_buffers && read.buffer_slot >= 0;
+        sqe.opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        sqe.fd = read.file->native();
+        sqe.off = read.offset + pending.done;
+        sqe.addr = (uint64_t)(uintptr_t)destination(pending);
+        sqe.len = read.size - pending.done;
+        sqe.ioprio = kernel_priority(read.priority);
+        sqe.buf_index = fixed ? (uint16_t)read.buffer_slot : 0;
+        sqe.user_data = slot;
+        sq_array[index] = index;
+        slots[slot] = std::move(pending);
+        tail++;
+        added++;
+        in_flight++;
+      }
+      __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+      // Entries the kernel has not consumed yet (e.g. after EAGAIN) go out with this batch
+      const uint32_t to_submit = tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+      if (to_submit > 0)
+      {
+        int submitted;
+        do
+          submitted = enter(ring_fd, to_submit, 0, 0);
+        while (submitted < 0 && errno == EINTR);
+        if (submitted < 0 && !retry_later(errno))
+          fail_unsubmitted(errno);
+        io_stats.batches++;
+      }
+      return added;
+    }
+
+    uint32_t poll(bool wait) override
+    {
+      uint32_t count = 0;
+      if (wait && in_flight > 0 && __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE) == *cq_head)
+      {
+        const uint32_t to_submit = *sq_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+        if (enter(ring_fd, to_submit, 1, IORING_ENTER_GETEVENTS) < 0 && !retry_later(errno))
+          count += fail_unsubmitted(errno);
+      }
+
+      uint32_t head = *cq_head;
+      const uint32_t tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+      std::vector<std::pair<uint32_t, int64_t>> finished;
+      for (; head != tail; head++)
+      {
+        const io_uring_cqe &cqe = cqes[head & cq_mask];
+        finished.emplace_back((uint32_t)cqe.user_data, (int64_t)cqe.res);
+      }
+      __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+
+      for (const auto &entry : finished)
+      {
+        Pending pending = std::move(slots[entry.first]);
+        free_slots.push_back(entry.first);
+        in_flight--;
+        const int64_t result = entry.second;
+        if (result > 0 && pending.done + (uint32_t)result < pending.request.size)
+        {
+          // Short read before end of file: issue the rest at the same priority
+          pending.done += (uint32_t)result;
+          requeue_front(std::move(pending));
+          continue;
+        }
+        complete(pending, short_read_result(pending, result));
+        count++;
+      }
+      return count;
+    }
+  };
+#endif
+
+  // io_uring where the kernel allows it, otherwise the pread pool
+  inline std::unique_ptr<IoBackend> create_io_backend(IoBufferPool *buffers, uint32_t depth = 64, bool allow_io_uring = true)
+  {
+#ifdef __linux__
+    if (allow_io_uring)
+    {
+      auto ring = std::make_unique<IoUringBackend>(buffers, depth);
+      if (ring->valid())
+        return ring;
+    }
+#else
+    (void)allow_io_uring;
+#endif
+    return std::make_unique<PreadBackend>(buffers, depth);
+  }
+}
+
+#endif
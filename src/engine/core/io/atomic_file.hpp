@@ -0,0 +1,63 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace hades
+{
+  // Temporary name next to path, unique per process, thread and call, so
+  // concurrent writers of the same path never share a temporary file
+  inline std::string atomic_temp_path(const std::string &path)
+  {
+    static std::atomic<uint64_t> counter{0};
+#ifdef _WIN32
+    const uint64_t process = (uint64_t)_getpid();
+#else
+    const uint64_t process = (uint64_t)getpid();
+#endif
+    const uint64_t thread = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), ".%llx.%llx.%llx.tmp", (unsigned long long)process, (unsigned long long)thread,
+             (unsigned long long)counter.fetch_add(1, std::memory_order_relaxed));
+    return path + suffix;
+  }
+
+  // Writes to a temporary file first and renames it into place, so a crash
+  // mid-write never leaves a truncated file behind for the next run to map.
+  inline bool write_file_atomic(const std::string &path, const std::vector<uint8_t> &bytes)
+  {
+    const std::string temp_path = atomic_temp_path(path);
+    FILE *file = fopen(temp_path.c_str(), "wb");
+    if (file == nullptr)
+      return false;
+    const bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if (fclose(file) != 0 || !written)
+    {
+      std::remove(temp_path.c_str());
+      return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+    {
+      std::remove(temp_path.c_str());
+      return false;
+    }
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <limits.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace hades
+{
+  // Reports writes to a set of files. On Linux this uses inotify on the
+  // parent directories, which also catches editors that save by writing a
+  // temporary file and renaming it over the original. Elsewhere it falls back
+  // to comparing modification times on every poll.
+  class FileWatcher
+  {
+  private:
+    std::unordered_set<std::string> files; // Normalized paths
+#ifdef __linux__
+    int fd = -1;
+    std::unordered_map<int, std::string> directories; // Watch descriptor -> directory
+    std::unordered_set<std::string> watched_directories;
+#else
+    std::unordered_map<std::string, std::filesystem::file_time_type> timestamps;
+#endif
+
+  public:
+    FileWatcher()
+    {
+#ifdef __linux__
+      fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    }
+
+    ~FileWatcher()
+    {
+#ifdef __linux__
+      if (fd >= 0)
+        close(fd);
+#endif
+    }
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    static std::string normalize(const std::string &path)
+    {
+      std::error_code ec;
+      std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+      return (ec ? std::filesystem::path(path) : absolute).lexically_normal().generic_string();
+    }
+
+    bool watch(const std::string &path)
+    {
+      const std::string file = normalize(path);
+      if (!files.insert(file).second)
+        return true;
+#ifdef __linux__
+      if (fd < 0)
+        return false;
+      const std::string directory = std::filesystem::path(file).parent_path().string();
+      if (watched_directories.count(directory) != 0)
+        return true;
+      const int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+      if (wd < 0)
+        return false;
+      directories[wd] = directory;
+      watched_directories.insert(directory);
+#else
+      std::error_code ec;
+      timestamps[file] = std::filesystem::last_write_time(file, ec);
+#endif
+      return true;
+    }
+
+    bool is_watched(const std::string &path) const
+    {
+      return files.count(normalize(path)) != 0;
+    }
+
+    // Waits up to timeout_ms for changes and returns each watched file that
+    // changed once, however many events it produced
+    std::vector<std::string> poll(int timeout_ms)
+    {
+      std::unordered_set<std::string> changed;
+#ifdef __linux__
+      if (fd < 0)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+        return {};
+      }
+      pollfd descriptor = {fd, POLLIN, 0};
+      if (::poll(&descriptor, 1, timeout_ms) <= 0)
+        return {};
+
+      alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+      for (;;)
+      {
+        const ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0)
+          break;
+        for (ssize_t offset = 0; offset < length;)
+        {
+          const inotify_event *event = (const inotify_event *)(buffer + offset);
+          offset += sizeof(inotify_event) + event->len;
+          auto directory = directories.find(event->wd);
+          if (directory == directories.end() || event->len == 0)
+            continue;
+          const std::string file = (std::filesystem::path(directory->second) / event->name).generic_string();
+          if (files.count(file) != 0)
+            changed.insert(file);
+        }
+      }
+#else
+      std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+      for (auto &[file, timestamp] : timestamps)
+      {
+        std::error_code ec;
+        const auto current = std::filesystem::last_write_time(file, ec);
+        if (!ec && current != timestamp)
+        {
+          timestamp = current;
+          changed.insert(file);
+        }
+      }
+#endif
+      return std::vector<std::string>(changed.begin(), changed.end());
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hades
+{
+  // Read-only memory mapping of a whole file. The mapping stays valid for the
+  // lifetime of the object, so callers can hand out pointers straight into it.
+  class MappedFile
+  {
+  private:
+    const uint8_t *bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+  public:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept
+    {
+      *this = std::move(other);
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+      if (this != &other)
+      {
+        close();
+        std::swap(bytes, other.bytes);
+        std::swap(length, other.length);
+        std::swap(opened, other.opened);
+#ifdef _WIN32
+        std::swap(file, other.file);
+        std::swap(mapping, other.mapping);
+#endif
+      }
+      return *this;
+    }
+
+    ~MappedFile()
+    {
+      close();
+    }
+
+    bool open(const std::string &path)
+    {
+      close();
+#ifdef _WIN32
+      file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE)
+        return false;
+      LARGE_INTEGER file_size;
+      if (!GetFileSizeEx(file, &file_size))
+      {
+        close();
+        return false;
+      }
+      length = (size_t)file_size.QuadPart;
+      opened = true;
+      if (length == 0)
+        return true;
+      mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping == nullptr)
+      {
+        close();
+        return false;
+      }
+      bytes = (const uint8_t *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (bytes == nullptr)
+      {
+        close();
+        return false;
+      }
+#else
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+      struct stat st;
+      if (fstat(fd, &st) != 0)
+      {
+        ::close(fd);
+        return false;
+      }
+      length = (size_t)st.st_size;
+      if (length > 0)
+      {
+        void *ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+          ::close(fd);
+          length = 0;
+          return false;
+        }
+        bytes = (const uint8_t *)ptr;
+      }
+      // The mapping keeps its own reference to the file
+      ::close(fd);
+      opened = true;
+#endif
+      return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+      if (bytes)
+        UnmapViewOfFile(bytes);
+      if (mapping)
+        CloseHandle(mapping);
+      if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+      mapping = nullptr;
+      file = INVALID_HANDLE_VALUE;
+#else
+      if (bytes)
+        munmap((void *)bytes, length);
+#endif
+      bytes = nullptr;
+      length = 0;
+      opened = false;
+    }
+
+    bool is_open() const { return opened; }
+    const uint8_t *data() const { return bytes; }
+    size_t size() const { return length; }
+  };
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hades
+{
+  // Counts outstanding jobs of a batch. JobSystem::wait() returns once it hits zero.
+  struct JobCounter
+  {
+    std::atomic<uint32_t> pending{0};
+  };
+
+  // Fixed pool of worker threads pulling jobs from one shared queue. Threads
+  // that wait on a counter run queued jobs instead of sleeping, so nested
+  // parallel work cannot deadlock the pool.
+  class JobSystem
+  {
+  private:
+    struct Job
+    {
+      std::function<void()> function;
+      JobCounter *counter;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Job> queue;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    bool stopping = false;
+
+    static uint32_t &thread_slot()
+    {
+      static thread_local uint32_t slot = 0;
+      return slot;
+    }
+
+    bool try_run_one()
+    {
+      Job job;
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (queue.empty())
+          return false;
+        job = std::move(queue.front());
+        queue.pop_front();
+      }
+      job.function();
+      job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+
+    void worker_main(uint32_t slot)
+    {
+      thread_slot() = slot;
+      for (;;)
+      {
+        Job job;
+        {
+          std::unique_lock<std::mutex> lock(queue_mutex);
+          queue_cv.wait(lock, [this]
+                        { return stopping || !queue.empty(); });
+          if (queue.empty())
+            return;
+          job = std::move(queue.front());
+          queue.pop_front();
+        }
+        job.function();
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+      }
+    }
+
+  public:
+    // worker_count == 0 picks one worker per hardware thread minus the caller
+    explicit JobSystem(uint32_t worker_count = 0)
+    {
+      if (worker_count == 0)
+      {
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        worker_count = hardware > 1 ? hardware - 1 : 1;
+      }
+      for (uint32_t i = 0; i < worker_count; i++)
+        workers.emplace_back(&JobSystem::worker_main, this, i + 1);
+    }
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    ~JobSystem()
+    {
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+      }
+      queue_cv.notify_all();
+      for (auto &worker : workers)
+        worker.join();
+    }
+
+    // Process-wide pool used by the asset pipeline
+    static JobSystem &get()
+    {
+      static JobSystem instance;
+      return instance;
+    }
+
+    uint32_t worker_count() const { return (uint32_t)workers.size(); }
+
+    // Number of distinct values thread_index() can return; size per-thread buffers with this
+    uint32_t thread_count() const { return (uint32_t)workers.size() + 1; }
+
+    // 1..worker_count() on pool workers, 0 on any other thread
+    static uint32_t thread_index() { return thread_slot(); }
+
+    void run(std::function<void()> function, JobCounter &counter)
+    {
+      counter.pending.fetch_add(1, std::memory_order_relaxed);
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        queue.push_back(Job{std::move(function), &counter});
+      }
+      queue_cv.notify_one();
+    }
+
+    void wait(JobCounter &counter)
+    {
+      while (counter.pending.load(std::memory_order_acquire) != 0)
+      {
+        if (!try_run_one())
+          std::this_thread::yield();
+      }
+    }
+
+    // Calls function(begin, end) over [0, count) in batches of at most batch_size and waits for all of them
+    void parallel_for(uint32_t count, uint32_t batch_size, const std::function<void(uint32_t, uint32_t)> &function)
+    {
+      if (count == 0)
+        return;
+      batch_size = std::max(batch_size, 1u);
+      JobCounter counter;
+      for (uint32_t begin = 0; begin < count; begin += batch_size)
+      {
+        const uint32_t end = std::min(count, begin + batch_size);
+        run([&function, begin, end]
+            { function(begin, end); },
+            counter);
+      }
+      wait(counter);
+    }
+  };
+}
+
+#endif
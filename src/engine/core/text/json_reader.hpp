@@ -0,0 +1,283 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "number_parser.hpp"
+
+namespace hades
+{
+  enum JsonType
+  {
+    JSON_INVALID,
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT,
+  };
+
+  // Maximum nesting accepted by JsonValue::parse(); deeper documents are rejected
+  constexpr int JSON_MAX_DEPTH = 64;
+
+  inline const char *json_skip_whitespace(const char *p, const char *end)
+  {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+      p++;
+    return p;
+  }
+
+  // Returns the end of the string starting at the opening quote, or nullptr
+  inline const char *json_skip_string(const char *p, const char *end)
+  {
+    for (p++; p < end; p++)
+    {
+      if (*p == '\\')
+        p++;
+      else if (*p == '"')
+        return p + 1;
+      else if ((unsigned char)*p < 0x20)
+        return nullptr;
+    }
+    return nullptr;
+  }
+
+  // Returns the end of the value starting at p (no leading whitespace), or
+  // nullptr if it is malformed
+  inline const char *json_skip_value(const char *p, const char *end, int depth = 0)
+  {
+    if (p >= end || depth > JSON_MAX_DEPTH)
+      return nullptr;
+    switch (*p)
+    {
+    case '"':
+      return json_skip_string(p, end);
+    case '{':
+    case '[':
+    {
+      const bool object = *p == '{';
+      const char close = object ? '}' : ']';
+      p = json_skip_whitespace(p + 1, end);
+      if (p < end && *p == close)
+        return p + 1;
+      for (;;)
+      {
+        if (object)
+        {
+          if (p >= end || *p != '"' || (p = json_skip_string(p, end)) == nullptr)
+            return nullptr;
+          p = json_skip_whitespace(p, end);
+          if (p >= end || *p != ':')
+            return nullptr;
+          p = json_skip_whitespace(p + 1, end);
+        }
+        if ((p = json_skip_value(p, end, depth + 1)) == nullptr)
+          return nullptr;
+        p = json_skip_whitespace(p, end);
+        if (p < end && *p == ',')
+        {
+          p = json_skip_whitespace(p + 1, end);
+          continue;
+        }
+        return p < end && *p == close ? p + 1 : nullptr;
+      }
+    }
+    case 't':
+      return end - p >= 4 && memcmp(p, "true", 4) == 0 ? p + 4 : nullptr;
+    case 'f':
+      return end - p >= 5 && memcmp(p, "false", 5) == 0 ? p + 5 : nullptr;
+    case 'n':
+      return end - p >= 4 && memcmp(p, "null", 4) == 0 ? p + 4 : nullptr;
+    default:
+    {
+      float ignored;
+      const char *cursor = p;
+      return (*p == '-' || is_digit(*p)) && parse_float(cursor, end, ignored) ? cursor : nullptr;
+    }
+    }
+  }
+
+  // A view of one value inside a JSON document. Nothing is copied or
+  // allocated: lookups walk the source text on demand, so iterate arrays
+  // with begin()/end() rather than indexing them in a loop.
+  class JsonValue
+  {
+  private:
+    const char *first = nullptr;
+    const char *last = nullptr;
+
+    JsonValue(const char *first, const char *last) : first(first), last(last) {}
+
+  public:
+    JsonValue() = default;
+
+    // Validates the whole document once; the returned root is invalid on error
+    static JsonValue parse(const char *text, size_t length)
+    {
+      const char *end = text + length;
+      const char *begin = json_skip_whitespace(text, end);
+      const char *value_end = json_skip_value(begin, end);
+      if (value_end == nullptr || json_skip_whitespace(value_end, end) != end)
+        return JsonValue();
+      return JsonValue(begin, value_end);
+    }
+
+    JsonType type() const
+    {
+      if (first == nullptr)
+        return JSON_INVALID;
+      switch (*first)
+      {
+      case '{':
+        return JSON_OBJECT;
+      case '[':
+        return JSON_ARRAY;
+      case '"':
+        return JSON_STRING;
+      case 't':
+      case 'f':
+        return JSON_BOOL;
+      case 'n':
+        return JSON_NULL;
+      default:
+        return JSON_NUMBER;
+      }
+    }
+
+    bool valid() const { return first != nullptr; }
+    bool is_object() const { return type() == JSON_OBJECT; }
+    bool is_array() const { return type() == JSON_ARRAY; }
+    bool is_number() const { return type() == JSON_NUMBER; }
+    bool is_string() const { return type() == JSON_STRING; }
+
+    // Raw source text of the value
+    std::string_view text() const { return std::string_view(first, (size_t)(last - first)); }
+
+    class Iterator
+    {
+    private:
+      const char *cursor;
+      const char *end;
+      bool object;
+
+      // Start of the value of the element at cursor, skipping an object key
+      const char *value_start() const
+      {
+        if (!object)
+          return cursor;
+        const char *p = json_skip_string(cursor, end);
+        return json_skip_whitespace(json_skip_whitespace(p, end) + 1, end);
+      }
+
+    public:
+      Iterator(const char *cursor, const char *end, bool object) : cursor(cursor), end(end), object(object) {}
+
+      // Member name of an object element, escapes left as written
+      std::string_view key() const
+      {
+        const char *key_end = json_skip_string(cursor, end);
+        return std::string_view(cursor + 1, (size_t)(key_end - cursor - 2));
+      }
+
+      JsonValue value() const
+      {
+        const char *start = value_start();
+        return JsonValue(start, json_skip_value(start, end));
+      }
+
+      JsonValue operator*() const { return value(); }
+
+      Iterator &operator++()
+      {
+        const char *p = json_skip_whitespace(json_skip_value(value_start(), end), end);
+        cursor = *p == ',' ? json_skip_whitespace(p + 1, end) : p;
+        return *this;
+      }
+
+      bool operator!=(const Iterator &other) const { return cursor != other.cursor; }
+    };
+
+    // Elements of an array or members of an object; empty for anything else
+    Iterator begin() const
+    {
+      if (type() != JSON_ARRAY && type() != JSON_OBJECT)
+        return Iterator(last, last, false);
+      return Iterator(json_skip_whitespace(first + 1, last), last, type() == JSON_OBJECT);
+    }
+
+    Iterator end() const
+    {
+      if (type() != JSON_ARRAY && type() != JSON_OBJECT)
+        return Iterator(last, last, false);
+      return Iterator(last - 1, last, type() == JSON_OBJECT);
+    }
+
+    size_t size() const
+    {
+      size_t count = 0;
+      for (Iterator it = begin(); it != end(); ++it)
+        count++;
+      return count;
+    }
+
+    // Object member by name, invalid if absent. Keys are compared as written.
+    JsonValue operator[](std::string_view key) const
+    {
+      if (type() != JSON_OBJECT)
+        return JsonValue();
+      for (Iterator it = begin(); it != end(); ++it)
+        if (it.key() == key)
+          return it.value();
+      return JsonValue();
+    }
+
+    // Array element by position, invalid if out of range
+    JsonValue operator[](size_t index) const
+    {
+      if (type() != JSON_ARRAY)
+        return JsonValue();
+      for (Iterator it = begin(); it != end(); ++it)
+        if (index-- == 0)
+          return it.value();
+      return JsonValue();
+    }
+
+    float as_float(float fallback = 0.0f) const
+    {
+      const char *cursor = first;
+      float value;
+      if (type() != JSON_NUMBER || !parse_float(cursor, last, value))
+        return fallback;
+      return value;
+    }
+
+    uint64_t as_uint(uint64_t fallback = 0) const
+    {
+      const char *cursor = first;
+      int64_t integer;
+      if (type() != JSON_NUMBER || !parse_int(cursor, last, integer) || integer < 0)
+        return fallback;
+      return (uint64_t)integer;
+    }
+
+    bool as_bool(bool fallback = false) const
+    {
+      const JsonType t = type();
+      return t == JSON_BOOL ? *first == 't' : fallback;
+    }
+
+    // String contents without the quotes; escape sequences are not decoded
+    std::string_view as_string(std::string_view fallback = std::string_view()) const
+    {
+      if (type() != JSON_STRING)
+        return fallback;
+      return std::string_view(first + 1, (size_t)(last - first - 2));
+    }
+  };
+}
+
+#endif
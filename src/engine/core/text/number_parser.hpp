@@ -0,0 +1,137 @@
+#ifndef NUMBER_PARSER_H
+#define NUMBER_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace hades
+{
+  inline bool is_digit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  // Parses a signed decimal integer at cursor and advances past it. Values
+  // out of range saturate to INT64_MIN or INT64_MAX.
+  inline bool parse_int(const char *&cursor, const char *end, int64_t &out)
+  {
+    const char *p = cursor;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      negative = *p++ == '-';
+    if (p == end || !is_digit(*p))
+      return false;
+    const uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t value = 0;
+    while (p < end && is_digit(*p))
+    {
+      const uint64_t digit = (uint64_t)(*p++ - '0');
+      value = value > (limit - digit) / 10 ? limit : value * 10 + digit;
+    }
+    if (negative)
+      out = value == limit ? INT64_MIN : -(int64_t)value;
+    else
+      out = (int64_t)value;
+    cursor = p;
+    return true;
+  }
+
+  // Parses a decimal float at cursor and advances past it. Numbers with at
+  // most 19 significant digits and a small exponent take Clinger's fast path:
+  // an exact integer mantissa scaled by an exact power of ten is correctly
+  // rounded in double precision. Everything else falls back to strtod.
+  inline bool parse_float(const char *&cursor, const char *end, float &out)
+  {
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char *p = cursor;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      negative = *p++ == '-';
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    while (p < end && is_digit(*p))
+    {
+      any_digit = true;
+      if (digits < 19)
+      {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        if (mantissa != 0)
+          digits++;
+      }
+      else
+      {
+        exponent++;
+        digits++;
+      }
+      p++;
+    }
+    if (p < end && *p == '.')
+    {
+      p++;
+      while (p < end && is_digit(*p))
+      {
+        any_digit = true;
+        if (digits < 19)
+        {
+          mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+          exponent--;
+          if (mantissa != 0)
+            digits++;
+        }
+        else
+        {
+          digits++;
+        }
+        p++;
+      }
+    }
+
+    if (any_digit && p < end && (*p == 'e' || *p == 'E'))
+    {
+      const char *exponent_start = p + 1;
+      int64_t value;
+      if (parse_int(exponent_start, end, value))
+      {
+        exponent += (int)(value > 10000 ? 10000 : value < -10000 ? -10000 : value);
+        p = exponent_start;
+      }
+    }
+
+    if (any_digit && digits <= 19 && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+    {
+      double value = (double)mantissa;
+      value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+      out = (float)(negative ? -value : value);
+      cursor = p;
+      return true;
+    }
+
+    // Slow path: long mantissas, large exponents, inf and nan
+    char buffer[64];
+    const char *token_end = cursor;
+    while (token_end < end && token_end - cursor < (ptrdiff_t)sizeof(buffer) - 1 && *token_end != ' ' && *token_end != '\t' &&
+           *token_end != '\r' && *token_end != '\n' && *token_end != '/')
+      token_end++;
+    const size_t length = (size_t)(token_end - cursor);
+    if (length == 0)
+      return false;
+    memcpy(buffer, cursor, length);
+    buffer[length] = '\0';
+    char *parsed_end;
+    const double value = strtod(buffer, &parsed_end);
+    if (parsed_end == buffer)
+      return false;
+    out = (float)value;
+    cursor += parsed_end - buffer;
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef PAK_H
+#define PAK_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../compression/lz.hpp"
+#include "../hash/hash.hpp"
+#include "../io/mapped_file.hpp"
+#include "../jobs/job_system.hpp"
+
+// Pak archive (.hpak)
+//
+// [PakHeader][PakEntry x entry_count][PakBlock x block_count][names][payloads...]
+//
+// Entries are sorted by path hash so lookups are a binary search over the
+// mapped table. A stored entry is one contiguous payload that is handed out
+// as a pointer into the mapping. A compressed entry is split into
+// PAK_BLOCK_SIZE blocks that are compressed independently, so large files
+// decode in parallel and a block that does not shrink is kept raw.
+namespace hades
+{
+  namespace vfs
+  {
+    constexpr uint32_t PAK_MAGIC = 0x4b415048; // "HPAK"
+    constexpr uint32_t PAK_VERSION = 2; // 2: path hashes moved from FNV-1a to hash64
+    constexpr uint32_t PAK_BLOCK_SIZE = 64 * 1024;
+    constexpr uint64_t PAK_ALIGNMENT = 16;
+
+    enum PakEntryFlags : uint32_t
+    {
+      PAK_ENTRY_COMPRESSED = 1,
+    };
+
+    struct PakHeader
+    {
+      uint32_t magic;
+      uint32_t version;
+      uint64_t file_size;
+      uint32_t entry_count;
+      uint32_t block_count;
+      uint32_t block_size;
+      uint32_t names_size;
+      uint64_t names_offset;
+    };
+
+    struct PakEntry
+    {
+      uint64_t path_hash;
+      uint64_t size;   // Decoded size
+      uint64_t offset; // Payload offset for stored entries
+      uint32_t flags;  // PakEntryFlags
+      uint32_t first_block; // Compressed entries: first of ceil(size / block_size) blocks
+      uint32_t name_offset; // Into the name table; names are not null terminated
+      uint32_t name_length;
+    };
+
+    struct PakBlock
+    {
+      uint64_t offset;
+      uint32_t compressed_size; // Equal to the decoded size when the block is stored raw
+      uint32_t reserved;
+    };
+
+    static_assert(std::is_trivially_copyable<PakHeader>::value, "PakHeader must be trivially copyable");
+    static_assert(sizeof(PakHeader) == 40, "PakHeader layout changed");
+    static_assert(sizeof(PakEntry) == 40, "PakEntry layout changed");
+    static_assert(sizeof(PakBlock) == 16, "PakBlock layout changed");
+
+    // Archive paths are relative, use forward slashes and are case sensitive
+    inline std::string normalize_path(std::string_view path)
+    {
+      std::string normalized(path);
+      std::replace(normalized.begin(), normalized.end(), '\\', '/');
+      size_t start = 0;
+      while (start < normalized.size() && normalized[start] == '/')
+        start++;
+      if (normalized.compare(start, 2, "./") == 0)
+        start += 2;
+      return normalized.substr(start);
+    }
+
+    inline uint64_t path_hash(std::string_view normalized_path)
+    {
+      return hash64(normalized_path);
+    }
+
+    // Read-only view of a mapped pak archive
+    class PakArchive
+    {
+    private:
+      MappedFile file;
+      const PakHeader *header_ptr = nullptr;
+      const PakEntry *entry_ptr = nullptr;
+      const PakBlock *block_ptr = nullptr;
+      const char *name_ptr = nullptr;
+
+      // Only fits in 32 bits once open() checked it against the block table
+      uint64_t block_count_of(const PakEntry &entry) const
+      {
+        return entry.size / header_ptr->block_size + (entry.size % header_ptr->block_size != 0);
+      }
+
+      bool decode_block(const PakEntry &entry, uint32_t index, uint8_t *out) const
+      {
+        const PakBlock &block = block_ptr[entry.first_block + index];
+        const uint64_t begin = (uint64_t)index * header_ptr->block_size;
+        const size_t size = (size_t)std::min<uint64_t>(header_ptr->block_size, entry.size - begin);
+        if (block.compressed_size == size)
+        {
+          memcpy(out + begin, file.data() + block.offset, size);
+          return true;
+        }
+        return lz_decompress(file.data() + block.offset, block.compressed_size, out + begin, size);
+      }
+
+    public:
+      static std::optional<PakArchive> open(const std::string &path)
+      {
+        PakArchive pak;
+        if (!pak.file.open(path) || pak.file.size() < sizeof(PakHeader))
+          return std::nullopt;
+
+        pak.header_ptr = (const PakHeader *)pak.file.data();
+        const PakHeader &header = *pak.header_ptr;
+        const uint64_t file_size = pak.file.size();
+        if (header.magic != PAK_MAGIC || header.version != PAK_VERSION || header.file_size != file_size || header.block_size == 0)
+          return std::nullopt;
+        const uint64_t tables_end = sizeof(PakHeader) + sizeof(PakEntry) * (uint64_t)header.entry_count + sizeof(PakBlock) * (uint64_t)header.block_count;
+        if (tables_end > file_size || header.names_offset < tables_end || header.names_offset + header.names_size > file_size)
+          return std::nullopt;
+
+        pak.entry_ptr = (const PakEntry *)(pak.file.data() + sizeof(PakHeader));
+        pak.block_ptr = (const PakBlock *)(pak.entry_ptr + header.entry_count);
+        pak.name_ptr = (const char *)pak.file.data() + header.names_offset;
+
+        for (uint32_t i = 0; i < header.block_count; i++)
+        {
+          const PakBlock &block = pak.block_ptr[i];
+          if (block.compressed_size > header.block_size || block.offset > file_size || block.compressed_size > file_size - block.offset)
+            return std::nullopt;
+        }
+        for (uint32_t i = 0; i < header.entry_count; i++)
+        {
+          const PakEntry &entry = pak.entry_ptr[i];
+          if (i > 0 && pak.entry_ptr[i - 1].path_hash >= entry.path_hash)
+            return std::nullopt; // Unsorted or duplicate hashes
+          if ((uint64_t)entry.name_offset + entry.name_length > header.names_size)
+            return std::nullopt;
+          if (entry.flags & PAK_ENTRY_COMPRESSED)
+          {
+            if (entry.first_block > header.block_count || pak.block_count_of(entry) > header.block_count - entry.first_block)
+              return std::nullopt;
+          }
+          else if (entry.offset > file_size || entry.size > file_size - entry.offset)
+          {
+            return std::nullopt;
+          }
+        }
+        return pak;
+      }
+
+      uint32_t entry_count() const { return header_ptr->entry_count; }
+      const PakEntry &entry(uint32_t index) const { return entry_ptr[index]; }
+
+      std::string_view name(const PakEntry &entry) const
+      {
+        return std::string_view(name_ptr + entry.name_offset, entry.name_length);
+      }
+
+      const PakEntry *find(std::string_view path) const
+      {
+        const std::string normalized = normalize_path(path);
+        const uint64_t hash = path_hash(normalized);
+        const PakEntry *end = entry_ptr + header_ptr->entry_count;
+        const PakEntry *found = std::lower_bound(entry_ptr, end, hash, [](const PakEntry &entry, uint64_t value)
+                                                 { return entry.path_hash < value; });
+        if (found == end || found->path_hash != hash || name(*found) != normalized)
+          return nullptr;
+        return found;
+      }
+
+      // Pointer into the mapping for stored entries; nullptr when compressed
+      const uint8_t *view(const PakEntry &entry) const
+      {
+        if (entry.flags & PAK_ENTRY_COMPRESSED)
+          return nullptr;
+        return file.data() + entry.offset;
+      }
+
+      // Decodes an entry into out (entry.size bytes). Entries with several
+      // blocks are decoded in parallel on jobs.
+      bool read(const PakEntry &entry, uint8_t *out, JobSystem &jobs = JobSystem::get()) const
+      {
+        if (const uint8_t *stored = view(entry))
+        {
+          memcpy(out, stored, (size_t)entry.size);
+          return true;
+        }
+        const uint32_t blocks = (uint32_t)block_count_of(entry);
+        if (blocks <= 1)
+          return blocks == 0 || decode_block(entry, 0, out);
+
+        std::atomic<bool> ok{true};
+        jobs.parallel_for(blocks, 4, [&](uint32_t begin, uint32_t end)
+                          {
+                            for (uint32_t i = begin; i < end; i++)
+                              if (!decode_block(entry, i, out))
+                                ok.store(false, std::memory_order_relaxed); });
+        return ok.load();
+      }
+
+      size_t size_bytes() const { return file.size(); }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef PAK_BUILDER_H
+#define PAK_BUILDER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "pak.hpp"
+#include "../compression/lz.hpp"
+#include "../io/atomic_file.hpp"
+#include "../io/mapped_file.hpp"
+#include "../jobs/job_system.hpp"
+
+namespace hades
+{
+  namespace vfs
+  {
+    struct PakBuildReport
+    {
+      uint32_t files = 0;
+      uint32_t stored = 0; // Kept uncompressed and served zero-copy
+      uint64_t raw_bytes = 0;
+      uint64_t payload_bytes = 0;
+    };
+
+    // Collects files in memory and lays them out as a pak archive
+    class PakBuilder
+    {
+    private:
+      struct Input
+      {
+        std::string name;
+        uint64_t hash;
+        std::vector<uint8_t> bytes;
+        bool compress;
+      };
+      std::vector<Input> inputs;
+      std::unordered_set<uint64_t> hashes;
+
+    public:
+      // Returns false when the path (or another path with the same hash) was already added
+      bool add(std::string_view path, std::vector<uint8_t> bytes, bool compress = true)
+      {
+        std::string name = normalize_path(path);
+        const uint64_t hash = path_hash(name);
+        if (!hashes.insert(hash).second)
+          return false;
+        inputs.push_back(Input{std::move(name), hash, std::move(bytes), compress});
+        return true;
+      }
+
+      bool add_file(const std::string &disk_path, std::string_view archive_path, bool compress = true)
+      {
+        MappedFile file;
+        if (!file.open(disk_path))
+          return false;
+        return add(archive_path, std::vector<uint8_t>(file.data(), file.data() + file.size()), compress);
+      }
+
+      // Lays out the archive
+      bool build(std::vector<uint8_t> &bytes, PakBuildReport *report = nullptr, JobSystem &jobs = JobSystem::get())
+      {
+        std::sort(inputs.begin(), inputs.end(), [](const Input &a, const Input &b)
+                  { return a.hash < b.hash; });
+
+        // Compress every block of every compressible input in parallel
+        struct PendingBlock
+        {
+          uint32_t input;
+          uint64_t begin;
+          uint32_t size;
+          std::vector<uint8_t> compressed; // Empty when the block did not shrink
+        };
+        std::vector<PendingBlock> pending;
+        for (uint32_t i = 0; i < inputs.size(); i++)
+          if (inputs[i].compress)
+            for (uint64_t begin = 0; begin < inputs[i].bytes.size(); begin += PAK_BLOCK_SIZE)
+              pending.push_back(PendingBlock{i, begin, (uint32_t)std::min<uint64_t>(PAK_BLOCK_SIZE, inputs[i].bytes.size() - begin), {}});
+        jobs.parallel_for((uint32_t)pending.size(), 4, [&](uint32_t begin, uint32_t end)
+                          {
+                            for (uint32_t b = begin; b < end; b++)
+                            {
+                              PendingBlock &block = pending[b];
+                              block.compressed.resize(lz_compress_bound(block.size));
+                              const size_t size = lz_compress(inputs[block.input].bytes.data() + block.begin, block.size, block.compressed.data(), block.compressed.size());
+                              block.compressed.resize(size > 0 && size < block.size ? size : 0);
+                            } });
+
+        // Inputs that barely compress are stored whole so they can be read in place
+        std::vector<uint64_t> packed_size(inputs.size(), 0);
+        for (const PendingBlock &block : pending)
+          packed_size[block.input] += block.compressed.empty() ? block.size : block.compressed.size();
+        std::vector<bool> compressed(inputs.size(), false);
+        uint32_t block_count = 0;
+        for (uint32_t i = 0; i < inputs.size(); i++)
+        {
+          compressed[i] = inputs[i].compress && !inputs[i].bytes.empty() && packed_size[i] < inputs[i].bytes.size() - inputs[i].bytes.size() / 16;
+          if (compressed[i])
+            block_count += (uint32_t)((inputs[i].bytes.size() + PAK_BLOCK_SIZE - 1) / PAK_BLOCK_SIZE);
+        }
+
+        PakHeader header = {};
+        header.magic = PAK_MAGIC;
+        header.version = PAK_VERSION;
+        header.entry_count = (uint32_t)inputs.size();
+        header.block_count = block_count;
+        header.block_size = PAK_BLOCK_SIZE;
+        header.names_offset = sizeof(PakHeader) + sizeof(PakEntry) * (uint64_t)inputs.size() + sizeof(PakBlock) * (uint64_t)block_count;
+
+        std::vector<PakEntry> entries(inputs.size());
+        std::vector<PakBlock> blocks;
+        blocks.reserve(block_count);
+        std::string names;
+        for (uint32_t i = 0; i < inputs.size(); i++)
+        {
+          entries[i].path_hash = inputs[i].hash;
+          entries[i].size = inputs[i].bytes.size();
+          entries[i].name_offset = (uint32_t)names.size();
+          entries[i].name_length = (uint32_t)inputs[i].name.size();
+          names += inputs[i].name;
+        }
+        header.names_size = (uint32_t)names.size();
+
+        // Payloads follow the name table, stored entries aligned for in-place use
+        uint64_t offset = header.names_offset + names.size();
+        std::vector<std::pair<uint64_t, const uint8_t *>> copies; // Offset, source; sizes come from the tables
+        std::vector<uint64_t> copy_sizes;
+        size_t next_block = 0;
+        if (report != nullptr)
+          *report = PakBuildReport();
+        for (uint32_t i = 0; i < inputs.size(); i++)
+        {
+          PakEntry &entry = entries[i];
+          if (!compressed[i])
+          {
+            offset = (offset + PAK_ALIGNMENT - 1) & ~(PAK_ALIGNMENT - 1);
+            entry.offset = offset;
+            copies.emplace_back(offset, inputs[i].bytes.data());
+            copy_sizes.push_back(inputs[i].bytes.size());
+            offset += inputs[i].bytes.size();
+            if (report != nullptr)
+              report->stored++;
+            continue;
+          }
+          entry.flags = PAK_ENTRY_COMPRESSED;
+          entry.first_block = (uint32_t)blocks.size();
+          while (next_block < pending.size() && pending[next_block].input < i)
+            next_block++;
+          for (; next_block < pending.size() && pending[next_block].input == i; next_block++)
+          {
+            const PendingBlock &block = pending[next_block];
+            PakBlock out = {};
+            out.offset = offset;
+            if (block.compressed.empty())
+            {
+              out.compressed_size = block.size;
+              copies.emplace_back(offset, inputs[i].bytes.data() + block.begin);
+            }
+            else
+            {
+              out.compressed_size = (uint32_t)block.compressed.size();
+              copies.emplace_back(offset, block.compressed.data());
+            }
+            copy_sizes.push_back(out.compressed_size);
+            offset += out.compressed_size;
+            blocks.push_back(out);
+          }
+        }
+        header.file_size = offset;
+
+        bytes.assign(offset, 0);
+        memcpy(bytes.data(), &header, sizeof(header));
+        if (!entries.empty())
+          memcpy(bytes.data() + sizeof(header), entries.data(), sizeof(PakEntry) * entries.size());
+        if (!blocks.empty())
+          memcpy(bytes.data() + sizeof(header) + sizeof(PakEntry) * entries.size(), blocks.data(), sizeof(PakBlock) * blocks.size());
+        memcpy(bytes.data() + header.names_offset, names.data(), names.size());
+        for (size_t c = 0; c < copies.size(); c++)
+          if (copy_sizes[c] > 0)
+            memcpy(bytes.data() + copies[c].first, copies[c].second, copy_sizes[c]);
+
+        if (report != nullptr)
+        {
+          report->files = (uint32_t)inputs.size();
+          for (const Input &input : inputs)
+            report->raw_bytes += input.bytes.size();
+          report->payload_bytes = offset - header.names_offset - names.size();
+        }
+        return true;
+      }
+
+      bool write(const std::string &path, PakBuildReport *report = nullptr, JobSystem &jobs = JobSystem::get())
+      {
+        std::vector<uint8_t> bytes;
+        return build(bytes, report, jobs) && write_file_atomic(path, bytes);
+      }
+    };
+  }
+}
+
+#endif
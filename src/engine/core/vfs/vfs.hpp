@@ -0,0 +1,119 @@
+#ifndef VFS_H
+#define VFS_H
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pak.hpp"
+#include "../io/mapped_file.hpp"
+#include "../jobs/job_system.hpp"
+
+namespace hades
+{
+  namespace vfs
+  {
+    // Contents of a file read through the file system. Stored pak entries and
+    // loose files point straight into a mapping; compressed pak entries own
+    // their decoded bytes.
+    class File
+    {
+    private:
+      std::vector<uint8_t> owned;
+      MappedFile mapped;
+      const uint8_t *bytes = nullptr;
+      size_t length = 0;
+      bool in_place = false;
+
+      friend class FileSystem;
+
+    public:
+      const uint8_t *data() const { return bytes; }
+      size_t size() const { return length; }
+      bool zero_copy() const { return in_place; }
+      std::string_view text() const { return std::string_view((const char *)bytes, length); }
+    };
+
+    // Layers mounted pak archives and loose directories into one namespace of
+    // relative paths. Later mounts shadow earlier ones, so a patch archive or
+    // a development directory can override shipped content.
+    class FileSystem
+    {
+    private:
+      struct Mount
+      {
+        std::unique_ptr<PakArchive> pak;
+        std::string directory;
+      };
+      std::vector<Mount> mounts;
+
+    public:
+      bool mount_pak(const std::string &path)
+      {
+        auto pak = PakArchive::open(path);
+        if (!pak)
+          return false;
+        mounts.push_back(Mount{std::make_unique<PakArchive>(std::move(*pak)), std::string()});
+        return true;
+      }
+
+      void mount_directory(const std::string &path)
+      {
+        mounts.push_back(Mount{nullptr, path});
+      }
+
+      bool exists(std::string_view path) const
+      {
+        const std::string normalized = normalize_path(path);
+        for (auto mount = mounts.rbegin(); mount != mounts.rend(); ++mount)
+        {
+          if (mount->pak ? mount->pak->find(normalized) != nullptr : std::filesystem::is_regular_file(std::filesystem::path(mount->directory) / normalized))
+            return true;
+        }
+        return false;
+      }
+
+      std::optional<File> read(std::string_view path, JobSystem &jobs = JobSystem::get()) const
+      {
+        const std::string normalized = normalize_path(path);
+        for (auto mount = mounts.rbegin(); mount != mounts.rend(); ++mount)
+        {
+          File file;
+          if (mount->pak)
+          {
+            const PakEntry *entry = mount->pak->find(normalized);
+            if (entry == nullptr)
+              continue;
+            file.length = (size_t)entry->size;
+            if ((file.bytes = mount->pak->view(*entry)) != nullptr)
+            {
+              file.in_place = true;
+              return file;
+            }
+            file.owned.resize(file.length);
+            if (!mount->pak->read(*entry, file.owned.data(), jobs))
+              return std::nullopt; // Corrupt archive
+            file.bytes = file.owned.data();
+            return file;
+          }
+
+          const std::filesystem::path loose = std::filesystem::path(mount->directory) / normalized;
+          if (!std::filesystem::is_regular_file(loose))
+            continue;
+          if (!file.mapped.open(loose.string()))
+            return std::nullopt;
+          file.bytes = file.mapped.data();
+          file.length = file.mapped.size();
+          file.in_place = true;
+          return file;
+        }
+        return std::nullopt;
+      }
+    };
+  }
+}
+
+#endif
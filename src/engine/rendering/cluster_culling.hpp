@@ -0,0 +1,100 @@
+#ifndef CLUSTER_CULLING_H
+#define CLUSTER_CULLING_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../assets/mesh/hmesh.hpp"
+
+namespace hades
+{
+  // Six normalized planes (a, b, c, d) with a*x + b*y + c*z + d >= 0 inside
+  struct Frustum
+  {
+    float planes[6][4];
+  };
+
+  struct ClusterCullStats
+  {
+    uint32_t total = 0;
+    uint32_t backface_culled = 0;
+    uint32_t frustum_culled = 0;
+    uint32_t visible = 0;
+  };
+
+  // Extracts the frustum of a column-major clip matrix with Vulkan's [0, 1]
+  // depth range. Passing model-view-projection yields object space planes.
+  inline Frustum extract_frustum(const float *clip)
+  {
+    auto row = [clip](int r, int c)
+    { return clip[c * 4 + r]; };
+
+    Frustum frustum;
+    for (int c = 0; c < 4; c++)
+    {
+      frustum.planes[0][c] = row(3, c) + row(0, c); // Left
+      frustum.planes[1][c] = row(3, c) - row(0, c); // Right
+      frustum.planes[2][c] = row(3, c) + row(1, c); // Bottom
+      frustum.planes[3][c] = row(3, c) - row(1, c); // Top
+      frustum.planes[4][c] = row(2, c);             // Near
+      frustum.planes[5][c] = row(3, c) - row(2, c); // Far
+    }
+    for (auto &plane : frustum.planes)
+    {
+      const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+      if (length > 0.0f)
+        for (int c = 0; c < 4; c++)
+          plane[c] /= length;
+    }
+    return frustum;
+  }
+
+  inline bool sphere_in_frustum(const Frustum &frustum, const float *center, float radius)
+  {
+    for (const auto &plane : frustum.planes)
+      if (plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3] < -radius)
+        return false;
+    return true;
+  }
+
+  // True when every triangle of the cluster faces away from the camera
+  inline bool cluster_backfacing(const HMeshMeshlet &meshlet, const float *camera)
+  {
+    if (meshlet.cone_cutoff >= 1.0f)
+      return false;
+    const float view[3] = {meshlet.cone_apex[0] - camera[0], meshlet.cone_apex[1] - camera[1], meshlet.cone_apex[2] - camera[2]};
+    const float distance = std::sqrt(view[0] * view[0] + view[1] * view[1] + view[2] * view[2]);
+    const float along_axis = view[0] * meshlet.cone_axis[0] + view[1] * meshlet.cone_axis[1] + view[2] * meshlet.cone_axis[2];
+    return along_axis >= meshlet.cone_cutoff * distance;
+  }
+
+  // Appends the indices (relative to the submesh's first meshlet) of the
+  // clusters that survive cone and frustum tests to visible. The frustum and
+  // camera position must be in the mesh's object space.
+  inline ClusterCullStats cull_clusters(const MappedMesh &mesh, const HMeshSubmesh &submesh, const Frustum &frustum, const float *camera, std::vector<uint32_t> &visible)
+  {
+    ClusterCullStats stats;
+    const HMeshMeshlet *meshlets = mesh.submesh_meshlets(submesh);
+    for (uint32_t i = 0; i < submesh.meshlet_count; i++)
+    {
+      const HMeshMeshlet &meshlet = meshlets[i];
+      stats.total++;
+      if (cluster_backfacing(meshlet, camera))
+      {
+        stats.backface_culled++;
+        continue;
+      }
+      if (!sphere_in_frustum(frustum, meshlet.center, meshlet.radius))
+      {
+        stats.frustum_culled++;
+        continue;
+      }
+      stats.visible++;
+      visible.push_back(i);
+    }
+    return stats;
+  }
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace hades
+{
+  // Caps the frame rate by waiting out what is left of each frame's period.
+  // It sleeps while the deadline is further away than a sleep has been seen
+  // to take, then spins the rest, which alone is accurate to microseconds.
+  // Deadlines advance by whole periods so the rate does not drift; a frame
+  // that overran starts a new schedule instead of being caught up on.
+  class FrameLimiter
+  {
+  public:
+    using clock = std::chrono::steady_clock;
+
+  private:
+    clock::duration period = clock::duration::zero();
+    clock::time_point deadline;
+    // Longest a 1 ms sleep is expected to take; learned from past sleeps
+    static constexpr clock::duration INITIAL_SLEEP_COST = std::chrono::milliseconds(2);
+    clock::duration sleep_cost = INITIAL_SLEEP_COST;
+
+  public:
+    // Frames per second; zero or less disables the limit
+    void set_rate(double fps)
+    {
+      period = fps > 0.0 ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / fps)) : clock::duration::zero();
+      deadline = clock::now();
+    }
+
+    double rate() const { return period > clock::duration::zero() ? 1.0 / std::chrono::duration<double>(period).count() : 0.0; }
+
+    clock::duration sleep_estimate() const { return sleep_cost; }
+    void set_sleep_estimate(clock::duration cost) { sleep_cost = cost; }
+
+    // Blocks until the next frame may start; returns how long it waited
+    clock::duration wait()
+    {
+      const clock::time_point start = clock::now();
+      if (period == clock::duration::zero())
+        return clock::duration::zero();
+      deadline += period;
+      if (deadline < start)
+        deadline = start;
+
+      // One sleep stalled past the period (preemption, a resume) must not
+      // leave the estimate too high to ever sleep again and spin for good
+      const clock::duration max_cost = std::max<clock::duration>(period / 2, INITIAL_SLEEP_COST);
+      sleep_cost = std::min(sleep_cost, max_cost);
+
+      const clock::duration slice = std::chrono::milliseconds(1);
+      clock::time_point now = start;
+      while (deadline - now > sleep_cost)
+      {
+        std::this_thread::sleep_for(slice);
+        const clock::time_point woke = clock::now();
+        // Rise to the worst sleep at once, fall back slowly
+        const clock::duration took = woke - now;
+        sleep_cost = took > sleep_cost ? std::min(took, max_cost) : sleep_cost - (sleep_cost - took) / 16;
+        now = woke;
+      }
+      while (now < deadline)
+      {
+        std::this_thread::yield();
+        now = clock::now();
+      }
+      return now - start;
+    }
+  };
+
+  // Rolling statistics over the last WINDOW samples, in milliseconds
+  class LatencyTracker
+  {
+  public:
+    static constexpr uint32_t WINDOW = 128;
+
+  private:
+    double samples[WINDOW] = {};
+    uint32_t count = 0;
+    uint32_t next = 0;
+    double sum = 0.0;
+
+  public:
+    void add(double ms)
+    {
+      if (count == WINDOW)
+        sum -= samples[next];
+      else
+        count++;
+      samples[next] = ms;
+      sum += ms;
+      next = (next + 1) % WINDOW;
+    }
+
+    void clear()
+    {
+      count = next = 0;
+      sum = 0.0;
+    }
+
+    uint32_t size() const { return count; }
+    double average() const { return count > 0 ? sum / count : 0.0; }
+    double max() const { return count > 0 ? *std::max_element(samples, samples + count) : 0.0; }
+    double last() const { return count > 0 ? samples[(next + WINDOW - 1) % WINDOW] : 0.0; }
+  };
+}
+
+#endif
@@ -0,0 +1,529 @@
+#ifndef GPU_ALLOCATOR_H
+#define GPU_ALLOCATOR_H
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "tlsf.hpp"
+
+namespace hades::gpu
+{
+  enum MemoryUsage
+  {
+    MEMORY_USAGE_GPU_ONLY, // Device local; written by transfers and shaders
+    MEMORY_USAGE_UPLOAD,   // Host visible and coherent; written by the CPU, read once by the GPU
+    MEMORY_USAGE_READBACK, // Host visible, cached where possible; written by the GPU, read by the CPU
+  };
+
+  constexpr uint32_t DEDICATED_BLOCK = UINT32_MAX;
+
+  // A sub-range of a VkDeviceMemory. Plain value: copying it does not
+  // duplicate ownership, and it must be returned with Allocator::free exactly once.
+  struct Allocation
+  {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    void *mapped = nullptr; // Persistent mapping of offset, null unless host visible
+    uint32_t memory_type = 0;
+    uint32_t block = DEDICATED_BLOCK;
+    uint32_t node = Tlsf::INVALID;
+
+    explicit operator bool() const { return memory != VK_NULL_HANDLE; }
+  };
+
+  struct Buffer
+  {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    Allocation allocation;
+  };
+
+  struct Image
+  {
+    VkImage image = VK_NULL_HANDLE;
+    Allocation allocation;
+  };
+
+  struct AllocatorSettings
+  {
+    VkDeviceSize block_size = 64ull << 20;
+    VkDeviceSize dedicated_threshold = 32ull << 20; // Larger requests get their own VkDeviceMemory
+    uint32_t empty_blocks_kept = 1;                 // Per memory type, so alternating load and unload does not thrash
+  };
+
+  struct MemoryTypeStats
+  {
+    uint32_t blocks = 0;
+    uint32_t allocations = 0;
+    VkDeviceSize reserved = 0; // Bytes held in VkDeviceMemory
+    VkDeviceSize used = 0;     // Bytes handed out
+    VkDeviceSize largest_free = 0;
+  };
+
+  struct AllocatorStats
+  {
+    uint32_t device_allocations = 0; // Live vkAllocateMemory objects
+    uint32_t device_allocation_limit = 0;
+    uint32_t dedicated = 0;
+    uint32_t allocations = 0;
+    VkDeviceSize reserved = 0;
+    VkDeviceSize used = 0;
+    uint32_t memory_type_count = 0;
+    MemoryTypeStats types[VK_MAX_MEMORY_TYPES];
+  };
+
+  // An allocation the defragmenter wants relocated. The destination is
+  // already reserved; the owner copies the contents over, rebinds its
+  // resource to the destination (buffers and images have to be recreated
+  // for that) and hands the list back to finish_defragmentation once the
+  // copies have executed.
+  struct DefragmentationMove
+  {
+    Allocation source;
+    Allocation destination;
+    uint64_t user; // Tag passed to allocate, identifying the owning resource
+  };
+
+  // Device memory sub-allocator. Each memory type owns a list of large
+  // VkDeviceMemory blocks carved up by a TLSF allocator, so object counts
+  // stay far below maxMemoryAllocationCount. Host visible blocks are mapped
+  // once for their lifetime. Allocate and free are thread safe.
+  class Allocator
+  {
+  private:
+    struct Block
+    {
+      VkDeviceMemory memory = VK_NULL_HANDLE;
+      void *mapped = nullptr;
+      uint32_t memory_type = 0;
+      Tlsf ranges;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    const VkAllocationCallbacks *allocator = nullptr;
+    VkPhysicalDeviceMemoryProperties memory_properties = {};
+    VkDeviceSize buffer_image_granularity = 1;
+    VkDeviceSize non_coherent_atom = 1;
+    uint32_t allocation_limit = 0;
+    AllocatorSettings settings;
+    std::vector<Block> blocks; // Destroyed blocks leave a null slot for reuse
+    std::unordered_set<VkDeviceMemory> dedicated_memory;
+    VkDeviceSize dedicated_bytes = 0;
+    std::mutex mutex;
+
+    static VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    bool host_visible(uint32_t type) const
+    {
+      return (memory_properties.memoryTypes[type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    }
+
+    bool host_coherent(uint32_t type) const
+    {
+      return (memory_properties.memoryTypes[type].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    }
+
+    VkResult allocate_memory(uint32_t type, VkDeviceSize size, VkDeviceMemory &memory, void *&mapped)
+    {
+      VkMemoryAllocateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+      info.allocationSize = size;
+      info.memoryTypeIndex = type;
+      VkResult err = vkAllocateMemory(device, &info, allocator, &memory);
+      if (err != VK_SUCCESS)
+        return err;
+      mapped = nullptr;
+      if (host_visible(type))
+      {
+        err = vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+        if (err != VK_SUCCESS)
+        {
+          vkFreeMemory(device, memory, allocator);
+          memory = VK_NULL_HANDLE;
+        }
+      }
+      return err;
+    }
+
+    uint32_t create_block(uint32_t type, VkDeviceSize minimum)
+    {
+      // Start at the configured size, capped to a slice of the heap, and
+      // halve on failure while the request still fits
+      const VkDeviceSize heap = memory_properties.memoryHeaps[memory_properties.memoryTypes[type].heapIndex].size;
+      VkDeviceSize size = std::max(std::min(settings.block_size, heap / 8), minimum);
+      Block block;
+      block.memory_type = type;
+      while (allocate_memory(type, size, block.memory, block.mapped) != VK_SUCCESS)
+      {
+        if (size / 2 < minimum)
+          return UINT32_MAX;
+        size /= 2;
+      }
+      block.ranges.reset(size);
+
+      for (uint32_t i = 0; i < blocks.size(); i++)
+        if (blocks[i].memory == VK_NULL_HANDLE)
+        {
+          blocks[i] = std::move(block);
+          return i;
+        }
+      blocks.push_back(std::move(block));
+      return (uint32_t)blocks.size() - 1;
+    }
+
+    void destroy_block(uint32_t index)
+    {
+      vkFreeMemory(device, blocks[index].memory, allocator); // Implicitly unmaps
+      blocks[index] = Block();
+    }
+
+    bool sub_allocate(uint32_t index, VkDeviceSize size, VkDeviceSize alignment, uint64_t user, Allocation &out)
+    {
+      Block &block = blocks[index];
+      const Tlsf::Range range = block.ranges.allocate(size, alignment, user);
+      if (!range.valid())
+        return false;
+      out.memory = block.memory;
+      out.offset = range.offset;
+      out.size = range.size;
+      out.mapped = block.mapped != nullptr ? (uint8_t *)block.mapped + range.offset : nullptr;
+      out.memory_type = block.memory_type;
+      out.block = index;
+      out.node = range.node;
+      return true;
+    }
+
+    VkResult allocate_from_type(uint32_t type, VkDeviceSize size, VkDeviceSize alignment, bool dedicated, uint64_t user, Allocation &out)
+    {
+      if (dedicated || size > settings.dedicated_threshold)
+      {
+        Allocation allocation;
+        const VkResult err = allocate_memory(type, size, allocation.memory, allocation.mapped);
+        if (err != VK_SUCCESS)
+          return err;
+        allocation.size = size;
+        allocation.memory_type = type;
+        out = allocation;
+        dedicated_memory.insert(allocation.memory);
+        dedicated_bytes += size;
+        return VK_SUCCESS;
+      }
+
+      for (uint32_t i = 0; i < blocks.size(); i++)
+        if (blocks[i].memory != VK_NULL_HANDLE && blocks[i].memory_type == type && sub_allocate(i, size, alignment, user, out))
+          return VK_SUCCESS;
+      const uint32_t index = create_block(type, size);
+      if (index == UINT32_MAX)
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+      return sub_allocate(index, size, alignment, user, out) ? VK_SUCCESS : VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    void release(const Allocation &allocation)
+    {
+      if (allocation.block == DEDICATED_BLOCK)
+      {
+        vkFreeMemory(device, allocation.memory, allocator);
+        dedicated_memory.erase(allocation.memory);
+        dedicated_bytes -= allocation.size;
+        return;
+      }
+      Block &block = blocks[allocation.block];
+      block.ranges.free(allocation.node);
+      if (!block.ranges.empty())
+        return;
+      uint32_t empty = 0;
+      for (const Block &other : blocks)
+        if (other.memory != VK_NULL_HANDLE && other.memory_type == block.memory_type && other.ranges.empty())
+          empty++;
+      if (empty > settings.empty_blocks_kept)
+        destroy_block(allocation.block);
+    }
+
+  public:
+    Allocator() = default;
+    Allocator(const Allocator &) = delete;
+    Allocator &operator=(const Allocator &) = delete;
+
+    // Picks the memory type for a usage among those allowed by type_bits.
+    // Required flags must all be present; among the candidates the type with
+    // the most preferred and fewest unwanted flags wins, earliest on ties.
+    static uint32_t find_memory_type(const VkPhysicalDeviceMemoryProperties &properties, uint32_t type_bits, MemoryUsage usage)
+    {
+      VkMemoryPropertyFlags required = 0, preferred = 0, unwanted = 0;
+      switch (usage)
+      {
+      case MEMORY_USAGE_GPU_ONLY:
+        preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        unwanted = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        break;
+      case MEMORY_USAGE_UPLOAD:
+        required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        unwanted = VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT; // Leave the BAR window to streaming
+        break;
+      case MEMORY_USAGE_READBACK:
+        required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        preferred = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        break;
+      }
+      unwanted |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT;
+
+      uint32_t best = UINT32_MAX;
+      int best_score = -1000;
+      for (uint32_t i = 0; i < properties.memoryTypeCount; i++)
+      {
+        const VkMemoryPropertyFlags flags = properties.memoryTypes[i].propertyFlags;
+        if (!(type_bits & (1u << i)) || (flags & required) != required)
+          continue;
+        const int score = (int)std::bitset<32>(flags & preferred).count() - (int)std::bitset<32>(flags & unwanted).count();
+        if (score > best_score)
+        {
+          best = i;
+          best_score = score;
+        }
+      }
+      return best;
+    }
+
+    void init(VkPhysicalDevice physical_device, VkDevice device, const VkAllocationCallbacks *allocator, AllocatorSettings settings = AllocatorSettings())
+    {
+      this->device = device;
+      this->allocator = allocator;
+      this->settings = settings;
+      vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
+      VkPhysicalDeviceProperties properties;
+      vkGetPhysicalDeviceProperties(physical_device, &properties);
+      buffer_image_granularity = properties.limits.bufferImageGranularity;
+      non_coherent_atom = properties.limits.nonCoherentAtomSize;
+      allocation_limit = properties.limits.maxMemoryAllocationCount;
+    }
+
+    // Frees every block and dedicated allocation. Outstanding allocations
+    // become invalid.
+    void destroy()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (uint32_t i = 0; i < blocks.size(); i++)
+        if (blocks[i].memory != VK_NULL_HANDLE)
+          destroy_block(i);
+      blocks.clear();
+      for (VkDeviceMemory memory : dedicated_memory)
+        vkFreeMemory(device, memory, allocator);
+      dedicated_memory.clear();
+      dedicated_bytes = 0;
+    }
+
+    // linear is false for optimally tiled images. Those are padded out to
+    // bufferImageGranularity on both ends so they never share a page with a
+    // buffer in the same block. user tags the allocation for defragmentation;
+    // zero means it must not be moved.
+    VkResult allocate(const VkMemoryRequirements &requirements, MemoryUsage usage, bool linear, Allocation &out, bool dedicated = false, uint64_t user = 0)
+    {
+      VkDeviceSize size = requirements.size;
+      VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+      if (!linear && buffer_image_granularity > 1)
+      {
+        alignment = std::max(alignment, buffer_image_granularity);
+        size = align_up(size, buffer_image_granularity);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      uint32_t type_bits = requirements.memoryTypeBits;
+      VkResult err = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+      // Fall back to the next best type when a heap is exhausted
+      for (uint32_t type; (type = find_memory_type(memory_properties, type_bits, usage)) != UINT32_MAX; type_bits &= ~(1u << type))
+      {
+        VkDeviceSize type_size = size, type_alignment = alignment;
+        if (host_visible(type) && !host_coherent(type))
+        {
+          // Keep flush and invalidate ranges from touching a neighbour
+          type_alignment = std::max(type_alignment, non_coherent_atom);
+          type_size = align_up(type_size, non_coherent_atom);
+        }
+        err = allocate_from_type(type, type_size, type_alignment, dedicated, user, out);
+        if (err == VK_SUCCESS)
+          return err;
+      }
+      return err;
+    }
+
+    void free(Allocation &allocation)
+    {
+      if (!allocation)
+        return;
+      std::lock_guard<std::mutex> lock(mutex);
+      release(allocation);
+      allocation = Allocation();
+    }
+
+    VkResult create_buffer(const VkBufferCreateInfo &info, MemoryUsage usage, Buffer &out, uint64_t user = 0)
+    {
+      VkResult err = vkCreateBuffer(device, &info, allocator, &out.buffer);
+      if (err != VK_SUCCESS)
+        return err;
+      VkMemoryRequirements requirements;
+      vkGetBufferMemoryRequirements(device, out.buffer, &requirements);
+      err = allocate(requirements, usage, true, out.allocation, false, user);
+      if (err == VK_SUCCESS)
+        err = vkBindBufferMemory(device, out.buffer, out.allocation.memory, out.allocation.offset);
+      if (err != VK_SUCCESS)
+        destroy_buffer(out);
+      return err;
+    }
+
+    VkResult create_image(const VkImageCreateInfo &info, MemoryUsage usage, Image &out, uint64_t user = 0)
+    {
+      VkResult err = vkCreateImage(device, &info, allocator, &out.image);
+      if (err != VK_SUCCESS)
+        return err;
+      VkMemoryRequirements requirements;
+      vkGetImageMemoryRequirements(device, out.image, &requirements);
+      err = allocate(requirements, usage, info.tiling == VK_IMAGE_TILING_LINEAR, out.allocation, false, user);
+      if (err == VK_SUCCESS)
+        err = vkBindImageMemory(device, out.image, out.allocation.memory, out.allocation.offset);
+      if (err != VK_SUCCESS)
+        destroy_image(out);
+      return err;
+    }
+
+    void destroy_buffer(Buffer &buffer)
+    {
+      if (buffer.buffer != VK_NULL_HANDLE)
+        vkDestroyBuffer(device, buffer.buffer, allocator);
+      buffer.buffer = VK_NULL_HANDLE;
+      free(buffer.allocation);
+    }
+
+    void destroy_image(Image &image)
+    {
+      if (image.image != VK_NULL_HANDLE)
+        vkDestroyImage(device, image.image, allocator);
+      image.image = VK_NULL_HANDLE;
+      free(image.allocation);
+    }
+
+    // Needed after CPU writes to non-coherent memory (only READBACK may pick such a type)
+    VkResult flush(const Allocation &allocation)
+    {
+      if (host_coherent(allocation.memory_type))
+        return VK_SUCCESS;
+      VkMappedMemoryRange range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, allocation.memory, allocation.offset, allocation.size};
+      return vkFlushMappedMemoryRanges(device, 1, &range);
+    }
+
+    // Needed before CPU reads of GPU writes in non-coherent memory
+    VkResult invalidate(const Allocation &allocation)
+    {
+      if (host_coherent(allocation.memory_type))
+        return VK_SUCCESS;
+      VkMappedMemoryRange range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, allocation.memory, allocation.offset, allocation.size};
+      return vkInvalidateMappedMemoryRanges(device, 1, &range);
+    }
+
+    // Plans moving tagged allocations out of the emptiest blocks of each
+    // memory type into free space in fuller ones, up to max_bytes. Blocks
+    // drained this way are released by finish_defragmentation.
+    std::vector<DefragmentationMove> begin_defragmentation(VkDeviceSize max_bytes)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::vector<DefragmentationMove> moves;
+      std::vector<uint32_t> order;
+      for (uint32_t i = 0; i < blocks.size(); i++)
+        if (blocks[i].memory != VK_NULL_HANDLE && !blocks[i].ranges.empty())
+          order.push_back(i);
+      std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                { return blocks[a].ranges.used_bytes() < blocks[b].ranges.used_bytes(); });
+
+      VkDeviceSize moved = 0;
+      std::vector<bool> receiving(blocks.size(), false); // Blocks holding new destinations are not drained in the same pass
+      for (size_t source = 0; source < order.size() && moved < max_bytes; source++)
+      {
+        const uint32_t from = order[source];
+        if (receiving[from])
+          continue;
+        std::vector<std::pair<Tlsf::Range, uint64_t>> live;
+        blocks[from].ranges.for_each_allocation([&](const Tlsf::Range &range, uint64_t user)
+                                                { live.emplace_back(range, user); });
+        for (const auto &entry : live)
+        {
+          const Tlsf::Range &range = entry.first;
+          if (entry.second == 0 || moved + range.size > max_bytes)
+            continue;
+          // The largest power of two dividing the old offset satisfies the
+          // original alignment, whatever it was
+          const VkDeviceSize alignment = range.offset == 0 ? 65536 : (range.offset & (~range.offset + 1));
+          // Only fuller blocks are destinations, so blocks drain from the emptiest up
+          for (size_t target = order.size(); target-- > source + 1;)
+          {
+            const uint32_t to = order[target];
+            if (blocks[to].memory_type != blocks[from].memory_type)
+              continue;
+            DefragmentationMove move;
+            if (!sub_allocate(to, range.size, std::min<VkDeviceSize>(alignment, 65536), entry.second, move.destination))
+              continue;
+            move.source.memory = blocks[from].memory;
+            move.source.offset = range.offset;
+            move.source.size = range.size;
+            move.source.mapped = blocks[from].mapped != nullptr ? (uint8_t *)blocks[from].mapped + range.offset : nullptr;
+            move.source.memory_type = blocks[from].memory_type;
+            move.source.block = from;
+            move.source.node = range.node;
+            move.user = entry.second;
+            moves.push_back(move);
+            moved += range.size;
+            receiving[to] = true;
+            break;
+          }
+        }
+      }
+      return moves;
+    }
+
+    void finish_defragmentation(const std::vector<DefragmentationMove> &moves)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const DefragmentationMove &move : moves)
+        release(move.source);
+    }
+
+    AllocatorStats stats()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      AllocatorStats stats;
+      stats.memory_type_count = memory_properties.memoryTypeCount;
+      stats.device_allocation_limit = allocation_limit;
+      stats.dedicated = (uint32_t)dedicated_memory.size();
+      stats.device_allocations = stats.dedicated;
+      stats.allocations = stats.dedicated;
+      stats.reserved = stats.used = dedicated_bytes;
+      for (const Block &block : blocks)
+      {
+        if (block.memory == VK_NULL_HANDLE)
+          continue;
+        const Tlsf::Stats ranges = block.ranges.stats();
+        MemoryTypeStats &type = stats.types[block.memory_type];
+        type.blocks++;
+        type.allocations += ranges.allocations;
+        type.reserved += ranges.capacity;
+        type.used += ranges.used;
+        type.largest_free = std::max(type.largest_free, ranges.largest_free);
+        stats.device_allocations++;
+        stats.allocations += ranges.allocations;
+        stats.reserved += ranges.capacity;
+        stats.used += ranges.used;
+      }
+      return stats;
+    }
+
+    const VkPhysicalDeviceMemoryProperties &properties() const { return memory_properties; }
+  };
+}
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef GPU_ASSET_RESIDENCY_H
+#define GPU_ASSET_RESIDENCY_H
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "asset_upload.hpp"
+
+namespace hades::gpu
+{
+  struct AssetResidencyStats
+  {
+    uint32_t meshes = 0;   // Uploaded and usable
+    uint32_t textures = 0;
+    uint32_t uploading = 0; // Staged, copy not yet complete
+    uint32_t deferred = 0;  // Did not fit this frame's upload budget
+    VkDeviceSize bytes = 0;
+  };
+
+  // GPU copies of the cooked assets the application holds. Each sync()
+  // finalizes what is new by copying it from the cooked file mapping straight
+  // into the staging ring, re-uploads assets whose source hash changed after a
+  // hot reload, and releases copies of assets no longer listed. Released
+  // copies are destroyed once their upload completed and the last frame that
+  // could use them retired, following the end_frame/retire frame serials.
+  class AssetResidency
+  {
+  private:
+    template <typename T>
+    struct Resident
+    {
+      uint64_t source_hash = 0;
+      T gpu;
+      bool listed = false;
+    };
+
+    struct Released
+    {
+      GpuMesh mesh;
+      GpuTexture texture;
+      uint64_t frame = 0;
+    };
+
+    Allocator *allocator = nullptr;
+    UploadQueue *uploads = nullptr;
+    VkDevice device = VK_NULL_HANDLE;
+    const VkAllocationCallbacks *callbacks = nullptr;
+    std::unordered_map<const MappedMesh *, Resident<GpuMesh>> meshes;
+    std::unordered_map<const MappedTexture *, Resident<GpuTexture>> textures;
+    std::vector<Released> released; // Since the last end_frame, or upload still running
+    std::deque<Released> pending;   // Ordered by frame
+    uint32_t deferred = 0;
+
+    void destroy_released(Released &copy)
+    {
+      destroy_gpu_mesh(*allocator, copy.mesh);
+      destroy_gpu_texture(*allocator, device, callbacks, copy.texture);
+    }
+
+    template <typename Asset, typename T, typename Create>
+    void sync_type(std::unordered_map<const Asset *, Resident<T>> &residents, const std::vector<const Asset *> &assets, Create create)
+    {
+      for (auto &entry : residents)
+        entry.second.listed = false;
+      for (const Asset *asset : assets)
+      {
+        if (asset == nullptr)
+          continue;
+        auto found = residents.find(asset);
+        if (found != residents.end() && found->second.source_hash == asset->source_hash())
+        {
+          found->second.listed = true;
+          continue;
+        }
+        T gpu;
+        if (!create(*asset, gpu))
+        {
+          // The old copy, if any, stays usable until the new one fits
+          if (found != residents.end())
+            found->second.listed = true;
+          deferred++;
+          continue;
+        }
+        Resident<T> &resident = residents[asset];
+        if (found != residents.end())
+          release(resident.gpu);
+        resident.source_hash = asset->source_hash();
+        resident.gpu = gpu;
+        resident.listed = true;
+      }
+      for (auto it = residents.begin(); it != residents.end();)
+        if (!it->second.listed)
+        {
+          release(it->second.gpu);
+          it = residents.erase(it);
+        }
+        else
+          ++it;
+    }
+
+    void release(const GpuMesh &mesh)
+    {
+      Released copy;
+      copy.mesh = mesh;
+      released.push_back(copy);
+    }
+
+    void release(const GpuTexture &texture)
+    {
+      Released copy;
+      copy.texture = texture;
+      released.push_back(copy);
+    }
+
+    static uint64_t ticket_of(const Released &copy) { return copy.mesh.ticket != 0 ? copy.mesh.ticket : copy.texture.ticket; }
+
+  public:
+    void init(Allocator &allocator, UploadQueue &uploads, VkDevice device, const VkAllocationCallbacks *callbacks)
+    {
+      this->allocator = &allocator;
+      this->uploads = &uploads;
+      this->device = device;
+      this->callbacks = callbacks;
+    }
+
+    // Call once per frame, before recording, with every asset the frame may draw
+    void sync(const std::vector<const MappedMesh *> &mesh_assets, const std::vector<const MappedTexture *> &texture_assets)
+    {
+      deferred = 0;
+      sync_type(meshes, mesh_assets, [this](const MappedMesh &mesh, GpuMesh &out)
+                { return create_gpu_mesh(*allocator, *uploads, mesh, out); });
+      sync_type(textures, texture_assets, [this](const MappedTexture &texture, GpuTexture &out)
+                { return create_gpu_texture(*allocator, device, callbacks, *uploads, texture, out); });
+    }
+
+    // Null until the asset's upload completed
+    const GpuMesh *mesh(const MappedMesh &asset)
+    {
+      auto found = meshes.find(&asset);
+      return found != meshes.end() && uploads->complete(found->second.gpu.ticket) ? &found->second.gpu : nullptr;
+    }
+
+    const GpuTexture *texture(const MappedTexture &asset)
+    {
+      auto found = textures.find(&asset);
+      return found != textures.end() && uploads->complete(found->second.gpu.ticket) ? &found->second.gpu : nullptr;
+    }
+
+    // Copies released since the last call belong to frame, a serial that
+    // increases by frame. A copy whose upload is still running waits for a
+    // later frame, so its transfer is never acquired after it is destroyed.
+    void end_frame(uint64_t frame)
+    {
+      size_t kept = 0;
+      for (Released &copy : released)
+      {
+        if (uploads->complete(ticket_of(copy)))
+        {
+          copy.frame = frame;
+          pending.push_back(copy);
+        }
+        else
+          released[kept++] = copy;
+      }
+      released.resize(kept);
+    }
+
+    // Destroys copies released up to frame; its fence must have signalled
+    void retire(uint64_t frame)
+    {
+      while (!pending.empty() && pending.front().frame <= frame)
+      {
+        destroy_released(pending.front());
+        pending.pop_front();
+      }
+    }
+
+    // The device must be idle
+    void destroy()
+    {
+      if (allocator == nullptr)
+        return;
+      for (auto &entry : meshes)
+        destroy_gpu_mesh(*allocator, entry.second.gpu);
+      for (auto &entry : textures)
+        destroy_gpu_texture(*allocator, device, callbacks, entry.second.gpu);
+      for (Released &copy : released)
+        destroy_released(copy);
+      for (Released &copy : pending)
+        destroy_released(copy);
+      meshes.clear();
+      textures.clear();
+      released.clear();
+      pending.clear();
+    }
+
+    AssetResidencyStats stats()
+    {
+      AssetResidencyStats stats;
+      for (auto &entry : meshes)
+        if (uploads->complete(entry.second.gpu.ticket))
+        {
+          stats.meshes++;
+          stats.bytes += entry.second.gpu.buffer.allocation.size;
+        }
+        else
+          stats.uploading++;
+      for (auto &entry : textures)
+        if (uploads->complete(entry.second.gpu.ticket))
+        {
+          stats.textures++;
+          stats.bytes += entry.second.gpu.image.allocation.size;
+        }
+        else
+          stats.uploading++;
+      stats.deferred = deferred;
+      return stats;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef GPU_ASSET_UPLOAD_H
+#define GPU_ASSET_UPLOAD_H
+
+#include <cstdint>
+#include <cstring>
+#include <vulkan/vulkan.h>
+
+#include "../../assets/mesh/hmesh.hpp"
+#include "../../assets/texture/htex.hpp"
+#include "../htex_format.hpp"
+#include "allocator.hpp"
+#include "upload_queue.hpp"
+
+namespace hades::gpu
+{
+  // Vertices followed by indices in one device local buffer
+  struct GpuMesh
+  {
+    Buffer buffer;
+    VkDeviceSize index_offset = 0;
+    uint64_t ticket = 0; // Usable once uploads.complete(ticket)
+  };
+
+  struct GpuTexture
+  {
+    Image image;
+    VkImageView view = VK_NULL_HANDLE;
+    uint64_t ticket = 0;
+  };
+
+  inline void destroy_gpu_mesh(Allocator &allocator, GpuMesh &mesh)
+  {
+    allocator.destroy_buffer(mesh.buffer);
+    mesh = GpuMesh();
+  }
+
+  inline void destroy_gpu_texture(Allocator &allocator, VkDevice device, const VkAllocationCallbacks *callbacks, GpuTexture &texture)
+  {
+    if (texture.view != VK_NULL_HANDLE)
+      vkDestroyImageView(device, texture.view, callbacks);
+    allocator.destroy_image(texture.image);
+    texture = GpuTexture();
+  }
+
+  // Copies a cooked mesh from its mapping into the staging ring and records
+  // the transfer. Returns false, with nothing left allocated, when the upload
+  // queue has no room this frame; try again after the next flush.
+  inline bool create_gpu_mesh(Allocator &allocator, UploadQueue &uploads, const MappedMesh &mesh, GpuMesh &out)
+  {
+    const void *vertices = mesh.vertices() != nullptr ? (const void *)mesh.vertices() : (const void *)mesh.quantized_vertices();
+    const VkDeviceSize vertex_bytes = (VkDeviceSize)mesh.vertex_count() * mesh.header().vertex_stride;
+    const VkDeviceSize index_offset = (vertex_bytes + 15) & ~15ull;
+    const VkDeviceSize size = index_offset + mesh.index_size_bytes();
+
+    VkDeviceSize staging_offset;
+    uint8_t *staging = (uint8_t *)uploads.stage(size, 16, staging_offset);
+    if (staging == nullptr)
+      return false;
+    memcpy(staging, vertices, vertex_bytes);
+    memcpy(staging + index_offset, mesh.index_data(), mesh.index_size_bytes());
+
+    VkBufferCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size = size;
+    info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if (allocator.create_buffer(info, MEMORY_USAGE_GPU_ONLY, out.buffer) != VK_SUCCESS)
+    {
+      uploads.cancel_stage();
+      return false;
+    }
+    out.index_offset = index_offset;
+    out.ticket = uploads.copy_to_buffer(staging_offset, out.buffer.buffer, 0, size);
+    return true;
+  }
+
+  // Uploads every mip of a cooked texture into a new sampled image. Mips are
+  // packed into the ring at 16 byte alignment, which suits every htex format.
+  inline bool create_gpu_texture(Allocator &allocator, VkDevice device, const VkAllocationCallbacks *callbacks, UploadQueue &uploads,
+                                 const MappedTexture &texture, GpuTexture &out)
+  {
+    VkBufferImageCopy regions[HTEX_MAX_MIPS];
+    const uint32_t region_count = htex_copy_regions(texture, 0, regions);
+    VkDeviceSize size = 0;
+    for (uint32_t level = 0; level < region_count; level++)
+    {
+      regions[level].bufferOffset = size;
+      size += (texture.mip(level).size + 15) & ~15ull;
+    }
+
+    VkDeviceSize staging_offset;
+    uint8_t *staging = (uint8_t *)uploads.stage(size, 16, staging_offset);
+    if (staging == nullptr)
+      return false;
+    for (uint32_t level = 0; level < region_count; level++)
+    {
+      memcpy(staging + regions[level].bufferOffset, texture.mip_data(level), texture.mip(level).size);
+      regions[level].bufferOffset += staging_offset;
+    }
+
+    VkImageCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    info.imageType = VK_IMAGE_TYPE_2D;
+    info.format = htex_vk_format(texture);
+    info.extent = {texture.width(), texture.height(), 1};
+    info.mipLevels = texture.mip_count();
+    info.arrayLayers = 1;
+    info.samples = VK_SAMPLE_COUNT_1_BIT;
+    info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (allocator.create_image(info, MEMORY_USAGE_GPU_ONLY, out.image) != VK_SUCCESS)
+    {
+      uploads.cancel_stage();
+      return false;
+    }
+
+    VkImageViewCreateInfo view_info = {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = out.image.image;
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = info.format;
+    view_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, info.mipLevels, 0, 1};
+    if (vkCreateImageView(device, &view_info, callbacks, &out.view) != VK_SUCCESS)
+    {
+      out.view = VK_NULL_HANDLE;
+      destroy_gpu_texture(allocator, device, callbacks, out);
+      uploads.cancel_stage();
+      return false;
+    }
+    out.ticket = uploads.copy_to_image(out.image.image, info.mipLevels, regions, region_count);
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,415 @@
+#ifndef GPU_DESCRIPTOR_HEAP_H
+#define GPU_DESCRIPTOR_HEAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace hades::gpu
+{
+  // Index into a descriptor heap's array; what draws hand to shaders in
+  // place of a descriptor set
+  typedef uint32_t DescriptorHandle;
+  const DescriptorHandle INVALID_DESCRIPTOR_HANDLE = UINT32_MAX;
+
+  struct DescriptorIndexingSupport
+  {
+    bool supported = false;
+    // Only the features a DescriptorHeap needs; chain into VkDeviceCreateInfo
+    // together with the extensions below
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT features = {};
+    uint32_t max_sampled_images = 0;
+    uint32_t max_combined_image_samplers = 0; // Count against both the sampler and sampled image limits
+    uint32_t max_storage_buffers = 0;
+  };
+
+  const char *const DESCRIPTOR_INDEXING_EXTENSIONS[] = {VK_KHR_MAINTENANCE3_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME};
+
+  // Whether the device can back a DescriptorHeap. The instance must have
+  // VK_KHR_get_physical_device_properties2 enabled.
+  inline DescriptorIndexingSupport query_descriptor_indexing(VkInstance instance, VkPhysicalDevice physical_device)
+  {
+    DescriptorIndexingSupport support;
+    uint32_t count = 0;
+    vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> extensions(count);
+    vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &count, extensions.data());
+    for (const char *name : DESCRIPTOR_INDEXING_EXTENSIONS)
+      if (std::none_of(extensions.begin(), extensions.end(), [name](const VkExtensionProperties &e)
+                       { return strcmp(e.extensionName, name) == 0; }))
+        return support;
+
+    auto get_features = (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR");
+    auto get_properties = (PFN_vkGetPhysicalDeviceProperties2KHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR");
+    if (get_features == nullptr || get_properties == nullptr)
+      return support;
+
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    VkPhysicalDeviceFeatures2KHR features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+    features2.pNext = &features;
+    get_features(physical_device, &features2);
+    if (!features.runtimeDescriptorArray || !features.descriptorBindingPartiallyBound || !features.descriptorBindingVariableDescriptorCount ||
+        !features.descriptorBindingSampledImageUpdateAfterBind || !features.descriptorBindingStorageBufferUpdateAfterBind ||
+        !features.shaderSampledImageArrayNonUniformIndexing)
+      return support;
+
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT properties = {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+    VkPhysicalDeviceProperties2KHR properties2 = {};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+    properties2.pNext = &properties;
+    get_properties(physical_device, &properties2);
+
+    support.supported = true;
+    support.features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    support.features.runtimeDescriptorArray = VK_TRUE;
+    support.features.descriptorBindingPartiallyBound = VK_TRUE;
+    support.features.descriptorBindingVariableDescriptorCount = VK_TRUE;
+    support.features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    support.features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    support.features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    const uint32_t max_resources = properties.maxPerStageUpdateAfterBindResources;
+    support.max_sampled_images = std::min({properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                           properties.maxDescriptorSetUpdateAfterBindSampledImages, max_resources});
+    support.max_combined_image_samplers = std::min({support.max_sampled_images, properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                                    properties.maxDescriptorSetUpdateAfterBindSamplers});
+    support.max_storage_buffers = std::min({properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+                                            properties.maxDescriptorSetUpdateAfterBindStorageBuffers, max_resources});
+    return support;
+  }
+
+  // Free list of heap indices. A released index is not handed out again
+  // until the frame that released it has finished on the GPU, since
+  // commands already recorded may still read the old descriptor.
+  class DescriptorHandles
+  {
+  private:
+    std::vector<DescriptorHandle> free_list;
+    std::vector<DescriptorHandle> released; // Since the last end_frame
+    std::deque<std::pair<uint64_t, DescriptorHandle>> pending; // Ordered by frame
+    uint32_t next = 0;
+    uint32_t capacity = 0;
+
+  public:
+    void reset(uint32_t new_capacity)
+    {
+      free_list.clear();
+      released.clear();
+      pending.clear();
+      next = 0;
+      capacity = new_capacity;
+    }
+
+    // Raises the capacity; existing handles stay valid
+    void grow(uint32_t new_capacity) { capacity = std::max(capacity, new_capacity); }
+
+    DescriptorHandle allocate()
+    {
+      if (!free_list.empty())
+      {
+        const DescriptorHandle handle = free_list.back();
+        free_list.pop_back();
+        return handle;
+      }
+      return next < capacity ? next++ : INVALID_DESCRIPTOR_HANDLE;
+    }
+
+    void release(DescriptorHandle handle) { released.push_back(handle); }
+
+    // Everything released since the last call belongs to frame, a serial
+    // that increases with every submit
+    void end_frame(uint64_t frame)
+    {
+      for (DescriptorHandle handle : released)
+        pending.emplace_back(frame, handle);
+      released.clear();
+    }
+
+    // Makes handles released up to and including frame reusable
+    void retire(uint64_t frame)
+    {
+      while (!pending.empty() && pending.front().first <= frame)
+      {
+        free_list.push_back(pending.front().second);
+        pending.pop_front();
+      }
+    }
+
+    uint32_t size() const { return capacity; }
+    // Handles not yet reusable, counting those waiting on the GPU
+    uint32_t live() const { return next - (uint32_t)free_list.size(); }
+  };
+
+  // One large descriptor array that every draw indexes into, built on
+  // VK_EXT_descriptor_indexing. The set is allocated update-after-bind and
+  // partially bound, so descriptors are written the moment a resource is
+  // created, even while the set is bound in frames still executing, and
+  // only the slots a shader reads have to be valid. It is bound once per
+  // command buffer; draws pass handles through push constants or instance
+  // data instead of binding a set each.
+  //
+  // The layout declares max_capacity descriptors as a variable count, while
+  // the set holds only what is needed. When the handles run out a set twice
+  // the size is allocated, the written descriptors are copied over and the
+  // old pool is destroyed once the frames using it have finished. The
+  // layout never changes, so pipelines built against it stay valid; only
+  // set() does. Render thread only.
+  class DescriptorHeap
+  {
+  private:
+    VkDevice device = VK_NULL_HANDLE;
+    const VkAllocationCallbacks *callbacks = nullptr;
+    VkDescriptorType descriptor_type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    uint32_t max_capacity = 0;
+    VkDescriptorSetLayout set_layout = VK_NULL_HANDLE;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkDescriptorSet heap_set = VK_NULL_HANDLE;
+    DescriptorHandles handles;
+    std::vector<bool> written;
+    std::vector<VkDescriptorPool> replaced; // Since the last end_frame
+    std::deque<std::pair<uint64_t, VkDescriptorPool>> retired; // Ordered by frame
+
+    VkResult allocate_set(uint32_t capacity, VkDescriptorPool &out_pool, VkDescriptorSet &out_set)
+    {
+      VkDescriptorPoolSize size = {descriptor_type, capacity};
+      VkDescriptorPoolCreateInfo pool_info = {};
+      pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+      pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+      pool_info.maxSets = 1;
+      pool_info.poolSizeCount = 1;
+      pool_info.pPoolSizes = &size;
+      VkResult err = vkCreateDescriptorPool(device, &pool_info, callbacks, &out_pool);
+      if (err != VK_SUCCESS)
+        return err;
+
+      VkDescriptorSetVariableDescriptorCountAllocateInfoEXT count_info = {};
+      count_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT;
+      count_info.descriptorSetCount = 1;
+      count_info.pDescriptorCounts = &capacity;
+      VkDescriptorSetAllocateInfo set_info = {};
+      set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      set_info.pNext = &count_info;
+      set_info.descriptorPool = out_pool;
+      set_info.descriptorSetCount = 1;
+      set_info.pSetLayouts = &set_layout;
+      err = vkAllocateDescriptorSets(device, &set_info, &out_set);
+      if (err != VK_SUCCESS)
+      {
+        vkDestroyDescriptorPool(device, out_pool, callbacks);
+        out_pool = VK_NULL_HANDLE;
+      }
+      return err;
+    }
+
+    bool grow()
+    {
+      const uint32_t capacity = handles.size();
+      const uint32_t new_capacity = std::min(max_capacity, std::max(capacity * 2, 64u));
+      if (new_capacity <= capacity)
+        return false;
+      VkDescriptorPool new_pool;
+      VkDescriptorSet new_set;
+      if (allocate_set(new_capacity, new_pool, new_set) != VK_SUCCESS)
+        return false;
+
+      // Copy runs of written descriptors; free slots may point at destroyed resources
+      std::vector<VkCopyDescriptorSet> copies;
+      for (uint32_t i = 0; i < capacity;)
+      {
+        if (!written[i])
+        {
+          i++;
+          continue;
+        }
+        uint32_t end = i;
+        while (end < capacity && written[end])
+          end++;
+        VkCopyDescriptorSet copy = {};
+        copy.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+        copy.srcSet = heap_set;
+        copy.srcArrayElement = i;
+        copy.dstSet = new_set;
+        copy.dstArrayElement = i;
+        copy.descriptorCount = end - i;
+        copies.push_back(copy);
+        i = end;
+      }
+      if (!copies.empty())
+        vkUpdateDescriptorSets(device, 0, nullptr, (uint32_t)copies.size(), copies.data());
+
+      replaced.push_back(pool);
+      pool = new_pool;
+      heap_set = new_set;
+      handles.grow(new_capacity);
+      written.resize(new_capacity, false);
+      return true;
+    }
+
+    void write(DescriptorHandle handle, const VkDescriptorImageInfo *image, const VkDescriptorBufferInfo *buffer)
+    {
+      VkWriteDescriptorSet write = {};
+      write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      write.dstSet = heap_set;
+      write.dstArrayElement = handle;
+      write.descriptorCount = 1;
+      write.descriptorType = descriptor_type;
+      write.pImageInfo = image;
+      write.pBufferInfo = buffer;
+      vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+      written[handle] = true;
+    }
+
+  public:
+    DescriptorHeap() = default;
+    DescriptorHeap(const DescriptorHeap &) = delete;
+    DescriptorHeap &operator=(const DescriptorHeap &) = delete;
+
+    // type is COMBINED_IMAGE_SAMPLER, SAMPLED_IMAGE or STORAGE_BUFFER, the
+    // types query_descriptor_indexing checks update-after-bind for.
+    // max_capacity must be within the matching DescriptorIndexingSupport limit.
+    VkResult init(VkDevice device, const VkAllocationCallbacks *callbacks, VkDescriptorType type, uint32_t initial_capacity,
+                  uint32_t max_capacity, VkShaderStageFlags stages = VK_SHADER_STAGE_ALL)
+    {
+      this->device = device;
+      this->callbacks = callbacks;
+      descriptor_type = type;
+      this->max_capacity = max_capacity;
+      initial_capacity = std::min(initial_capacity, max_capacity);
+
+      VkDescriptorSetLayoutBinding binding = {};
+      binding.binding = 0;
+      binding.descriptorType = type;
+      binding.descriptorCount = max_capacity;
+      binding.stageFlags = stages;
+      const VkDescriptorBindingFlagsEXT binding_flags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+                                                        VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT;
+      VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flags_info = {};
+      flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+      flags_info.bindingCount = 1;
+      flags_info.pBindingFlags = &binding_flags;
+      VkDescriptorSetLayoutCreateInfo layout_info = {};
+      layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+      layout_info.pNext = &flags_info;
+      layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+      layout_info.bindingCount = 1;
+      layout_info.pBindings = &binding;
+      VkResult err = vkCreateDescriptorSetLayout(device, &layout_info, callbacks, &set_layout);
+      if (err != VK_SUCCESS)
+        return err;
+
+      err = allocate_set(initial_capacity, pool, heap_set);
+      if (err != VK_SUCCESS)
+      {
+        vkDestroyDescriptorSetLayout(device, set_layout, callbacks);
+        set_layout = VK_NULL_HANDLE;
+        return err;
+      }
+      handles.reset(initial_capacity);
+      written.assign(initial_capacity, false);
+      return VK_SUCCESS;
+    }
+
+    void destroy()
+    {
+      if (device == VK_NULL_HANDLE)
+        return;
+      for (VkDescriptorPool old : replaced)
+        vkDestroyDescriptorPool(device, old, callbacks);
+      for (auto &old : retired)
+        vkDestroyDescriptorPool(device, old.second, callbacks);
+      replaced.clear();
+      retired.clear();
+      vkDestroyDescriptorPool(device, pool, callbacks);
+      vkDestroyDescriptorSetLayout(device, set_layout, callbacks);
+      pool = VK_NULL_HANDLE;
+      heap_set = VK_NULL_HANDLE;
+      set_layout = VK_NULL_HANDLE;
+      handles.reset(0);
+      written.clear();
+      device = VK_NULL_HANDLE;
+    }
+
+    // Returns INVALID_DESCRIPTOR_HANDLE once max_capacity handles are live
+    DescriptorHandle allocate()
+    {
+      DescriptorHandle handle = handles.allocate();
+      if (handle == INVALID_DESCRIPTOR_HANDLE && grow())
+        handle = handles.allocate();
+      return handle;
+    }
+
+    DescriptorHandle allocate_image(VkImageView view, VkImageLayout layout, VkSampler sampler = VK_NULL_HANDLE)
+    {
+      const DescriptorHandle handle = allocate();
+      if (handle != INVALID_DESCRIPTOR_HANDLE)
+        write_image(handle, view, layout, sampler);
+      return handle;
+    }
+
+    DescriptorHandle allocate_buffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE)
+    {
+      const DescriptorHandle handle = allocate();
+      if (handle != INVALID_DESCRIPTOR_HANDLE)
+        write_buffer(handle, buffer, offset, range);
+      return handle;
+    }
+
+    // Only for handles no submitted frame reads: freshly allocated ones, or
+    // ones released and allocated again
+    void write_image(DescriptorHandle handle, VkImageView view, VkImageLayout layout, VkSampler sampler = VK_NULL_HANDLE)
+    {
+      VkDescriptorImageInfo info = {sampler, view, layout};
+      write(handle, &info, nullptr);
+    }
+
+    void write_buffer(DescriptorHandle handle, VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE)
+    {
+      VkDescriptorBufferInfo info = {buffer, offset, range};
+      write(handle, nullptr, &info);
+    }
+
+    // The resource may be destroyed once the current frame has finished
+    void release(DescriptorHandle handle)
+    {
+      written[handle] = false;
+      handles.release(handle);
+    }
+
+    // Tags handles and sets released since the last call with frame. Call
+    // before submitting it.
+    void end_frame(uint64_t frame)
+    {
+      handles.end_frame(frame);
+      for (VkDescriptorPool old : replaced)
+        retired.emplace_back(frame, old);
+      replaced.clear();
+    }
+
+    // Recycles what frames up to and including frame released, once that
+    // frame's fence has signalled
+    void retire(uint64_t frame)
+    {
+      handles.retire(frame);
+      while (!retired.empty() && retired.front().first <= frame)
+      {
+        vkDestroyDescriptorPool(device, retired.front().second, callbacks);
+        retired.pop_front();
+      }
+    }
+
+    VkDescriptorSetLayout layout() const { return set_layout; }
+    // Changes when the heap grows; bind it at the start of every command buffer
+    VkDescriptorSet set() const { return heap_set; }
+    VkDescriptorType type() const { return descriptor_type; }
+    uint32_t capacity() const { return handles.size(); }
+    uint32_t live() const { return handles.live(); }
+  };
+}
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef GPU_FRAME_ALLOCATOR_H
+#define GPU_FRAME_ALLOCATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vulkan/vulkan.h>
+
+#include "allocator.hpp"
+
+namespace hades::gpu
+{
+  // Lock-free bump pointer over [0, capacity). Any number of threads may
+  // allocate at once; reset() must not race with them.
+  class BumpAllocator
+  {
+  private:
+    std::atomic<uint64_t> head{0};
+    uint64_t capacity = 0;
+
+  public:
+    explicit BumpAllocator(uint64_t capacity = 0) : capacity(capacity) {}
+
+    void reset(uint64_t new_capacity)
+    {
+      capacity = new_capacity;
+      head.store(0, std::memory_order_relaxed);
+    }
+
+    void reset() { head.store(0, std::memory_order_relaxed); }
+
+    // alignment must be a power of two
+    bool allocate(uint64_t size, uint64_t alignment, uint64_t &offset)
+    {
+      uint64_t current = head.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        const uint64_t start = (current + alignment - 1) & ~(alignment - 1);
+        if (start + size > capacity)
+          return false;
+        // On failure current is reloaded and the alignment redone
+        if (head.compare_exchange_weak(current, start + size, std::memory_order_relaxed))
+        {
+          offset = start;
+          return true;
+        }
+      }
+    }
+
+    uint64_t used() const { return std::min(head.load(std::memory_order_relaxed), capacity); }
+    uint64_t size() const { return capacity; }
+  };
+
+  // Sub-range of the frame allocator's buffer. offset is what goes into
+  // pDynamicOffsets for a descriptor bound at offset zero.
+  struct FrameAllocation
+  {
+    void *data = nullptr;
+    uint32_t offset = 0;
+  };
+
+  struct FrameAllocatorStats
+  {
+    VkDeviceSize used = 0;     // In the frame being recorded
+    VkDeviceSize peak = 0;     // Most any frame has used
+    VkDeviceSize capacity = 0; // Per frame
+    uint64_t failures = 0;
+  };
+
+  // Per-frame constants in one persistently mapped buffer split into a
+  // partition per frame in flight. Recording threads bump-allocate aligned
+  // ranges from the current partition without locks; the partition is
+  // recycled by begin_frame once the fence of the frame that last used it
+  // has signalled. Descriptors bind the buffer once, as
+  // UNIFORM_BUFFER_DYNAMIC or STORAGE_BUFFER_DYNAMIC with a range covering
+  // the largest block, and draws select their block through dynamic offsets.
+  class FrameAllocator
+  {
+  private:
+    Allocator *allocator = nullptr;
+    Buffer frame_buffer;
+    BumpAllocator bump;
+    VkDeviceSize partition_size = 0;
+    uint32_t partitions = 0;
+    uint32_t current = 0;
+    VkDeviceSize uniform_alignment = 256;
+    VkDeviceSize storage_alignment = 256;
+    VkDeviceSize peak = 0;
+    std::atomic<uint64_t> failures{0};
+
+  public:
+    FrameAllocator() = default;
+    FrameAllocator(const FrameAllocator &) = delete;
+    FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+    VkResult init(Allocator &allocator, VkPhysicalDevice physical_device, uint32_t frame_count, VkDeviceSize bytes_per_frame)
+    {
+      this->allocator = &allocator;
+      VkPhysicalDeviceProperties properties;
+      vkGetPhysicalDeviceProperties(physical_device, &properties);
+      uniform_alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 16);
+      storage_alignment = std::max<VkDeviceSize>(properties.limits.minStorageBufferOffsetAlignment, 16);
+      const VkDeviceSize granularity = std::max(uniform_alignment, storage_alignment);
+      partition_size = (bytes_per_frame + granularity - 1) / granularity * granularity;
+      return resize(frame_count);
+    }
+
+    // Recreates the buffer for a new number of frames in flight. None of the
+    // old frames may still be executing.
+    VkResult resize(uint32_t frame_count)
+    {
+      allocator->destroy_buffer(frame_buffer);
+      VkBufferCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      info.size = partition_size * frame_count;
+      info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+      VkResult err = allocator->create_buffer(info, MEMORY_USAGE_UPLOAD, frame_buffer);
+      partitions = err == VK_SUCCESS ? frame_count : 0;
+      current = 0;
+      bump.reset(partitions > 0 ? partition_size : 0);
+      return err;
+    }
+
+    void destroy()
+    {
+      if (allocator != nullptr)
+        allocator->destroy_buffer(frame_buffer);
+      partitions = 0;
+      bump.reset(0);
+    }
+
+    uint32_t frame_count() const { return partitions; }
+
+    // Starts allocating from frame's partition. Call after waiting on the
+    // fence of the frame that used it before.
+    void begin_frame(uint32_t frame)
+    {
+      peak = std::max<VkDeviceSize>(peak, bump.used());
+      current = frame;
+      bump.reset();
+    }
+
+    // Makes the frame's writes visible to the device. Call before submitting it.
+    void end_frame() { allocator->flush(frame_buffer.allocation); }
+
+    // Thread safe. Returns a null data pointer when the frame's partition is full.
+    FrameAllocation allocate(VkDeviceSize size, VkDeviceSize alignment)
+    {
+      FrameAllocation out;
+      uint64_t offset;
+      if (!bump.allocate(size, alignment, offset))
+      {
+        failures.fetch_add(1, std::memory_order_relaxed);
+        return out;
+      }
+      const VkDeviceSize absolute = (VkDeviceSize)current * partition_size + offset;
+      out.data = (uint8_t *)frame_buffer.allocation.mapped + absolute;
+      out.offset = (uint32_t)absolute;
+      return out;
+    }
+
+    FrameAllocation allocate_uniform(VkDeviceSize size) { return allocate(size, uniform_alignment); }
+    FrameAllocation allocate_storage(VkDeviceSize size) { return allocate(size, storage_alignment); }
+
+    // Copies value into a new uniform range
+    template <typename T>
+    FrameAllocation push_uniform(const T &value)
+    {
+      FrameAllocation out = allocate_uniform(sizeof(T));
+      if (out.data != nullptr)
+        memcpy(out.data, &value, sizeof(T));
+      return out;
+    }
+
+    VkBuffer buffer() const { return frame_buffer.buffer; }
+
+    FrameAllocatorStats stats() const
+    {
+      FrameAllocatorStats stats;
+      stats.used = bump.used();
+      stats.peak = std::max<VkDeviceSize>(peak, stats.used);
+      stats.capacity = partition_size;
+      stats.failures = failures.load(std::memory_order_relaxed);
+      return stats;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef GPU_INSTANCE_RING_H
+#define GPU_INSTANCE_RING_H
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+#include "allocator.hpp"
+#include "staging_ring.hpp"
+
+namespace hades::gpu
+{
+  // Host visible ring for data the CPU rewrites every frame, such as
+  // per-instance transforms. The GPU reads it in place as a vertex buffer;
+  // space written for a frame is reclaimed once that frame's fence has
+  // signalled. Render thread only.
+  class InstanceRing
+  {
+  private:
+    Allocator *allocator = nullptr;
+    Buffer ring_buffer;
+    RingAllocator ring;
+
+  public:
+    InstanceRing() = default;
+    InstanceRing(const InstanceRing &) = delete;
+    InstanceRing &operator=(const InstanceRing &) = delete;
+
+    VkResult init(Allocator &allocator, VkDeviceSize size, VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+    {
+      this->allocator = &allocator;
+      VkBufferCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      info.size = size;
+      info.usage = usage;
+      VkResult err = allocator.create_buffer(info, MEMORY_USAGE_UPLOAD, ring_buffer);
+      if (err == VK_SUCCESS)
+        ring.reset(size);
+      return err;
+    }
+
+    void destroy()
+    {
+      if (allocator != nullptr)
+        allocator->destroy_buffer(ring_buffer);
+      ring.reset(0);
+    }
+
+    // Returns where to write size bytes for the frame being built, or null
+    // when the frames in flight still hold the whole ring
+    void *allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset)
+    {
+      uint64_t position;
+      if (!ring.allocate(size, alignment, position))
+        return nullptr;
+      offset = position;
+      return (uint8_t *)ring_buffer.allocation.mapped + position;
+    }
+
+    // Everything allocated since the last call belongs to frame, a serial
+    // that increases with every submit. Call before submitting it.
+    void end_frame(uint64_t frame)
+    {
+      ring.close_batch(frame);
+      allocator->flush(ring_buffer.allocation);
+    }
+
+    // Reclaims frames up to and including frame once its fence has signalled
+    void retire(uint64_t frame) { ring.retire(frame); }
+
+    VkBuffer buffer() const { return ring_buffer.buffer; }
+    VkDeviceSize used() const { return ring.used(); }
+    VkDeviceSize size() const { return ring.size(); }
+  };
+}
+
+#endif
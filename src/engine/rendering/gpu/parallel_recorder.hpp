@@ -0,0 +1,219 @@
+#ifndef GPU_PARALLEL_RECORDER_H
+#define GPU_PARALLEL_RECORDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../../core/jobs/job_system.hpp"
+
+namespace hades::gpu
+{
+  // Records draws begin..end of a draw list into a secondary command buffer
+  using RecordRange = std::function<void(VkCommandBuffer, uint32_t begin, uint32_t end)>;
+
+  struct RecorderStats
+  {
+    uint32_t draws = 0;
+    uint32_t command_buffers = 0; // Secondaries executed by the last record()
+  };
+
+  // Splits recording of a frame's draw list over the job system. Every frame
+  // in flight owns one command pool per job system thread, so workers never
+  // share a pool and a frame's pools are reset together once its fence has
+  // signalled. Each partition becomes one secondary command buffer, and the
+  // caller executes them in draw order inside a render pass begun with
+  // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+  class ParallelRecorder
+  {
+  private:
+    struct ThreadPool
+    {
+      VkCommandPool pool = VK_NULL_HANDLE;
+      std::vector<VkCommandBuffer> buffers;
+      uint32_t used = 0;
+      // Threads outside the pool all report thread_index() 0; one of them
+      // helping in JobSystem::wait() must not record into the render thread's pool
+      std::atomic<bool> busy{false};
+    };
+
+    struct Frame
+    {
+      std::unique_ptr<ThreadPool[]> threads;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    const VkAllocationCallbacks *callbacks = nullptr;
+    uint32_t family = 0;
+    JobSystem *jobs = nullptr;
+    uint32_t thread_count = 0;
+    uint32_t min_draws_per_job = 256;
+    std::vector<Frame> frames;
+    uint32_t current = 0;
+    RecorderStats counters;
+
+    ThreadPool &claim_pool()
+    {
+      Frame &frame = frames[current];
+      const uint32_t preferred = std::min(JobSystem::thread_index(), thread_count - 1);
+      for (uint32_t i = 0;; i = (i + 1) % thread_count)
+      {
+        ThreadPool &pool = frame.threads[(preferred + i) % thread_count];
+        bool expected = false;
+        if (pool.busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+          return pool;
+      }
+    }
+
+    void destroy_pools()
+    {
+      for (Frame &frame : frames)
+      {
+        if (!frame.threads)
+          continue;
+        for (uint32_t i = 0; i < thread_count; i++)
+          if (frame.threads[i].pool != VK_NULL_HANDLE)
+            vkDestroyCommandPool(device, frame.threads[i].pool, callbacks); // Frees its command buffers
+        frame.threads.reset();
+      }
+    }
+
+    VkCommandBuffer begin(ThreadPool &pool, const VkCommandBufferInheritanceInfo &inheritance)
+    {
+      if (pool.used == pool.buffers.size())
+      {
+        VkCommandBufferAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        info.commandPool = pool.pool;
+        info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        info.commandBufferCount = 1;
+        VkCommandBuffer buffer = VK_NULL_HANDLE;
+        vkAllocateCommandBuffers(device, &info, &buffer);
+        pool.buffers.push_back(buffer);
+      }
+      VkCommandBuffer buffer = pool.buffers[pool.used++];
+      VkCommandBufferBeginInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+      info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+      info.pInheritanceInfo = &inheritance;
+      vkBeginCommandBuffer(buffer, &info);
+      return buffer;
+    }
+
+  public:
+    ParallelRecorder() = default;
+    ParallelRecorder(const ParallelRecorder &) = delete;
+    ParallelRecorder &operator=(const ParallelRecorder &) = delete;
+
+    // Partitions are never smaller than min_draws_per_job, so short lists
+    // stay on the calling thread
+    VkResult init(VkDevice device, const VkAllocationCallbacks *callbacks, uint32_t family, uint32_t frame_count,
+                  JobSystem &jobs = JobSystem::get(), uint32_t min_draws_per_job = 256)
+    {
+      this->device = device;
+      this->callbacks = callbacks;
+      this->family = family;
+      this->jobs = &jobs;
+      this->min_draws_per_job = std::max(min_draws_per_job, 1u);
+      thread_count = jobs.thread_count();
+      return resize(frame_count);
+    }
+
+    // Recreates the pools for a new number of frames in flight. None of the
+    // old frames may still be executing.
+    VkResult resize(uint32_t frame_count)
+    {
+      destroy_pools();
+      frames.resize(frame_count);
+      for (Frame &frame : frames)
+      {
+        frame.threads.reset(new ThreadPool[thread_count]);
+        for (uint32_t i = 0; i < thread_count; i++)
+        {
+          VkCommandPoolCreateInfo info = {};
+          info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+          info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+          info.queueFamilyIndex = family;
+          VkResult err = vkCreateCommandPool(device, &info, callbacks, &frame.threads[i].pool);
+          if (err != VK_SUCCESS)
+            return err;
+        }
+      }
+      current = 0;
+      return VK_SUCCESS;
+    }
+
+    void destroy()
+    {
+      destroy_pools();
+      frames.clear();
+    }
+
+    uint32_t frame_count() const { return (uint32_t)frames.size(); }
+
+    // Makes frame the target of later recording and recycles its command
+    // buffers. Call after waiting on that frame's fence.
+    void begin_frame(uint32_t frame)
+    {
+      current = frame;
+      for (uint32_t i = 0; i < thread_count; i++)
+      {
+        ThreadPool &pool = frames[frame].threads[i];
+        vkResetCommandPool(device, pool.pool, 0);
+        pool.used = 0;
+      }
+    }
+
+    // Records one secondary on the calling thread, for work that is not
+    // part of the draw list
+    VkCommandBuffer record_secondary(const VkCommandBufferInheritanceInfo &inheritance, const std::function<void(VkCommandBuffer)> &function)
+    {
+      ThreadPool &pool = claim_pool();
+      VkCommandBuffer buffer = begin(pool, inheritance);
+      function(buffer);
+      vkEndCommandBuffer(buffer);
+      pool.busy.store(false, std::memory_order_release);
+      return buffer;
+    }
+
+    // Records draw_count draws across the job system and appends the
+    // finished secondaries to out in draw order
+    void record(const VkCommandBufferInheritanceInfo &inheritance, uint32_t draw_count, const RecordRange &record_range,
+                std::vector<VkCommandBuffer> &out)
+    {
+      counters = RecorderStats();
+      counters.draws = draw_count;
+      if (draw_count == 0)
+        return;
+      const uint32_t jobs_wanted = (draw_count + min_draws_per_job - 1) / min_draws_per_job;
+      const uint32_t target = std::min(jobs_wanted, thread_count);
+      const uint32_t batch = (draw_count + target - 1) / target;
+      const uint32_t partitions = (draw_count + batch - 1) / batch;
+      const size_t first = out.size();
+      out.resize(first + partitions);
+
+      auto record_partition = [&](uint32_t begin_draw, uint32_t end_draw)
+      {
+        ThreadPool &pool = claim_pool();
+        VkCommandBuffer buffer = begin(pool, inheritance);
+        record_range(buffer, begin_draw, end_draw);
+        vkEndCommandBuffer(buffer);
+        pool.busy.store(false, std::memory_order_release);
+        out[first + begin_draw / batch] = buffer;
+      };
+      if (partitions == 1)
+        record_partition(0, draw_count);
+      else
+        jobs->parallel_for(draw_count, batch, record_partition);
+      counters.command_buffers = partitions;
+    }
+
+    RecorderStats stats() const { return counters; }
+  };
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef GPU_STAGING_RING_H
+#define GPU_STAGING_RING_H
+
+#include <cstdint>
+#include <deque>
+
+namespace hades::gpu
+{
+  // Offsets into a circular staging buffer. Space is handed out in order
+  // and reclaimed a batch at a time: close_batch marks everything allocated
+  // so far as belonging to a submission, and retire releases it once the
+  // GPU has signalled that submission's fence. Allocations never straddle
+  // the end of the buffer; a request that does not fit there wraps to
+  // offset zero and the skipped tail is reclaimed with its batch.
+  class RingAllocator
+  {
+  private:
+    struct Marker
+    {
+      uint64_t batch;
+      uint64_t head;  // Write position when the batch was closed
+      uint64_t total; // Bytes consumed since creation, padding included
+    };
+
+    uint64_t capacity = 0;
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    uint64_t total = 0;   // Monotonic count of consumed bytes
+    uint64_t retired = 0; // Monotonic count of reclaimed bytes
+    std::deque<Marker> markers;
+
+  public:
+    explicit RingAllocator(uint64_t capacity = 0) { reset(capacity); }
+
+    void reset(uint64_t new_capacity)
+    {
+      capacity = new_capacity;
+      head = tail = total = retired = 0;
+      markers.clear();
+    }
+
+    // alignment must be a power of two
+    bool allocate(uint64_t size, uint64_t alignment, uint64_t &offset)
+    {
+      if (size == 0 || size > capacity)
+        return false;
+      if (used() == 0)
+        head = tail = 0; // Nothing in flight: start over for the longest run
+      else if (used() == capacity)
+        return false;
+
+      const uint64_t start = (head + alignment - 1) & ~(alignment - 1);
+      if (head >= tail)
+      {
+        // Free space is [head, capacity) followed by [0, tail)
+        if (start + size <= capacity)
+        {
+          offset = start;
+        }
+        else if (size <= tail)
+        {
+          total += capacity - head;
+          head = 0;
+          offset = 0;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else
+      {
+        if (start + size > tail)
+          return false;
+        offset = start;
+      }
+      total += offset + size - head;
+      head = offset + size;
+      return true;
+    }
+
+    // Everything allocated since the previous close belongs to batch. Batch
+    // ids must increase.
+    void close_batch(uint64_t batch)
+    {
+      if (total == (markers.empty() ? retired : markers.back().total))
+        return; // Nothing allocated since
+      markers.push_back(Marker{batch, head, total});
+    }
+
+    // Reclaims the space of every batch up to and including batch
+    void retire(uint64_t batch)
+    {
+      while (!markers.empty() && markers.front().batch <= batch)
+      {
+        tail = markers.front().head;
+        retired = markers.front().total;
+        markers.pop_front();
+      }
+    }
+
+    uint64_t size() const { return capacity; }
+    uint64_t used() const { return total - retired; }
+  };
+}
+
+#endif
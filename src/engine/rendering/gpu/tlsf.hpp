@@ -0,0 +1,321 @@
+#ifndef GPU_TLSF_H
+#define GPU_TLSF_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace hades::gpu
+{
+  // Two-level segregated fit allocator over the offsets [0, capacity). It
+  // never touches the memory it manages, so one instance describes one
+  // VkDeviceMemory block. Free ranges are bucketed by size class: a power of
+  // two first level split into 32 linear second level classes, with bitmaps
+  // so allocate and free are O(1). Neighbouring free ranges are merged on
+  // free, keeping fragmentation bounded.
+  class Tlsf
+  {
+  public:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    struct Range
+    {
+      uint64_t offset = 0;
+      uint64_t size = 0; // May exceed the request when the remainder was too small to split off
+      uint32_t node = INVALID;
+
+      bool valid() const { return node != INVALID; }
+    };
+
+    struct Stats
+    {
+      uint64_t capacity = 0;
+      uint64_t used = 0;
+      uint64_t largest_free = 0;
+      uint32_t allocations = 0;
+      uint32_t free_ranges = 0;
+    };
+
+  private:
+    static constexpr uint32_t SL_BITS = 5;
+    static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+    static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+    static constexpr uint64_t MIN_SPLIT = 64; // Smaller tails stay with the allocation
+
+    struct Node
+    {
+      uint64_t offset;
+      uint64_t size;
+      uint64_t user;
+      uint32_t prev_physical;
+      uint32_t next_physical;
+      uint32_t prev_free;
+      uint32_t next_free;
+      bool free;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> spare_nodes;
+    uint32_t heads[FL_COUNT][SL_COUNT];
+    uint64_t fl_bitmap = 0;
+    uint32_t sl_bitmap[FL_COUNT] = {};
+    uint64_t capacity = 0;
+    uint64_t used = 0;
+    uint32_t allocations = 0;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    static uint32_t msb(uint64_t value)
+    {
+      unsigned long index;
+      _BitScanReverse64(&index, value);
+      return (uint32_t)index;
+    }
+    static uint32_t lsb(uint64_t value)
+    {
+      unsigned long index;
+      _BitScanForward64(&index, value);
+      return (uint32_t)index;
+    }
+#else
+    static uint32_t msb(uint64_t value) { return 63 - (uint32_t)__builtin_clzll(value); }
+    static uint32_t lsb(uint64_t value) { return (uint32_t)__builtin_ctzll(value); }
+#endif
+
+    static void mapping(uint64_t size, uint32_t &fl, uint32_t &sl)
+    {
+      if (size < SL_COUNT)
+      {
+        fl = 0;
+        sl = (uint32_t)size;
+        return;
+      }
+      const uint32_t top = msb(size);
+      fl = top - SL_BITS + 1;
+      sl = (uint32_t)(size >> (top - SL_BITS)) ^ SL_COUNT;
+    }
+
+    // Rounds up to the next class boundary so any range found is large enough
+    static void mapping_search(uint64_t size, uint32_t &fl, uint32_t &sl)
+    {
+      if (size >= SL_COUNT)
+        size += (1ull << (msb(size) - SL_BITS)) - 1;
+      mapping(size, fl, sl);
+    }
+
+    uint32_t new_node()
+    {
+      if (!spare_nodes.empty())
+      {
+        const uint32_t index = spare_nodes.back();
+        spare_nodes.pop_back();
+        return index;
+      }
+      nodes.push_back(Node{});
+      return (uint32_t)nodes.size() - 1;
+    }
+
+    void insert_free(uint32_t index)
+    {
+      Node &node = nodes[index];
+      uint32_t fl, sl;
+      mapping(node.size, fl, sl);
+      node.free = true;
+      node.prev_free = INVALID;
+      node.next_free = heads[fl][sl];
+      if (node.next_free != INVALID)
+        nodes[node.next_free].prev_free = index;
+      heads[fl][sl] = index;
+      fl_bitmap |= 1ull << fl;
+      sl_bitmap[fl] |= 1u << sl;
+    }
+
+    void remove_free(uint32_t index)
+    {
+      Node &node = nodes[index];
+      uint32_t fl, sl;
+      mapping(node.size, fl, sl);
+      if (node.prev_free != INVALID)
+        nodes[node.prev_free].next_free = node.next_free;
+      else
+        heads[fl][sl] = node.next_free;
+      if (node.next_free != INVALID)
+        nodes[node.next_free].prev_free = node.prev_free;
+      if (heads[fl][sl] == INVALID)
+      {
+        sl_bitmap[fl] &= ~(1u << sl);
+        if (sl_bitmap[fl] == 0)
+          fl_bitmap &= ~(1ull << fl);
+      }
+      node.free = false;
+    }
+
+    uint32_t find_free(uint64_t size) const
+    {
+      uint32_t fl, sl;
+      mapping_search(size, fl, sl);
+      if (fl >= FL_COUNT)
+        return INVALID;
+      uint32_t sl_map = sl_bitmap[fl] & (~0u << sl);
+      if (sl_map == 0)
+      {
+        const uint64_t fl_map = fl + 1 < 64 ? fl_bitmap & (~0ull << (fl + 1)) : 0;
+        if (fl_map == 0)
+          return INVALID;
+        fl = lsb(fl_map);
+        sl_map = sl_bitmap[fl];
+      }
+      return heads[fl][lsb(sl_map)];
+    }
+
+    // Splits [node.offset + size, end) off into a new free node
+    void split_tail(uint32_t index, uint64_t size)
+    {
+      const uint32_t tail = new_node();
+      Node &node = nodes[index];
+      nodes[tail] = Node{node.offset + size, node.size - size, 0, index, node.next_physical, INVALID, INVALID, false};
+      if (node.next_physical != INVALID)
+        nodes[node.next_physical].prev_physical = tail;
+      node.next_physical = tail;
+      node.size = size;
+      insert_free(tail);
+    }
+
+    // Folds next into index and recycles next
+    void absorb_next(uint32_t index)
+    {
+      Node &node = nodes[index];
+      const uint32_t next = node.next_physical;
+      node.size += nodes[next].size;
+      node.next_physical = nodes[next].next_physical;
+      if (node.next_physical != INVALID)
+        nodes[node.next_physical].prev_physical = index;
+      spare_nodes.push_back(next);
+    }
+
+  public:
+    explicit Tlsf(uint64_t capacity = 0) { reset(capacity); }
+
+    void reset(uint64_t new_capacity)
+    {
+      nodes.clear();
+      spare_nodes.clear();
+      for (auto &level : heads)
+        for (uint32_t &head : level)
+          head = INVALID;
+      fl_bitmap = 0;
+      for (uint32_t &bitmap : sl_bitmap)
+        bitmap = 0;
+      capacity = new_capacity;
+      used = 0;
+      allocations = 0;
+      if (capacity > 0)
+      {
+        nodes.push_back(Node{0, capacity, 0, INVALID, INVALID, INVALID, INVALID, false});
+        insert_free(0);
+      }
+    }
+
+    // alignment must be a power of two. Returns an invalid range when no free
+    // range can hold the request.
+    Range allocate(uint64_t size, uint64_t alignment = 1, uint64_t user = 0)
+    {
+      assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+      if (size == 0)
+        size = 1;
+
+      // Most ranges start aligned, so try the exact size before paying for padding
+      uint32_t index = find_free(size);
+      if (index != INVALID && ((nodes[index].offset + alignment - 1) & ~(alignment - 1)) + size > nodes[index].offset + nodes[index].size)
+        index = INVALID;
+      if (index == INVALID && alignment > 1)
+        index = find_free(size + alignment - 1);
+      if (index == INVALID)
+        return Range();
+      remove_free(index);
+
+      const uint64_t padding = ((nodes[index].offset + alignment - 1) & ~(alignment - 1)) - nodes[index].offset;
+      if (padding > 0)
+      {
+        // The padding becomes a free range of its own in front of the
+        // allocation; its physical predecessor is in use, or it would have
+        // been merged into this range
+        split_tail(index, padding);
+        remove_free(nodes[index].next_physical);
+        const uint32_t front = index;
+        index = nodes[index].next_physical;
+        insert_free(front);
+      }
+      if (nodes[index].size - size >= MIN_SPLIT)
+        split_tail(index, size);
+
+      Node &node = nodes[index];
+      node.user = user;
+      used += node.size;
+      allocations++;
+      return Range{node.offset, node.size, index};
+    }
+
+    void free(uint32_t index)
+    {
+      assert(index < nodes.size() && !nodes[index].free);
+      used -= nodes[index].size;
+      allocations--;
+      const uint32_t next = nodes[index].next_physical;
+      if (next != INVALID && nodes[next].free)
+      {
+        remove_free(next);
+        absorb_next(index);
+      }
+      const uint32_t prev = nodes[index].prev_physical;
+      if (prev != INVALID && nodes[prev].free)
+      {
+        remove_free(prev);
+        absorb_next(prev);
+        index = prev;
+      }
+      insert_free(index);
+    }
+
+    uint64_t user(uint32_t index) const { return nodes[index].user; }
+    uint64_t size() const { return capacity; }
+    uint64_t used_bytes() const { return used; }
+    uint32_t allocation_count() const { return allocations; }
+    bool empty() const { return allocations == 0; }
+
+    // Calls f(Range, user) for every live allocation in address order
+    template <typename F>
+    void for_each_allocation(F &&f) const
+    {
+      if (nodes.empty())
+        return;
+      // Node 0 always starts at offset 0: merges keep the lower node, and
+      // front padding splits the tail off rather than the head
+      for (uint32_t index = 0; index != INVALID; index = nodes[index].next_physical)
+        if (!nodes[index].free)
+          f(Range{nodes[index].offset, nodes[index].size, index}, nodes[index].user);
+    }
+
+    Stats stats() const
+    {
+      Stats stats;
+      stats.capacity = capacity;
+      stats.used = used;
+      stats.allocations = allocations;
+      for (uint32_t fl = 0; fl < FL_COUNT; fl++)
+        for (uint32_t sl = 0; sl < SL_COUNT; sl++)
+          for (uint32_t index = heads[fl][sl]; index != INVALID; index = nodes[index].next_free)
+          {
+            stats.free_ranges++;
+            if (nodes[index].size > stats.largest_free)
+              stats.largest_free = nodes[index].size;
+          }
+      return stats;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,410 @@
+#ifndef GPU_UPLOAD_QUEUE_H
+#define GPU_UPLOAD_QUEUE_H
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "allocator.hpp"
+#include "staging_ring.hpp"
+
+namespace hades::gpu
+{
+  struct UploadSettings
+  {
+    VkDeviceSize ring_size = 64ull << 20;
+    VkDeviceSize bytes_per_frame = 16ull << 20; // Staged bytes per flush; keeps big loads from spiking a frame
+  };
+
+  struct UploadStats
+  {
+    VkDeviceSize frame_bytes = 0; // Staged since the last flush
+    VkDeviceSize ring_used = 0;
+    VkDeviceSize ring_size = 0;
+    uint64_t total_bytes = 0;
+    uint64_t batches = 0;
+    uint64_t deferred = 0; // stage() refusals because of the budget or a full ring
+    uint64_t stalls = 0;   // Times the CPU had to wait for an old batch to retire
+  };
+
+  // Streams data to device local buffers and images through a persistently
+  // mapped staging ring. Callers write straight into the ring, so data mapped
+  // from a cooked file is copied once on the CPU. Copies recorded between two
+  // flush() calls form one batch: one command buffer, one submit, one fence.
+  // When the device has a transfer-only queue family the batches run there,
+  // and ownership of each destination is handed to the graphics family with
+  // a release barrier in the batch and a matching acquire barrier that
+  // record_acquires() adds to the graphics command buffer.
+  //
+  // Copies return a ticket, the id of the batch they went into. A resource
+  // may be used by graphics commands recorded after record_acquires() once
+  // complete(ticket) is true. Thread safe; flush() and record_acquires()
+  // belong to the render thread.
+  class UploadQueue
+  {
+  private:
+    static constexpr uint32_t BATCH_SLOTS = 4;
+
+    struct Batch
+    {
+      VkCommandPool pool = VK_NULL_HANDLE;
+      VkCommandBuffer commands = VK_NULL_HANDLE;
+      VkFence fence = VK_NULL_HANDLE;
+      uint64_t id = 0;
+      bool recording = false;
+      bool in_flight = false;
+      bool staged = false;
+      std::vector<VkBufferMemoryBarrier> buffer_releases;
+      std::vector<VkImageMemoryBarrier> image_releases;
+    };
+
+    Allocator *allocator = nullptr;
+    VkDevice device = VK_NULL_HANDLE;
+    const VkAllocationCallbacks *callbacks = nullptr;
+    VkQueue queue = VK_NULL_HANDLE;
+    uint32_t family = 0;
+    uint32_t graphics_family = 0;
+    UploadSettings settings;
+    Buffer ring_buffer;
+    RingAllocator ring;
+    Batch batches[BATCH_SLOTS];
+    uint32_t current = 0;
+    uint64_t next_id = 1;
+    uint64_t completed_id = 0;
+    uint64_t acquired_id = 0; // Highest batch whose resources the graphics queue may use
+    uint32_t open_stages = 0; // stage() calls whose copy has not been recorded yet
+    std::vector<VkBufferMemoryBarrier> buffer_acquires; // Retired cross-family releases awaiting their acquire
+    std::vector<VkImageMemoryBarrier> image_acquires;
+    UploadStats counters;
+    std::mutex mutex;
+
+    static constexpr VkPipelineStageFlags CONSUMER_STAGES =
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    static constexpr VkAccessFlags CONSUMER_ACCESS = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                                     VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+    bool cross_family() const { return family != graphics_family; }
+
+    void retire(Batch &batch)
+    {
+      batch.in_flight = false;
+      ring.retire(batch.id);
+      if (batch.id > completed_id)
+        completed_id = batch.id;
+      if (!cross_family())
+        acquired_id = completed_id;
+      // Batches retire in submission order, so acquires stay in order too
+      buffer_acquires.insert(buffer_acquires.end(), batch.buffer_releases.begin(), batch.buffer_releases.end());
+      image_acquires.insert(image_acquires.end(), batch.image_releases.begin(), batch.image_releases.end());
+      batch.buffer_releases.clear();
+      batch.image_releases.clear();
+    }
+
+    void poll()
+    {
+      // Oldest first so completed_id only moves forward
+      for (uint32_t i = 1; i <= BATCH_SLOTS; i++)
+      {
+        Batch &batch = batches[(current + i) % BATCH_SLOTS];
+        if (batch.in_flight && vkGetFenceStatus(device, batch.fence) == VK_SUCCESS)
+          retire(batch);
+      }
+    }
+
+    Batch &begin_batch()
+    {
+      Batch &batch = batches[current];
+      if (batch.recording)
+        return batch;
+      if (batch.in_flight)
+      {
+        // Every slot is in flight: the GPU is BATCH_SLOTS flushes behind
+        counters.stalls++;
+        vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        poll();
+        if (batch.in_flight)
+          retire(batch);
+      }
+      vkResetCommandPool(device, batch.pool, 0);
+      VkCommandBufferBeginInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+      info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(batch.commands, &info);
+      batch.id = next_id++;
+      batch.recording = true;
+      batch.staged = false;
+      return batch;
+    }
+
+  public:
+    UploadQueue() = default;
+    UploadQueue(const UploadQueue &) = delete;
+    UploadQueue &operator=(const UploadQueue &) = delete;
+
+    // queue may belong to a transfer-only family; graphics_family is where
+    // the uploaded resources are consumed
+    VkResult init(Allocator &allocator, VkDevice device, const VkAllocationCallbacks *callbacks, VkQueue queue, uint32_t family,
+                  uint32_t graphics_family, UploadSettings settings = UploadSettings())
+    {
+      this->allocator = &allocator;
+      this->device = device;
+      this->callbacks = callbacks;
+      this->queue = queue;
+      this->family = family;
+      this->graphics_family = graphics_family;
+      this->settings = settings;
+
+      VkBufferCreateInfo buffer_info = {};
+      buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      buffer_info.size = settings.ring_size;
+      buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+      VkResult err = allocator.create_buffer(buffer_info, MEMORY_USAGE_UPLOAD, ring_buffer);
+      if (err != VK_SUCCESS)
+        return err;
+      ring.reset(settings.ring_size);
+
+      for (Batch &batch : batches)
+      {
+        VkCommandPoolCreateInfo pool_info = {};
+        pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        pool_info.queueFamilyIndex = family;
+        if ((err = vkCreateCommandPool(device, &pool_info, callbacks, &batch.pool)) != VK_SUCCESS)
+          return err;
+        VkCommandBufferAllocateInfo command_info = {};
+        command_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_info.commandPool = batch.pool;
+        command_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_info.commandBufferCount = 1;
+        if ((err = vkAllocateCommandBuffers(device, &command_info, &batch.commands)) != VK_SUCCESS)
+          return err;
+        VkFenceCreateInfo fence_info = {};
+        fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if ((err = vkCreateFence(device, &fence_info, callbacks, &batch.fence)) != VK_SUCCESS)
+          return err;
+      }
+      return VK_SUCCESS;
+    }
+
+    void destroy()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (Batch &batch : batches)
+      {
+        if (batch.in_flight)
+          vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        if (batch.fence != VK_NULL_HANDLE)
+          vkDestroyFence(device, batch.fence, callbacks);
+        if (batch.pool != VK_NULL_HANDLE)
+          vkDestroyCommandPool(device, batch.pool, callbacks); // Frees its command buffer
+        batch = Batch();
+      }
+      if (allocator != nullptr)
+        allocator->destroy_buffer(ring_buffer);
+      buffer_acquires.clear();
+      image_acquires.clear();
+    }
+
+    // Reserves size bytes of staging memory in the open batch and returns
+    // where to write them, with offset set to their position in buffer().
+    // Returns null when the frame budget is spent or the ring is full; the
+    // caller retries after the next flush. The first request of a frame may
+    // exceed the budget, so no upload smaller than the ring starves.
+    void *stage(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (counters.frame_bytes > 0 && counters.frame_bytes + size > settings.bytes_per_frame)
+      {
+        counters.deferred++;
+        return nullptr;
+      }
+      Batch &batch = begin_batch();
+      uint64_t position;
+      if (!ring.allocate(size, alignment, position))
+      {
+        poll();
+        if (!ring.allocate(size, alignment, position))
+        {
+          counters.deferred++;
+          return nullptr;
+        }
+      }
+      batch.staged = true;
+      open_stages++;
+      counters.frame_bytes += size;
+      counters.total_bytes += size;
+      offset = position;
+      return (uint8_t *)ring_buffer.allocation.mapped + position;
+    }
+
+    // Copies staged bytes into a buffer. The buffer must have been created
+    // with VK_BUFFER_USAGE_TRANSFER_DST_BIT and be idle on the GPU. Each
+    // successful stage() must be followed by exactly one copy or cancel_stage().
+    uint64_t copy_to_buffer(VkDeviceSize staging_offset, VkBuffer destination, VkDeviceSize destination_offset, VkDeviceSize size)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      Batch &batch = begin_batch();
+      if (open_stages > 0)
+        open_stages--;
+      const VkBufferCopy region = {staging_offset, destination_offset, size};
+      vkCmdCopyBuffer(batch.commands, ring_buffer.buffer, destination, 1, &region);
+
+      VkBufferMemoryBarrier barrier = {};
+      barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier.dstAccessMask = CONSUMER_ACCESS;
+      barrier.srcQueueFamilyIndex = cross_family() ? family : VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = cross_family() ? graphics_family : VK_QUEUE_FAMILY_IGNORED;
+      barrier.buffer = destination;
+      barrier.offset = destination_offset;
+      barrier.size = size;
+      batch.buffer_releases.push_back(barrier);
+      return batch.id;
+    }
+
+    // Copies staged texels into every region of an image, moving it from
+    // undefined to shader read-only layout. Regions index mips 0 to mip_count - 1.
+    uint64_t copy_to_image(VkImage destination, uint32_t mip_count, const VkBufferImageCopy *regions, uint32_t region_count)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      Batch &batch = begin_batch();
+      if (open_stages > 0)
+        open_stages--;
+      VkImageMemoryBarrier barrier = {};
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask = 0;
+      barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+      barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      barrier.srcQueueFamilyIndex = barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image = destination;
+      barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mip_count, 0, 1};
+      vkCmdPipelineBarrier(batch.commands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+      vkCmdCopyBufferToImage(batch.commands, ring_buffer.buffer, destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, region_count, regions);
+
+      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      barrier.srcQueueFamilyIndex = cross_family() ? family : VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = cross_family() ? graphics_family : VK_QUEUE_FAMILY_IGNORED;
+      batch.image_releases.push_back(barrier);
+      return batch.id;
+    }
+
+    // Gives up on the last stage() without recording a copy. Its ring space
+    // is reclaimed with the batch.
+    void cancel_stage()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (open_stages > 0)
+        open_stages--;
+    }
+
+    // Stages and copies data into a buffer in one go. Returns the ticket, or
+    // zero when stage() refused and the upload should be retried next frame.
+    uint64_t upload_buffer(const void *data, VkDeviceSize size, VkBuffer destination, VkDeviceSize destination_offset = 0)
+    {
+      VkDeviceSize offset;
+      void *staging = stage(size, 16, offset);
+      if (staging == nullptr)
+        return 0;
+      memcpy(staging, data, size);
+      return copy_to_buffer(offset, destination, destination_offset, size);
+    }
+
+    // Submits the open batch and starts the next frame's budget. Call once
+    // per frame, before the graphics submit that may use what was staged.
+    uint64_t flush()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      counters.frame_bytes = 0;
+      poll();
+      Batch &batch = batches[current];
+      // A batch with nothing staged, or with a stage whose copy another
+      // thread is still writing, stays open for the next frame
+      if (!batch.recording || !batch.staged || open_stages > 0)
+        return 0;
+
+      // Same family: one barrier makes the copies visible to every later
+      // consumer. Cross family: the release half of the ownership transfer;
+      // destination stages are ignored on a release.
+      const VkPipelineStageFlags destination_stages = cross_family() ? (VkPipelineStageFlags)VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : CONSUMER_STAGES;
+      std::vector<VkBufferMemoryBarrier> buffer_barriers = batch.buffer_releases;
+      std::vector<VkImageMemoryBarrier> image_barriers = batch.image_releases;
+      if (cross_family())
+      {
+        for (VkBufferMemoryBarrier &barrier : buffer_barriers)
+          barrier.dstAccessMask = 0;
+        for (VkImageMemoryBarrier &barrier : image_barriers)
+          barrier.dstAccessMask = 0;
+      }
+      if (!buffer_barriers.empty() || !image_barriers.empty())
+        vkCmdPipelineBarrier(batch.commands, VK_PIPELINE_STAGE_TRANSFER_BIT, destination_stages, 0, 0, nullptr, (uint32_t)buffer_barriers.size(),
+                             buffer_barriers.data(), (uint32_t)image_barriers.size(), image_barriers.data());
+      if (!cross_family())
+      {
+        batch.buffer_releases.clear();
+        batch.image_releases.clear();
+      }
+      vkEndCommandBuffer(batch.commands);
+
+      VkSubmitInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+      info.commandBufferCount = 1;
+      info.pCommandBuffers = &batch.commands;
+      vkResetFences(device, 1, &batch.fence);
+      vkQueueSubmit(queue, 1, &info, batch.fence);
+      ring.close_batch(batch.id);
+      batch.recording = false;
+      batch.in_flight = true;
+      counters.batches++;
+      current = (current + 1) % BATCH_SLOTS;
+      return batch.id;
+    }
+
+    // Records the acquire half of every ownership transfer whose batch has
+    // completed. Call at the start of each graphics command buffer; it is a
+    // no-op when uploads run on the graphics family.
+    void record_acquires(VkCommandBuffer commands)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      poll();
+      acquired_id = completed_id;
+      if (buffer_acquires.empty() && image_acquires.empty())
+        return;
+      for (VkBufferMemoryBarrier &barrier : buffer_acquires)
+        barrier.srcAccessMask = 0;
+      for (VkImageMemoryBarrier &barrier : image_acquires)
+        barrier.srcAccessMask = 0;
+      vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, CONSUMER_STAGES, 0, 0, nullptr, (uint32_t)buffer_acquires.size(),
+                           buffer_acquires.data(), (uint32_t)image_acquires.size(), image_acquires.data());
+      buffer_acquires.clear();
+      image_acquires.clear();
+    }
+
+    bool complete(uint64_t ticket)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (ticket > acquired_id)
+        poll();
+      return ticket != 0 && ticket <= acquired_id;
+    }
+
+    VkBuffer buffer() const { return ring_buffer.buffer; }
+    bool uses_transfer_queue() const { return cross_family(); }
+
+    UploadStats stats()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      UploadStats stats = counters;
+      stats.ring_used = ring.used();
+      stats.ring_size = ring.size();
+      return stats;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef HMESH_VERTEX_INPUT_H
+#define HMESH_VERTEX_INPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vulkan/vulkan.h>
+
+#include "../assets/mesh/hmesh.hpp"
+
+namespace hades
+{
+  // Push constant block matching HMeshDecode in shaders/hmesh_decode.glsl
+  struct HMeshDecodeConstants
+  {
+    float position_offset[4];
+    float position_scale[4];
+    float uv_offset_scale[4];
+  };
+
+  struct HMeshVertexInput
+  {
+    VkVertexInputBindingDescription binding;
+    VkVertexInputAttributeDescription attributes[3];
+  };
+
+  // Vertex layout of a cooked mesh: position, normal and uv at locations 0-2.
+  // Quantized formats use normalized attributes, so the input assembler does
+  // the integer to float conversion and the shader only rescales.
+  inline HMeshVertexInput hmesh_vertex_input(const MappedMesh &mesh, uint32_t binding = 0)
+  {
+    HMeshVertexInput input = {};
+    input.binding.binding = binding;
+    input.binding.stride = mesh.header().vertex_stride;
+    input.binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+      input.attributes[i].location = i;
+      input.attributes[i].binding = binding;
+    }
+
+    if (mesh.vertex_format() == HMESH_VERTEX_FLOAT)
+    {
+      input.attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+      input.attributes[0].offset = offsetof(MeshVertex, position);
+      input.attributes[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+      input.attributes[1].offset = offsetof(MeshVertex, normal);
+      input.attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
+      input.attributes[2].offset = offsetof(MeshVertex, uv);
+      return input;
+    }
+
+    input.attributes[0].format = mesh.vertex_format() == HMESH_VERTEX_QUANTIZED_HALF ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R16G16B16A16_UNORM;
+    input.attributes[0].offset = offsetof(QuantizedVertex, position);
+    input.attributes[1].format = VK_FORMAT_R16G16_SNORM;
+    input.attributes[1].offset = offsetof(QuantizedVertex, normal);
+    input.attributes[2].format = VK_FORMAT_R16G16_UNORM;
+    input.attributes[2].offset = offsetof(QuantizedVertex, uv);
+    return input;
+  }
+
+  // Identity decode for float files, the stored ranges otherwise
+  inline HMeshDecodeConstants hmesh_decode_constants(const MappedMesh &mesh)
+  {
+    HMeshDecodeConstants constants = {{0, 0, 0, 0}, {1, 1, 1, 1}, {0, 0, 1, 1}};
+    const HMeshVertexQuantization *quantization = mesh.vertex_quantization();
+    if (quantization == nullptr)
+      return constants;
+    memcpy(constants.position_offset, quantization->position_offset, sizeof(quantization->position_offset));
+    memcpy(constants.position_scale, quantization->position_scale, sizeof(quantization->position_scale));
+    memcpy(constants.uv_offset_scale, quantization->uv_offset, sizeof(quantization->uv_offset));
+    memcpy(constants.uv_offset_scale + 2, quantization->uv_scale, sizeof(quantization->uv_scale));
+    return constants;
+  }
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef HTEX_FORMAT_H
+#define HTEX_FORMAT_H
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+#include "../assets/texture/htex.hpp"
+
+namespace hades
+{
+  // Image format for a cooked texture. BC formats need the
+  // textureCompressionBC device feature, which every desktop GPU exposes.
+  inline VkFormat htex_vk_format(uint32_t format, bool srgb)
+  {
+    switch (format)
+    {
+    case HTEX_FORMAT_RGBA8:
+      return srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    case HTEX_FORMAT_BC1:
+      return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+    case HTEX_FORMAT_BC3:
+      return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+    case HTEX_FORMAT_BC5:
+      return VK_FORMAT_BC5_UNORM_BLOCK;
+    case HTEX_FORMAT_BC7:
+      return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+    default:
+      return VK_FORMAT_UNDEFINED;
+    }
+  }
+
+  inline VkFormat htex_vk_format(const MappedTexture &texture)
+  {
+    return htex_vk_format(texture.format(), texture.srgb());
+  }
+
+  // Buffer to image copy regions for every mip of a texture whose file
+  // contents were uploaded to a buffer at buffer_offset. Returns the region count.
+  inline uint32_t htex_copy_regions(const MappedTexture &texture, VkDeviceSize buffer_offset, VkBufferImageCopy *regions)
+  {
+    for (uint32_t level = 0; level < texture.mip_count(); level++)
+    {
+      const HTexMip &mip = texture.mip(level);
+      VkBufferImageCopy &region = regions[level];
+      region = {};
+      region.bufferOffset = buffer_offset + mip.offset;
+      region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      region.imageSubresource.mipLevel = level;
+      region.imageSubresource.layerCount = 1;
+      region.imageExtent = {mip.width, mip.height, 1};
+    }
+    return texture.mip_count();
+  }
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef LOD_SELECTION_H
+#define LOD_SELECTION_H
+
+#include <cmath>
+#include <cstdint>
+
+#include "../assets/mesh/hmesh.hpp"
+
+namespace hades
+{
+  // Pixels per object space unit at distance 1 for a perspective projection
+  inline float lod_projection_scale(float fov_y_radians, float viewport_height)
+  {
+    return viewport_height / (2.0f * std::tan(fov_y_radians * 0.5f));
+  }
+
+  // Picks the coarsest LOD of a submesh whose error stays under pixel_threshold
+  // on screen. Returns 0 for the full resolution submesh, otherwise the level.
+  inline uint32_t select_lod(const MappedMesh &mesh, const HMeshSubmesh &submesh, float distance, float projection_scale, float pixel_threshold = 1.0f)
+  {
+    const float safe_distance = distance > 1e-4f ? distance : 1e-4f;
+    const HMeshLod *lods = mesh.submesh_lods(submesh);
+    uint32_t selected = 0;
+    for (uint32_t i = 0; i < submesh.lod_count; i++)
+    {
+      // Errors grow monotonically down the chain
+      if (lods[i].error * projection_scale / safe_distance > pixel_threshold)
+        break;
+      selected = lods[i].level;
+    }
+    return selected;
+  }
+}
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef PIPELINE_CACHE_H
+#define PIPELINE_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../core/hash/hash.hpp"
+#include "../core/io/atomic_file.hpp"
+
+namespace hades
+{
+  // The driver a cache blob was produced by. Blobs are only handed back to a
+  // driver with the same identity; anything else is discarded, since some
+  // drivers crash on foreign or corrupt cache data instead of ignoring it.
+  struct PipelineCacheKey
+  {
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    uint32_t driver_version = 0;
+    uint8_t uuid[VK_UUID_SIZE] = {};
+  };
+
+  inline PipelineCacheKey pipeline_cache_key(const VkPhysicalDeviceProperties &properties)
+  {
+    PipelineCacheKey key;
+    key.vendor_id = properties.vendorID;
+    key.device_id = properties.deviceID;
+    key.driver_version = properties.driverVersion;
+    memcpy(key.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    return key;
+  }
+
+  // "pipelines-<vendor>-<device>-<uuid>.bin", so caches of several GPUs or
+  // drivers can share one directory
+  inline std::string pipeline_cache_file_name(const PipelineCacheKey &key)
+  {
+    char name[32 + 2 * VK_UUID_SIZE + 8];
+    int length = snprintf(name, sizeof(name), "pipelines-%04x-%04x-", key.vendor_id, key.device_id);
+    for (uint32_t i = 0; i < VK_UUID_SIZE; i++)
+      length += snprintf(name + length, sizeof(name) - length, "%02x", key.uuid[i]);
+    snprintf(name + length, sizeof(name) - length, ".bin");
+    return name;
+  }
+
+  constexpr char PIPELINE_CACHE_MAGIC[4] = {'H', 'P', 'S', 'O'};
+  constexpr uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+
+  // On-disk wrapper around the driver's blob. The driver version is not part
+  // of VkPipelineCacheHeaderVersionOne, and the content hash catches torn or
+  // bit-rotted files before the driver sees them.
+  struct PipelineCacheFileHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint8_t uuid[VK_UUID_SIZE];
+    uint32_t reserved;
+    uint64_t data_size;
+    uint64_t data_hash;
+  };
+  static_assert(sizeof(PipelineCacheFileHeader) == 56, "PipelineCacheFileHeader layout changed");
+
+  inline std::vector<uint8_t> wrap_pipeline_cache(const PipelineCacheKey &key, const void *data, size_t size)
+  {
+    PipelineCacheFileHeader header = {};
+    memcpy(header.magic, PIPELINE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = PIPELINE_CACHE_FILE_VERSION;
+    header.vendor_id = key.vendor_id;
+    header.device_id = key.device_id;
+    header.driver_version = key.driver_version;
+    memcpy(header.uuid, key.uuid, VK_UUID_SIZE);
+    header.data_size = size;
+    header.data_hash = hash64(data, size);
+
+    std::vector<uint8_t> bytes(sizeof(header) + size);
+    memcpy(bytes.data(), &header, sizeof(header));
+    if (size > 0)
+      memcpy(bytes.data() + sizeof(header), data, size);
+    return bytes;
+  }
+
+  // Checks a driver blob against the device it is about to be given to, using
+  // the header every implementation writes at the start of its cache data
+  inline bool pipeline_cache_data_matches(const void *data, size_t size, const PipelineCacheKey &key)
+  {
+    VkPipelineCacheHeaderVersionOne header;
+    if (size < sizeof(header))
+      return false;
+    memcpy(&header, data, sizeof(header));
+    return header.headerSize >= sizeof(header) && header.headerSize <= size &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == key.vendor_id && header.deviceID == key.device_id &&
+           memcmp(header.pipelineCacheUUID, key.uuid, VK_UUID_SIZE) == 0;
+  }
+
+  // Returns the driver blob inside a cache file, or size 0 when the file was
+  // written by another driver, is truncated or fails its checksum
+  inline size_t unwrap_pipeline_cache(const std::vector<uint8_t> &bytes, const PipelineCacheKey &key, const uint8_t *&data)
+  {
+    data = nullptr;
+    PipelineCacheFileHeader header;
+    if (bytes.size() < sizeof(header))
+      return 0;
+    memcpy(&header, bytes.data(), sizeof(header));
+    if (memcmp(header.magic, PIPELINE_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != PIPELINE_CACHE_FILE_VERSION)
+      return 0;
+    if (header.vendor_id != key.vendor_id || header.device_id != key.device_id || header.driver_version != key.driver_version ||
+        memcmp(header.uuid, key.uuid, VK_UUID_SIZE) != 0)
+      return 0;
+    if (header.data_size != bytes.size() - sizeof(header))
+      return 0;
+    const uint8_t *payload = bytes.data() + sizeof(header);
+    if (hash64(payload, (size_t)header.data_size) != header.data_hash || !pipeline_cache_data_matches(payload, (size_t)header.data_size, key))
+      return 0;
+    data = payload;
+    return (size_t)header.data_size;
+  }
+
+  enum PipelineCacheStatus
+  {
+    PIPELINE_CACHE_EMPTY,    // No file for this device yet
+    PIPELINE_CACHE_LOADED,   // Seeded from the file
+    PIPELINE_CACHE_REJECTED, // A file existed but belonged to another driver or was damaged
+  };
+
+  // VkPipelineCache persisted in a directory across runs. Created after the
+  // device and destroyed before it; pass handle() to every pipeline creation.
+  class PipelineCache
+  {
+  private:
+    VkDevice device = VK_NULL_HANDLE;
+    const VkAllocationCallbacks *allocator = nullptr;
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    PipelineCacheKey key;
+    std::string path;
+    PipelineCacheStatus status = PIPELINE_CACHE_EMPTY;
+    size_t loaded_bytes = 0;
+    uint64_t loaded_hash = 0;
+
+    static std::vector<uint8_t> read_file(const std::string &path)
+    {
+      std::ifstream file(path, std::ios::binary | std::ios::ate);
+      if (!file)
+        return {};
+      std::vector<uint8_t> bytes((size_t)file.tellg());
+      file.seekg(0);
+      if (!file.read((char *)bytes.data(), (std::streamsize)bytes.size()))
+        return {};
+      return bytes;
+    }
+
+  public:
+    PipelineCache() = default;
+    PipelineCache(const PipelineCache &) = delete;
+    PipelineCache &operator=(const PipelineCache &) = delete;
+
+    VkResult create(VkPhysicalDevice physical_device, VkDevice device, const VkAllocationCallbacks *allocator, const std::string &directory)
+    {
+      this->device = device;
+      this->allocator = allocator;
+      VkPhysicalDeviceProperties properties;
+      vkGetPhysicalDeviceProperties(physical_device, &properties);
+      key = pipeline_cache_key(properties);
+      path = (std::filesystem::path(directory) / pipeline_cache_file_name(key)).string();
+
+      const std::vector<uint8_t> bytes = read_file(path);
+      const uint8_t *data = nullptr;
+      const size_t size = unwrap_pipeline_cache(bytes, key, data);
+      status = size > 0 ? PIPELINE_CACHE_LOADED : (bytes.empty() ? PIPELINE_CACHE_EMPTY : PIPELINE_CACHE_REJECTED);
+      loaded_bytes = size;
+      loaded_hash = size > 0 ? hash64(data, size) : 0;
+
+      VkPipelineCacheCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+      info.initialDataSize = size;
+      info.pInitialData = data;
+      VkResult err = vkCreatePipelineCache(device, &info, allocator, &cache);
+      if (err != VK_SUCCESS && size > 0)
+      {
+        // The driver refused data that passed our checks; start over empty
+        status = PIPELINE_CACHE_REJECTED;
+        loaded_bytes = 0;
+        loaded_hash = 0;
+        info.initialDataSize = 0;
+        info.pInitialData = nullptr;
+        err = vkCreatePipelineCache(device, &info, allocator, &cache);
+      }
+      return err;
+    }
+
+    // Writes the cache back if pipelines were added since it was loaded.
+    // Entries another process saved in the meantime are merged in first, so
+    // two instances running side by side do not discard each other's work.
+    bool save()
+    {
+      if (cache == VK_NULL_HANDLE)
+        return false;
+
+      const std::vector<uint8_t> on_disk = read_file(path);
+      const uint8_t *disk_data = nullptr;
+      const size_t disk_size = unwrap_pipeline_cache(on_disk, key, disk_data);
+      if (disk_size > 0 && hash64(disk_data, disk_size) != loaded_hash)
+      {
+        VkPipelineCacheCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        info.initialDataSize = disk_size;
+        info.pInitialData = disk_data;
+        VkPipelineCache other = VK_NULL_HANDLE;
+        if (vkCreatePipelineCache(device, &info, allocator, &other) == VK_SUCCESS)
+        {
+          vkMergePipelineCaches(device, cache, 1, &other);
+          vkDestroyPipelineCache(device, other, allocator);
+        }
+      }
+
+      size_t size = 0;
+      if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS)
+        return false;
+      std::vector<uint8_t> data(size);
+      if (size == 0 || vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS)
+        return false;
+      data.resize(size);
+      if (size == loaded_bytes && hash64(data.data(), size) == loaded_hash)
+        return true; // Nothing new
+
+      std::error_code ec;
+      std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+      return write_file_atomic(path, wrap_pipeline_cache(key, data.data(), size));
+    }
+
+    void destroy()
+    {
+      if (cache != VK_NULL_HANDLE)
+        vkDestroyPipelineCache(device, cache, allocator);
+      cache = VK_NULL_HANDLE;
+    }
+
+    VkPipelineCache handle() const { return cache; }
+    PipelineCacheStatus state() const { return status; }
+    size_t initial_size() const { return loaded_bytes; }
+    const std::string &file() const { return path; }
+  };
+}
+
+#endif
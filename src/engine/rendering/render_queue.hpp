@@ -0,0 +1,368 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "../core/jobs/job_system.hpp"
+
+namespace hades
+{
+  // Draw key layout, most significant first. Sorting on the whole key groups
+  // draws by state from the most to the least expensive change:
+  //   view 4 | pass 4 | pipeline 12 | material 16 | mesh 16 | depth 12
+  constexpr uint32_t DRAW_KEY_DEPTH_BITS = 12;
+  constexpr uint32_t DRAW_KEY_MESH_SHIFT = 12;
+  constexpr uint32_t DRAW_KEY_MATERIAL_SHIFT = 28;
+  constexpr uint32_t DRAW_KEY_PIPELINE_SHIFT = 44;
+  constexpr uint32_t DRAW_KEY_PASS_SHIFT = 56;
+  constexpr uint32_t DRAW_KEY_VIEW_SHIFT = 60;
+
+  // Ids wider than their field are truncated, which only costs extra binds
+  inline uint64_t make_draw_key(uint32_t view, uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth)
+  {
+    return (uint64_t)(view & 0xf) << DRAW_KEY_VIEW_SHIFT | (uint64_t)(pass & 0xf) << DRAW_KEY_PASS_SHIFT |
+           (uint64_t)(pipeline & 0xfff) << DRAW_KEY_PIPELINE_SHIFT | (uint64_t)(material & 0xffff) << DRAW_KEY_MATERIAL_SHIFT |
+           (uint64_t)(mesh & 0xffff) << DRAW_KEY_MESH_SHIFT | (depth & ((1u << DRAW_KEY_DEPTH_BITS) - 1));
+  }
+
+  // Quantizes a view depth in [0, 1] for the key. Opaque passes sort front to
+  // back so early depth testing rejects more; blended passes need back to front.
+  inline uint32_t draw_key_depth(float depth, bool back_to_front = false)
+  {
+    const float clamped = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+    const uint32_t max = (1u << DRAW_KEY_DEPTH_BITS) - 1;
+    const uint32_t quantized = (uint32_t)(clamped * max + 0.5f);
+    return back_to_front ? max - quantized : quantized;
+  }
+
+  inline uint32_t draw_key_view(uint64_t key) { return (uint32_t)(key >> DRAW_KEY_VIEW_SHIFT) & 0xf; }
+  inline uint32_t draw_key_pass(uint64_t key) { return (uint32_t)(key >> DRAW_KEY_PASS_SHIFT) & 0xf; }
+  inline uint32_t draw_key_pipeline(uint64_t key) { return (uint32_t)(key >> DRAW_KEY_PIPELINE_SHIFT) & 0xfff; }
+  inline uint32_t draw_key_material(uint64_t key) { return (uint32_t)(key >> DRAW_KEY_MATERIAL_SHIFT) & 0xffff; }
+  inline uint32_t draw_key_mesh(uint64_t key) { return (uint32_t)(key >> DRAW_KEY_MESH_SHIFT) & 0xffff; }
+
+  struct DrawItem
+  {
+    uint64_t key;
+    uint32_t draw; // Index of the draw's DrawCommand
+  };
+
+  // Vertex buffer binding that per-instance data is bound to by record_batches()
+  constexpr uint32_t INSTANCE_VERTEX_BINDING = 1;
+
+  // Everything needed to issue one indexed draw
+  struct DrawCommand
+  {
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkDescriptorSet material = VK_NULL_HANDLE; // Bound at set 0
+    // Bindless materials leave material null and pass a descriptor heap
+    // handle instead, pushed as a uint32 at offset 0 to these stages
+    VkShaderStageFlags material_index_stages = 0;
+    uint32_t material_index = 0;
+    VkBuffer vertex_buffer = VK_NULL_HANDLE;
+    VkDeviceSize vertex_buffer_offset = 0;
+    VkBuffer index_buffer = VK_NULL_HANDLE;
+    VkDeviceSize index_buffer_offset = 0;
+    VkIndexType index_type = VK_INDEX_TYPE_UINT32;
+    uint32_t index_count = 0;
+    uint32_t first_index = 0;
+    int32_t vertex_offset = 0;
+    uint32_t instance_count = 1;
+    uint32_t first_instance = 0;
+  };
+
+  // Stable LSD radix sort of draw items by key, one byte per pass. Byte
+  // positions where every key agrees are skipped, so keys that only use a
+  // few fields cost a few passes. With a job system, large inputs are split
+  // into chunks that count and scatter in parallel; the chunks keep their
+  // order inside each bucket, which keeps the sort stable.
+  inline void radix_sort_draws(std::vector<DrawItem> &items, std::vector<DrawItem> &scratch, JobSystem *jobs = nullptr,
+                               uint32_t parallel_threshold = 16384)
+  {
+    const uint32_t count = (uint32_t)items.size();
+    if (count < 2)
+      return;
+    scratch.resize(count);
+
+    uint32_t chunk_size = count;
+    if (jobs != nullptr && count >= parallel_threshold)
+      chunk_size = std::max(4096u, (count + jobs->thread_count() - 1) / jobs->thread_count());
+    const uint32_t chunk_count = (count + chunk_size - 1) / chunk_size;
+    std::vector<std::array<uint32_t, 256>> offsets(chunk_count);
+    auto for_each_chunk = [&](auto &&function)
+    {
+      if (chunk_count == 1)
+        function(0u, count);
+      else
+        jobs->parallel_for(count, chunk_size, function);
+    };
+
+    // Which key bytes vary at all
+    uint64_t differing = 0;
+    for (uint32_t i = 1; i < count; i++)
+      differing |= items[i].key ^ items[0].key;
+
+    DrawItem *source = items.data();
+    DrawItem *destination = scratch.data();
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+      if (((differing >> shift) & 0xff) == 0)
+        continue;
+
+      for_each_chunk([&](uint32_t begin, uint32_t end)
+                     {
+                       std::array<uint32_t, 256> &histogram = offsets[begin / chunk_size];
+                       histogram.fill(0);
+                       for (uint32_t i = begin; i < end; i++)
+                         histogram[(source[i].key >> shift) & 0xff]++; });
+
+      // Exclusive prefix sum, bucket major then chunk, turns counts into write positions
+      uint32_t position = 0;
+      for (uint32_t bucket = 0; bucket < 256; bucket++)
+        for (uint32_t chunk = 0; chunk < chunk_count; chunk++)
+        {
+          const uint32_t bucket_count = offsets[chunk][bucket];
+          offsets[chunk][bucket] = position;
+          position += bucket_count;
+        }
+
+      for_each_chunk([&](uint32_t begin, uint32_t end)
+                     {
+                       std::array<uint32_t, 256> &next = offsets[begin / chunk_size];
+                       for (uint32_t i = begin; i < end; i++)
+                         destination[next[(source[i].key >> shift) & 0xff]++] = source[i]; });
+      std::swap(source, destination);
+    }
+    if (source != items.data())
+      items.swap(scratch);
+  }
+
+  // Consecutive sorted draws issued as one instanced draw; instance i of the
+  // batch reads the per-instance data of sorted draw first + i
+  struct DrawBatch
+  {
+    uint32_t first;
+    uint32_t count;
+  };
+
+  // Whether two draws differ only in their per-instance data
+  inline bool same_geometry(const DrawCommand &a, const DrawCommand &b)
+  {
+    return a.pipeline == b.pipeline && a.layout == b.layout && a.material == b.material &&
+           a.material_index_stages == b.material_index_stages && a.material_index == b.material_index && a.vertex_buffer == b.vertex_buffer &&
+           a.vertex_buffer_offset == b.vertex_buffer_offset && a.index_buffer == b.index_buffer && a.index_buffer_offset == b.index_buffer_offset &&
+           a.index_type == b.index_type && a.index_count == b.index_count && a.first_index == b.first_index && a.vertex_offset == b.vertex_offset;
+  }
+
+  struct RenderQueueStats
+  {
+    uint32_t draws = 0;
+    uint32_t draw_calls = 0;
+    uint32_t pipeline_binds = 0;
+    uint32_t descriptor_binds = 0;
+    uint32_t material_index_pushes = 0;
+    uint32_t vertex_buffer_binds = 0;
+    uint32_t index_buffer_binds = 0;
+  };
+
+  // Visible draws of a frame. Producers push a key per draw, sort() orders
+  // them, and record() replays any range of the sorted list, binding only
+  // state that differs from the previous draw in that range. Ranges are
+  // independent so they can be recorded by different threads.
+  //
+  // Draws that share mesh and material sort next to each other, since depth
+  // is the lowest key field. build_batches() turns those runs into
+  // instanced draws that record_batches() issues with one call each.
+  class RenderQueue
+  {
+  private:
+    struct BindState
+    {
+      const DrawCommand *bound = nullptr;
+      VkPipelineLayout layout = VK_NULL_HANDLE;
+      uint32_t pipelines = 0;
+      uint32_t descriptors = 0;
+      uint32_t material_indices = 0;
+      uint32_t vertex_buffers = 0;
+      uint32_t index_buffers = 0;
+      uint32_t draw_calls = 0;
+    };
+
+    std::vector<DrawItem> items;
+    std::vector<DrawItem> scratch;
+    std::vector<DrawBatch> batches;
+    std::atomic<uint32_t> pipeline_binds{0};
+    std::atomic<uint32_t> descriptor_binds{0};
+    std::atomic<uint32_t> material_index_pushes{0};
+    std::atomic<uint32_t> vertex_buffer_binds{0};
+    std::atomic<uint32_t> index_buffer_binds{0};
+    std::atomic<uint32_t> draw_calls{0};
+
+    static void bind(VkCommandBuffer command_buffer, const DrawCommand &draw, BindState &state)
+    {
+      const DrawCommand *bound = state.bound;
+      if (bound == nullptr || draw.pipeline != bound->pipeline)
+      {
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.pipeline);
+        state.pipelines++;
+      }
+      // Sets stay bound across pipelines with the same layout
+      if (draw.material != VK_NULL_HANDLE && (bound == nullptr || draw.material != bound->material || draw.layout != state.layout))
+      {
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.layout, 0, 1, &draw.material, 0, nullptr);
+        state.layout = draw.layout;
+        state.descriptors++;
+      }
+      // Push constants also survive pipeline changes within a layout
+      if (draw.material_index_stages != 0 &&
+          (bound == nullptr || draw.material_index != bound->material_index || draw.material_index_stages != bound->material_index_stages ||
+           draw.layout != bound->layout))
+      {
+        vkCmdPushConstants(command_buffer, draw.layout, draw.material_index_stages, 0, sizeof(uint32_t), &draw.material_index);
+        state.material_indices++;
+      }
+      if (bound == nullptr || draw.vertex_buffer != bound->vertex_buffer || draw.vertex_buffer_offset != bound->vertex_buffer_offset)
+      {
+        vkCmdBindVertexBuffers(command_buffer, 0, 1, &draw.vertex_buffer, &draw.vertex_buffer_offset);
+        state.vertex_buffers++;
+      }
+      if (bound == nullptr || draw.index_buffer != bound->index_buffer || draw.index_buffer_offset != bound->index_buffer_offset ||
+          draw.index_type != bound->index_type)
+      {
+        vkCmdBindIndexBuffer(command_buffer, draw.index_buffer, draw.index_buffer_offset, draw.index_type);
+        state.index_buffers++;
+      }
+      state.bound = &draw;
+    }
+
+    void add_counts(const BindState &state)
+    {
+      pipeline_binds += state.pipelines;
+      descriptor_binds += state.descriptors;
+      material_index_pushes += state.material_indices;
+      vertex_buffer_binds += state.vertex_buffers;
+      index_buffer_binds += state.index_buffers;
+      draw_calls += state.draw_calls;
+    }
+
+  public:
+    void clear()
+    {
+      items.clear();
+      batches.clear();
+      pipeline_binds = descriptor_binds = material_index_pushes = vertex_buffer_binds = index_buffer_binds = draw_calls = 0;
+    }
+
+    void push(uint64_t key, uint32_t draw) { items.push_back(DrawItem{key, draw}); }
+
+    void sort(JobSystem *jobs = &JobSystem::get()) { radix_sort_draws(items, scratch, jobs); }
+
+    uint32_t size() const { return (uint32_t)items.size(); }
+    const DrawItem *data() const { return items.data(); }
+
+    // Records sorted draws begin..end; commands is indexed by DrawItem::draw
+    void record(VkCommandBuffer command_buffer, uint32_t begin, uint32_t end, const DrawCommand *commands)
+    {
+      BindState state;
+      for (uint32_t i = begin; i < end; i++)
+      {
+        const DrawCommand &draw = commands[items[i].draw];
+        bind(command_buffer, draw, state);
+        vkCmdDrawIndexed(command_buffer, draw.index_count, draw.instance_count, draw.first_index, draw.vertex_offset, draw.first_instance);
+        state.draw_calls++;
+      }
+      add_counts(state);
+    }
+
+    // Groups the sorted draws into runs of identical geometry, at most
+    // max_instances long. Draws that already carry instances stay alone.
+    // Returns the batch count.
+    uint32_t build_batches(const DrawCommand *commands, uint32_t max_instances = 1024)
+    {
+      batches.clear();
+      for (uint32_t i = 0; i < size(); i++)
+      {
+        const DrawCommand &draw = commands[items[i].draw];
+        if (!batches.empty())
+        {
+          DrawBatch &last = batches.back();
+          const DrawCommand &first = commands[items[last.first].draw];
+          // Only mesh and material ids decide the run; depth sits below them
+          if (last.count < max_instances && (items[i].key ^ items[last.first].key) >> DRAW_KEY_MESH_SHIFT == 0 && draw.instance_count == 1 &&
+              first.instance_count == 1 && same_geometry(draw, first))
+          {
+            last.count++;
+            continue;
+          }
+        }
+        batches.push_back(DrawBatch{i, 1});
+      }
+      return (uint32_t)batches.size();
+    }
+
+    uint32_t batch_count() const { return (uint32_t)batches.size(); }
+    const DrawBatch *batch_data() const { return batches.data(); }
+
+    // Gathers per-instance data into sorted order, stride bytes per draw.
+    // per_draw is indexed by DrawItem::draw; destination takes size() entries.
+    void write_instances(void *destination, const void *per_draw, uint32_t stride, JobSystem *jobs = &JobSystem::get()) const
+    {
+      auto gather = [&](uint32_t begin, uint32_t end)
+      {
+        for (uint32_t i = begin; i < end; i++)
+          memcpy((uint8_t *)destination + (size_t)i * stride, (const uint8_t *)per_draw + (size_t)items[i].draw * stride, stride);
+      };
+      if (jobs != nullptr && size() >= 16384)
+        jobs->parallel_for(size(), 4096, gather);
+      else
+        gather(0, size());
+    }
+
+    // Records batches begin..end. Per-instance data written by
+    // write_instances() is bound at INSTANCE_VERTEX_BINDING; each batch
+    // reaches its slice through firstInstance, so the binding is set once.
+    void record_batches(VkCommandBuffer command_buffer, uint32_t begin, uint32_t end, const DrawCommand *commands, VkBuffer instance_buffer,
+                        VkDeviceSize instance_offset)
+    {
+      if (begin == end)
+        return;
+      vkCmdBindVertexBuffers(command_buffer, INSTANCE_VERTEX_BINDING, 1, &instance_buffer, &instance_offset);
+      BindState state;
+      for (uint32_t b = begin; b < end; b++)
+      {
+        const DrawBatch &batch = batches[b];
+        const DrawCommand &draw = commands[items[batch.first].draw];
+        bind(command_buffer, draw, state);
+        if (batch.count == 1)
+          vkCmdDrawIndexed(command_buffer, draw.index_count, draw.instance_count, draw.first_index, draw.vertex_offset,
+                           draw.instance_count == 1 ? batch.first : draw.first_instance);
+        else
+          vkCmdDrawIndexed(command_buffer, draw.index_count, batch.count, draw.first_index, draw.vertex_offset, batch.first);
+        state.draw_calls++;
+      }
+      add_counts(state);
+    }
+
+    RenderQueueStats stats() const
+    {
+      RenderQueueStats stats;
+      stats.draws = size();
+      stats.draw_calls = draw_calls;
+      stats.pipeline_binds = pipeline_binds;
+      stats.descriptor_binds = descriptor_binds;
+      stats.material_index_pushes = material_index_pushes;
+      stats.vertex_buffer_binds = vertex_buffer_binds;
+      stats.index_buffer_binds = index_buffer_binds;
+      return stats;
+    }
+  };
+}
+
+#endif
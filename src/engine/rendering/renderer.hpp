@@ -3,16 +3,53 @@
 
 #include "lib/SDL2/include/SDL_video.h"
 #include <imgui.h>
+#include <cstdint>
+#include <vector>
 namespace hades
 {
+  class MappedMesh;
+  class MappedTexture;
+  class RenderQueue;
+
+  enum PresentMode
+  {
+    PRESENT_MODE_FIFO,      // Vsync with a queue of frames: never tears, most latency
+    PRESENT_MODE_MAILBOX,   // Vsync, each new frame replaces the queued one
+    PRESENT_MODE_IMMEDIATE, // No vsync: least latency, tears
+  };
+
+  const uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+  // Throughput against latency; can be changed while running
+  struct RendererSettings
+  {
+    PresentMode present_mode = PRESENT_MODE_FIFO; // Falls back to FIFO when unsupported
+    uint32_t frames_in_flight = 2;                // Frames the CPU may record ahead of the GPU, 1 to MAX_FRAMES_IN_FLIGHT
+    double frame_rate_limit = 0.0;                // Frames per second, 0 for none
+  };
+
   class Renderer
   {
   public:
     explicit Renderer() = default;
 
     virtual void init(SDL_Window *window) = 0;
+    // Applied from the next frame; may be called before init
+    virtual void configure(const RendererSettings &settings) {}
+    // Blocks until the next frame may start: the frame rate limit has passed
+    // and a frame in flight is free. Call right before polling input so the
+    // frame is built from the freshest input.
+    virtual void wait_for_frame() {}
     virtual void render_frame(SDL_Window *window) = 0;
+    // Uploads the listed cooked assets that have no GPU copy yet and releases
+    // the copies of assets no longer listed; called once per frame before render_imgui
+    virtual void sync_assets(const std::vector<const MappedMesh *> &meshes, const std::vector<const MappedTexture *> &textures) {}
+    // Sorted scene draws for the next render_imgui; the queue must stay
+    // alive and unchanged until render_imgui returns
+    virtual void submit_scene(RenderQueue &queue) {}
     virtual void render_imgui(ImDrawData *draw_data) = 0;
+    // Draws renderer statistics windows; called between ImGui::NewFrame and ImGui::Render
+    virtual void render_stats() {}
     virtual void cleanup() = 0;
 
     virtual ~Renderer() = default;
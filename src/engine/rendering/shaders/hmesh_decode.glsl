@@ -0,0 +1,33 @@
+// Vertex stage decode for quantized .hmesh vertices (HMESH_VERTEX_QUANTIZED_*).
+// Bind the attributes from hmesh_vertex_input() and push HMeshDecodeConstants.
+// Unorm16 and half positions both arrive as floats from the input assembler,
+// so one multiply-add restores them; normals are unwrapped from the octahedron.
+//
+// layout(location = 0) in vec4 in_position; // R16G16B16A16_UNORM or _SFLOAT
+// layout(location = 1) in vec2 in_normal;   // R16G16_SNORM, octahedral
+// layout(location = 2) in vec2 in_uv;       // R16G16_UNORM
+
+struct HMeshDecode
+{
+  vec4 position_offset;
+  vec4 position_scale;
+  vec4 uv_offset_scale; // xy offset, zw scale
+};
+
+vec3 hmesh_decode_position(HMeshDecode decode, vec4 stored)
+{
+  return decode.position_offset.xyz + stored.xyz * decode.position_scale.xyz;
+}
+
+vec3 hmesh_decode_normal(vec2 encoded)
+{
+  vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float t = max(-n.z, 0.0);
+  n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+  return normalize(n);
+}
+
+vec2 hmesh_decode_uv(HMeshDecode decode, vec2 stored)
+{
+  return decode.uv_offset_scale.xy + stored * decode.uv_offset_scale.zw;
+}
@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <string>
+#include <vector>
 #include <vulkan/vulkan.h>
 #include <_string.h>
 #include "imgui.h"
@@ -7,8 +11,17 @@
 #include "lib/SDL2/include/SDL_video.h"
 #include <SDL_vulkan.h>
 #include "renderer.hpp"
+#include "frame_pacing.hpp"
+#include "pipeline_cache.hpp"
+#include "render_queue.hpp"
+#include "gpu/allocator.hpp"
+#include "gpu/asset_residency.hpp"
+#include "gpu/descriptor_heap.hpp"
+#include "gpu/frame_allocator.hpp"
+#include "gpu/instance_ring.hpp"
+#include "gpu/parallel_recorder.hpp"
+#include "gpu/upload_queue.hpp"
 
-// #define APP_USE_UNLIMITED_FRAME_RATE
 #ifdef _DEBUG
 #define APP_USE_VULKAN_DEBUG_REPORT
 #endif
@@ -16,20 +29,38 @@
 namespace hades
 {
 
+  // VK_KHR_dynamic_rendering and the extensions it depends on in Vulkan 1.0
+  const char *const DYNAMIC_RENDERING_EXTENSIONS[] = {VK_KHR_MULTIVIEW_EXTENSION_NAME, VK_KHR_MAINTENANCE2_EXTENSION_NAME, VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+                                                      VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME};
+
+  // Per swapchain image
   struct Vulkan_Frame
   {
-    VkCommandPool CommandPool;
-    VkCommandBuffer CommandBuffer;
-    VkFence Fence;
     VkImage Backbuffer;
     VkImageView BackbufferView;
     VkFramebuffer Framebuffer;
+    VkSemaphore RenderCompleteSemaphore; // Per image, so it is not signalled again while a present of the image still waits on it
   };
 
-  struct Vulkan_FrameSemaphores
+  // Per frame in flight, independent of the swapchain
+  struct Vulkan_FrameContext
   {
+    VkCommandPool CommandPool;
+    VkCommandBuffer CommandBuffer;
+    VkFence Fence;
     VkSemaphore ImageAcquiredSemaphore;
-    VkSemaphore RenderCompleteSemaphore;
+    uint64_t Serial; // Submit serial of the last frame recorded here, 0 if none
+  };
+
+  // Swapchain replaced by a resize. Frames still in flight and their presents
+  // may use it, so it is destroyed once the first frame submitted against the
+  // new swapchain retires.
+  struct Vulkan_RetiredSwapchain
+  {
+    VkSwapchainKHR Swapchain;
+    Vulkan_Frame *Frames;
+    uint32_t ImageCount;
+    uint64_t Serial;
   };
 
   // Helper structure to hold the data needed by one rendering context into one OS window
@@ -42,17 +73,17 @@ namespace hades
     VkSurfaceKHR Surface;
     VkSurfaceFormatKHR SurfaceFormat;
     VkPresentModeKHR PresentMode;
-    VkRenderPass RenderPass;
-    VkPipeline Pipeline; // The window pipeline may uses a different VkRenderPass than the one passed in ImGui_ImplVulkan_InitInfo
-    bool UseDynamicRendering;
+    VkRenderPass RenderPass;   // Kept across resizes: it only depends on SurfaceFormat, which is chosen once
+    VkPipeline Pipeline;       // The window pipeline may uses a different VkRenderPass than the one passed in ImGui_ImplVulkan_InitInfo
+    bool UseDynamicRendering;  // Render with VK_KHR_dynamic_rendering, without RenderPass or framebuffers
     bool ClearEnable;
     VkClearValue ClearValue;
-    uint32_t FrameIndex;     // Current frame being rendered to (0 <= FrameIndex < FrameInFlightCount)
-    uint32_t ImageCount;     // Number of simultaneous in-flight frames (returned by vkGetSwapchainImagesKHR, usually derived from min_image_count)
-    uint32_t SemaphoreCount; // Number of simultaneous in-flight frames + 1, to be able to use it in vkAcquireNextImageKHR
-    uint32_t SemaphoreIndex; // Current set of swapchain wait semaphores we're using (needs to be distinct from per frame data)
-    Vulkan_Frame *Frames;
-    Vulkan_FrameSemaphores *FrameSemaphores;
+    uint32_t FrameIndex;     // Frame in flight being recorded (0 <= FrameIndex < FramesInFlight)
+    uint32_t FramesInFlight; // Frames the CPU may record ahead of the GPU
+    uint32_t ImageIndex;     // Swapchain image acquired for the current frame
+    uint32_t ImageCount;     // Number of swapchain images (returned by vkGetSwapchainImagesKHR, usually derived from min_image_count)
+    Vulkan_Frame *Frames;               // One per swapchain image
+    Vulkan_FrameContext *FrameContexts; // One per frame in flight
 
     Vulkan_Window()
     {
@@ -71,6 +102,8 @@ namespace hades
     VkDevice g_Device = VK_NULL_HANDLE;
     uint32_t g_QueueFamily = (uint32_t)-1;
     VkQueue g_Queue = VK_NULL_HANDLE;
+    uint32_t g_TransferQueueFamily = (uint32_t)-1; // Same as g_QueueFamily when there is no dedicated transfer family
+    VkQueue g_TransferQueue = VK_NULL_HANDLE;
     VkDebugReportCallbackEXT g_DebugReport = VK_NULL_HANDLE;
     VkPipelineCache g_PipelineCache = VK_NULL_HANDLE;
     VkDescriptorPool g_DescriptorPool = VK_NULL_HANDLE;
@@ -78,6 +111,44 @@ namespace hades
     uint32_t g_MinImageCount = 2;
     bool g_SwapChainRebuild = false;
 
+    // Pipelines compiled by earlier runs are loaded from here at startup
+    std::string pipeline_cache_dir = "cache";
+    PipelineCache pipeline_cache;
+    double startup_ms = 0.0; // setup_vulkan through ImGui pipeline creation
+    gpu::Allocator allocator;
+    gpu::UploadQueue uploads;
+    // GPU copies of the assets the application holds, uploaded through uploads
+    gpu::AssetResidency residency;
+
+    // Scene draw list, recorded into secondary command buffers by job system
+    // workers. submit_scene fills these in before render_imgui; with
+    // instancing the count is RenderQueue::batch_count().
+    uint32_t scene_draw_count = 0;
+    gpu::RecordRange record_scene_draws;
+    gpu::ParallelRecorder recorder;
+    std::vector<VkCommandBuffer> secondaries;
+    // Per-instance data of batched scene draws, written each frame before
+    // render_imgui and bound by RenderQueue::record_batches
+    gpu::InstanceRing instances;
+    uint64_t frame_serial = 0;
+    // Per-draw and per-view constants, bound through dynamic offsets
+    gpu::FrameAllocator frame_constants;
+    // Bindless textures; only created when the device supports descriptor indexing
+    gpu::DescriptorIndexingSupport descriptor_indexing;
+    gpu::DescriptorHeap textures;
+    // Swapchains replaced by resizes, oldest first
+    std::vector<Vulkan_RetiredSwapchain> retired_swapchains;
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamic_rendering = {};
+    PFN_vkCmdBeginRenderingKHR cmd_begin_rendering = nullptr;
+    PFN_vkCmdEndRenderingKHR cmd_end_rendering = nullptr;
+
+    RendererSettings settings;
+    FrameLimiter limiter;
+    // Time from the input poll after wait_for_frame to vkQueuePresentKHR returning
+    LatencyTracker latency;
+    std::chrono::steady_clock::time_point input_time;
+    bool input_sampled = false;
+
     static void check_vk_result(VkResult err)
     {
       if (err == 0)
@@ -107,6 +178,25 @@ namespace hades
       return false;
     }
 
+    // Fills dynamic_rendering with the features to enable, if the device has them
+    bool query_dynamic_rendering(const ImVector<VkExtensionProperties> &properties)
+    {
+      dynamic_rendering = {};
+      dynamic_rendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+      for (const char *extension : DYNAMIC_RENDERING_EXTENSIONS)
+        if (!IsExtensionAvailable(properties, extension))
+          return false;
+      auto get_features = (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(g_Instance, "vkGetPhysicalDeviceFeatures2KHR");
+      if (get_features == nullptr)
+        return false;
+      VkPhysicalDeviceFeatures2KHR features2 = {};
+      features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+      features2.pNext = &dynamic_rendering;
+      get_features(g_PhysicalDevice, &features2);
+      dynamic_rendering.pNext = nullptr;
+      return dynamic_rendering.dynamicRendering == VK_TRUE;
+    }
+
     VkPhysicalDevice SetupVulkan_SelectPhysicalDevice()
     {
       uint32_t gpu_count;
@@ -219,6 +309,15 @@ namespace hades
             g_QueueFamily = i;
             break;
           }
+        // A transfer-only family maps to the copy engine, which runs uploads
+        // alongside rendering
+        g_TransferQueueFamily = g_QueueFamily;
+        for (uint32_t i = 0; i < count; i++)
+          if ((queues[i].queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queues[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+          {
+            g_TransferQueueFamily = i;
+            break;
+          }
         free(queues);
         assert(g_QueueFamily != (uint32_t)-1);
       }
@@ -238,22 +337,70 @@ namespace hades
         if (IsExtensionAvailable(properties, VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME))
           device_extensions.push_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
 #endif
+        void *features = nullptr;
+        descriptor_indexing = gpu::query_descriptor_indexing(g_Instance, g_PhysicalDevice);
+        if (descriptor_indexing.supported)
+        {
+          for (const char *extension : gpu::DESCRIPTOR_INDEXING_EXTENSIONS)
+            device_extensions.push_back(extension);
+          features = &descriptor_indexing.features;
+        }
+        // Dynamic rendering spares the window a render pass and framebuffers
+        if (query_dynamic_rendering(properties))
+        {
+          for (const char *extension : DYNAMIC_RENDERING_EXTENSIONS)
+            device_extensions.push_back(extension);
+          dynamic_rendering.pNext = features;
+          features = &dynamic_rendering;
+        }
 
         const float queue_priority[] = {1.0f};
-        VkDeviceQueueCreateInfo queue_info[1] = {};
+        VkDeviceQueueCreateInfo queue_info[2] = {};
         queue_info[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         queue_info[0].queueFamilyIndex = g_QueueFamily;
         queue_info[0].queueCount = 1;
         queue_info[0].pQueuePriorities = queue_priority;
+        queue_info[1] = queue_info[0];
+        queue_info[1].queueFamilyIndex = g_TransferQueueFamily;
         VkDeviceCreateInfo create_info = {};
         create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-        create_info.queueCreateInfoCount = sizeof(queue_info) / sizeof(queue_info[0]);
+        create_info.pNext = features;
+        create_info.queueCreateInfoCount = g_TransferQueueFamily != g_QueueFamily ? 2 : 1;
         create_info.pQueueCreateInfos = queue_info;
         create_info.enabledExtensionCount = (uint32_t)device_extensions.Size;
         create_info.ppEnabledExtensionNames = device_extensions.Data;
         err = vkCreateDevice(g_PhysicalDevice, &create_info, g_Allocator, &g_Device);
         check_vk_result(err);
         vkGetDeviceQueue(g_Device, g_QueueFamily, 0, &g_Queue);
+        vkGetDeviceQueue(g_Device, g_TransferQueueFamily, 0, &g_TransferQueue);
+        if (dynamic_rendering.dynamicRendering)
+        {
+          cmd_begin_rendering = (PFN_vkCmdBeginRenderingKHR)vkGetDeviceProcAddr(g_Device, "vkCmdBeginRenderingKHR");
+          cmd_end_rendering = (PFN_vkCmdEndRenderingKHR)vkGetDeviceProcAddr(g_Device, "vkCmdEndRenderingKHR");
+          g_MainWindowData.UseDynamicRendering = cmd_begin_rendering != nullptr && cmd_end_rendering != nullptr;
+        }
+      }
+
+      // Create Pipeline Cache, seeded from the previous run when the driver matches
+      {
+        err = pipeline_cache.create(g_PhysicalDevice, g_Device, g_Allocator, pipeline_cache_dir);
+        check_vk_result(err);
+        g_PipelineCache = pipeline_cache.handle();
+        if (pipeline_cache.state() == PIPELINE_CACHE_REJECTED)
+          fprintf(stderr, "[vulkan] Discarding stale pipeline cache %s\n", pipeline_cache.file().c_str());
+      }
+
+      allocator.init(g_PhysicalDevice, g_Device, g_Allocator);
+      err = uploads.init(allocator, g_Device, g_Allocator, g_TransferQueue, g_TransferQueueFamily, g_QueueFamily);
+      check_vk_result(err);
+      residency.init(allocator, uploads, g_Device, g_Allocator);
+      err = instances.init(allocator, 16ull << 20);
+      check_vk_result(err);
+      if (descriptor_indexing.supported)
+      {
+        err = textures.init(g_Device, g_Allocator, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1024, std::min(descriptor_indexing.max_combined_image_samplers, 1u << 16),
+                            VK_SHADER_STAGE_FRAGMENT_BIT);
+        check_vk_result(err);
       }
 
       // Create Descriptor Pool
@@ -372,23 +519,59 @@ namespace hades
       g_MainWindowData.SurfaceFormat = VulkanH_SelectSurfaceFormat(g_PhysicalDevice, g_MainWindowData.Surface, requestSurfaceImageFormat, (size_t)IM_ARRAYSIZE(requestSurfaceImageFormat), requestSurfaceColorSpace);
 
       // Select Present Mode
-#ifdef APP_UNLIMITED_FRAME_RATE
-      VkPresentModeKHR present_modes[] = {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_FIFO_KHR};
-#else
-      VkPresentModeKHR present_modes[] = {VK_PRESENT_MODE_FIFO_KHR};
-#endif
-      g_MainWindowData.PresentMode = VulkanH_SelectPresentMode(g_PhysicalDevice, g_MainWindowData.Surface, &present_modes[0], IM_ARRAYSIZE(present_modes));
-      // printf("[vulkan] Selected PresentMode = %d\n", g_MainWindowData.PresentMode);
+      select_present_mode();
 
       // Create SwapChain, RenderPass, Framebuffer, etc.
       assert(g_MinImageCount >= 2);
+      g_MainWindowData.FramesInFlight = settings.frames_in_flight;
       VulkanH_CreateOrResizeWindow(g_Instance, g_PhysicalDevice, g_Device, g_QueueFamily, g_Allocator, width, height, g_MinImageCount);
+      err = recorder.init(g_Device, g_Allocator, g_QueueFamily, g_MainWindowData.FramesInFlight);
+      check_vk_result(err);
+      err = frame_constants.init(allocator, g_PhysicalDevice, g_MainWindowData.FramesInFlight, 4ull << 20);
+      check_vk_result(err);
+    }
+
+    // Picks the settings' present mode if the surface has it, FIFO otherwise
+    void select_present_mode()
+    {
+      const VkPresentModeKHR modes[] = {VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR};
+      const VkPresentModeKHR present_modes[] = {modes[settings.present_mode], VK_PRESENT_MODE_FIFO_KHR};
+      g_MainWindowData.PresentMode = VulkanH_SelectPresentMode(g_PhysicalDevice, g_MainWindowData.Surface, &present_modes[0], IM_ARRAYSIZE(present_modes));
+      g_MinImageCount = std::max(2, VulkanH_GetMinImageCountFromPresentMode(g_MainWindowData.PresentMode));
+    }
+
+    // Recreates the frame contexts; idles the device
+    void set_frames_in_flight(uint32_t count)
+    {
+      VkResult err = vkDeviceWaitIdle(g_Device);
+      check_vk_result(err);
+      instances.retire(frame_serial);
+      textures.retire(frame_serial);
+      residency.retire(frame_serial);
+      VulkanH_RetireSwapchains(g_Device, g_Allocator, frame_serial);
+      VulkanH_DestroyFrameContexts(g_Device, g_Allocator);
+      g_MainWindowData.FramesInFlight = count;
+      VulkanH_CreateFrameContexts(g_Device, g_QueueFamily, g_Allocator);
+      err = recorder.resize(count);
+      check_vk_result(err);
+      err = frame_constants.resize(count);
+      check_vk_result(err);
     }
 
     void CleanupVulkan()
     {
       vkDestroyDescriptorPool(g_Device, g_DescriptorPool, g_Allocator);
 
+      if (!pipeline_cache.save())
+        fprintf(stderr, "[vulkan] Failed to write pipeline cache %s\n", pipeline_cache.file().c_str());
+      pipeline_cache.destroy();
+      g_PipelineCache = VK_NULL_HANDLE;
+      residency.destroy();
+      uploads.destroy();
+      instances.destroy();
+      textures.destroy();
+      allocator.destroy();
+
 #ifdef APP_USE_VULKAN_DEBUG_REPORT
       // Remove the debug report callback
       auto f_vkDestroyDebugReportCallbackEXT = (PFN_vkDestroyDebugReportCallbackEXT)vkGetInstanceProcAddr(g_Instance, "vkDestroyDebugReportCallbackEXT");
@@ -401,40 +584,81 @@ namespace hades
 
     void CleanupVulkanWindow()
     {
+      recorder.destroy();
+      frame_constants.destroy();
       VulkanH_DestroyWindow(g_Instance, g_Device, g_Allocator);
     }
 
-    void FrameRender(ImDrawData *draw_data)
+    // Returns false when the swapchain is out of date and nothing was submitted
+    bool FrameRender(ImDrawData *draw_data)
     {
       VkResult err;
 
-      VkSemaphore image_acquired_semaphore = g_MainWindowData.FrameSemaphores[g_MainWindowData.SemaphoreIndex].ImageAcquiredSemaphore;
-      VkSemaphore render_complete_semaphore = g_MainWindowData.FrameSemaphores[g_MainWindowData.SemaphoreIndex].RenderCompleteSemaphore;
-      err = vkAcquireNextImageKHR(g_Device, g_MainWindowData.Swapchain, UINT64_MAX, image_acquired_semaphore, VK_NULL_HANDLE, &g_MainWindowData.FrameIndex);
-      if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
+      Vulkan_FrameContext *fc = &g_MainWindowData.FrameContexts[g_MainWindowData.FrameIndex];
       {
-        g_SwapChainRebuild = true;
-        return;
+        // Usually already signalled, wait_for_frame waited on it
+        err = vkWaitForFences(g_Device, 1, &fc->Fence, VK_TRUE, UINT64_MAX);
+        check_vk_result(err);
       }
-      check_vk_result(err);
 
-      Vulkan_Frame *fd = &g_MainWindowData.Frames[g_MainWindowData.FrameIndex];
+      err = vkAcquireNextImageKHR(g_Device, g_MainWindowData.Swapchain, UINT64_MAX, fc->ImageAcquiredSemaphore, VK_NULL_HANDLE, &g_MainWindowData.ImageIndex);
+      if (err == VK_ERROR_OUT_OF_DATE_KHR)
       {
-        err = vkWaitForFences(g_Device, 1, &fd->Fence, VK_TRUE, UINT64_MAX); // wait indefinitely instead of periodically checking
+        g_SwapChainRebuild = true;
+        return false;
+      }
+      // A suboptimal image is still acquired, so render and present it first
+      if (err == VK_SUBOPTIMAL_KHR)
+        g_SwapChainRebuild = true;
+      else
         check_vk_result(err);
+      Vulkan_Frame *fd = &g_MainWindowData.Frames[g_MainWindowData.ImageIndex];
+
+      // Uploads staged since the last frame start copying now
+      uploads.flush();
 
-        err = vkResetFences(g_Device, 1, &fd->Fence);
+      {
+        err = vkResetFences(g_Device, 1, &fc->Fence);
         check_vk_result(err);
+        instances.retire(fc->Serial);
+        textures.retire(fc->Serial);
+        residency.retire(fc->Serial);
+        VulkanH_RetireSwapchains(g_Device, g_Allocator, fc->Serial);
       }
+      recorder.begin_frame(g_MainWindowData.FrameIndex);
+      frame_constants.begin_frame(g_MainWindowData.FrameIndex);
       {
-        err = vkResetCommandPool(g_Device, fd->CommandPool, 0);
+        err = vkResetCommandPool(g_Device, fc->CommandPool, 0);
         check_vk_result(err);
         VkCommandBufferBeginInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        err = vkBeginCommandBuffer(fd->CommandBuffer, &info);
+        err = vkBeginCommandBuffer(fc->CommandBuffer, &info);
         check_vk_result(err);
+        uploads.record_acquires(fc->CommandBuffer);
+      }
+      const bool parallel = scene_draw_count > 0 && record_scene_draws;
+      if (g_MainWindowData.UseDynamicRendering)
+      {
+        VulkanH_TransitionBackbuffer(fc->CommandBuffer, fd->Backbuffer, false);
+        VkRenderingAttachmentInfoKHR attachment = {};
+        attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        attachment.imageView = fd->BackbufferView;
+        attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        attachment.loadOp = g_MainWindowData.ClearEnable ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.clearValue = g_MainWindowData.ClearValue;
+        VkRenderingInfoKHR info = {};
+        info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        info.flags = parallel ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+        info.renderArea.extent.width = g_MainWindowData.Width;
+        info.renderArea.extent.height = g_MainWindowData.Height;
+        info.layerCount = 1;
+        info.colorAttachmentCount = 1;
+        info.pColorAttachments = &attachment;
+        cmd_begin_rendering(fc->CommandBuffer, &info);
       }
+      else
       {
         VkRenderPassBeginInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -444,105 +668,152 @@ namespace hades
         info.renderArea.extent.height = g_MainWindowData.Height;
         info.clearValueCount = 1;
         info.pClearValues = &g_MainWindowData.ClearValue;
-        vkCmdBeginRenderPass(fd->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBeginRenderPass(fc->CommandBuffer, &info, parallel ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
       }
 
-      // Record dear imgui primitives into command buffer
-      ImGui_ImplVulkan_RenderDrawData(draw_data, fd->CommandBuffer);
+      if (parallel)
+      {
+        // A subpass takes either inline commands or secondaries, so dear
+        // imgui gets a secondary of its own after the scene's
+        VkCommandBufferInheritanceRenderingInfoKHR rendering = {};
+        rendering.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+        rendering.colorAttachmentCount = 1;
+        rendering.pColorAttachmentFormats = &g_MainWindowData.SurfaceFormat.format;
+        rendering.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+        VkCommandBufferInheritanceInfo inheritance = {};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.pNext = g_MainWindowData.UseDynamicRendering ? &rendering : nullptr;
+        inheritance.renderPass = g_MainWindowData.RenderPass;
+        inheritance.subpass = 0;
+        inheritance.framebuffer = fd->Framebuffer;
+        secondaries.clear();
+        recorder.record(inheritance, scene_draw_count, record_scene_draws, secondaries);
+        secondaries.push_back(recorder.record_secondary(inheritance, [draw_data](VkCommandBuffer commands)
+                                                        { ImGui_ImplVulkan_RenderDrawData(draw_data, commands); }));
+        vkCmdExecuteCommands(fc->CommandBuffer, (uint32_t)secondaries.size(), secondaries.data());
+      }
+      else
+      {
+        // Record dear imgui primitives into command buffer
+        ImGui_ImplVulkan_RenderDrawData(draw_data, fc->CommandBuffer);
+      }
 
       // Submit command buffer
-      vkCmdEndRenderPass(fd->CommandBuffer);
+      if (g_MainWindowData.UseDynamicRendering)
+      {
+        cmd_end_rendering(fc->CommandBuffer);
+        VulkanH_TransitionBackbuffer(fc->CommandBuffer, fd->Backbuffer, true);
+      }
+      else
+        vkCmdEndRenderPass(fc->CommandBuffer);
       {
         VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         VkSubmitInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         info.waitSemaphoreCount = 1;
-        info.pWaitSemaphores = &image_acquired_semaphore;
+        info.pWaitSemaphores = &fc->ImageAcquiredSemaphore;
         info.pWaitDstStageMask = &wait_stage;
         info.commandBufferCount = 1;
-        info.pCommandBuffers = &fd->CommandBuffer;
+        info.pCommandBuffers = &fc->CommandBuffer;
         info.signalSemaphoreCount = 1;
-        info.pSignalSemaphores = &render_complete_semaphore;
+        info.pSignalSemaphores = &fd->RenderCompleteSemaphore;
 
-        err = vkEndCommandBuffer(fd->CommandBuffer);
+        err = vkEndCommandBuffer(fc->CommandBuffer);
         check_vk_result(err);
-        err = vkQueueSubmit(g_Queue, 1, &info, fd->Fence);
+        fc->Serial = ++frame_serial;
+        instances.end_frame(fc->Serial);
+        textures.end_frame(fc->Serial);
+        residency.end_frame(fc->Serial);
+        frame_constants.end_frame();
+        err = vkQueueSubmit(g_Queue, 1, &info, fc->Fence);
         check_vk_result(err);
       }
+      g_MainWindowData.FrameIndex = (g_MainWindowData.FrameIndex + 1) % g_MainWindowData.FramesInFlight;
+      return true;
     }
 
     void FramePresent()
     {
-      if (g_SwapChainRebuild)
-        return;
-      VkSemaphore render_complete_semaphore = g_MainWindowData.FrameSemaphores[g_MainWindowData.SemaphoreIndex].RenderCompleteSemaphore;
       VkPresentInfoKHR info = {};
       info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
       info.waitSemaphoreCount = 1;
-      info.pWaitSemaphores = &render_complete_semaphore;
+      info.pWaitSemaphores = &g_MainWindowData.Frames[g_MainWindowData.ImageIndex].RenderCompleteSemaphore;
       info.swapchainCount = 1;
       info.pSwapchains = &g_MainWindowData.Swapchain;
-      info.pImageIndices = &g_MainWindowData.FrameIndex;
+      info.pImageIndices = &g_MainWindowData.ImageIndex;
       VkResult err = vkQueuePresentKHR(g_Queue, &info);
+      if (input_sampled)
+      {
+        latency.add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - input_time).count());
+        input_sampled = false;
+      }
       if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
       {
         g_SwapChainRebuild = true;
         return;
       }
       check_vk_result(err);
-      g_MainWindowData.SemaphoreIndex = (g_MainWindowData.SemaphoreIndex + 1) % g_MainWindowData.SemaphoreCount; // Now we can use the next set of semaphores
     }
 
-    void VulkanH_CreateWindowCommandBuffers(VkPhysicalDevice physical_device, VkDevice device, uint32_t queue_family, const VkAllocationCallbacks *allocator)
+    void VulkanH_CreateFrameContexts(VkDevice device, uint32_t queue_family, const VkAllocationCallbacks *allocator)
     {
-      assert(physical_device != VK_NULL_HANDLE && device != VK_NULL_HANDLE);
-      IM_UNUSED(physical_device);
+      assert(device != VK_NULL_HANDLE && g_MainWindowData.FrameContexts == nullptr);
+      g_MainWindowData.FrameIndex = 0;
+      g_MainWindowData.FrameContexts = (Vulkan_FrameContext *)IM_ALLOC(sizeof(Vulkan_FrameContext) * g_MainWindowData.FramesInFlight);
+      memset(g_MainWindowData.FrameContexts, 0, sizeof(g_MainWindowData.FrameContexts[0]) * g_MainWindowData.FramesInFlight);
 
       // Create Command Buffers
       VkResult err;
-      for (uint32_t i = 0; i < g_MainWindowData.ImageCount; i++)
+      for (uint32_t i = 0; i < g_MainWindowData.FramesInFlight; i++)
       {
-        Vulkan_Frame *fd = &g_MainWindowData.Frames[i];
+        Vulkan_FrameContext *fc = &g_MainWindowData.FrameContexts[i];
         {
           VkCommandPoolCreateInfo info = {};
           info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
           info.flags = 0;
           info.queueFamilyIndex = queue_family;
-          err = vkCreateCommandPool(device, &info, allocator, &fd->CommandPool);
+          err = vkCreateCommandPool(device, &info, allocator, &fc->CommandPool);
           check_vk_result(err);
         }
         {
           VkCommandBufferAllocateInfo info = {};
           info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-          info.commandPool = fd->CommandPool;
+          info.commandPool = fc->CommandPool;
           info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
           info.commandBufferCount = 1;
-          err = vkAllocateCommandBuffers(device, &info, &fd->CommandBuffer);
+          err = vkAllocateCommandBuffers(device, &info, &fc->CommandBuffer);
           check_vk_result(err);
         }
         {
           VkFenceCreateInfo info = {};
           info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
           info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-          err = vkCreateFence(device, &info, allocator, &fd->Fence);
+          err = vkCreateFence(device, &info, allocator, &fc->Fence);
           check_vk_result(err);
         }
-      }
-
-      for (uint32_t i = 0; i < g_MainWindowData.SemaphoreCount; i++)
-      {
-        Vulkan_FrameSemaphores *fsd = &g_MainWindowData.FrameSemaphores[i];
         {
           VkSemaphoreCreateInfo info = {};
           info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-          err = vkCreateSemaphore(device, &info, allocator, &fsd->ImageAcquiredSemaphore);
-          check_vk_result(err);
-          err = vkCreateSemaphore(device, &info, allocator, &fsd->RenderCompleteSemaphore);
+          err = vkCreateSemaphore(device, &info, allocator, &fc->ImageAcquiredSemaphore);
           check_vk_result(err);
         }
       }
     }
 
+    void VulkanH_DestroyFrameContexts(VkDevice device, const VkAllocationCallbacks *allocator)
+    {
+      for (uint32_t i = 0; g_MainWindowData.FrameContexts != nullptr && i < g_MainWindowData.FramesInFlight; i++)
+      {
+        Vulkan_FrameContext *fc = &g_MainWindowData.FrameContexts[i];
+        vkDestroyFence(device, fc->Fence, allocator);
+        vkFreeCommandBuffers(device, fc->CommandPool, 1, &fc->CommandBuffer);
+        vkDestroyCommandPool(device, fc->CommandPool, allocator);
+        vkDestroySemaphore(device, fc->ImageAcquiredSemaphore, allocator);
+      }
+      IM_FREE(g_MainWindowData.FrameContexts);
+      g_MainWindowData.FrameContexts = nullptr;
+    }
+
     int VulkanH_GetMinImageCountFromPresentMode(VkPresentModeKHR present_mode)
     {
       if (present_mode == VK_PRESENT_MODE_MAILBOX_KHR)
@@ -555,30 +826,28 @@ namespace hades
       return 1;
     }
 
-    // Also destroy old swap chain and in-flight frames data, if any.
+    // Retires the old swap chain and its frames data, if any, without waiting
+    // for the device: frames in flight keep using them until they retire.
     void VulkanH_CreateWindowSwapChain(VkPhysicalDevice physical_device, VkDevice device, const VkAllocationCallbacks *allocator, int w, int h, uint32_t min_image_count)
     {
       VkResult err;
       VkSwapchainKHR old_swapchain = g_MainWindowData.Swapchain;
       g_MainWindowData.Swapchain = VK_NULL_HANDLE;
-      err = vkDeviceWaitIdle(device);
-      check_vk_result(err);
 
       // We don't use Vulkan_DestroyWindow() because we want to preserve the old swapchain to create the new one.
-      // Destroy old Framebuffer
-      for (uint32_t i = 0; i < g_MainWindowData.ImageCount; i++)
-        VulkanH_DestroyFrame(device, &g_MainWindowData.Frames[i], allocator);
-      for (uint32_t i = 0; i < g_MainWindowData.SemaphoreCount; i++)
-        VulkanH_DestroyFrameSemaphores(device, &g_MainWindowData.FrameSemaphores[i], allocator);
-      IM_FREE(g_MainWindowData.Frames);
-      IM_FREE(g_MainWindowData.FrameSemaphores);
+      if (old_swapchain != VK_NULL_HANDLE || g_MainWindowData.Frames != nullptr)
+      {
+        Vulkan_RetiredSwapchain retired = {};
+        retired.Swapchain = old_swapchain;
+        retired.Frames = g_MainWindowData.Frames;
+        retired.ImageCount = g_MainWindowData.ImageCount;
+        // The last present to the old swapchain carries no fence, so wait for
+        // the first frame submitted after it rather than the last one before
+        retired.Serial = frame_serial + 1;
+        retired_swapchains.push_back(retired);
+      }
       g_MainWindowData.Frames = nullptr;
-      g_MainWindowData.FrameSemaphores = nullptr;
       g_MainWindowData.ImageCount = 0;
-      if (g_MainWindowData.RenderPass)
-        vkDestroyRenderPass(device, g_MainWindowData.RenderPass, allocator);
-      if (g_MainWindowData.Pipeline)
-        vkDestroyPipeline(device, g_MainWindowData.Pipeline, allocator);
 
       // If min image count was not specified, request different count of images dependent on selected present mode
       if (min_image_count == 0)
@@ -627,20 +896,26 @@ namespace hades
         err = vkGetSwapchainImagesKHR(device, g_MainWindowData.Swapchain, &g_MainWindowData.ImageCount, backbuffers);
         check_vk_result(err);
 
-        assert(g_MainWindowData.Frames == nullptr && g_MainWindowData.FrameSemaphores == nullptr);
-        g_MainWindowData.SemaphoreCount = g_MainWindowData.ImageCount + 1;
+        assert(g_MainWindowData.Frames == nullptr);
         g_MainWindowData.Frames = (Vulkan_Frame *)IM_ALLOC(sizeof(Vulkan_Frame) * g_MainWindowData.ImageCount);
-        g_MainWindowData.FrameSemaphores = (Vulkan_FrameSemaphores *)IM_ALLOC(sizeof(Vulkan_FrameSemaphores) * g_MainWindowData.SemaphoreCount);
         memset(g_MainWindowData.Frames, 0, sizeof(g_MainWindowData.Frames[0]) * g_MainWindowData.ImageCount);
-        memset(g_MainWindowData.FrameSemaphores, 0, sizeof(g_MainWindowData.FrameSemaphores[0]) * g_MainWindowData.SemaphoreCount);
         for (uint32_t i = 0; i < g_MainWindowData.ImageCount; i++)
           g_MainWindowData.Frames[i].Backbuffer = backbuffers[i];
       }
-      if (old_swapchain)
-        vkDestroySwapchainKHR(device, old_swapchain, allocator);
+
+      // Create the present semaphores
+      {
+        VkSemaphoreCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        for (uint32_t i = 0; i < g_MainWindowData.ImageCount; i++)
+        {
+          err = vkCreateSemaphore(device, &info, allocator, &g_MainWindowData.Frames[i].RenderCompleteSemaphore);
+          check_vk_result(err);
+        }
+      }
 
       // Create the Render Pass
-      if (g_MainWindowData.UseDynamicRendering == false)
+      if (g_MainWindowData.UseDynamicRendering == false && g_MainWindowData.RenderPass == VK_NULL_HANDLE)
       {
         VkAttachmentDescription attachment = {};
         attachment.format = g_MainWindowData.SurfaceFormat.format;
@@ -702,7 +977,7 @@ namespace hades
         }
       }
 
-      // Create Framebuffer
+      // Create Framebuffer; dynamic rendering draws straight into the views
       if (g_MainWindowData.UseDynamicRendering == false)
       {
         VkImageView attachment[1];
@@ -729,7 +1004,25 @@ namespace hades
     {
       (void)instance;
       VulkanH_CreateWindowSwapChain(physical_device, device, allocator, width, height, min_image_count);
-      VulkanH_CreateWindowCommandBuffers(physical_device, device, queue_family, allocator);
+      // Frames in flight do not depend on the swapchain and survive its rebuilds
+      if (g_MainWindowData.FrameContexts == nullptr)
+        VulkanH_CreateFrameContexts(device, queue_family, allocator);
+    }
+
+    // Destroys the swapchains retired up to serial. The fence of that frame
+    // must have signalled.
+    void VulkanH_RetireSwapchains(VkDevice device, const VkAllocationCallbacks *allocator, uint64_t serial)
+    {
+      size_t count = 0;
+      while (count < retired_swapchains.size() && retired_swapchains[count].Serial <= serial)
+      {
+        Vulkan_RetiredSwapchain &retired = retired_swapchains[count++];
+        for (uint32_t i = 0; i < retired.ImageCount; i++)
+          VulkanH_DestroyFrame(device, &retired.Frames[i], allocator);
+        IM_FREE(retired.Frames);
+        vkDestroySwapchainKHR(device, retired.Swapchain, allocator);
+      }
+      retired_swapchains.erase(retired_swapchains.begin(), retired_swapchains.begin() + count);
     }
 
     void VulkanH_DestroyWindow(VkInstance instance, VkDevice device, const VkAllocationCallbacks *allocator)
@@ -737,14 +1030,13 @@ namespace hades
       vkDeviceWaitIdle(device);
       vkQueueWaitIdle(g_Queue);
 
+      VulkanH_RetireSwapchains(device, allocator, UINT64_MAX);
+
       for (uint32_t i = 0; i < g_MainWindowData.ImageCount; i++)
         VulkanH_DestroyFrame(device, &g_MainWindowData.Frames[i], allocator);
-      for (uint32_t i = 0; i < g_MainWindowData.SemaphoreCount; i++)
-        VulkanH_DestroyFrameSemaphores(device, &g_MainWindowData.FrameSemaphores[i], allocator);
       IM_FREE(g_MainWindowData.Frames);
-      IM_FREE(g_MainWindowData.FrameSemaphores);
       g_MainWindowData.Frames = nullptr;
-      g_MainWindowData.FrameSemaphores = nullptr;
+      VulkanH_DestroyFrameContexts(device, allocator);
       vkDestroyPipeline(device, g_MainWindowData.Pipeline, allocator);
       vkDestroyRenderPass(device, g_MainWindowData.RenderPass, allocator);
       vkDestroySwapchainKHR(device, g_MainWindowData.Swapchain, allocator);
@@ -753,28 +1045,35 @@ namespace hades
       g_MainWindowData = Vulkan_Window();
     }
 
-    void VulkanH_DestroyFrame(VkDevice device, Vulkan_Frame *fd, const VkAllocationCallbacks *allocator)
+    // The layout changes a render pass would make, for dynamic rendering
+    void VulkanH_TransitionBackbuffer(VkCommandBuffer command_buffer, VkImage image, bool to_present)
     {
-      vkDestroyFence(device, fd->Fence, allocator);
-      vkFreeCommandBuffers(device, fd->CommandPool, 1, &fd->CommandBuffer);
-      vkDestroyCommandPool(device, fd->CommandPool, allocator);
-      fd->Fence = VK_NULL_HANDLE;
-      fd->CommandBuffer = VK_NULL_HANDLE;
-      fd->CommandPool = VK_NULL_HANDLE;
-
-      vkDestroyImageView(device, fd->BackbufferView, allocator);
-      vkDestroyFramebuffer(device, fd->Framebuffer, allocator);
+      VkImageMemoryBarrier barrier = {};
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask = to_present ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT : 0;
+      barrier.dstAccessMask = to_present ? 0 : VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+      barrier.oldLayout = to_present ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+      barrier.newLayout = to_present ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image = image;
+      barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+      // The acquire semaphore is waited on at this source stage, as in the render pass dependency
+      vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                           to_present ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
     }
 
-    void VulkanH_DestroyFrameSemaphores(VkDevice device, Vulkan_FrameSemaphores *fsd, const VkAllocationCallbacks *allocator)
+    void VulkanH_DestroyFrame(VkDevice device, Vulkan_Frame *fd, const VkAllocationCallbacks *allocator)
     {
-      vkDestroySemaphore(device, fsd->ImageAcquiredSemaphore, allocator);
-      vkDestroySemaphore(device, fsd->RenderCompleteSemaphore, allocator);
-      fsd->ImageAcquiredSemaphore = fsd->RenderCompleteSemaphore = VK_NULL_HANDLE;
+      vkDestroySemaphore(device, fd->RenderCompleteSemaphore, allocator);
+      vkDestroyImageView(device, fd->BackbufferView, allocator);
+      vkDestroyFramebuffer(device, fd->Framebuffer, allocator);
+      fd->RenderCompleteSemaphore = VK_NULL_HANDLE;
     }
 
     void init(SDL_Window *window)
     {
+      const auto start = std::chrono::steady_clock::now();
       setup_vulkan(window);
       setup_window(window);
 
@@ -799,12 +1098,52 @@ namespace hades
       init_info.DescriptorPool = g_DescriptorPool;
       init_info.RenderPass = g_MainWindowData.RenderPass;
       init_info.Subpass = 0;
+      init_info.UseDynamicRendering = g_MainWindowData.UseDynamicRendering;
+      init_info.PipelineRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+      init_info.PipelineRenderingCreateInfo.colorAttachmentCount = 1;
+      init_info.PipelineRenderingCreateInfo.pColorAttachmentFormats = &g_MainWindowData.SurfaceFormat.format;
       init_info.MinImageCount = g_MinImageCount;
-      init_info.ImageCount = g_MainWindowData.ImageCount;
+      // dear imgui cycles its vertex buffers by this count, so it has to cover every frame in flight
+      init_info.ImageCount = std::max(g_MainWindowData.ImageCount, MAX_FRAMES_IN_FLIGHT);
       init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
       init_info.Allocator = g_Allocator;
       init_info.CheckVkResultFn = check_vk_result;
       ImGui_ImplVulkan_Init(&init_info);
+
+      startup_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      const char *cache_state[] = {"empty", "loaded", "rejected"};
+      printf("[vulkan] Startup %.1f ms (pipeline cache %s, %zu bytes)\n", startup_ms, cache_state[pipeline_cache.state()], pipeline_cache.initial_size());
+    }
+
+    void configure(const RendererSettings &new_settings) override
+    {
+      const RendererSettings previous = settings;
+      settings = new_settings;
+      settings.frames_in_flight = std::min(std::max(settings.frames_in_flight, 1u), MAX_FRAMES_IN_FLIGHT);
+      if (settings.frame_rate_limit != previous.frame_rate_limit)
+        limiter.set_rate(settings.frame_rate_limit);
+      if (settings.present_mode != previous.present_mode || settings.frames_in_flight != previous.frames_in_flight)
+        latency.clear();
+      // Frames in flight change in render_frame, at the start of the next frame
+      if (settings.present_mode != previous.present_mode && g_MainWindowData.Surface != VK_NULL_HANDLE)
+      {
+        select_present_mode();
+        g_SwapChainRebuild = true;
+      }
+    }
+
+    void wait_for_frame() override
+    {
+      limiter.wait();
+      // Waiting for the frame in flight here rather than in FrameRender
+      // keeps time spent behind the GPU out of input latency
+      if (g_MainWindowData.FrameContexts != nullptr)
+      {
+        VkResult err = vkWaitForFences(g_Device, 1, &g_MainWindowData.FrameContexts[g_MainWindowData.FrameIndex].Fence, VK_TRUE, UINT64_MAX);
+        check_vk_result(err);
+      }
+      input_time = std::chrono::steady_clock::now();
+      input_sampled = true;
     }
 
     void render_frame(SDL_Window *window)
@@ -812,17 +1151,33 @@ namespace hades
       int fb_width, fb_height;
       SDL_GetWindowSize(window, &fb_width, &fb_height);
 
+      if (g_MainWindowData.FramesInFlight != settings.frames_in_flight)
+        set_frames_in_flight(settings.frames_in_flight);
+
       // Resize swap chain?
 
       if (fb_width > 0 && fb_height > 0 && (g_SwapChainRebuild || g_MainWindowData.Width != fb_width || g_MainWindowData.Height != fb_height))
       {
         ImGui_ImplVulkan_SetMinImageCount(g_MinImageCount);
         VulkanH_CreateOrResizeWindow(g_Instance, g_PhysicalDevice, g_Device, g_QueueFamily, g_Allocator, fb_width, fb_height, g_MinImageCount);
-        g_MainWindowData.FrameIndex = 0;
         g_SwapChainRebuild = false;
       }
     }
 
+    void sync_assets(const std::vector<const MappedMesh *> &meshes, const std::vector<const MappedTexture *> &textures) override
+    {
+      residency.sync(meshes, textures);
+    }
+
+    void submit_scene(RenderQueue &queue) override
+    {
+      scene_draw_count = queue.size();
+      // There are no scene pipelines to build DrawCommands from yet, so each
+      // range is recorded as an empty secondary. The frame still takes the
+      // parallel path, and RenderQueue::record slots in here once they exist.
+      record_scene_draws = [](VkCommandBuffer, uint32_t, uint32_t) {};
+    }
+
     void render_imgui(ImDrawData *draw_data)
     {
       ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
@@ -831,8 +1186,71 @@ namespace hades
       g_MainWindowData.ClearValue.color.float32[1] = clear_color.y * clear_color.w;
       g_MainWindowData.ClearValue.color.float32[2] = clear_color.z * clear_color.w;
       g_MainWindowData.ClearValue.color.float32[3] = clear_color.w;
-      FrameRender(draw_data);
-      FramePresent();
+      if (FrameRender(draw_data))
+        FramePresent();
+    }
+
+    void render_stats()
+    {
+      const gpu::AllocatorStats stats = allocator.stats();
+      ImGui::Begin("GPU Memory");
+      ImGui::Text("%u device allocations of %u allowed (%u dedicated)", stats.device_allocations, stats.device_allocation_limit, stats.dedicated);
+      ImGui::Text("%u resources, %.1f MB used of %.1f MB reserved", stats.allocations, stats.used / 1048576.0, stats.reserved / 1048576.0);
+      const VkPhysicalDeviceMemoryProperties &memory = allocator.properties();
+      for (uint32_t type = 0; type < stats.memory_type_count; type++)
+      {
+        const gpu::MemoryTypeStats &usage = stats.types[type];
+        if (usage.blocks == 0)
+          continue;
+        const VkMemoryPropertyFlags flags = memory.memoryTypes[type].propertyFlags;
+        ImGui::Text("Type %u%s%s: %u blocks, %u allocations, %.1f / %.1f MB, largest free %.1f MB", type,
+                    (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) ? " device" : "", (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? " host" : "",
+                    usage.blocks, usage.allocations, usage.used / 1048576.0, usage.reserved / 1048576.0, usage.largest_free / 1048576.0);
+      }
+      const gpu::UploadStats upload = uploads.stats();
+      ImGui::Separator();
+      ImGui::Text("Uploads on the %s queue: %.1f / %.1f MB staged, %.1f MB this frame", uploads.uses_transfer_queue() ? "transfer" : "graphics",
+                  upload.ring_used / 1048576.0, upload.ring_size / 1048576.0, upload.frame_bytes / 1048576.0);
+      ImGui::Text("%llu batches, %.1f MB total, %llu deferred, %llu stalls", (unsigned long long)upload.batches, upload.total_bytes / 1048576.0,
+                  (unsigned long long)upload.deferred, (unsigned long long)upload.stalls);
+      const gpu::AssetResidencyStats resident = residency.stats();
+      ImGui::Text("Resident assets: %u meshes, %u textures, %.1f MB; %u uploading, %u waiting for budget", resident.meshes, resident.textures,
+                  resident.bytes / 1048576.0, resident.uploading, resident.deferred);
+      const gpu::RecorderStats recording = recorder.stats();
+      ImGui::Text("Scene: %u draws recorded into %u secondary command buffers", recording.draws, recording.command_buffers);
+      ImGui::Text("Instance data: %.1f / %.1f MB in flight", instances.used() / 1048576.0, instances.size() / 1048576.0);
+      if (descriptor_indexing.supported)
+        ImGui::Text("Bindless textures: %u / %u slots", textures.live(), textures.capacity());
+      else
+        ImGui::Text("Bindless textures: unsupported");
+      const gpu::FrameAllocatorStats constants = frame_constants.stats();
+      ImGui::Text("Frame constants: %.1f KB, peak %.1f of %.1f KB per frame, %llu failed", constants.used / 1024.0, constants.peak / 1024.0,
+                  constants.capacity / 1024.0, (unsigned long long)constants.failures);
+      ImGui::End();
+
+      ImGui::Begin("Frame Pacing");
+      RendererSettings edited = settings;
+      const char *present_modes[] = {"FIFO", "Mailbox", "Immediate"};
+      int present_mode = edited.present_mode;
+      int frames_in_flight = (int)edited.frames_in_flight;
+      float frame_rate_limit = (float)edited.frame_rate_limit;
+      bool changed = ImGui::Combo("Present mode", &present_mode, present_modes, IM_ARRAYSIZE(present_modes));
+      changed |= ImGui::SliderInt("Frames in flight", &frames_in_flight, 1, (int)MAX_FRAMES_IN_FLIGHT);
+      changed |= ImGui::InputFloat("Frame rate limit", &frame_rate_limit, 10.0f, 60.0f, "%.0f");
+      if (changed)
+      {
+        edited.present_mode = (PresentMode)present_mode;
+        edited.frames_in_flight = (uint32_t)frames_in_flight;
+        edited.frame_rate_limit = std::max(0.0f, frame_rate_limit);
+        configure(edited);
+      }
+      const VkPresentModeKHR active = g_MainWindowData.PresentMode;
+      ImGui::Text("Presenting %s to %u swapchain images", active == VK_PRESENT_MODE_MAILBOX_KHR ? "mailbox" : active == VK_PRESENT_MODE_IMMEDIATE_KHR ? "immediate" : "FIFO",
+                  g_MainWindowData.ImageCount);
+      ImGui::Text("%s, %zu old swapchains waiting for their frames", g_MainWindowData.UseDynamicRendering ? "Dynamic rendering" : "Render pass",
+                  retired_swapchains.size());
+      ImGui::Text("Input to present: %.2f ms average, %.2f ms worst over %u frames", latency.average(), latency.max(), latency.size());
+      ImGui::End();
     }
 
     void cleanup()
@@ -1,29 +1,39 @@
 #ifndef RENDER_SYSTEM_H
 #define RENDER_SYSTEM_H
 
+#include <vector>
+
 #include "../core/ecs/system.hpp"
-#include "../components/render_component.hpp"
 #include "../core/ecs/component_manager.hpp"
 #include "../core/ecs/entity_manager.hpp"
+#include "../components/mesh_component.hpp"
+#include "../rendering/render_queue.hpp"
 
 namespace hades
 {
+  // Builds the frame's scene draw list: one draw per entity with a
+  // MeshComponent, sorted by key. DrawItem::draw indexes draw_entities.
+  // The renderer takes the queue through Renderer::submit_scene.
   class RenderSystem : public System
   {
   public:
+    RenderQueue queue;
+    std::vector<Entity::EntityId> draw_entities;
+
     void update(float deltaTime, ComponentManager &componentManager, EntityManager &entityManager) override
     {
-      // Iterate over entities and update their position based on velocity
-      for (auto entity : entityManager.getAllEntities())
+      queue.clear();
+      draw_entities.clear();
+      for (Entity::EntityId entity : entityManager.getAllEntities())
       {
-        if (componentManager.hasComponent<RenderComponent>(entity))
-        {
-          auto &renderComp = componentManager.getComponent<RenderComponent>(entity);
-        }
-
-        // Submit the draw call
-        //  bgfx::submit(0, renderComp.program); // 'program' is the bgfx shader program
+        if (!componentManager.hasComponent<MeshComponent>(entity))
+          continue;
+        // No camera yet, so every draw sits at the same depth
+        const uint32_t mesh = componentManager.getComponent<MeshComponent>(entity).mesh;
+        queue.push(make_draw_key(0, 0, 0, 0, mesh, 0), (uint32_t)draw_entities.size());
+        draw_entities.push_back(entity);
       }
+      queue.sort();
     }
   };
 }
@@ -1,3 +1,4 @@
+#include <map>
 #include <CLI/CLI.hpp>
 #include "editor/window_manager.hpp"
 
@@ -5,10 +6,17 @@ int main(int argc, char **argv)
 {
   CLI::App app{"Hades"};
 
+  hades::RendererSettings settings;
+  const std::map<std::string, hades::PresentMode> present_modes = {
+      {"fifo", hades::PRESENT_MODE_FIFO}, {"mailbox", hades::PRESENT_MODE_MAILBOX}, {"immediate", hades::PRESENT_MODE_IMMEDIATE}};
+  app.add_option("--present-mode", settings.present_mode, "fifo, mailbox or immediate")->transform(CLI::CheckedTransformer(present_modes, CLI::ignore_case));
+  app.add_option("--frames-in-flight", settings.frames_in_flight, "Frames the CPU may record ahead of the GPU")->check(CLI::Range(1u, hades::MAX_FRAMES_IN_FLIGHT));
+  app.add_option("--fps-limit", settings.frame_rate_limit, "Frame rate cap, 0 for none")->check(CLI::NonNegativeNumber);
+
   CLI11_PARSE(app, argc, argv);
 
   hades::WindowManager window_manager;
-  window_manager.init();
+  window_manager.init(settings);
 
   while (window_manager.running)
   {
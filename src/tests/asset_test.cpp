@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../engine/assets/asset_registry.hpp"
+#include "../engine/assets/hot_reload.hpp"
+#include "../engine/core/io/file_watcher.hpp"
+#include "test_files.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    class AssetRegistryTest : public TempDirTest
+    {
+    protected:
+      std::string write_quad(const std::string &name)
+      {
+        const auto path = dir / name;
+        std::ofstream(path, std::ios::binary) << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                                                 "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                                                 "vn 0 0 1\n"
+                                                 "f 1/1/1 2/2/1 3/3/1 4/4/1\n";
+        return path.string();
+      }
+
+      std::string write_material(const std::string &name, const char *diffuse)
+      {
+        const auto path = dir / name;
+        std::ofstream(path, std::ios::binary) << "newmtl paint\nKd " << diffuse << "\n";
+        return path.string();
+      }
+
+      std::string write_painted_quad(const std::string &name)
+      {
+        const auto path = dir / name;
+        std::ofstream(path, std::ios::binary) << "mtllib paint.mtl\n"
+                                                 "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                                                 "usemtl paint\n"
+                                                 "f 1 2 3 4\n";
+        return path.string();
+      }
+    };
+
+    TEST_F(AssetRegistryTest, DeduplicatesLoadsAndCountsReferences)
+    {
+      AssetRegistry registry((dir / "cache").string());
+      const std::string obj = write_quad("quad.obj");
+      AssetHandle<MappedMesh> first = registry.acquire_mesh(obj, dir.string() + "/");
+      ASSERT_TRUE(first);
+      // A different spelling of the same path still resolves to the same asset
+      AssetHandle<MappedMesh> second = registry.acquire_mesh((dir / "." / "quad.obj").string(), dir.string() + "/");
+      EXPECT_EQ(first.get(), second.get());
+      AssetHandle<MappedMesh> third = second;
+
+      AssetUsage usage = registry.get_usage(ASSET_MESH);
+      EXPECT_EQ(usage.loads, 1u);
+      EXPECT_EQ(usage.hits, 1u);
+      EXPECT_EQ(usage.resident, 1u);
+      EXPECT_EQ(usage.referenced, 1u);
+      EXPECT_EQ(usage.cpu_bytes, first->size_bytes());
+      EXPECT_EQ(registry.snapshot()[0].references, 3u);
+
+      first.reset();
+      second.reset();
+      third.reset();
+      usage = registry.get_usage(ASSET_MESH);
+      EXPECT_EQ(usage.resident, 1u); // Within budget, so it stays cached
+      EXPECT_EQ(usage.referenced, 0u);
+
+      EXPECT_TRUE(registry.acquire_mesh(obj, dir.string() + "/"));
+      EXPECT_EQ(registry.get_usage(ASSET_MESH).loads, 1u);
+      EXPECT_FALSE(registry.acquire_mesh((dir / "missing.obj").string(), dir.string() + "/"));
+      EXPECT_EQ(registry.snapshot().size(), 1u);
+    }
+
+    TEST_F(AssetRegistryTest, EvictsLeastRecentlyReleasedOverBudget)
+    {
+      AssetRegistry registry((dir / "cache").string());
+      AssetHandle<MappedMesh> a = registry.acquire_mesh(write_quad("a.obj"), dir.string() + "/");
+      AssetHandle<MappedMesh> b = registry.acquire_mesh(write_quad("b.obj"), dir.string() + "/");
+      AssetHandle<MappedMesh> c = registry.acquire_mesh(write_quad("c.obj"), dir.string() + "/");
+      ASSERT_TRUE(a && b && c);
+      const uint64_t keys[3] = {a.key(), b.key(), c.key()};
+
+      // Referenced assets survive any budget
+      registry.set_budget(AssetBudget{a->size_bytes(), UINT64_MAX});
+      EXPECT_EQ(registry.get_usage(ASSET_MESH).resident, 3u);
+
+      a.reset(); // Over budget on release: evicted right away
+      EXPECT_FALSE(registry.is_resident(keys[0]));
+      registry.set_budget(AssetBudget{UINT64_MAX, UINT64_MAX});
+      c.reset();
+      b.reset();
+      registry.set_budget(AssetBudget{registry.get_usage(ASSET_MESH).cpu_bytes / 2, UINT64_MAX});
+      // c was released before b, so it goes first
+      EXPECT_FALSE(registry.is_resident(keys[2]));
+      EXPECT_TRUE(registry.is_resident(keys[1]));
+      EXPECT_EQ(registry.get_usage(ASSET_MESH).evictions, 2u);
+
+      registry.purge();
+      EXPECT_EQ(registry.get_usage(ASSET_MESH).resident, 0u);
+      EXPECT_EQ(registry.get_usage(ASSET_MESH).cpu_bytes, 0u);
+    }
+
+    TEST_F(AssetRegistryTest, WatcherReportsEachChangedFileOnce)
+    {
+      const std::string watched = write_material("watched.mtl", "1 0 0");
+      const std::string ignored = write_material("ignored.mtl", "1 0 0");
+      FileWatcher watcher;
+      ASSERT_TRUE(watcher.watch(watched));
+      EXPECT_TRUE(watcher.is_watched((dir / "." / "watched.mtl").string()));
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      write_material("watched.mtl", "0 1 0");
+      write_material("watched.mtl", "0 0 1");
+      write_material("ignored.mtl", "0 0 1");
+      std::vector<std::string> changed = watcher.poll(1000);
+      ASSERT_EQ(changed.size(), 1u);
+      EXPECT_EQ(changed[0], FileWatcher::normalize(watched));
+    }
+
+    TEST_F(AssetRegistryTest, ReloadsMeshWhenMaterialLibraryChanges)
+    {
+      AssetRegistry registry((dir / "cache").string());
+      const std::string mtl = write_material("paint.mtl", "1 0 0");
+      AssetHandle<MappedMesh> mesh = registry.acquire_mesh(write_painted_quad("quad.obj"), dir.string() + "/");
+      ASSERT_TRUE(mesh);
+      const MappedMesh *address = mesh.get();
+      EXPECT_FLOAT_EQ(mesh->materials()[0].diffuse[0], 1.0f);
+
+      // Re-cooking unchanged sources swaps nothing
+      JobCounter counter;
+      EXPECT_EQ(registry.reload_dependents(mtl, counter), 1u);
+      JobSystem::get().wait(counter);
+      EXPECT_EQ(registry.apply_reloads(), 0u);
+
+      write_material("paint.mtl", "0 1 0");
+      EXPECT_EQ(registry.reload_dependents(mtl, counter), 1u);
+      JobSystem::get().wait(counter);
+      EXPECT_FLOAT_EQ(mesh->materials()[0].diffuse[0], 1.0f); // Nothing changes before the frame boundary
+      EXPECT_EQ(registry.apply_reloads(), 1u);
+      EXPECT_EQ(mesh.get(), address);
+      EXPECT_FLOAT_EQ(mesh->materials()[0].diffuse[1], 1.0f);
+      EXPECT_EQ(registry.generation(mesh.key()), 1u);
+      EXPECT_EQ(registry.get_usage(ASSET_MESH).reloads, 1u);
+      EXPECT_EQ(registry.reload_dependents((dir / "unrelated.mtl").string(), counter), 0u);
+    }
+
+    TEST_F(AssetRegistryTest, HotReloaderPicksUpSavedFiles)
+    {
+      AssetRegistry registry((dir / "cache").string());
+      write_material("paint.mtl", "1 0 0");
+      AssetHandle<MappedMesh> mesh = registry.acquire_mesh(write_painted_quad("quad.obj"), dir.string() + "/");
+      ASSERT_TRUE(mesh);
+
+      HotReloader reloader(registry, JobSystem::get(), std::chrono::milliseconds(10));
+      std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Let the watcher pick up the files
+      write_material("paint.mtl", "0 0 1");
+      uint32_t applied = 0;
+      for (int attempt = 0; attempt < 500 && applied == 0; attempt++)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        applied = registry.apply_reloads();
+      }
+      EXPECT_EQ(applied, 1u);
+      EXPECT_FLOAT_EQ(mesh->materials()[0].diffuse[2], 1.0f);
+    }
+
+    TEST_F(AssetRegistryTest, KeysTexturesByCookSettings)
+    {
+      AssetRegistry registry((dir / "cache").string());
+      const std::string tga = write_tga(dir / "checker.tga", 8, 8);
+      AssetHandle<MappedTexture> colour = registry.acquire_texture(tga);
+      TextureCookSettings data_settings;
+      data_settings.srgb = false;
+      AssetHandle<MappedTexture> data = registry.acquire_texture(tga, data_settings);
+      ASSERT_TRUE(colour && data);
+      EXPECT_NE(colour.key(), data.key());
+      EXPECT_TRUE(colour->srgb());
+      EXPECT_FALSE(data->srgb());
+      EXPECT_EQ(registry.acquire_texture(tga).get(), colour.get());
+
+      const AssetUsage usage = registry.get_usage(ASSET_TEXTURE);
+      EXPECT_EQ(usage.resident, 2u);
+      EXPECT_EQ(usage.gpu_bytes, 2u * (4 + 1 + 1 + 1) * 16); // 8x8 BC7 chain of 16-byte blocks
+    }
+  }
+}
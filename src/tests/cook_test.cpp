@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../engine/assets/asset_cook.hpp"
+#include "../engine/assets/asset_registry.hpp"
+#include "test_files.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    class CookTest : public TempDirTest
+    {
+    protected:
+      std::filesystem::path assets;
+      CookOptions options;
+
+      void SetUp() override
+      {
+        TempDirTest::SetUp();
+        assets = dir / "assets";
+        std::filesystem::create_directories(assets / "textures");
+        options.cache_dir = (dir / "cache").string();
+
+        std::ofstream(assets / "crate.obj") << "mtllib crate.mtl\n"
+                                               "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                                               "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                                               "usemtl wood\n"
+                                               "f 1/1 2/2 3/3 4/4\n";
+        std::ofstream(assets / "crate.mtl") << "newmtl wood\nKd 1 1 1\n"
+                                               "map_Kd textures/wood.tga\n"
+                                               "map_Bump -bm 0.5 textures/wood_normal.tga\n"
+                                               "map_Ks textures/gone.tga\n";
+        write_tga(assets / "textures" / "wood.tga", 8, 8);
+        write_tga(assets / "textures" / "wood_normal.tga", 8, 8);
+        write_tga(assets / "textures" / "loose.tga", 4, 4);
+      }
+
+      CookSummary cook()
+      {
+        CookDatabase database;
+        const std::string path = (std::filesystem::path(options.cache_dir) / "cook.db").string();
+        EXPECT_TRUE(database.load(path));
+        const CookSummary summary = cook_graph(CookGraph::scan(assets.string()), database, options);
+        EXPECT_TRUE(database.save(path));
+        return summary;
+      }
+    };
+
+    TEST_F(CookTest, FollowsObjToMaterialToTextures)
+    {
+      const CookGraph graph = CookGraph::scan(assets.string());
+      ASSERT_EQ(graph.nodes.size(), 4u);
+      ASSERT_EQ(graph.missing.size(), 1u);
+      EXPECT_NE(graph.missing[0].find("gone.tga"), std::string::npos);
+
+      const CookNode *mesh = nullptr;
+      for (const CookNode &node : graph.nodes)
+        if (node.kind == COOK_MESH)
+          mesh = &node;
+      ASSERT_NE(mesh, nullptr);
+      ASSERT_EQ(mesh->materials.size(), 1u);
+      ASSERT_EQ(mesh->textures.size(), 2u);
+      for (uint32_t texture : mesh->textures)
+      {
+        const CookNode &node = graph.nodes[texture];
+        const bool normal = node.source.find("wood_normal") != std::string::npos;
+        EXPECT_EQ(node.texture_settings.srgb, !normal) << node.source;
+        EXPECT_EQ(node.texture_settings.format, normal ? HTEX_FORMAT_BC5 : HTEX_FORMAT_BC7) << node.source;
+      }
+    }
+
+    TEST_F(CookTest, RecooksOnlyWhatChanged)
+    {
+      CookSummary first = cook();
+      EXPECT_EQ(first.cooked, 4u);
+      EXPECT_EQ(first.failed, 0u);
+
+      CookSummary second = cook();
+      EXPECT_EQ(second.cooked, 0u);
+      EXPECT_EQ(second.up_to_date, 4u);
+
+      // Touching a file without changing it rehashes but does not re-cook
+      const auto path = assets / "textures" / "loose.tga";
+      std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(5));
+      EXPECT_EQ(cook().cooked, 0u);
+
+      // A material edit re-cooks the mesh that folds it in, nothing else
+      std::ofstream(assets / "crate.mtl", std::ios::app) << "Ns 10\n";
+      std::filesystem::last_write_time(assets / "crate.mtl", std::filesystem::last_write_time(assets / "crate.mtl") + std::chrono::seconds(5));
+      CookSummary third = cook();
+      EXPECT_EQ(third.cooked, 1u);
+      EXPECT_EQ(third.up_to_date, 3u);
+
+      // Removing a source prunes its output
+      CookDatabase database;
+      ASSERT_TRUE(database.load((std::filesystem::path(options.cache_dir) / "cook.db").string()));
+      std::string loose_output;
+      for (const auto &entry : database.records())
+        if (entry.second.source.find("loose.tga") != std::string::npos)
+          loose_output = entry.second.output;
+      ASSERT_TRUE(std::filesystem::is_regular_file(loose_output));
+      std::filesystem::remove(path);
+      CookSummary fourth = cook();
+      EXPECT_EQ(fourth.pruned, 1u);
+      EXPECT_FALSE(std::filesystem::exists(loose_output));
+    }
+
+    TEST_F(CookTest, IdenticalSourcesCookOnceIntoOneOutput)
+    {
+      std::filesystem::create_directories(assets / "copies");
+      for (int i = 0; i < 16; i++)
+        write_tga(assets / "copies" / ("copy" + std::to_string(i) + ".tga"), 128, 128);
+
+      JobSystem jobs(8);
+      CookDatabase database;
+      const CookSummary summary = cook_graph(CookGraph::scan(assets.string()), database, options, jobs);
+      EXPECT_EQ(summary.failed, 0u) << (summary.failures.empty() ? "" : summary.failures[0]);
+      EXPECT_EQ(summary.cooked, 20u);
+
+      std::set<std::string> outputs;
+      for (const auto &entry : database.records())
+        if (entry.second.source.find("copy") != std::string::npos)
+          outputs.insert(entry.second.output);
+      ASSERT_EQ(outputs.size(), 1u);
+      EXPECT_TRUE(MappedTexture::open(*outputs.begin()).has_value());
+      for (const auto &file : std::filesystem::directory_iterator(TextureCooker::cache_dir_in(options.cache_dir)))
+        EXPECT_EQ(file.path().extension(), ".htex") << file.path();
+    }
+
+    TEST_F(CookTest, RuntimeLoadsCookedOutputsFromTheCache)
+    {
+      ASSERT_EQ(cook().cooked, 4u);
+      CookDatabase database;
+      ASSERT_TRUE(database.load((std::filesystem::path(options.cache_dir) / "cook.db").string()));
+      // Backdate every output so a runtime re-cook would show as a newer write
+      const auto old_time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+      for (const auto &entry : database.records())
+        std::filesystem::last_write_time(entry.second.output, old_time);
+
+      AssetRegistry registry(options.cache_dir);
+      EXPECT_TRUE(registry.acquire_mesh((assets / "crate.obj").string(), assets.string() + "/"));
+      for (const CookNode &node : CookGraph::scan(assets.string()).nodes)
+      {
+        if (node.kind == COOK_TEXTURE)
+        {
+          EXPECT_TRUE(registry.acquire_texture(node.source, node.texture_settings)) << node.source;
+        }
+      }
+      for (const auto &entry : database.records())
+        EXPECT_EQ(std::filesystem::last_write_time(entry.second.output), old_time) << entry.second.output;
+      // and nothing was cooked beside them
+      size_t outputs = 0;
+      for (const auto &file : std::filesystem::recursive_directory_iterator(options.cache_dir))
+        outputs += file.path().extension() == ".hmesh" || file.path().extension() == ".htex";
+      EXPECT_EQ(outputs, database.records().size());
+    }
+
+    TEST_F(CookTest, DatabaseRoundTripsAndRejectsGarbage)
+    {
+      CookDatabase database;
+      CookRecord record;
+      record.source = "a dir/crate.obj";
+      record.variant = "mesh v1";
+      record.cooker_version = 6;
+      record.hash = 0x0123456789abcdefull;
+      record.output = "cache/0123456789abcdef.hmesh";
+      record.inputs.push_back(CookStamp{"a dir/crate.obj", 120, 1234567890123});
+      record.inputs.push_back(CookStamp{"a dir/crate.mtl", 40, -5});
+      database.put(record);
+      const std::string path = (dir / "cook.db").string();
+      ASSERT_TRUE(database.save(path));
+
+      CookDatabase loaded;
+      ASSERT_TRUE(loaded.load(path));
+      const CookRecord *found = loaded.find(CookDatabase::key("a dir/crate.obj", "mesh v1"));
+      ASSERT_NE(found, nullptr);
+      EXPECT_EQ(found->hash, record.hash);
+      EXPECT_EQ(found->output, record.output);
+      ASSERT_EQ(found->inputs.size(), 2u);
+      EXPECT_EQ(found->inputs[1].path, "a dir/crate.mtl");
+      EXPECT_EQ(found->inputs[1].mtime, -5);
+
+      std::ofstream(path, std::ios::app) << "R\tnot enough fields\n";
+      EXPECT_FALSE(loaded.load(path));
+      EXPECT_TRUE(loaded.records().empty());
+
+      // Numbers that do not parse are as bad as missing fields
+      ASSERT_TRUE(database.save(path));
+      std::ofstream(path, std::ios::app) << "R\t6\tnot hex\t0\ta\tb\tc\n";
+      EXPECT_FALSE(loaded.load(path));
+      EXPECT_TRUE(loaded.records().empty());
+      ASSERT_TRUE(database.save(path));
+      std::ofstream(path, std::ios::app) << "R\t6\t1\t1\ta\tb\tc\nI\t99999999999999999999999\t0\td\n";
+      EXPECT_FALSE(loaded.load(path));
+    }
+  }
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../engine/rendering/gpu/descriptor_heap.hpp"
+#include "vulkan_test_device.hpp"
+
+namespace hades::gpu
+{
+  namespace
+  {
+    TEST(DescriptorHeapTest, ReleasedHandlesWaitForTheirFrame)
+    {
+      DescriptorHandles handles;
+      handles.reset(3);
+      EXPECT_EQ(handles.allocate(), 0u);
+      EXPECT_EQ(handles.allocate(), 1u);
+      EXPECT_EQ(handles.allocate(), 2u);
+      EXPECT_EQ(handles.allocate(), INVALID_DESCRIPTOR_HANDLE);
+
+      handles.release(1);
+      handles.end_frame(5);
+      EXPECT_EQ(handles.allocate(), INVALID_DESCRIPTOR_HANDLE);
+      EXPECT_EQ(handles.live(), 3u);
+      handles.retire(4);
+      EXPECT_EQ(handles.allocate(), INVALID_DESCRIPTOR_HANDLE);
+      handles.retire(5);
+      EXPECT_EQ(handles.live(), 2u);
+      EXPECT_EQ(handles.allocate(), 1u);
+
+      handles.grow(4);
+      EXPECT_EQ(handles.allocate(), 3u);
+      EXPECT_EQ(handles.size(), 4u);
+    }
+
+    TEST(DescriptorHeapTest, GrowsWithoutMovingHandles)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      const DescriptorIndexingSupport support = query_descriptor_indexing(vulkan.instance, vulkan.physical_device);
+      if (!support.supported)
+        GTEST_SKIP() << "no descriptor indexing";
+      VkDevice device = vulkan.create_device(DESCRIPTOR_INDEXING_EXTENSIONS, 2, &support.features);
+      ASSERT_NE(device, VK_NULL_HANDLE);
+
+      VkBufferCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      info.size = 256;
+      info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+      VkBuffer buffer;
+      ASSERT_EQ(vkCreateBuffer(device, &info, nullptr, &buffer), VK_SUCCESS);
+
+      DescriptorHeap heap;
+      ASSERT_EQ(heap.init(device, nullptr, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 64, std::min(support.max_storage_buffers, 256u)), VK_SUCCESS);
+      EXPECT_NE(heap.layout(), VK_NULL_HANDLE);
+      std::vector<DescriptorHandle> handles;
+      for (uint32_t i = 0; i < 64; i++)
+        handles.push_back(heap.allocate_buffer(buffer, 0, 256));
+      const VkDescriptorSet first_set = heap.set();
+      EXPECT_EQ(heap.capacity(), 64u);
+
+      // A handle released in frame 1 is not reused before frame 1 retires,
+      // even though the heap grows in between
+      heap.release(handles[10]);
+      heap.end_frame(1);
+      const DescriptorHandle grown = heap.allocate_buffer(buffer);
+      EXPECT_EQ(grown, 64u);
+      EXPECT_EQ(heap.capacity(), 128u);
+      EXPECT_NE(heap.set(), first_set);
+      heap.end_frame(2);
+      heap.retire(2);
+      EXPECT_EQ(heap.allocate(), handles[10]);
+      EXPECT_EQ(heap.live(), 65u);
+
+      while (heap.allocate() != INVALID_DESCRIPTOR_HANDLE)
+        ;
+      EXPECT_EQ(heap.capacity(), std::min(support.max_storage_buffers, 256u));
+      heap.destroy();
+      vkDestroyBuffer(device, buffer, nullptr);
+      vkDestroyDevice(device, nullptr);
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../engine/rendering/gpu/frame_allocator.hpp"
+#include "vulkan_test_device.hpp"
+
+namespace hades::gpu
+{
+  namespace
+  {
+    TEST(FrameAllocatorTest, BumpAlignsAndStopsAtCapacity)
+    {
+      BumpAllocator bump(1024);
+      uint64_t a, b, c;
+      ASSERT_TRUE(bump.allocate(10, 16, a));
+      ASSERT_TRUE(bump.allocate(100, 256, b));
+      EXPECT_EQ(a, 0u);
+      EXPECT_EQ(b, 256u);
+      EXPECT_FALSE(bump.allocate(700, 256, c));
+      ASSERT_TRUE(bump.allocate(512, 256, c));
+      EXPECT_EQ(c, 512u);
+      EXPECT_EQ(bump.used(), 1024u);
+      EXPECT_FALSE(bump.allocate(1, 1, c));
+      bump.reset();
+      ASSERT_TRUE(bump.allocate(1, 1, c));
+      EXPECT_EQ(c, 0u);
+    }
+
+    TEST(FrameAllocatorTest, ConcurrentAllocationsDoNotOverlap)
+    {
+      const uint32_t threads = 4, per_thread = 2000;
+      BumpAllocator bump(threads * per_thread * 64);
+      std::vector<std::vector<std::pair<uint64_t, uint64_t>>> ranges(threads);
+      std::vector<std::thread> workers;
+      for (uint32_t t = 0; t < threads; t++)
+        workers.emplace_back([&, t]()
+                             {
+          for (uint32_t i = 0; i < per_thread; i++)
+          {
+            const uint64_t size = 1 + (i * 7 + t) % 40;
+            uint64_t offset;
+            if (bump.allocate(size, 16, offset))
+              ranges[t].emplace_back(offset, size);
+          } });
+      for (std::thread &worker : workers)
+        worker.join();
+
+      std::vector<std::pair<uint64_t, uint64_t>> all;
+      for (const auto &list : ranges)
+        all.insert(all.end(), list.begin(), list.end());
+      EXPECT_EQ(all.size(), threads * per_thread); // 48 bytes at most per allocation
+      std::sort(all.begin(), all.end());
+      for (size_t i = 0; i < all.size(); i++)
+      {
+        EXPECT_EQ(all[i].first % 16, 0u);
+        if (i > 0)
+        {
+          EXPECT_LE(all[i - 1].first + all[i - 1].second, all[i].first);
+        }
+      }
+    }
+
+    TEST(FrameAllocatorTest, FramesUseSeparatePartitions)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      VkDevice device = vulkan.create_device();
+      ASSERT_NE(device, VK_NULL_HANDLE);
+      Allocator allocator;
+      allocator.init(vulkan.physical_device, device, nullptr);
+
+      FrameAllocator constants;
+      ASSERT_EQ(constants.init(allocator, vulkan.physical_device, 3, 4000), VK_SUCCESS);
+      const VkDeviceSize capacity = constants.stats().capacity;
+      EXPECT_GE(capacity, 4000u);
+
+      constants.begin_frame(1);
+      const float color[4] = {1.0f, 0.5f, 0.25f, 1.0f};
+      FrameAllocation first = constants.push_uniform(color);
+      FrameAllocation second = constants.allocate_storage(64);
+      ASSERT_NE(first.data, nullptr);
+      ASSERT_NE(second.data, nullptr);
+      EXPECT_EQ(first.offset, capacity);
+      EXPECT_GT(second.offset, first.offset);
+      EXPECT_EQ(memcmp(first.data, color, sizeof(color)), 0);
+      EXPECT_EQ(constants.allocate_uniform(capacity).data, nullptr);
+      EXPECT_EQ(constants.stats().failures, 1u);
+      constants.end_frame();
+
+      constants.begin_frame(2);
+      EXPECT_EQ(constants.stats().used, 0u);
+      EXPECT_GT(constants.stats().peak, 0u);
+      EXPECT_EQ(constants.allocate_uniform(16).offset, 2 * capacity);
+
+      ASSERT_EQ(constants.resize(2), VK_SUCCESS);
+      EXPECT_EQ(constants.frame_count(), 2u);
+      constants.destroy();
+      allocator.destroy();
+      vkDestroyDevice(device, nullptr);
+    }
+  }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <ctime>
+#include <thread>
+
+#include "../engine/rendering/frame_pacing.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    TEST(FramePacingTest, LimiterHoldsTheRate)
+    {
+      FrameLimiter limiter;
+      EXPECT_EQ(limiter.wait(), FrameLimiter::clock::duration::zero());
+      limiter.set_rate(500.0);
+      EXPECT_DOUBLE_EQ(limiter.rate(), 500.0);
+
+      const auto start = FrameLimiter::clock::now();
+      for (int i = 0; i < 25; i++)
+        limiter.wait();
+      // Only lower bounds: a busy machine may stretch any frame
+      const double elapsed = std::chrono::duration<double, std::milli>(FrameLimiter::clock::now() - start).count();
+      EXPECT_GE(elapsed, 49.0);
+
+      // An overrun frame restarts the schedule instead of owing the lost
+      // time, so the frame after it still gets a full period
+      limiter.wait();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      const auto overrun = FrameLimiter::clock::now();
+      limiter.wait();
+      limiter.wait();
+      EXPECT_GE(FrameLimiter::clock::now() - overrun, std::chrono::milliseconds(2));
+    }
+
+    TEST(FramePacingTest, LimiterRecoversFromASlowSleep)
+    {
+      FrameLimiter limiter;
+      limiter.set_rate(50.0);
+      limiter.set_sleep_estimate(std::chrono::seconds(1));
+      const std::clock_t start = std::clock();
+      for (int i = 0; i < 10; i++)
+      {
+        limiter.wait();
+        EXPECT_LE(limiter.sleep_estimate(), std::chrono::milliseconds(10));
+      }
+      // 200 ms of frames mostly asleep rather than spinning
+      EXPECT_LT((double)(std::clock() - start) / CLOCKS_PER_SEC, 0.15);
+    }
+
+    TEST(FramePacingTest, LatencyWindowRolls)
+    {
+      LatencyTracker latency;
+      EXPECT_EQ(latency.average(), 0.0);
+      latency.add(10.0);
+      latency.add(20.0);
+      EXPECT_DOUBLE_EQ(latency.average(), 15.0);
+      EXPECT_DOUBLE_EQ(latency.max(), 20.0);
+      EXPECT_DOUBLE_EQ(latency.last(), 20.0);
+
+      for (uint32_t i = 0; i < LatencyTracker::WINDOW; i++)
+        latency.add(4.0);
+      EXPECT_EQ(latency.size(), LatencyTracker::WINDOW);
+      EXPECT_DOUBLE_EQ(latency.average(), 4.0);
+      EXPECT_DOUBLE_EQ(latency.max(), 4.0);
+      latency.clear();
+      EXPECT_EQ(latency.size(), 0u);
+    }
+  }
+}
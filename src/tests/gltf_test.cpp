@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../engine/assets/gltf/glb_file.hpp"
+#include "../engine/assets/gltf/glb_importer.hpp"
+#include "../engine/core/text/json_reader.hpp"
+#include "test_files.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    JsonValue parse(const char *text)
+    {
+      return JsonValue::parse(text, strlen(text));
+    }
+
+    TEST(JsonReaderTest, ReadsNestedValuesInPlace)
+    {
+      const char *text = " {\"a\": [1, 2.5, -3e2], \"s\": \"x\\\"y\", \"o\": {\"t\": true, \"n\": null}, \"e\": [], \"k\": {}} ";
+      const JsonValue root = parse(text);
+      ASSERT_TRUE(root.is_object());
+      EXPECT_EQ(root.size(), 5u);
+      EXPECT_EQ(root["a"].size(), 3u);
+      EXPECT_EQ(root["a"][0].as_uint(), 1u);
+      EXPECT_FLOAT_EQ(root["a"][1].as_float(), 2.5f);
+      EXPECT_FLOAT_EQ(root["a"][2].as_float(), -300.0f);
+      EXPECT_FALSE(root["a"][3].valid());
+      EXPECT_EQ(root["s"].as_string(), "x\\\"y");
+      EXPECT_TRUE(root["o"]["t"].as_bool());
+      EXPECT_EQ(root["o"]["n"].type(), JSON_NULL);
+      EXPECT_EQ(root["e"].size(), 0u);
+      EXPECT_EQ(root["k"].size(), 0u);
+      EXPECT_FALSE(root["missing"].valid());
+
+      // The views point into the source text
+      EXPECT_GE(root["s"].text().data(), text);
+      EXPECT_LT(root["s"].text().data(), text + strlen(text));
+    }
+
+    TEST(JsonReaderTest, RejectsMalformedDocuments)
+    {
+      const char *documents[] = {"", "{", "[1,]", "{\"a\" 1}", "{\"a\":1} x", "[tru]", "{1:2}", "\"unterminated"};
+      for (const char *document : documents)
+        EXPECT_FALSE(parse(document).valid()) << document;
+      std::string deep(JSON_MAX_DEPTH + 2, '[');
+      deep += std::string(JSON_MAX_DEPTH + 2, ']');
+      EXPECT_FALSE(JsonValue::parse(deep.data(), deep.size()).valid());
+    }
+
+    void append_chunk(std::vector<uint8_t> &glb, uint32_t type, const void *data, size_t size, uint8_t pad)
+    {
+      const uint32_t padded = (uint32_t)((size + 3) & ~(size_t)3);
+      const uint32_t header[2] = {padded, type};
+      glb.insert(glb.end(), (const uint8_t *)header, (const uint8_t *)header + 8);
+      glb.insert(glb.end(), (const uint8_t *)data, (const uint8_t *)data + size);
+      glb.insert(glb.end(), padded - size, pad);
+    }
+
+    std::string write_test_glb(const std::filesystem::path &path,
+                               const std::string &nodes = "[{\"name\":\"root\",\"children\":[1],\"translation\":[1,2,3]},"
+                                                          "{\"mesh\":0,\"matrix\":[2,0,0,0, 0,0,2,0, 0,-2,0,0, 5,6,7,1]}]")
+    {
+      // One triangle: interleaved float3 position and normalized ushort2 uv, ushort indices
+      std::vector<uint8_t> bin;
+      const float positions[3][3] = {{0, 0, 0}, {1, 0, 0}, {0, 2, 0}};
+      const uint16_t uvs[3][2] = {{0, 0}, {65535, 0}, {0, 65535}};
+      for (int v = 0; v < 3; v++)
+      {
+        bin.insert(bin.end(), (const uint8_t *)positions[v], (const uint8_t *)positions[v] + 12);
+        bin.insert(bin.end(), (const uint8_t *)uvs[v], (const uint8_t *)uvs[v] + 4);
+      }
+      const uint16_t indices[3] = {0, 2, 1};
+      bin.insert(bin.end(), (const uint8_t *)indices, (const uint8_t *)indices + 6);
+
+      const std::string json =
+          "{\"asset\":{\"version\":\"2.0\"},"
+          "\"nodes\":" + nodes + ","
+          "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":2},\"indices\":1,\"material\":0}]}],"
+          "\"materials\":[{\"name\":\"paint\",\"pbrMetallicRoughness\":{\"baseColorFactor\":[0.5,0.25,1,1]}}],"
+          "\"buffers\":[{\"byteLength\":54}],"
+          "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":48,\"byteStride\":16},"
+          "{\"buffer\":0,\"byteOffset\":48,\"byteLength\":6}],"
+          "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+          "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"},"
+          "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5123,\"normalized\":true,\"count\":3,\"type\":\"VEC2\"},"
+          "{\"bufferView\":1,\"componentType\":5123,\"count\":4,\"type\":\"SCALAR\"}]}";
+
+      std::vector<uint8_t> glb(12);
+      append_chunk(glb, GLB_CHUNK_JSON, json.data(), json.size(), ' ');
+      append_chunk(glb, GLB_CHUNK_BIN, bin.data(), bin.size(), 0);
+      const uint32_t header[3] = {GLB_MAGIC, GLB_VERSION, (uint32_t)glb.size()};
+      memcpy(glb.data(), header, sizeof(header));
+      std::ofstream(path, std::ios::binary).write((const char *)glb.data(), glb.size());
+      return path.string();
+    }
+
+    class GlbTest : public TempDirTest
+    {
+    };
+
+    TEST_F(GlbTest, AccessorsViewTheBinChunk)
+    {
+      auto glb = GlbFile::open(write_test_glb(dir / "triangle.glb"));
+      ASSERT_TRUE(glb.has_value());
+      const GlbAccessor positions = glb->accessor(0);
+      ASSERT_TRUE(positions.valid());
+      EXPECT_GE(positions.data, glb->bin());
+      EXPECT_LT(positions.data, glb->bin() + glb->bin_size());
+
+      const StridedView<std::array<float, 3>> view = positions.view<std::array<float, 3>>(GLTF_FLOAT);
+      ASSERT_TRUE(view.valid());
+      EXPECT_EQ(view.size(), 3u);
+      EXPECT_EQ(view.stride(), 16u);
+      EXPECT_EQ(view.packed(), nullptr);
+      EXPECT_FLOAT_EQ(view[2][1], 2.0f);
+      EXPECT_FALSE(positions.view<uint16_t>(GLTF_UNSIGNED_SHORT).valid());
+
+      const StridedView<uint16_t> indices = glb->accessor(1).view<uint16_t>(GLTF_UNSIGNED_SHORT);
+      ASSERT_TRUE(indices.valid());
+      EXPECT_EQ(indices[1], 2u);
+
+      // Reads past the end of its buffer view
+      EXPECT_FALSE(glb->accessor(3).valid());
+      EXPECT_FALSE(glb->accessor(4).valid());
+    }
+
+    TEST_F(GlbTest, ImportsNodesAndMeshes)
+    {
+      auto glb = GlbFile::open(write_test_glb(dir / "triangle.glb"));
+      ASSERT_TRUE(glb.has_value());
+
+      EntityManager entityManager;
+      ComponentManager componentManager;
+      const std::vector<Entity::EntityId> entities = import_glb_nodes(*glb, entityManager, componentManager);
+      ASSERT_EQ(entities.size(), 2u);
+
+      const auto &root = componentManager.getComponent<TransformHierarchyComponent>(entities[0]);
+      EXPECT_FALSE(root.hasParent());
+      ASSERT_EQ(root.children.size(), 1u);
+      EXPECT_EQ(root.children[0], entities[1]);
+      const auto &child = componentManager.getComponent<TransformHierarchyComponent>(entities[1]);
+      EXPECT_EQ(child.parent, entities[0]);
+      EXPECT_FLOAT_EQ(componentManager.getComponent<TransformComponent>(entities[0]).translation[2], 3.0f);
+      EXPECT_FALSE(componentManager.hasComponent<MeshComponent>(entities[0]));
+      EXPECT_EQ(componentManager.getComponent<MeshComponent>(entities[1]).mesh, 0u);
+
+      // The matrix node is a 90 degree turn about x, scaled by 2
+      const TransformComponent &transform = componentManager.getComponent<TransformComponent>(entities[1]);
+      EXPECT_FLOAT_EQ(transform.translation[0], 5.0f);
+      EXPECT_FLOAT_EQ(transform.scale[1], 2.0f);
+      EXPECT_NEAR(transform.rotation[0], std::sqrt(0.5f), 1e-6f);
+      EXPECT_NEAR(transform.rotation[3], std::sqrt(0.5f), 1e-6f);
+
+      MeshData mesh;
+      ASSERT_TRUE(import_glb_mesh(*glb, 0, mesh));
+      ASSERT_EQ(mesh.submeshes.size(), 1u);
+      EXPECT_EQ(mesh.submeshes[0].material, 0u);
+      EXPECT_EQ(mesh.materials[0].name, "paint");
+      EXPECT_FLOAT_EQ(mesh.materials[0].diffuse[1], 0.25f);
+      EXPECT_EQ(mesh.indices, (std::vector<uint32_t>{0, 2, 1}));
+      EXPECT_FLOAT_EQ(mesh.vertices[2].uv[1], 1.0f);
+      EXPECT_FLOAT_EQ(mesh.bounds.max[1], 2.0f);
+    }
+
+    TEST_F(GlbTest, DropsChildLinksThatCloseACycle)
+    {
+      auto glb = GlbFile::open(write_test_glb(dir / "cycle.glb", "[{\"children\":[1]},{\"children\":[2]},{\"children\":[0,2]}]"));
+      ASSERT_TRUE(glb.has_value());
+
+      EntityManager entityManager;
+      ComponentManager componentManager;
+      const std::vector<Entity::EntityId> entities = import_glb_nodes(*glb, entityManager, componentManager);
+      ASSERT_EQ(entities.size(), 3u);
+      EXPECT_FALSE(componentManager.getComponent<TransformHierarchyComponent>(entities[0]).hasParent());
+      EXPECT_EQ(componentManager.getComponent<TransformHierarchyComponent>(entities[1]).parent, entities[0]);
+      EXPECT_EQ(componentManager.getComponent<TransformHierarchyComponent>(entities[2]).parent, entities[1]);
+      EXPECT_TRUE(componentManager.getComponent<TransformHierarchyComponent>(entities[2]).children.empty());
+    }
+
+    TEST_F(GlbTest, RejectsTruncatedFile)
+    {
+      const std::string path = write_test_glb(dir / "triangle.glb");
+      std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+      EXPECT_FALSE(GlbFile::open(path).has_value());
+    }
+  }
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../engine/rendering/gpu/allocator.hpp"
+#include "vulkan_test_device.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    using gpu::Tlsf;
+
+    TEST(TlsfTest, AlignsSplitsAndCoalesces)
+    {
+      Tlsf tlsf(1 << 20);
+      const Tlsf::Range a = tlsf.allocate(100);
+      const Tlsf::Range b = tlsf.allocate(1000, 256);
+      const Tlsf::Range c = tlsf.allocate(5000, 4096);
+      ASSERT_TRUE(a.valid() && b.valid() && c.valid());
+      EXPECT_EQ(a.offset, 0u);
+      EXPECT_EQ(b.offset % 256, 0u);
+      EXPECT_EQ(c.offset % 4096, 0u);
+      EXPECT_GE(b.offset, a.offset + a.size);
+      EXPECT_GE(c.offset, b.offset + b.size);
+      EXPECT_EQ(tlsf.allocation_count(), 3u);
+
+      tlsf.free(b.node);
+      tlsf.free(a.node);
+      tlsf.free(c.node);
+      const Tlsf::Stats stats = tlsf.stats();
+      EXPECT_EQ(stats.used, 0u);
+      EXPECT_EQ(stats.free_ranges, 1u);
+      EXPECT_EQ(stats.largest_free, 1u << 20);
+      EXPECT_FALSE(tlsf.allocate((1 << 20) + 1).valid());
+      EXPECT_TRUE(tlsf.allocate(1 << 20).valid());
+    }
+
+    TEST(TlsfTest, RandomWorkloadNeverOverlaps)
+    {
+      const uint64_t capacity = 16 << 20;
+      Tlsf tlsf(capacity);
+      std::mt19937 rng(7);
+      std::vector<std::pair<Tlsf::Range, uint64_t>> live; // Range and requested alignment
+      for (int step = 0; step < 20000; step++)
+      {
+        if (live.empty() || rng() % 100 < 55)
+        {
+          const uint64_t size = 1 + rng() % (rng() % 8 == 0 ? 200000 : 3000);
+          const uint64_t alignment = 1ull << (rng() % 13);
+          const Tlsf::Range range = tlsf.allocate(size, alignment, step + 1);
+          if (!range.valid())
+            continue;
+          EXPECT_EQ(range.offset % alignment, 0u);
+          EXPECT_GE(range.size, size);
+          EXPECT_LE(range.offset + range.size, capacity);
+          EXPECT_EQ(tlsf.user(range.node), (uint64_t)step + 1);
+          live.emplace_back(range, alignment);
+        }
+        else
+        {
+          const size_t victim = rng() % live.size();
+          tlsf.free(live[victim].first.node);
+          live[victim] = live.back();
+          live.pop_back();
+        }
+      }
+
+      std::vector<Tlsf::Range> sorted;
+      tlsf.for_each_allocation([&](const Tlsf::Range &range, uint64_t)
+                               { sorted.push_back(range); });
+      ASSERT_EQ(sorted.size(), live.size());
+      for (size_t i = 1; i < sorted.size(); i++)
+        EXPECT_LE(sorted[i - 1].offset + sorted[i - 1].size, sorted[i].offset);
+
+      for (const auto &entry : live)
+        tlsf.free(entry.first.node);
+      EXPECT_EQ(tlsf.stats().free_ranges, 1u);
+      EXPECT_EQ(tlsf.stats().largest_free, capacity);
+    }
+
+    TEST(GpuAllocatorTest, PicksMemoryTypesByUsage)
+    {
+      // Discrete GPU layout: device local VRAM, host memory, and a small BAR window
+      VkPhysicalDeviceMemoryProperties properties = {};
+      properties.memoryTypeCount = 4;
+      properties.memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+      properties.memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+      properties.memoryTypes[2].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+      properties.memoryTypes[3].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+      EXPECT_EQ(gpu::Allocator::find_memory_type(properties, 0xf, gpu::MEMORY_USAGE_GPU_ONLY), 0u);
+      EXPECT_EQ(gpu::Allocator::find_memory_type(properties, 0xf, gpu::MEMORY_USAGE_UPLOAD), 1u);
+      EXPECT_EQ(gpu::Allocator::find_memory_type(properties, 0xf, gpu::MEMORY_USAGE_READBACK), 2u);
+      // Resources restricted to other types fall back rather than fail
+      EXPECT_EQ(gpu::Allocator::find_memory_type(properties, 0x8, gpu::MEMORY_USAGE_GPU_ONLY), 3u);
+      EXPECT_EQ(gpu::Allocator::find_memory_type(properties, 0x1, gpu::MEMORY_USAGE_UPLOAD), UINT32_MAX);
+    }
+
+    TEST(GpuAllocatorTest, PacksBuffersIntoBlocks)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      VkDevice device = vulkan.create_device();
+      ASSERT_NE(device, VK_NULL_HANDLE);
+
+      gpu::AllocatorSettings settings;
+      settings.block_size = 1 << 20;
+      settings.dedicated_threshold = 512 << 10;
+      settings.empty_blocks_kept = 0;
+      gpu::Allocator allocator;
+      allocator.init(vulkan.physical_device, device, nullptr, settings);
+
+      VkBufferCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      info.size = 16 << 10;
+      info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+      std::vector<gpu::Buffer> buffers(200);
+      for (uint32_t i = 0; i < buffers.size(); i++)
+        ASSERT_EQ(allocator.create_buffer(info, i % 2 ? gpu::MEMORY_USAGE_UPLOAD : gpu::MEMORY_USAGE_GPU_ONLY, buffers[i], i + 1), VK_SUCCESS);
+      EXPECT_NE(buffers[1].allocation.mapped, nullptr);
+
+      info.size = 2 << 20;
+      gpu::Buffer large;
+      ASSERT_EQ(allocator.create_buffer(info, gpu::MEMORY_USAGE_GPU_ONLY, large), VK_SUCCESS);
+      EXPECT_EQ(large.allocation.block, gpu::DEDICATED_BLOCK);
+
+      gpu::AllocatorStats stats = allocator.stats();
+      EXPECT_EQ(stats.allocations, 201u);
+      EXPECT_LE(stats.device_allocations, 6u);
+
+      // Free most of the upload buffers so the defragmenter has something to drain
+      for (uint32_t i = 1; i < buffers.size(); i += 2)
+        if (i % 10 != 1)
+          allocator.destroy_buffer(buffers[i]);
+      const std::vector<gpu::DefragmentationMove> moves = allocator.begin_defragmentation(~0ull);
+      EXPECT_FALSE(moves.empty());
+      for (const gpu::DefragmentationMove &move : moves)
+      {
+        EXPECT_NE(move.user, 0u);
+        EXPECT_NE(move.source.memory, move.destination.memory);
+      }
+      allocator.finish_defragmentation(moves);
+      EXPECT_LT(allocator.stats().device_allocations, stats.device_allocations);
+
+      allocator.destroy_buffer(large);
+      EXPECT_EQ(allocator.stats().dedicated, 0u);
+
+      // destroy() releases dedicated allocations still live, not only blocks
+      ASSERT_EQ(allocator.create_buffer(info, gpu::MEMORY_USAGE_GPU_ONLY, large), VK_SUCCESS);
+      EXPECT_EQ(allocator.stats().dedicated, 1u);
+      vkDestroyBuffer(device, large.buffer, nullptr);
+      for (gpu::Buffer &buffer : buffers)
+        if (buffer.buffer != VK_NULL_HANDLE)
+          vkDestroyBuffer(device, buffer.buffer, nullptr);
+      allocator.destroy();
+      stats = allocator.stats();
+      EXPECT_EQ(stats.device_allocations, 0u);
+      EXPECT_EQ(stats.reserved, 0u);
+      vkDestroyDevice(device, nullptr);
+    }
+  }
+}
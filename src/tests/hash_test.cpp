@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../engine/core/hash/hash.hpp"
+#include "../engine/core/hash/string_id.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    struct Position
+    {
+    };
+    struct Velocity
+    {
+    };
+
+    // Evaluated by the compiler; a regression here fails the build
+    static_assert("transform"_sid == StringId("transform"), "literal and constructor ids differ");
+    static_assert("transform"_sid != "transforms"_sid, "ids collide");
+    static_assert(wyhash("") != wyhash("a"), "empty and one byte keys collide");
+    static_assert(type_id<Position>() != type_id<Velocity>(), "type ids collide");
+    static_assert(fnv1a_64_text("") == FNV1A_64_OFFSET, "FNV offset basis");
+
+    std::vector<uint8_t> random_bytes(size_t size, uint32_t seed)
+    {
+      std::mt19937 rng(seed);
+      std::vector<uint8_t> bytes(size);
+      for (uint8_t &byte : bytes)
+        byte = (uint8_t)rng();
+      return bytes;
+    }
+
+    TEST(HashTest, RuntimeMatchesCompileTime)
+    {
+      constexpr uint64_t literal = wyhash("materials/brick.mtl");
+      const std::string name = std::string("materials/") + "brick.mtl";
+      EXPECT_EQ(wyhash(name), literal);
+      EXPECT_EQ(hash64(name), literal); // Short keys take the wyhash path
+      EXPECT_EQ(fnv1a_64_text(name), fnv1a_64(name.data(), name.size()));
+      EXPECT_EQ(StringId::intern(name), "materials/brick.mtl"_sid);
+    }
+
+    TEST(HashTest, SimdAndScalarPathsAgree)
+    {
+      const std::vector<uint8_t> bytes = random_bytes(70000, 1);
+      for (size_t size : {256, 257, 319, 320, 1023, 1024, 1088, 1089, 4096, 69999})
+        for (uint64_t seed : {0ull, 1ull, 0x9e3779b97f4a7c15ull})
+          EXPECT_EQ(hash_detail::hash_long(bytes.data(), size, seed, true), hash_detail::hash_long(bytes.data(), size, seed, false)) << size;
+    }
+
+    TEST(HashTest, EveryByteAndLengthMatters)
+    {
+      std::vector<uint8_t> bytes = random_bytes(3000, 2);
+      const uint64_t base = hash64(bytes.data(), bytes.size());
+      std::set<uint64_t> seen = {base};
+      for (size_t i = 0; i < bytes.size(); i += 7)
+      {
+        bytes[i] ^= 1;
+        EXPECT_TRUE(seen.insert(hash64(bytes.data(), bytes.size())).second) << i;
+        bytes[i] ^= 1;
+      }
+      EXPECT_NE(hash64(bytes.data(), bytes.size(), 1), base);
+
+      // Zero-filled buffers of every length up to a few stripes
+      const std::vector<uint8_t> zeros(600, 0);
+      std::set<uint64_t> lengths;
+      for (size_t size = 0; size <= zeros.size(); size++)
+        EXPECT_TRUE(lengths.insert(hash64(zeros.data(), size)).second) << size;
+    }
+
+    TEST(StringTableTest, GrowsAndFindsEveryName)
+    {
+      StringTable table(16);
+      std::vector<StringId> ids;
+      for (int i = 0; i < 1000; i++)
+        ids.push_back(table.intern("entity_" + std::to_string(i)));
+      EXPECT_EQ(table.size(), 1000u);
+      EXPECT_EQ(table.intern("entity_5"), ids[5]);
+      EXPECT_EQ(table.size(), 1000u);
+      for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(table.find(ids[i]), "entity_" + std::to_string(i));
+      EXPECT_TRUE(table.find("never interned"_sid).empty());
+    }
+
+    TEST(StringTableTest, ReadersRunAlongsideWriters)
+    {
+      StringTable table(16);
+      const StringId anchor = table.intern("anchor");
+      std::atomic<bool> done{false};
+      std::atomic<uint32_t> misses{0};
+      std::vector<std::thread> threads;
+      for (int reader = 0; reader < 2; reader++)
+        threads.emplace_back([&]
+                             {
+                               while (!done.load())
+                                 if (table.find(anchor) != "anchor")
+                                   misses++; });
+      std::vector<std::thread> writers;
+      for (int writer = 0; writer < 4; writer++)
+        writers.emplace_back([&, writer]
+                             {
+                               for (int i = 0; i < 2000; i++)
+                                 table.intern("name_" + std::to_string(i % 1500) + "_" + std::to_string(writer % 2)); });
+      for (std::thread &writer : writers)
+        writer.join();
+      done = true;
+      for (std::thread &thread : threads)
+        thread.join();
+
+      EXPECT_EQ(misses.load(), 0u);
+      EXPECT_EQ(table.size(), 1u + 1500u * 2);
+      EXPECT_EQ(table.find(StringId("name_1499_1")), "name_1499_1");
+    }
+
+    TEST(StringIdTest, NamesTypes)
+    {
+      EXPECT_NE(type_name<Position>().find("Position"), std::string_view::npos);
+      EXPECT_EQ(type_id<Position>(), StringId(type_name<Position>()));
+    }
+  }
+}
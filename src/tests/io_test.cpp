@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../engine/core/io/async_io.hpp"
+#include "../engine/core/io/atomic_file.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    class AsyncIoTest : public ::testing::TestWithParam<bool>
+    {
+    protected:
+      std::filesystem::path path;
+      std::vector<uint8_t> contents;
+
+      void SetUp() override
+      {
+        path = std::filesystem::temp_directory_path() / (std::string("hades_io_") + std::to_string(GetParam()));
+        contents.resize(1 << 20);
+        for (size_t i = 0; i < contents.size(); i++)
+          contents[i] = (uint8_t)(i * 31 + (i >> 12));
+        std::ofstream(path, std::ios::binary).write((const char *)contents.data(), contents.size());
+      }
+
+      void TearDown() override
+      {
+        std::filesystem::remove(path);
+      }
+    };
+
+    TEST_P(AsyncIoTest, ReadsIntoPoolSlotsAndCallerMemory)
+    {
+      IoBufferPool pool(16, 64 * 1024);
+      auto backend = create_io_backend(&pool, 8, GetParam());
+      if (GetParam() && std::string(backend->name()) != "io_uring")
+        GTEST_SKIP() << "io_uring is not available";
+      IoFile file;
+      ASSERT_TRUE(file.open(path.string()));
+      EXPECT_EQ(file.size(), contents.size());
+
+      uint32_t matched = 0;
+      for (uint32_t i = 0; i < 16; i++)
+      {
+        IoRead read;
+        read.file = &file;
+        read.offset = (uint64_t)i * pool.slot_size();
+        read.size = (uint32_t)pool.slot_size();
+        read.buffer_slot = pool.acquire();
+        read.on_complete = [&](const IoRead &done, int64_t result)
+        {
+          EXPECT_EQ(result, (int64_t)done.size);
+          if (memcmp(pool.slot((uint32_t)done.buffer_slot), contents.data() + done.offset, done.size) == 0)
+            matched++;
+          pool.release((uint32_t)done.buffer_slot);
+        };
+        backend->read(std::move(read));
+      }
+
+      // Reads past the end come back short
+      std::vector<uint8_t> tail(4096);
+      int64_t tail_result = -1;
+      IoRead read;
+      read.file = &file;
+      read.offset = contents.size() - 100;
+      read.size = (uint32_t)tail.size();
+      read.destination = tail.data();
+      read.on_complete = [&](const IoRead &, int64_t result)
+      { tail_result = result; };
+      backend->read(std::move(read));
+
+      backend->drain();
+      EXPECT_EQ(matched, 16u);
+      EXPECT_EQ(tail_result, 100);
+      EXPECT_EQ(memcmp(tail.data(), contents.data() + contents.size() - 100, 100), 0);
+      EXPECT_EQ(backend->stats().reads, 17u);
+      EXPECT_EQ(backend->stats().bytes, 16 * pool.slot_size() + 100);
+      EXPECT_EQ(backend->stats().failed, 0u);
+      EXPECT_LT(backend->stats().batches, 17u);
+    }
+
+    TEST_P(AsyncIoTest, UrgentReadsOvertakeQueuedPrefetches)
+    {
+      auto backend = create_io_backend(nullptr, 2, GetParam());
+      if (GetParam() && std::string(backend->name()) != "io_uring")
+        GTEST_SKIP() << "io_uring is not available";
+      IoFile file;
+      ASSERT_TRUE(file.open(path.string()));
+
+      std::vector<uint8_t> buffers(4 * 4096);
+      std::vector<IoPriority> order;
+      const IoPriority priorities[] = {IoPriority::PREFETCH, IoPriority::PREFETCH, IoPriority::NORMAL, IoPriority::URGENT};
+      for (uint32_t i = 0; i < 4; i++)
+      {
+        IoRead read;
+        read.file = &file;
+        read.offset = i * 4096;
+        read.size = 4096;
+        read.destination = buffers.data() + i * 4096;
+        read.priority = priorities[i];
+        read.on_complete = [&](const IoRead &done, int64_t)
+        { order.push_back(done.priority); };
+        backend->read(std::move(read));
+      }
+      backend->drain();
+      ASSERT_EQ(order.size(), 4u);
+      // Urgent and normal share the depth; prefetches wait for both
+      EXPECT_NE(order[0], IoPriority::PREFETCH);
+      EXPECT_NE(order[1], IoPriority::PREFETCH);
+      EXPECT_EQ(order[2], IoPriority::PREFETCH);
+      EXPECT_EQ(order[3], IoPriority::PREFETCH);
+      EXPECT_EQ(memcmp(buffers.data(), contents.data(), buffers.size()), 0);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Backends, AsyncIoTest, ::testing::Values(true, false), [](const ::testing::TestParamInfo<bool> &info)
+                             { return info.param ? "IoUring" : "Pread"; });
+
+    TEST(AtomicFileTest, ConcurrentWritersOfOnePathAllSucceed)
+    {
+      const std::filesystem::path dir = std::filesystem::temp_directory_path() / "hades_atomic_file";
+      std::filesystem::remove_all(dir);
+      std::filesystem::create_directories(dir);
+      const std::string path = (dir / "same.bin").string();
+      const std::vector<uint8_t> bytes(64 << 10, 0x5a);
+
+      std::atomic<uint32_t> failures{0};
+      std::vector<std::thread> writers;
+      for (int t = 0; t < 8; t++)
+        writers.emplace_back([&]
+                             {
+                               for (int i = 0; i < 20; i++)
+                                 if (!write_file_atomic(path, bytes))
+                                   failures++; });
+      for (std::thread &writer : writers)
+        writer.join();
+      EXPECT_EQ(failures.load(), 0u);
+      EXPECT_EQ(std::filesystem::file_size(path), bytes.size());
+      // Every temporary file was renamed into place
+      EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 1);
+      std::filesystem::remove_all(dir);
+    }
+  }
+}
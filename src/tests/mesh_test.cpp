@@ -0,0 +1,493 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../engine/assets/mesh/hmesh.hpp"
+#include "../engine/assets/mesh/mesh_cooker.hpp"
+#include "../engine/assets/mesh/mesh_lod.hpp"
+#include "../engine/assets/mesh/mesh_optimizer.hpp"
+#include "../engine/assets/mesh/meshlet_builder.hpp"
+#include "../engine/assets/mesh/obj_importer.hpp"
+#include "../engine/assets/mesh/vertex_quantization.hpp"
+#include "../engine/rendering/cluster_culling.hpp"
+#include "../engine/rendering/lod_selection.hpp"
+#include "../engine/core/text/number_parser.hpp"
+#include "test_files.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    class MeshCookerTest : public TempDirTest
+    {
+    protected:
+      std::string write_file(const std::string &name, const std::string &contents)
+      {
+        const auto path = dir / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.string();
+      }
+
+      std::string write_quad()
+      {
+        return write_file("quad.obj",
+                          "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                          "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                          "vn 0 0 1\n"
+                          "f 1/1/1 2/2/1 3/3/1 4/4/1\n");
+      }
+    };
+
+    TEST_F(MeshCookerTest, CooksObjAndMapsResult)
+    {
+      const std::string obj = write_quad();
+      MeshCooker cooker((dir / "cache").string());
+
+      auto mesh = cooker.load_obj(obj, dir.string() + "/");
+      ASSERT_TRUE(mesh.has_value());
+      EXPECT_EQ(mesh->index_count(), 6u);
+      EXPECT_EQ(mesh->submesh_count(), 1u);
+      EXPECT_EQ(mesh->submeshes()[0].index_count, 6u);
+      EXPECT_FLOAT_EQ(mesh->header().bounds_max[1], 1.0f);
+      EXPECT_FLOAT_EQ(mesh->decode_vertex(mesh->vertex_index(mesh->submeshes()[0], 2)).normal[2], 1.0f);
+      EXPECT_TRUE(std::filesystem::exists(cooker.cooked_path(MeshCooker::hash_obj(obj, dir.string() + "/", HMESH_VERTEX_QUANTIZED_UNORM16))));
+    }
+
+    TEST_F(MeshCookerTest, ReusesCacheUntilSourceChanges)
+    {
+      const std::string obj = write_quad();
+      MeshCooker cooker((dir / "cache").string());
+      const uint64_t first_hash = MeshCooker::hash_obj(obj, dir.string() + "/", HMESH_VERTEX_QUANTIZED_UNORM16);
+      ASSERT_TRUE(cooker.load_obj(obj, dir.string() + "/").has_value());
+
+      // A second load must map the existing file instead of cooking again
+      const auto cooked = cooker.cooked_path(first_hash);
+      const auto cooked_time = std::filesystem::last_write_time(cooked);
+      auto again = cooker.load_obj(obj, dir.string() + "/");
+      ASSERT_TRUE(again.has_value());
+      EXPECT_EQ(again->source_hash(), first_hash);
+      EXPECT_EQ(std::filesystem::last_write_time(cooked), cooked_time);
+
+      write_file("quad.obj", "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n");
+      EXPECT_NE(MeshCooker::hash_obj(obj, dir.string() + "/", HMESH_VERTEX_QUANTIZED_UNORM16), first_hash);
+      auto edited = cooker.load_obj(obj, dir.string() + "/");
+      ASSERT_TRUE(edited.has_value());
+      EXPECT_EQ(edited->index_count(), 3u);
+    }
+
+    TEST_F(MeshCookerTest, KeepsOneCachedFilePerVertexFormat)
+    {
+      const std::string obj = write_quad();
+      MeshCooker quantized((dir / "cache").string());
+      MeshCooker full((dir / "cache").string(), HMESH_VERTEX_FLOAT);
+      const uint64_t quantized_hash = MeshCooker::hash_obj(obj, dir.string() + "/", HMESH_VERTEX_QUANTIZED_UNORM16);
+      const uint64_t full_hash = MeshCooker::hash_obj(obj, dir.string() + "/", HMESH_VERTEX_FLOAT);
+      ASSERT_NE(quantized_hash, full_hash);
+
+      ASSERT_TRUE(quantized.load_obj(obj, dir.string() + "/").has_value());
+      ASSERT_TRUE(full.load_obj(obj, dir.string() + "/").has_value());
+      const auto quantized_time = std::filesystem::last_write_time(quantized.cooked_path(quantized_hash));
+      const auto full_time = std::filesystem::last_write_time(full.cooked_path(full_hash));
+
+      // Alternating formats must not cook over each other's output
+      auto again = quantized.load_obj(obj, dir.string() + "/");
+      ASSERT_TRUE(again.has_value());
+      EXPECT_EQ(again->vertex_format(), HMESH_VERTEX_QUANTIZED_UNORM16);
+      again = full.load_obj(obj, dir.string() + "/");
+      ASSERT_TRUE(again.has_value());
+      EXPECT_EQ(again->vertex_format(), HMESH_VERTEX_FLOAT);
+      EXPECT_EQ(std::filesystem::last_write_time(quantized.cooked_path(quantized_hash)), quantized_time);
+      EXPECT_EQ(std::filesystem::last_write_time(full.cooked_path(full_hash)), full_time);
+    }
+
+    TEST_F(MeshCookerTest, WeldsSharedCornersIntoSixteenBitIndices)
+    {
+      MeshCooker cooker((dir / "cache").string());
+      auto mesh = cooker.load_obj(write_quad(), dir.string() + "/");
+      ASSERT_TRUE(mesh.has_value());
+
+      // The two triangles of the quad share the diagonal
+      EXPECT_EQ(mesh->vertex_count(), 4u);
+      const HMeshSubmesh &submesh = mesh->submeshes()[0];
+      EXPECT_EQ(submesh.index_size, 2u);
+      EXPECT_EQ(submesh.vertex_count, 4u);
+      for (uint32_t i = 0; i < submesh.index_count; i++)
+        EXPECT_LT(mesh->vertex_index(submesh, i), 4u);
+    }
+
+    TEST(MeshIndexingTest, LargeSubmeshesSwitchToThirtyTwoBitIndices)
+    {
+      MeshData mesh;
+      const uint32_t triangles = 30000;
+      for (uint32_t i = 0; i < triangles * 3; i++)
+      {
+        MeshVertex vertex = {};
+        vertex.position[0] = (float)i;
+        mesh.vertices.push_back(vertex);
+        mesh.indices.push_back(i);
+      }
+      // Repeat the first triangle through a copy of its first vertex, which
+      // welding must collapse and remap back to vertex 0
+      mesh.indices.insert(mesh.indices.end(), {triangles * 3, 1, 2});
+      mesh.vertices.push_back(mesh.vertices[0]);
+      mesh.submeshes.push_back(Submesh{0, (uint32_t)mesh.indices.size(), 0, (uint32_t)mesh.vertices.size()});
+
+      weld_mesh(mesh);
+      EXPECT_EQ(mesh.vertices.size(), triangles * 3);
+      EXPECT_EQ(mesh.submeshes[0].vertex_count, triangles * 3);
+      EXPECT_EQ(index_size_for_vertex_count(mesh.submeshes[0].vertex_count), 4u);
+      EXPECT_EQ(mesh.indices[triangles * 3], 0u);
+    }
+
+    // Regular grid of quads, triangulated in a scattered order
+    MeshData make_grid(uint32_t size)
+    {
+      MeshData mesh;
+      for (uint32_t y = 0; y <= size; y++)
+        for (uint32_t x = 0; x <= size; x++)
+        {
+          MeshVertex vertex = {};
+          vertex.position[0] = (float)x;
+          vertex.position[1] = (float)y;
+          vertex.normal[2] = 1.0f;
+          mesh.vertices.push_back(vertex);
+        }
+      std::vector<uint32_t> quads;
+      for (uint32_t i = 0; i < size * size; i++)
+        quads.push_back((i * 7919) % (size * size));
+      for (uint32_t quad : quads)
+      {
+        const uint32_t x = quad % size, y = quad / size;
+        const uint32_t v = y * (size + 1) + x;
+        mesh.indices.insert(mesh.indices.end(), {v, v + 1, v + size + 2, v, v + size + 2, v + size + 1});
+      }
+      mesh.submeshes.push_back(Submesh{0, (uint32_t)mesh.indices.size(), 0, (uint32_t)mesh.vertices.size()});
+      return mesh;
+    }
+
+    TEST(MeshOptimizerTest, ImprovesCacheEfficiencyAndKeepsTriangles)
+    {
+      MeshData mesh = make_grid(64);
+      std::vector<std::array<float, 3>> before;
+      for (uint32_t index : mesh.indices)
+        before.push_back({mesh.vertices[index].position[0], mesh.vertices[index].position[1], 0.0f});
+
+      const MeshOptimizeReport report = optimize_mesh(mesh);
+      EXPECT_LT(report.after.acmr(), report.before.acmr());
+      EXPECT_LT(report.after.acmr(), 1.0f);
+      EXPECT_EQ(report.after.vertices, report.before.vertices);
+
+      // The same set of triangles must come out, only reordered
+      auto triangle_set = [](const std::vector<std::array<float, 3>> &corners)
+      {
+        std::vector<std::array<float, 6>> triangles;
+        for (size_t i = 0; i < corners.size(); i += 3)
+        {
+          std::array<std::array<float, 2>, 3> t = {{{corners[i][0], corners[i][1]}, {corners[i + 1][0], corners[i + 1][1]}, {corners[i + 2][0], corners[i + 2][1]}}};
+          std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+          triangles.push_back({t[0][0], t[0][1], t[1][0], t[1][1], t[2][0], t[2][1]});
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+      };
+      std::vector<std::array<float, 3>> after;
+      for (uint32_t index : mesh.indices)
+        after.push_back({mesh.vertices[index].position[0], mesh.vertices[index].position[1], 0.0f});
+      EXPECT_EQ(triangle_set(before), triangle_set(after));
+
+      // Vertex fetch order follows first use
+      uint32_t next = 0;
+      for (uint32_t index : mesh.indices)
+      {
+        EXPECT_LE(index, next);
+        if (index == next)
+          next++;
+      }
+    }
+
+    TEST(MeshLodTest, SimplifiesPlaneAndKeepsBorder)
+    {
+      MeshData mesh = make_grid(32);
+      mesh.bounds.expand(mesh.vertices.front().position);
+      mesh.bounds.expand(mesh.vertices.back().position);
+      const uint32_t lod0_triangles = mesh.submeshes[0].index_count / 3;
+
+      JobSystem jobs(2);
+      generate_lods(mesh, MeshLodSettings(), jobs);
+      ASSERT_FALSE(mesh.lods.empty());
+
+      float previous_error = 0.0f;
+      uint32_t previous_triangles = lod0_triangles;
+      for (const MeshLod &lod : mesh.lods)
+      {
+        EXPECT_LT(lod.index_count / 3, previous_triangles);
+        EXPECT_GE(lod.error, previous_error);
+        previous_triangles = lod.index_count / 3;
+        previous_error = lod.error;
+
+        // A flat grid simplifies without error and keeps its four corners
+        EXPECT_NEAR(lod.error, 0.0f, 1e-3f);
+        bool corners[4] = {};
+        for (uint32_t i = 0; i < lod.index_count; i++)
+        {
+          const float *p = mesh.vertices[mesh.indices[lod.index_offset + i]].position;
+          corners[(p[0] == 32.0f ? 1 : 0) + (p[1] == 32.0f ? 2 : 0)] |= (p[0] == 0.0f || p[0] == 32.0f) && (p[1] == 0.0f || p[1] == 32.0f);
+        }
+        EXPECT_TRUE(corners[0] && corners[1] && corners[2] && corners[3]);
+      }
+      EXPECT_LE(mesh.lods.back().index_count / 3, lod0_triangles / 8);
+    }
+
+    TEST(MeshLodTest, SeamsStayWelded)
+    {
+      // Grid split down the middle by a UV seam: vertices on x == 8 exist twice
+      MeshData mesh;
+      const uint32_t size = 16;
+      std::vector<uint32_t> ids((size + 1) * (size + 1) * 2);
+      for (uint32_t side = 0; side < 2; side++)
+        for (uint32_t y = 0; y <= size; y++)
+          for (uint32_t x = 0; x <= size; x++)
+          {
+            MeshVertex vertex = {};
+            vertex.position[0] = (float)x;
+            vertex.position[1] = (float)y;
+            vertex.normal[2] = 1.0f;
+            vertex.uv[0] = (float)side;
+            ids[side * (size + 1) * (size + 1) + y * (size + 1) + x] = (uint32_t)mesh.vertices.size();
+            mesh.vertices.push_back(vertex);
+            mesh.bounds.expand(vertex.position);
+          }
+      for (uint32_t y = 0; y < size; y++)
+        for (uint32_t x = 0; x < size; x++)
+        {
+          const uint32_t side = x < size / 2 ? 0 : 1;
+          auto id = [&](uint32_t vx, uint32_t vy)
+          { return ids[side * (size + 1) * (size + 1) + vy * (size + 1) + vx]; };
+          mesh.indices.insert(mesh.indices.end(), {id(x, y), id(x + 1, y), id(x + 1, y + 1), id(x, y), id(x + 1, y + 1), id(x, y + 1)});
+        }
+      mesh.submeshes.push_back(Submesh{0, (uint32_t)mesh.indices.size(), 0, (uint32_t)mesh.vertices.size()});
+
+      JobSystem jobs(1);
+      generate_lods(mesh, MeshLodSettings(), jobs);
+      ASSERT_FALSE(mesh.lods.empty());
+      for (const MeshLod &lod : mesh.lods)
+        for (uint32_t i = 0; i < lod.index_count; i++)
+        {
+          // Every triangle keeps the attributes of its own side of the seam
+          const MeshVertex &v = mesh.vertices[mesh.indices[lod.index_offset + i]];
+          const MeshVertex &first = mesh.vertices[mesh.indices[lod.index_offset + i / 3 * 3]];
+          EXPECT_EQ(v.uv[0], first.uv[0]);
+          EXPECT_TRUE(v.uv[0] == 0.0f ? v.position[0] <= size / 2 : v.position[0] >= size / 2);
+        }
+    }
+
+    TEST_F(MeshCookerTest, RejectsTruncatedFile)
+    {
+      MeshData mesh;
+      mesh.vertices.resize(3);
+      mesh.indices = {0, 1, 2};
+      mesh.submeshes.push_back(Submesh{0, 3, 0, 3});
+      mesh.materials.push_back(MeshMaterial());
+      const std::string path = (dir / "tri.hmesh").string();
+      ASSERT_TRUE(write_hmesh(mesh, 42, path));
+      ASSERT_TRUE(MappedMesh::open(path).has_value());
+
+      std::filesystem::resize_file(path, std::filesystem::file_size(path) - 16);
+      EXPECT_FALSE(MappedMesh::open(path).has_value());
+    }
+
+    TEST_F(MeshCookerTest, MeshletsCoverSubmeshAndCullClusters)
+    {
+      MeshData mesh = make_grid(32);
+      optimize_mesh(mesh);
+      build_mesh_meshlets(mesh);
+      const Submesh &submesh = mesh.submeshes[0];
+      ASSERT_GT(submesh.meshlet_count, 1u);
+
+      // Every triangle lands in exactly one meshlet
+      std::vector<std::array<uint32_t, 3>> expected, actual;
+      for (uint32_t i = 0; i < submesh.index_count; i += 3)
+        expected.push_back({mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]});
+      for (const Meshlet &meshlet : mesh.meshlets)
+      {
+        EXPECT_LE(meshlet.vertex_count, MESHLET_MAX_VERTICES);
+        EXPECT_LE(meshlet.triangle_count, MESHLET_MAX_TRIANGLES);
+        EXPECT_EQ(meshlet.triangle_offset % 4, 0u);
+        for (uint32_t t = 0; t < meshlet.triangle_count; t++)
+        {
+          std::array<uint32_t, 3> triangle;
+          for (uint32_t c = 0; c < 3; c++)
+            triangle[c] = mesh.meshlet_vertices[meshlet.vertex_offset + mesh.meshlet_triangles[meshlet.triangle_offset + t * 3 + c]];
+          actual.push_back(triangle);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+      std::sort(actual.begin(), actual.end());
+      EXPECT_EQ(expected, actual);
+
+      const std::string path = (dir / "grid.hmesh").string();
+      ASSERT_TRUE(write_hmesh(mesh, 1, path));
+      auto mapped = MappedMesh::open(path);
+      ASSERT_TRUE(mapped.has_value());
+      const HMeshSubmesh &cooked = mapped->submeshes()[0];
+      ASSERT_EQ(cooked.meshlet_count, submesh.meshlet_count);
+
+      // Orthographic clip space covering x and y in [0, 32], depth along z
+      float clip[16] = {1.0f / 16, 0, 0, 0, 0, 1.0f / 16, 0, 0, 0, 0, 0.1f, 0, -1, -1, 0.5f, 1};
+      std::vector<uint32_t> visible;
+      const float front[3] = {16, 16, 10};
+      ClusterCullStats stats = cull_clusters(*mapped, cooked, extract_frustum(clip), front, visible);
+      EXPECT_EQ(stats.visible, cooked.meshlet_count);
+      EXPECT_EQ(visible.size(), cooked.meshlet_count);
+
+      // The flat grid faces +z, so every cluster is backfacing from below
+      visible.clear();
+      const float behind[3] = {16, 16, -10};
+      stats = cull_clusters(*mapped, cooked, extract_frustum(clip), behind, visible);
+      EXPECT_EQ(stats.backface_culled, cooked.meshlet_count);
+      EXPECT_TRUE(visible.empty());
+
+      // Shift the view half a grid to the right
+      visible.clear();
+      clip[12] = -2;
+      stats = cull_clusters(*mapped, cooked, extract_frustum(clip), front, visible);
+      EXPECT_GT(stats.frustum_culled, 0u);
+      EXPECT_GT(stats.visible, 0u);
+      EXPECT_EQ(stats.frustum_culled + stats.visible, stats.total);
+    }
+
+    TEST_F(MeshCookerTest, QuantizedVerticesStayWithinReportedError)
+    {
+      // Sphere-ish normals and UVs outside [0, 1] exercise every encoding
+      MeshData mesh = make_grid(16);
+      for (MeshVertex &vertex : mesh.vertices)
+      {
+        const float x = vertex.position[0] / 16.0f * 2.0f - 1.0f, y = vertex.position[1] / 16.0f * 2.0f - 1.0f;
+        const float length = std::sqrt(x * x + y * y + 0.25f);
+        vertex.normal[0] = x / length;
+        vertex.normal[1] = y / length;
+        vertex.normal[2] = (vertex.position[0] > 8 ? -0.5f : 0.5f) / length;
+        vertex.uv[0] = vertex.position[0] * 0.25f - 1.0f;
+        vertex.uv[1] = vertex.position[1] * 0.5f;
+        vertex.position[2] = 100.0f;
+      }
+
+      for (HMeshVertexFormat format : {HMESH_VERTEX_QUANTIZED_UNORM16, HMESH_VERTEX_QUANTIZED_HALF})
+      {
+        const std::string path = (dir / "quantized.hmesh").string();
+        VertexQuantizationReport report;
+        ASSERT_TRUE(write_hmesh(mesh, 1, path, format, &report));
+        EXPECT_EQ(report.bytes_after * 2, report.bytes_before);
+        EXPECT_LT(report.max_position_error, 16.0f / 4096.0f);
+        EXPECT_LT(report.max_normal_error, 0.01f);
+        EXPECT_LT(report.max_uv_error, 8.0f / 65535.0f);
+
+        auto mapped = MappedMesh::open(path);
+        ASSERT_TRUE(mapped.has_value());
+        EXPECT_EQ(mapped->vertices(), nullptr);
+        EXPECT_EQ(mapped->header().vertex_stride, sizeof(QuantizedVertex));
+        for (uint32_t i = 0; i < mapped->vertex_count(); i++)
+        {
+          const MeshVertex decoded = mapped->decode_vertex(i);
+          for (int axis = 0; axis < 3; axis++)
+            EXPECT_NEAR(decoded.position[axis], mesh.vertices[i].position[axis], report.max_position_error + 1e-6f);
+        }
+      }
+
+      EXPECT_EQ(half_to_float(float_to_half(1.0f)), 1.0f);
+      EXPECT_EQ(half_to_float(float_to_half(-2.5f)), -2.5f);
+      EXPECT_EQ(half_to_float(float_to_half(6.0e-8f)), half_to_float(1));
+      EXPECT_TRUE(std::isinf(half_to_float(float_to_half(70000.0f))));
+    }
+
+    TEST(NumberParserTest, MatchesStrtof)
+    {
+      const char *inputs[] = {"0", "-0.5", "1.25e3", "3.14159265358979", "-1e-7", "123456789012345678901234", "6.02214076e23", "1E-40", ".75", "42.", "+7"};
+      for (const char *input : inputs)
+      {
+        const char *cursor = input;
+        float value;
+        ASSERT_TRUE(parse_float(cursor, input + strlen(input), value)) << input;
+        EXPECT_EQ(value, strtof(input, nullptr)) << input;
+        EXPECT_EQ(cursor, input + strlen(input)) << input;
+      }
+      const char *slash = "12/3";
+      int64_t index;
+      ASSERT_TRUE(parse_int(slash, slash + 4, index));
+      EXPECT_EQ(index, 12);
+      EXPECT_EQ(*slash, '/');
+
+      // Out of range values saturate and still consume every digit
+      const char *extremes[] = {"9223372036854775807", "9223372036854775808", "99999999999999999999999",
+                                "-9223372036854775808", "-9223372036854775809", "-99999999999999999999999"};
+      const int64_t expected[] = {INT64_MAX, INT64_MAX, INT64_MAX, INT64_MIN, INT64_MIN, INT64_MIN};
+      for (int i = 0; i < 6; i++)
+      {
+        const char *cursor = extremes[i];
+        const char *end = cursor + strlen(cursor);
+        ASSERT_TRUE(parse_int(cursor, end, index)) << extremes[i];
+        EXPECT_EQ(index, expected[i]) << extremes[i];
+        EXPECT_EQ(cursor, end);
+      }
+    }
+
+    TEST_F(MeshCookerTest, ChunkedObjImportMatchesSingleChunk)
+    {
+      write_file("two.mtl", "newmtl red\nKd 1 0 0\nmap_Kd -bm 1 red.png\n\nnewmtl blue\nKd 0 0 1\n");
+      const std::string obj = write_file("scene.obj",
+                                         "# two groups, relative indices and CRLF\r\n"
+                                         "mtllib two.mtl\r\n"
+                                         "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                                         "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                                         "vn 0 0 1\n"
+                                         "g first\r\n"
+                                         "usemtl red\n"
+                                         "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+                                         "v 2 0 0\nv 3 0 0\nv 3 1 0\n"
+                                         "f -3//1 -2//1 -1//1\n"
+                                         "usemtl blue\n"
+                                         "f 5 6 7\n"
+                                         "g second\n"
+                                         "f 1 3 4 # trailing comment\n"
+                                         "usemtl missing\n"
+                                         "f 2 3 4\n");
+
+      JobSystem jobs(3);
+      MeshData whole, chunked;
+      ASSERT_TRUE(import_obj(obj, dir.string() + "/", whole, jobs));
+      ASSERT_TRUE(import_obj(obj, dir.string() + "/", chunked, jobs, 1));
+
+      // Groups then materials: first/red, first/blue, second/blue, second/default
+      ASSERT_EQ(whole.submeshes.size(), 4u);
+      ASSERT_EQ(whole.materials.size(), 3u);
+      EXPECT_EQ(whole.materials[0].diffuse_texture, "red.png");
+      EXPECT_FLOAT_EQ(whole.materials[1].diffuse[2], 1.0f);
+      const uint32_t expected_materials[] = {0, 1, 1, 2};
+      const uint32_t expected_triangles[] = {3, 1, 1, 1};
+      for (size_t i = 0; i < 4; i++)
+      {
+        EXPECT_EQ(whole.submeshes[i].material, expected_materials[i]);
+        EXPECT_EQ(whole.submeshes[i].index_count, expected_triangles[i] * 3);
+      }
+      EXPECT_FLOAT_EQ(whole.vertices[whole.indices[9]].position[0], 2.0f);
+      EXPECT_FLOAT_EQ(whole.vertices[whole.indices[2]].uv[1], 1.0f);
+      EXPECT_FLOAT_EQ(whole.bounds.max[0], 3.0f);
+
+      ASSERT_EQ(chunked.vertices.size(), whole.vertices.size());
+      EXPECT_EQ(memcmp(chunked.vertices.data(), whole.vertices.data(), sizeof(MeshVertex) * whole.vertices.size()), 0);
+      EXPECT_EQ(chunked.indices, whole.indices);
+      ASSERT_EQ(chunked.submeshes.size(), whole.submeshes.size());
+      for (size_t i = 0; i < whole.submeshes.size(); i++)
+        EXPECT_EQ(chunked.submeshes[i].material, whole.submeshes[i].material);
+
+      write_file("broken.obj", "v 0 0 0\nf 1 2 3\n");
+      MeshData broken;
+      EXPECT_FALSE(import_obj((dir / "broken.obj").string(), dir.string() + "/", broken, jobs));
+    }
+  }
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../engine/rendering/gpu/parallel_recorder.hpp"
+#include "vulkan_test_device.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    TEST(ParallelRecorderTest, PartitionsDrawsInOrder)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      VkDevice device = vulkan.create_device();
+      ASSERT_NE(device, VK_NULL_HANDLE);
+
+      JobSystem jobs(3);
+      gpu::ParallelRecorder recorder;
+      ASSERT_EQ(recorder.init(device, nullptr, vulkan.queue_family, 2, jobs, 100), VK_SUCCESS);
+
+      // Without a render pass the inheritance only matters to the driver's validation
+      VkCommandBufferInheritanceInfo inheritance = {};
+      inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+      for (uint32_t frame = 0; frame < 4; frame++)
+      {
+        recorder.begin_frame(frame % 2);
+        std::mutex mutex;
+        std::map<VkCommandBuffer, std::pair<uint32_t, uint32_t>> ranges;
+        std::vector<VkCommandBuffer> secondaries;
+        recorder.record(inheritance, 1000, [&](VkCommandBuffer commands, uint32_t begin, uint32_t end)
+                        {
+                          std::lock_guard<std::mutex> lock(mutex);
+                          EXPECT_TRUE(ranges.emplace(commands, std::make_pair(begin, end)).second); },
+                        secondaries);
+
+        // One partition per thread, covering every draw once and in order
+        ASSERT_EQ(secondaries.size(), jobs.thread_count());
+        EXPECT_EQ(recorder.stats().command_buffers, jobs.thread_count());
+        uint32_t next = 0;
+        for (VkCommandBuffer commands : secondaries)
+        {
+          ASSERT_EQ(ranges.count(commands), 1u);
+          EXPECT_EQ(ranges[commands].first, next);
+          next = ranges[commands].second;
+        }
+        EXPECT_EQ(next, 1000u);
+      }
+
+      // Short lists stay on the calling thread
+      std::vector<VkCommandBuffer> secondaries;
+      recorder.begin_frame(0);
+      recorder.record(inheritance, 50, [](VkCommandBuffer, uint32_t, uint32_t) {}, secondaries);
+      EXPECT_EQ(secondaries.size(), 1u);
+
+      recorder.destroy();
+      vkDestroyDevice(device, nullptr);
+    }
+  }
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "../engine/rendering/pipeline_cache.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    PipelineCacheKey test_key()
+    {
+      PipelineCacheKey key;
+      key.vendor_id = 0x10005; // Mesa
+      key.device_id = 0;
+      key.driver_version = 0x6000001;
+      for (uint32_t i = 0; i < VK_UUID_SIZE; i++)
+        key.uuid[i] = (uint8_t)(i * 17);
+      return key;
+    }
+
+    // What a driver returns from vkGetPipelineCacheData: its header, then opaque entries
+    std::vector<uint8_t> driver_blob(const PipelineCacheKey &key, size_t payload)
+    {
+      VkPipelineCacheHeaderVersionOne header = {};
+      header.headerSize = sizeof(header);
+      header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+      header.vendorID = key.vendor_id;
+      header.deviceID = key.device_id;
+      memcpy(header.pipelineCacheUUID, key.uuid, VK_UUID_SIZE);
+      std::vector<uint8_t> blob(sizeof(header) + payload);
+      memcpy(blob.data(), &header, sizeof(header));
+      for (size_t i = 0; i < payload; i++)
+        blob[sizeof(header) + i] = (uint8_t)(i * 31);
+      return blob;
+    }
+
+    TEST(PipelineCacheTest, FileRoundTrips)
+    {
+      const PipelineCacheKey key = test_key();
+      const std::vector<uint8_t> blob = driver_blob(key, 500);
+      const std::vector<uint8_t> file = wrap_pipeline_cache(key, blob.data(), blob.size());
+
+      const uint8_t *data = nullptr;
+      ASSERT_EQ(unwrap_pipeline_cache(file, key, data), blob.size());
+      EXPECT_EQ(memcmp(data, blob.data(), blob.size()), 0);
+      EXPECT_NE(pipeline_cache_file_name(key).find("pipelines-10005-0000-00112233"), std::string::npos);
+    }
+
+    TEST(PipelineCacheTest, RejectsOtherDriversAndDamage)
+    {
+      const PipelineCacheKey key = test_key();
+      const std::vector<uint8_t> blob = driver_blob(key, 64);
+      const std::vector<uint8_t> file = wrap_pipeline_cache(key, blob.data(), blob.size());
+      const uint8_t *data = nullptr;
+
+      PipelineCacheKey updated = key;
+      updated.driver_version++;
+      EXPECT_EQ(unwrap_pipeline_cache(file, updated, data), 0u);
+      PipelineCacheKey other_uuid = key;
+      other_uuid.uuid[15] ^= 1;
+      EXPECT_EQ(unwrap_pipeline_cache(file, other_uuid, data), 0u);
+
+      std::vector<uint8_t> truncated(file.begin(), file.end() - 1);
+      EXPECT_EQ(unwrap_pipeline_cache(truncated, key, data), 0u);
+      std::vector<uint8_t> flipped = file;
+      flipped.back() ^= 0x80;
+      EXPECT_EQ(unwrap_pipeline_cache(flipped, key, data), 0u);
+      EXPECT_EQ(data, nullptr);
+
+      // A blob whose own Vulkan header disagrees is refused even when correctly wrapped
+      std::vector<uint8_t> foreign = driver_blob(key, 64);
+      foreign[8] ^= 1; // vendorID
+      EXPECT_FALSE(pipeline_cache_data_matches(foreign.data(), foreign.size(), key));
+      EXPECT_EQ(unwrap_pipeline_cache(wrap_pipeline_cache(key, foreign.data(), foreign.size()), key, data), 0u);
+      EXPECT_FALSE(pipeline_cache_data_matches(blob.data(), 16, key));
+    }
+
+    // Runs against whatever ICD the loader finds; CI points it at lavapipe with
+    // VK_ICD_FILENAMES. Skipped on machines without a Vulkan implementation.
+    TEST(PipelineCacheTest, PersistsAcrossDevices)
+    {
+      VkApplicationInfo app = {};
+      app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+      app.apiVersion = VK_API_VERSION_1_0;
+      VkInstanceCreateInfo instance_info = {};
+      instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+      instance_info.pApplicationInfo = &app;
+      VkInstance instance = VK_NULL_HANDLE;
+      if (vkCreateInstance(&instance_info, nullptr, &instance) != VK_SUCCESS)
+        GTEST_SKIP() << "no Vulkan implementation";
+      uint32_t count = 1;
+      VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+      vkEnumeratePhysicalDevices(instance, &count, &physical_device);
+      if (physical_device == VK_NULL_HANDLE)
+      {
+        vkDestroyInstance(instance, nullptr);
+        GTEST_SKIP() << "no Vulkan device";
+      }
+
+      const float priority = 1.0f;
+      VkDeviceQueueCreateInfo queue_info = {};
+      queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+      queue_info.queueCount = 1;
+      queue_info.pQueuePriorities = &priority;
+      VkDeviceCreateInfo device_info = {};
+      device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+      device_info.queueCreateInfoCount = 1;
+      device_info.pQueueCreateInfos = &queue_info;
+
+      const std::filesystem::path dir = std::filesystem::temp_directory_path() / "hades_pipeline_cache";
+      std::filesystem::remove_all(dir);
+      for (PipelineCacheStatus expected : {PIPELINE_CACHE_EMPTY, PIPELINE_CACHE_LOADED})
+      {
+        VkDevice device = VK_NULL_HANDLE;
+        ASSERT_EQ(vkCreateDevice(physical_device, &device_info, nullptr, &device), VK_SUCCESS);
+        PipelineCache cache;
+        EXPECT_EQ(cache.create(physical_device, device, nullptr, dir.string()), VK_SUCCESS);
+        EXPECT_NE(cache.handle(), VK_NULL_HANDLE);
+        EXPECT_EQ(cache.state(), expected);
+        EXPECT_TRUE(cache.save());
+        EXPECT_TRUE(std::filesystem::is_regular_file(cache.file()));
+        cache.destroy();
+        vkDestroyDevice(device, nullptr);
+      }
+      vkDestroyInstance(instance, nullptr);
+      std::filesystem::remove_all(dir);
+    }
+  }
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../engine/rendering/render_queue.hpp"
+#include "../engine/systems/render_system.hpp"
+#include "vulkan_test_device.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    std::vector<DrawItem> random_draws(uint32_t count, uint32_t seed)
+    {
+      std::mt19937 rng(seed);
+      std::vector<DrawItem> items(count);
+      for (uint32_t i = 0; i < count; i++)
+        items[i] = DrawItem{make_draw_key(rng() % 2, rng() % 3, rng() % 40, rng() % 300, rng() % 1000, rng() % 4096), i};
+      return items;
+    }
+
+    void expect_stable_sort(std::vector<DrawItem> items, JobSystem *jobs)
+    {
+      std::vector<DrawItem> expected = items;
+      std::stable_sort(expected.begin(), expected.end(), [](const DrawItem &a, const DrawItem &b)
+                       { return a.key < b.key; });
+      std::vector<DrawItem> scratch;
+      radix_sort_draws(items, scratch, jobs, 1000);
+      ASSERT_EQ(items.size(), expected.size());
+      for (size_t i = 0; i < items.size(); i++)
+      {
+        EXPECT_EQ(items[i].key, expected[i].key);
+        EXPECT_EQ(items[i].draw, expected[i].draw);
+      }
+    }
+
+    TEST(RenderQueueTest, KeysOrderByStateThenDepth)
+    {
+      const uint64_t near = make_draw_key(0, 0, 1, 7, 3, draw_key_depth(0.1f));
+      const uint64_t far = make_draw_key(0, 0, 1, 7, 3, draw_key_depth(0.9f));
+      const uint64_t other_material = make_draw_key(0, 0, 1, 8, 0, 0);
+      const uint64_t other_pipeline = make_draw_key(0, 0, 2, 0, 0, 0);
+      const uint64_t later_pass = make_draw_key(0, 1, 0, 0, 0, 0);
+      EXPECT_LT(near, far);
+      EXPECT_LT(far, other_material);
+      EXPECT_LT(other_material, other_pipeline);
+      EXPECT_LT(other_pipeline, later_pass);
+      EXPECT_GT(draw_key_depth(0.1f, true), draw_key_depth(0.9f, true));
+
+      const uint64_t key = make_draw_key(3, 2, 0xabc, 0x1234, 0xbeef, 5);
+      EXPECT_EQ(draw_key_view(key), 3u);
+      EXPECT_EQ(draw_key_pass(key), 2u);
+      EXPECT_EQ(draw_key_pipeline(key), 0xabcu);
+      EXPECT_EQ(draw_key_material(key), 0x1234u);
+      EXPECT_EQ(draw_key_mesh(key), 0xbeefu);
+    }
+
+    TEST(RenderQueueTest, RadixSortIsStable)
+    {
+      expect_stable_sort(random_draws(5000, 1), nullptr);
+      // Few distinct keys, so equal keys must keep their order
+      std::vector<DrawItem> items = random_draws(5000, 2);
+      for (DrawItem &item : items)
+        item.key &= 0xff00000000000000ull;
+      expect_stable_sort(items, nullptr);
+      expect_stable_sort({}, nullptr);
+    }
+
+    TEST(RenderQueueTest, ParallelRadixSortMatchesSerial)
+    {
+      JobSystem jobs(3);
+      expect_stable_sort(random_draws(50000, 3), &jobs);
+      expect_stable_sort(random_draws(4097, 4), &jobs);
+    }
+
+    // count props cycling over meshes x materials, all in one vertex/index buffer
+    std::vector<DrawCommand> forest(RenderQueue &queue, uint32_t count, uint32_t meshes, uint32_t materials)
+    {
+      std::vector<DrawCommand> draws;
+      for (uint32_t i = 0; i < count; i++)
+      {
+        const uint32_t mesh = i % meshes, material = (i / meshes) % materials;
+        DrawCommand draw;
+        draw.pipeline = (VkPipeline)(uintptr_t)0x10;
+        draw.layout = (VkPipelineLayout)(uintptr_t)0x1;
+        draw.material = (VkDescriptorSet)(uintptr_t)(0x100 * (material + 1));
+        draw.vertex_buffer = draw.index_buffer = (VkBuffer)(uintptr_t)0x1000;
+        draw.index_count = 36;
+        draw.first_index = mesh * 36;
+        draws.push_back(draw);
+        queue.push(make_draw_key(0, 0, 0, material, mesh, draw_key_depth((i % 97) / 97.0f)), i);
+      }
+      queue.sort(nullptr);
+      return draws;
+    }
+
+    TEST(RenderQueueTest, CoalescesIdenticalDrawsIntoInstances)
+    {
+      RenderQueue queue;
+      std::vector<DrawCommand> draws = forest(queue, 6000, 3, 2);
+      EXPECT_EQ(queue.build_batches(draws.data()), 6u);
+      uint32_t covered = 0;
+      for (uint32_t b = 0; b < queue.batch_count(); b++)
+      {
+        const DrawBatch &batch = queue.batch_data()[b];
+        EXPECT_EQ(batch.first, covered);
+        EXPECT_EQ(batch.count, 1000u);
+        covered += batch.count;
+      }
+      EXPECT_EQ(queue.build_batches(draws.data(), 300), 24u);
+
+      // Per-instance data follows the sorted order batches index into
+      std::vector<uint32_t> ids(draws.size()), sorted(draws.size());
+      for (uint32_t i = 0; i < ids.size(); i++)
+        ids[i] = i * 7;
+      queue.write_instances(sorted.data(), ids.data(), sizeof(uint32_t), nullptr);
+      for (uint32_t i = 0; i < queue.size(); i++)
+        EXPECT_EQ(sorted[i], queue.data()[i].draw * 7);
+
+      // Matching keys are not enough when the geometry differs
+      RenderQueue mixed;
+      std::vector<DrawCommand> odd = forest(mixed, 10, 1, 1);
+      odd[3].index_count = 12;
+      odd[7].instance_count = 4;
+      EXPECT_EQ(mixed.build_batches(odd.data()), 5u);
+    }
+
+    TEST(RenderQueueTest, RenderSystemQueuesEntitiesWithMeshes)
+    {
+      EntityManager entityManager;
+      ComponentManager componentManager;
+      const uint32_t meshes[] = {7, 2, 7, 5};
+      std::vector<Entity::EntityId> entities;
+      for (uint32_t mesh : meshes)
+      {
+        entities.push_back(entityManager.createEntity());
+        componentManager.addComponent(entities.back(), MeshComponent{mesh});
+      }
+      entityManager.createEntity(); // Nothing to draw
+
+      RenderSystem system;
+      system.update(0.0f, componentManager, entityManager);
+      ASSERT_EQ(system.queue.size(), 4u);
+      ASSERT_EQ(system.draw_entities.size(), 4u);
+      const uint32_t expected[] = {2, 5, 7, 7};
+      for (uint32_t i = 0; i < 4; i++)
+      {
+        const DrawItem &item = system.queue.data()[i];
+        EXPECT_EQ(draw_key_mesh(item.key), expected[i]);
+        EXPECT_EQ(componentManager.getComponent<MeshComponent>(system.draw_entities[item.draw]).mesh, expected[i]);
+      }
+
+      // Rebuilt from scratch every update
+      system.update(0.0f, componentManager, entityManager);
+      EXPECT_EQ(system.queue.size(), 4u);
+    }
+
+    TEST(RenderQueueTest, SkipsRedundantBinds)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      VkDevice device = vulkan.create_device();
+      ASSERT_NE(device, VK_NULL_HANDLE);
+      VkCommandPoolCreateInfo pool_info = {};
+      pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+      pool_info.queueFamilyIndex = vulkan.queue_family;
+      VkCommandPool pool;
+      ASSERT_EQ(vkCreateCommandPool(device, &pool_info, nullptr, &pool), VK_SUCCESS);
+      VkCommandBufferAllocateInfo allocate_info = {};
+      allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+      allocate_info.commandPool = pool;
+      allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+      allocate_info.commandBufferCount = 1;
+      VkCommandBuffer commands;
+      ASSERT_EQ(vkAllocateCommandBuffers(device, &allocate_info, &commands), VK_SUCCESS);
+
+      // Two pipelines sharing a layout, three materials, two meshes in one buffer
+      const VkPipeline pipelines[] = {(VkPipeline)(uintptr_t)0x10, (VkPipeline)(uintptr_t)0x20};
+      const VkDescriptorSet materials[] = {(VkDescriptorSet)(uintptr_t)0x100, (VkDescriptorSet)(uintptr_t)0x200, (VkDescriptorSet)(uintptr_t)0x300};
+      std::vector<DrawCommand> draws;
+      RenderQueue queue;
+      for (uint32_t i = 0; i < 120; i++)
+      {
+        const uint32_t pipeline = i % 2, material = i % 3, mesh = i % 4 < 2 ? 0 : 1;
+        DrawCommand draw;
+        draw.pipeline = pipelines[pipeline];
+        draw.layout = (VkPipelineLayout)(uintptr_t)0x1;
+        draw.material = materials[material];
+        draw.vertex_buffer = draw.index_buffer = (VkBuffer)(uintptr_t)0x1000;
+        draw.index_buffer_offset = 1 << 20;
+        draw.index_count = 36;
+        draw.first_index = mesh * 36;
+        draws.push_back(draw);
+        queue.push(make_draw_key(0, 0, pipeline, material, mesh, i), i);
+      }
+      queue.sort(nullptr);
+      queue.record(commands, 0, queue.size(), draws.data());
+      const RenderQueueStats stats = queue.stats();
+      EXPECT_EQ(stats.draws, 120u);
+      EXPECT_EQ(stats.pipeline_binds, 2u);
+      EXPECT_EQ(stats.descriptor_binds, 6u); // Every material under each pipeline
+      EXPECT_EQ(stats.vertex_buffer_binds, 1u);
+      EXPECT_EQ(stats.index_buffer_binds, 1u);
+      EXPECT_EQ(stats.draw_calls, 120u);
+
+      RenderQueue batched;
+      std::vector<DrawCommand> props = forest(batched, 6000, 3, 2);
+      batched.build_batches(props.data());
+      batched.record_batches(commands, 0, batched.batch_count(), props.data(), (VkBuffer)(uintptr_t)0x2000, 0);
+      EXPECT_EQ(batched.stats().draw_calls, 6u);
+      EXPECT_EQ(batched.stats().descriptor_binds, 2u);
+
+      // Bindless materials push their heap index instead of binding a set
+      for (DrawCommand &draw : draws)
+      {
+        draw.material_index = (uint32_t)(uintptr_t)draw.material >> 8;
+        draw.material = VK_NULL_HANDLE;
+        draw.material_index_stages = VK_SHADER_STAGE_FRAGMENT_BIT;
+      }
+      queue.clear();
+      for (uint32_t i = 0; i < draws.size(); i++)
+        queue.push(make_draw_key(0, 0, i % 2, i % 3, i % 4 < 2 ? 0 : 1, i), i);
+      queue.sort(nullptr);
+      queue.record(commands, 0, queue.size(), draws.data());
+      EXPECT_EQ(queue.stats().descriptor_binds, 0u);
+      EXPECT_EQ(queue.stats().material_index_pushes, 6u);
+
+      vkDestroyCommandPool(device, pool, nullptr);
+      vkDestroyDevice(device, nullptr);
+    }
+  }
+}
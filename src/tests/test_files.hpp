@@ -0,0 +1,45 @@
+#ifndef TEST_FILES_H
+#define TEST_FILES_H
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace hades
+{
+  // Gives each test an empty directory under the system temp directory,
+  // named after the test and removed again when it ends
+  class TempDirTest : public ::testing::Test
+  {
+  protected:
+    std::filesystem::path dir;
+
+    void SetUp() override
+    {
+      dir = std::filesystem::temp_directory_path() / (std::string("hades_") + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+      std::filesystem::remove_all(dir);
+      std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override
+    {
+      std::filesystem::remove_all(dir);
+    }
+  };
+
+  // Uncompressed 32-bit top-left origin TGA
+  inline std::string write_tga(const std::filesystem::path &path, uint8_t width, uint8_t height)
+  {
+    std::vector<uint8_t> bytes = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, width, 0, height, 0, 32, 0x28};
+    for (int i = 0; i < width * height; i++)
+      bytes.insert(bytes.end(), {(uint8_t)(i * 7), (uint8_t)(i * 3), (uint8_t)i, 255});
+    std::ofstream(path, std::ios::binary).write((const char *)bytes.data(), bytes.size());
+    return path.string();
+  }
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../engine/assets/texture/texture_cooker.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    TextureImage gradient_image(uint32_t width, uint32_t height)
+    {
+      TextureImage image;
+      image.width = width;
+      image.height = height;
+      image.pixels.resize((size_t)width * height * 4);
+      for (uint32_t y = 0; y < height; y++)
+        for (uint32_t x = 0; x < width; x++)
+        {
+          uint8_t *texel = &image.pixels[((size_t)y * width + x) * 4];
+          texel[0] = (uint8_t)(x * 255 / (width - 1));
+          texel[1] = (uint8_t)(y * 255 / (height - 1));
+          texel[2] = (uint8_t)((x + y) * 127 / (width + height - 2));
+          texel[3] = (uint8_t)(255 - x * 128 / (width - 1));
+        }
+      return image;
+    }
+
+    TEST(MipGeneratorTest, BuildsFullChainWithClampedDimensions)
+    {
+      const std::vector<TextureImage> mips = generate_mips(gradient_image(20, 6), true, MIP_FILTER_KAISER);
+      ASSERT_EQ(mips.size(), mip_count_for(20, 6));
+      ASSERT_EQ(mips.size(), 5u);
+      EXPECT_EQ(mips[1].width, 10u);
+      EXPECT_EQ(mips[1].height, 3u);
+      EXPECT_EQ(mips[2].height, 1u);
+      EXPECT_EQ(mips[4].width, 1u);
+      EXPECT_EQ(mips[4].pixels.size(), 4u);
+    }
+
+    TEST(MipGeneratorTest, AveragesInLinearSpace)
+    {
+      // Black and white stripes average to 50% linear light, not sRGB 128
+      TextureImage image;
+      image.width = 2;
+      image.height = 2;
+      image.pixels = {0, 0, 0, 255, 255, 255, 255, 255, 0, 0, 0, 255, 255, 255, 255, 255};
+      const std::vector<TextureImage> srgb = generate_mips(image, true, MIP_FILTER_BOX);
+      EXPECT_EQ(srgb[1].pixels[0], (uint8_t)std::lround(linear_to_srgb(0.5f) * 255.0f));
+      EXPECT_EQ(srgb[1].pixels[3], 255);
+      const std::vector<TextureImage> data = generate_mips(image, false, MIP_FILTER_BOX);
+      EXPECT_EQ(data[1].pixels[0], 128);
+    }
+
+    TEST(BlockCompressionTest, RoundTripsWithinErrorBounds)
+    {
+      const TextureImage image = gradient_image(32, 32);
+      // Red, green and alpha vary independently, so no format fits a block on one line
+      const float bounds[] = {0.0f, 7.0f, 6.0f, 1.5f, 5.5f}; // Indexed by HTexFormat
+      for (uint32_t format = HTEX_FORMAT_BC1; format <= HTEX_FORMAT_BC7; format++)
+      {
+        const EncodedMip mip = encode_image(image, format);
+        EXPECT_EQ(mip.bytes.size(), htex_mip_size(format, 32, 32));
+        EXPECT_LT(encoded_rmse(image, mip, format), bounds[format]) << "format " << format;
+      }
+
+      // A flat block must survive exactly in BC7
+      uint8_t texels[64], block[16], decoded[64];
+      for (int i = 0; i < 16; i++)
+      {
+        texels[i * 4] = 200;
+        texels[i * 4 + 1] = 100;
+        texels[i * 4 + 2] = 50;
+        texels[i * 4 + 3] = 255;
+      }
+      encode_bc7_block(texels, block);
+      decode_bc7_block(block, decoded);
+      for (int i = 0; i < 64; i++)
+        EXPECT_NEAR(decoded[i], texels[i], 1) << i;
+
+      // BC3 colour ignores c0 <= c1: index 3 is the two-thirds interpolant, not black
+      const uint8_t bc3[16] = {128, 128, 0, 0, 0, 0, 0, 0, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+      decode_bc3_block(bc3, decoded);
+      for (int i = 0; i < 16; i++)
+      {
+        EXPECT_NEAR(decoded[i * 4], 170, 1) << i;
+        EXPECT_EQ(decoded[i * 4 + 3], 128) << i;
+      }
+    }
+
+    TEST(HTexTest, WritesCoarsestMipFirstAndMapsBack)
+    {
+      const std::filesystem::path dir = std::filesystem::temp_directory_path() / "hades_htex_test";
+      std::filesystem::remove_all(dir);
+      std::filesystem::create_directories(dir);
+      const std::string path = (dir / "gradient.htex").string();
+
+      TextureCookSettings settings;
+      settings.format = HTEX_FORMAT_BC3;
+      std::vector<EncodedMip> mips;
+      TextureCookReport report;
+      ASSERT_TRUE(TextureCooker::cook(gradient_image(64, 16), settings, mips, report));
+      EXPECT_LT(report.bytes_after, report.bytes_before);
+      ASSERT_TRUE(write_htex(mips, settings.format, HTEX_FLAG_SRGB, 42, path));
+
+      auto texture = MappedTexture::open(path);
+      ASSERT_TRUE(texture.has_value());
+      EXPECT_EQ(texture->source_hash(), 42u);
+      EXPECT_TRUE(texture->srgb());
+      EXPECT_EQ(texture->mip_count(), 7u);
+      EXPECT_EQ(texture->mip(3).width, 8u);
+      EXPECT_EQ(texture->mip(3).height, 2u);
+      EXPECT_LT(texture->mip(6).offset, texture->mip(0).offset);
+      for (uint32_t level = 0; level < texture->mip_count(); level++)
+      {
+        EXPECT_EQ(texture->mip(level).offset % HTEX_ALIGNMENT, 0u);
+        EXPECT_EQ(memcmp(texture->mip_data(level), mips[level].bytes.data(), mips[level].bytes.size()), 0);
+      }
+
+      texture.reset();
+      std::filesystem::resize_file(path, std::filesystem::file_size(path) - 16);
+      EXPECT_FALSE(MappedTexture::open(path).has_value());
+      std::filesystem::remove_all(dir);
+    }
+  }
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "../engine/rendering/gpu/asset_residency.hpp"
+#include "../engine/rendering/gpu/staging_ring.hpp"
+#include "../engine/rendering/gpu/upload_queue.hpp"
+#include "vulkan_test_device.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    using gpu::RingAllocator;
+
+    TEST(RingAllocatorTest, WrapsAndReclaimsByBatch)
+    {
+      RingAllocator ring(1000);
+      uint64_t a, b, c;
+      ASSERT_TRUE(ring.allocate(300, 16, a));
+      ring.close_batch(1);
+      ASSERT_TRUE(ring.allocate(500, 16, b));
+      ring.close_batch(2);
+      EXPECT_EQ(a, 0u);
+      EXPECT_EQ(b, 304u);
+
+      // 196 bytes remain at the end, too few: nothing fits until batch 1 retires
+      EXPECT_FALSE(ring.allocate(250, 16, c));
+      ring.retire(1);
+      ASSERT_TRUE(ring.allocate(250, 16, c));
+      EXPECT_EQ(c, 0u); // Wrapped; the skipped tail is charged to this batch
+      EXPECT_EQ(ring.used(), 1000u - 300u + 250u);
+      ring.close_batch(3);
+
+      ring.retire(2);
+      EXPECT_EQ(ring.used(), 196u + 250u);
+      ring.retire(3);
+      EXPECT_EQ(ring.used(), 0u);
+      // An idle ring starts over at zero for the longest contiguous run
+      ASSERT_TRUE(ring.allocate(1000, 16, c));
+      EXPECT_EQ(c, 0u);
+    }
+
+    TEST(RingAllocatorTest, OpenBatchIsNeverReclaimed)
+    {
+      RingAllocator ring(256);
+      uint64_t offset;
+      ASSERT_TRUE(ring.allocate(128, 1, offset));
+      ring.close_batch(1);
+      ring.close_batch(2); // Empty, so it records nothing
+      ASSERT_TRUE(ring.allocate(128, 1, offset));
+      EXPECT_FALSE(ring.allocate(1, 1, offset));
+      ring.retire(2);
+      EXPECT_EQ(ring.used(), 128u); // Still owned by the unclosed batch
+      EXPECT_FALSE(ring.allocate(257, 1, offset));
+    }
+
+    TEST(UploadQueueTest, CopiesThroughTheRingWithinBudget)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      VkDevice device = vulkan.create_device();
+      ASSERT_NE(device, VK_NULL_HANDLE);
+      VkQueue queue;
+      vkGetDeviceQueue(device, vulkan.queue_family, 0, &queue);
+
+      gpu::Allocator allocator;
+      allocator.init(vulkan.physical_device, device, nullptr);
+      gpu::UploadSettings settings;
+      settings.ring_size = 1 << 20;
+      settings.bytes_per_frame = 64 << 10;
+      gpu::UploadQueue uploads;
+      ASSERT_EQ(uploads.init(allocator, device, nullptr, queue, vulkan.queue_family, vulkan.queue_family, settings), VK_SUCCESS);
+      EXPECT_FALSE(uploads.uses_transfer_queue());
+
+      VkBufferCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      info.size = 48 << 10;
+      info.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+      gpu::Buffer first, second;
+      ASSERT_EQ(allocator.create_buffer(info, gpu::MEMORY_USAGE_READBACK, first), VK_SUCCESS);
+      ASSERT_EQ(allocator.create_buffer(info, gpu::MEMORY_USAGE_READBACK, second), VK_SUCCESS);
+      std::vector<uint8_t> data(info.size);
+      for (size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)(i * 13 + 1);
+
+      const uint64_t ticket = uploads.upload_buffer(data.data(), data.size(), first.buffer);
+      ASSERT_NE(ticket, 0u);
+      // The second upload would exceed this frame's budget
+      EXPECT_EQ(uploads.upload_buffer(data.data(), data.size(), second.buffer), 0u);
+      EXPECT_EQ(uploads.stats().deferred, 1u);
+
+      EXPECT_EQ(uploads.flush(), ticket);
+      const uint64_t next = uploads.upload_buffer(data.data(), data.size(), second.buffer);
+      EXPECT_GT(next, ticket);
+      uploads.flush();
+      vkQueueWaitIdle(queue);
+      EXPECT_TRUE(uploads.complete(ticket));
+      EXPECT_TRUE(uploads.complete(next));
+      EXPECT_EQ(uploads.stats().ring_used, 0u);
+
+      allocator.invalidate(first.allocation);
+      allocator.invalidate(second.allocation);
+      EXPECT_EQ(memcmp(first.allocation.mapped, data.data(), data.size()), 0);
+      EXPECT_EQ(memcmp(second.allocation.mapped, data.data(), data.size()), 0);
+
+      allocator.destroy_buffer(first);
+      allocator.destroy_buffer(second);
+      uploads.destroy();
+      allocator.destroy();
+      vkDestroyDevice(device, nullptr);
+    }
+
+    TEST(AssetResidencyTest, UploadsListedMeshesAndReleasesTheRest)
+    {
+      VulkanTestDevice vulkan;
+      if (!vulkan.init())
+        GTEST_SKIP() << "no Vulkan device";
+      VkDevice device = vulkan.create_device();
+      ASSERT_NE(device, VK_NULL_HANDLE);
+      VkQueue queue;
+      vkGetDeviceQueue(device, vulkan.queue_family, 0, &queue);
+
+      MeshData data;
+      data.vertices.resize(3);
+      data.indices = {0, 1, 2};
+      data.submeshes.push_back(Submesh{0, 3, 0, 3});
+      data.materials.push_back(MeshMaterial());
+      const std::string path = (std::filesystem::temp_directory_path() / "hades_residency.hmesh").string();
+      ASSERT_TRUE(write_hmesh(data, 7, path));
+      std::optional<MappedMesh> mesh = MappedMesh::open(path);
+      ASSERT_TRUE(mesh.has_value());
+
+      gpu::Allocator allocator;
+      allocator.init(vulkan.physical_device, device, nullptr);
+      gpu::UploadQueue uploads;
+      ASSERT_EQ(uploads.init(allocator, device, nullptr, queue, vulkan.queue_family, vulkan.queue_family), VK_SUCCESS);
+      gpu::AssetResidency residency;
+      residency.init(allocator, uploads, device, nullptr);
+
+      residency.sync({&*mesh}, {});
+      EXPECT_EQ(residency.stats().uploading, 1u);
+      uploads.flush();
+      vkQueueWaitIdle(queue);
+      const gpu::GpuMesh *gpu_mesh = residency.mesh(*mesh);
+      ASSERT_NE(gpu_mesh, nullptr);
+      EXPECT_NE(gpu_mesh->buffer.buffer, VK_NULL_HANDLE);
+      // Listing it again keeps the same copy
+      residency.sync({&*mesh}, {});
+      EXPECT_EQ(residency.mesh(*mesh), gpu_mesh);
+      EXPECT_EQ(residency.stats().meshes, 1u);
+
+      // Dropped from the list, it is released and destroyed when its frame retires
+      residency.sync({}, {});
+      EXPECT_EQ(residency.mesh(*mesh), nullptr);
+      residency.end_frame(1);
+      const uint32_t allocations = allocator.stats().allocations;
+      residency.retire(1);
+      EXPECT_EQ(allocator.stats().allocations, allocations - 1);
+
+      residency.destroy();
+      uploads.destroy();
+      allocator.destroy();
+      vkDestroyDevice(device, nullptr);
+      std::filesystem::remove(path);
+    }
+  }
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../engine/core/compression/lz.hpp"
+#include "../engine/core/vfs/pak_builder.hpp"
+#include "../engine/core/vfs/vfs.hpp"
+#include "test_files.hpp"
+
+namespace hades
+{
+  namespace
+  {
+    std::vector<uint8_t> round_trip(const std::vector<uint8_t> &input)
+    {
+      std::vector<uint8_t> compressed(lz_compress_bound(input.size()));
+      const size_t size = lz_compress(input.data(), input.size(), compressed.data(), compressed.size());
+      EXPECT_GT(size, 0u);
+      std::vector<uint8_t> output(input.size());
+      EXPECT_TRUE(lz_decompress(compressed.data(), size, output.data(), output.size()));
+      return output;
+    }
+
+    // Text-like data with long repeats and short-offset runs
+    std::vector<uint8_t> repetitive(size_t size)
+    {
+      std::vector<uint8_t> data;
+      std::mt19937 rng(7);
+      const std::string words[] = {"vertex ", "normal ", "texcoord ", "0.5 ", "1.0 ", "\n"};
+      while (data.size() < size)
+      {
+        const std::string &word = words[rng() % 6];
+        data.insert(data.end(), word.begin(), word.end());
+        if (rng() % 16 == 0)
+          data.insert(data.end(), 40, (uint8_t)('a' + rng() % 26));
+      }
+      data.resize(size);
+      return data;
+    }
+
+    TEST(LzTest, RoundTripsRandomRepetitiveAndTinyInputs)
+    {
+      std::mt19937 rng(1);
+      std::vector<uint8_t> noise(100000);
+      for (uint8_t &byte : noise)
+        byte = (uint8_t)rng();
+      EXPECT_EQ(round_trip(noise), noise);
+
+      const std::vector<uint8_t> text = repetitive(150000);
+      EXPECT_EQ(round_trip(text), text);
+      std::vector<uint8_t> compressed(lz_compress_bound(text.size()));
+      EXPECT_LT(lz_compress(text.data(), text.size(), compressed.data(), compressed.size()), text.size() / 3);
+
+      for (size_t size : {0, 1, 5, 12, 13, 17, 300})
+      {
+        const std::vector<uint8_t> zeros(size, 0);
+        EXPECT_EQ(round_trip(zeros), zeros) << size;
+      }
+    }
+
+    TEST(LzTest, RejectsCorruptOrTruncatedInput)
+    {
+      const std::vector<uint8_t> text = repetitive(20000);
+      std::vector<uint8_t> compressed(lz_compress_bound(text.size()));
+      const size_t size = lz_compress(text.data(), text.size(), compressed.data(), compressed.size());
+      std::vector<uint8_t> output(text.size());
+
+      EXPECT_FALSE(lz_decompress(compressed.data(), size / 2, output.data(), output.size()));
+      EXPECT_FALSE(lz_decompress(compressed.data(), size, output.data(), output.size() - 1));
+      EXPECT_FALSE(lz_compress(text.data(), text.size(), compressed.data(), 64));
+
+      // An offset reaching before the start of the output
+      const uint8_t bad[] = {0x10, 'a', 0x09, 0x00, 0x00};
+      uint8_t small[16];
+      EXPECT_FALSE(lz_decompress(bad, sizeof(bad), small, sizeof(small)));
+    }
+
+    class PakTest : public TempDirTest
+    {
+    };
+
+    TEST_F(PakTest, ServesStoredEntriesInPlaceAndDecodesCompressedBlocks)
+    {
+      const std::vector<uint8_t> level = repetitive(200000); // Several blocks
+      std::vector<uint8_t> image(3000);
+      std::mt19937 rng(3);
+      for (uint8_t &byte : image)
+        byte = (uint8_t)rng();
+
+      vfs::PakBuilder builder;
+      EXPECT_TRUE(builder.add("levels/one.obj", level));
+      EXPECT_TRUE(builder.add("textures\\wall.htex", image, false));
+      EXPECT_TRUE(builder.add("empty.txt", {}));
+      EXPECT_FALSE(builder.add("./levels/one.obj", level));
+      vfs::PakBuildReport report;
+      const std::string path = (dir / "data.hpak").string();
+      ASSERT_TRUE(builder.write(path, &report));
+      EXPECT_EQ(report.files, 3u);
+      EXPECT_EQ(report.stored, 2u);
+      EXPECT_LT(report.payload_bytes, report.raw_bytes);
+
+      auto pak = vfs::PakArchive::open(path);
+      ASSERT_TRUE(pak.has_value());
+      EXPECT_EQ(pak->find("levels/two.obj"), nullptr);
+
+      const vfs::PakEntry *wall = pak->find("textures/wall.htex");
+      ASSERT_NE(wall, nullptr);
+      const uint8_t *view = pak->view(*wall);
+      ASSERT_NE(view, nullptr);
+      EXPECT_EQ((uintptr_t)view % vfs::PAK_ALIGNMENT, 0u);
+      EXPECT_EQ(std::vector<uint8_t>(view, view + wall->size), image);
+
+      const vfs::PakEntry *one = pak->find("/levels/one.obj");
+      ASSERT_NE(one, nullptr);
+      EXPECT_EQ(pak->view(*one), nullptr);
+      std::vector<uint8_t> decoded(one->size);
+      ASSERT_TRUE(pak->read(*one, decoded.data()));
+      EXPECT_EQ(decoded, level);
+
+      const vfs::PakEntry *empty = pak->find("empty.txt");
+      ASSERT_NE(empty, nullptr);
+      EXPECT_EQ(empty->size, 0u);
+    }
+
+    TEST_F(PakTest, RejectsTruncatedArchives)
+    {
+      vfs::PakBuilder builder;
+      builder.add("a.txt", repetitive(5000));
+      std::vector<uint8_t> bytes;
+      ASSERT_TRUE(builder.build(bytes));
+
+      const std::string path = (dir / "bad.hpak").string();
+      std::ofstream(path, std::ios::binary).write((const char *)bytes.data(), bytes.size() - 10);
+      EXPECT_FALSE(vfs::PakArchive::open(path).has_value());
+      std::ofstream(path, std::ios::binary).write("HPAK", 4);
+      EXPECT_FALSE(vfs::PakArchive::open(path).has_value());
+    }
+
+    TEST_F(PakTest, RejectsEntriesPastTheBlockTable)
+    {
+      vfs::PakBuilder builder;
+      builder.add("a.txt", repetitive(5000));
+      std::vector<uint8_t> bytes;
+      ASSERT_TRUE(builder.build(bytes));
+      const std::string path = (dir / "bad.hpak").string();
+      std::ofstream(path, std::ios::binary).write((const char *)bytes.data(), bytes.size());
+      ASSERT_TRUE(vfs::PakArchive::open(path).has_value());
+
+      // A size whose block count only fits once truncated to 32 bits
+      vfs::PakHeader header;
+      memcpy(&header, bytes.data(), sizeof(header));
+      vfs::PakEntry entry;
+      memcpy(&entry, bytes.data() + sizeof(header), sizeof(entry));
+      ASSERT_TRUE(entry.flags & vfs::PAK_ENTRY_COMPRESSED);
+      entry.size = (uint64_t)header.block_size << 32;
+      memcpy(bytes.data() + sizeof(header), &entry, sizeof(entry));
+      std::ofstream(path, std::ios::binary).write((const char *)bytes.data(), bytes.size());
+      EXPECT_FALSE(vfs::PakArchive::open(path).has_value());
+    }
+
+    TEST_F(PakTest, LaterMountsShadowEarlierOnes)
+    {
+      vfs::PakBuilder builder;
+      builder.add("config.txt", {'p', 'a', 'k'});
+      builder.add("only_in_pak.txt", {'x'});
+      const std::string path = (dir / "base.hpak").string();
+      ASSERT_TRUE(builder.write(path));
+      std::filesystem::create_directories(dir / "loose");
+      std::ofstream(dir / "loose" / "config.txt") << "loose";
+
+      vfs::FileSystem fs;
+      ASSERT_TRUE(fs.mount_pak(path));
+      fs.mount_directory((dir / "loose").string());
+      EXPECT_TRUE(fs.exists("only_in_pak.txt"));
+      EXPECT_FALSE(fs.exists("missing.txt"));
+      EXPECT_FALSE(fs.read("missing.txt").has_value());
+
+      auto config = fs.read("config.txt");
+      ASSERT_TRUE(config.has_value());
+      EXPECT_EQ(config->text(), "loose");
+      EXPECT_TRUE(config->zero_copy());
+      auto only = fs.read("only_in_pak.txt");
+      ASSERT_TRUE(only.has_value());
+      EXPECT_EQ(only->text(), "x");
+    }
+  }
+}
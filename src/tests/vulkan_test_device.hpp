@@ -0,0 +1,90 @@
+#ifndef VULKAN_TEST_DEVICE_H
+#define VULKAN_TEST_DEVICE_H
+
+#include <cstring>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace hades
+{
+  // Headless instance and device for tests that need a real driver. Runs
+  // against whatever ICD the loader finds; CI points it at lavapipe with
+  // VK_ICD_FILENAMES. Tests skip themselves when init() fails.
+  struct VulkanTestDevice
+  {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    uint32_t queue_family = 0;
+
+    bool init()
+    {
+      VkApplicationInfo app = {};
+      app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+      app.apiVersion = VK_API_VERSION_1_0;
+      VkInstanceCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+      info.pApplicationInfo = &app;
+      // Needed to query optional device features
+      uint32_t extension_count = 0;
+      vkEnumerateInstanceExtensionProperties(nullptr, &extension_count, nullptr);
+      std::vector<VkExtensionProperties> extensions(extension_count);
+      vkEnumerateInstanceExtensionProperties(nullptr, &extension_count, extensions.data());
+      const char *properties2 = VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME;
+      for (const VkExtensionProperties &extension : extensions)
+        if (strcmp(extension.extensionName, properties2) == 0)
+        {
+          info.enabledExtensionCount = 1;
+          info.ppEnabledExtensionNames = &properties2;
+        }
+      if (vkCreateInstance(&info, nullptr, &instance) != VK_SUCCESS)
+      {
+        instance = VK_NULL_HANDLE;
+        return false;
+      }
+      uint32_t count = 1;
+      vkEnumeratePhysicalDevices(instance, &count, &physical_device);
+      if (physical_device == VK_NULL_HANDLE)
+        return false;
+
+      VkQueueFamilyProperties families[16];
+      count = 16;
+      vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &count, families);
+      for (uint32_t i = 0; i < count; i++)
+        if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+        {
+          queue_family = i;
+          break;
+        }
+      return true;
+    }
+
+    VkDevice create_device(const char *const *extensions = nullptr, uint32_t extension_count = 0, const void *features = nullptr) const
+    {
+      const float priority = 1.0f;
+      VkDeviceQueueCreateInfo queue_info = {};
+      queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+      queue_info.queueFamilyIndex = queue_family;
+      queue_info.queueCount = 1;
+      queue_info.pQueuePriorities = &priority;
+      VkDeviceCreateInfo info = {};
+      info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+      info.pNext = features;
+      info.enabledExtensionCount = extension_count;
+      info.ppEnabledExtensionNames = extensions;
+      info.queueCreateInfoCount = 1;
+      info.pQueueCreateInfos = &queue_info;
+      VkDevice device = VK_NULL_HANDLE;
+      if (vkCreateDevice(physical_device, &info, nullptr, &device) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+      return device;
+    }
+
+    ~VulkanTestDevice()
+    {
+      if (instance != VK_NULL_HANDLE)
+        vkDestroyInstance(instance, nullptr);
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include "../engine/assets/asset_cook.hpp"
+
+// Cooks every OBJ (with its MTL files) and image under a directory into the
+// runtime cache, skipping anything the cook database says is current.
+int main(int argc, char **argv)
+{
+  CLI::App app{"Hades asset cooker"};
+  std::string input_dir;
+  hades::CookOptions options;
+  std::string database_path;
+  std::string texture_format = "bc7";
+  std::string vertex_format = "unorm16";
+  bool list = false;
+  app.add_option("input", input_dir, "Asset directory to scan")->required()->check(CLI::ExistingDirectory);
+  app.add_option("-c,--cache", options.cache_dir, "Cache directory the engine loads cooked assets from");
+  app.add_option("--db", database_path, "Cook database (default: <cache>/cook.db)");
+  app.add_option("--texture-format", texture_format, "Colour texture format")->check(CLI::IsMember({"rgba8", "bc1", "bc3", "bc7"}));
+  app.add_option("--vertex-format", vertex_format, "Cooked vertex format")->check(CLI::IsMember({"float", "unorm16", "half"}));
+  app.add_flag("-f,--force", options.force, "Cook everything, ignoring the database");
+  app.add_flag("-l,--list", list, "Print the dependency graph and exit");
+  app.add_flag("-v,--verbose", options.verbose, "Print stats for every asset cooked");
+
+  CLI11_PARSE(app, argc, argv);
+
+  const std::map<std::string, hades::HTexFormat> texture_formats = {
+      {"rgba8", hades::HTEX_FORMAT_RGBA8}, {"bc1", hades::HTEX_FORMAT_BC1}, {"bc3", hades::HTEX_FORMAT_BC3}, {"bc7", hades::HTEX_FORMAT_BC7}};
+  const std::map<std::string, hades::HMeshVertexFormat> vertex_formats = {
+      {"float", hades::HMESH_VERTEX_FLOAT}, {"unorm16", hades::HMESH_VERTEX_QUANTIZED_UNORM16}, {"half", hades::HMESH_VERTEX_QUANTIZED_HALF}};
+  hades::TextureCookSettings colour;
+  colour.format = texture_formats.at(texture_format);
+  options.vertex_format = vertex_formats.at(vertex_format);
+  if (database_path.empty())
+    database_path = (std::filesystem::path(options.cache_dir) / "cook.db").string();
+
+  const auto start = std::chrono::steady_clock::now();
+  const hades::CookGraph graph = hades::CookGraph::scan(input_dir, colour, options.vertex_format);
+  for (const std::string &missing : graph.missing)
+    fprintf(stderr, "WARN: missing %s\n", missing.c_str());
+
+  if (list)
+  {
+    for (const hades::CookNode &node : graph.nodes)
+    {
+      if (node.kind != hades::COOK_MESH)
+        continue;
+      printf("%s\n", node.source.c_str());
+      for (const std::string &material : node.materials)
+        printf("  %s\n", material.c_str());
+      for (uint32_t texture : node.textures)
+        printf("    %s [%s]\n", graph.nodes[texture].source.c_str(), graph.nodes[texture].variant.c_str());
+    }
+    return 0;
+  }
+
+  hades::CookDatabase database;
+  if (!database.load(database_path))
+    fprintf(stderr, "WARN: %s is malformed, cooking everything\n", database_path.c_str());
+  const hades::CookSummary summary = hades::cook_graph(graph, database, options);
+  if (!database.save(database_path))
+  {
+    fprintf(stderr, "ERR: failed to write %s\n", database_path.c_str());
+    return 1;
+  }
+
+  for (const std::string &failure : summary.failures)
+    fprintf(stderr, "ERR: failed to cook %s\n", failure.c_str());
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("%zu assets: %u cooked, %u up to date, %u failed, %u pruned in %.2f s\n", graph.nodes.size(), summary.cooked,
+         summary.up_to_date, summary.failed, summary.pruned, seconds);
+  return summary.failed > 0 ? 1 : 0;
+}
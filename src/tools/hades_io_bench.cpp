@@ -0,0 +1,171 @@
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../engine/core/io/async_io.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
+// Streams a set of files through each async I/O backend with a cold and a
+// warm page cache. Cold runs drop the files' cached pages with
+// posix_fadvise(DONTNEED) first, which works without root as long as the
+// pages are clean.
+namespace
+{
+  void drop_cache(const std::vector<std::string> &paths)
+  {
+#if !defined(_WIN32) && !defined(__APPLE__)
+    for (const std::string &path : paths)
+    {
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        continue;
+      fdatasync(fd);
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      ::close(fd);
+    }
+#else
+    (void)paths;
+#endif
+  }
+
+  struct Run
+  {
+    double seconds;
+    hades::IoStats stats;
+  };
+
+  Run stream(hades::IoBackend &backend, const std::vector<hades::IoFile> &files, uint32_t block, bool shuffle)
+  {
+    hades::IoBufferPool &pool = *backend.buffer_pool();
+    struct Block
+    {
+      const hades::IoFile *file;
+      uint64_t offset;
+    };
+    std::vector<Block> blocks;
+    for (const hades::IoFile &file : files)
+      for (uint64_t offset = 0; offset < file.size(); offset += block)
+        blocks.push_back(Block{&file, offset});
+    if (shuffle)
+      std::shuffle(blocks.begin(), blocks.end(), std::mt19937(42));
+
+    const hades::IoStats before = backend.stats();
+    const auto start = std::chrono::steady_clock::now();
+    size_t next = 0;
+    while (next < blocks.size() || backend.outstanding() > 0 || backend.queued() > 0)
+    {
+      // Keep every pool slot busy; each completion frees its slot for the next block
+      for (int32_t slot; next < blocks.size() && (slot = pool.acquire()) >= 0; next++)
+      {
+        hades::IoRead read;
+        read.file = blocks[next].file;
+        read.offset = blocks[next].offset;
+        read.size = block;
+        read.buffer_slot = slot;
+        read.priority = next % 4 == 0 ? hades::IoPriority::URGENT : hades::IoPriority::PREFETCH;
+        read.on_complete = [&pool](const hades::IoRead &done, int64_t)
+        { pool.release((uint32_t)done.buffer_slot); };
+        backend.read(std::move(read));
+      }
+      backend.submit();
+      backend.poll(true);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    hades::IoStats stats = backend.stats();
+    stats.reads -= before.reads;
+    stats.bytes -= before.bytes;
+    stats.failed -= before.failed;
+    stats.batches -= before.batches;
+    return Run{seconds, stats};
+  }
+}
+
+int main(int argc, char **argv)
+{
+  CLI::App app{"Hades async I/O benchmark"};
+  std::string directory = (std::filesystem::temp_directory_path() / "hades_io_bench").string();
+  uint32_t file_count = 64;
+  uint32_t file_mb = 4;
+  uint32_t block_kb = 256;
+  uint32_t depth = 64;
+  uint32_t threads = 4;
+  bool shuffle = false;
+  bool keep = false;
+  app.add_option("-d,--dir", directory, "Directory for the test files");
+  app.add_option("-n,--files", file_count, "Number of files");
+  app.add_option("-s,--file-mb", file_mb, "Size of each file in MiB");
+  app.add_option("-b,--block-kb", block_kb, "Read size in KiB");
+  app.add_option("--depth", depth, "Reads in flight");
+  app.add_option("-t,--threads", threads, "Worker threads of the pread backend");
+  app.add_flag("--random", shuffle, "Read blocks in random order");
+  app.add_flag("--keep", keep, "Keep the test files");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::filesystem::create_directories(directory);
+  std::vector<std::string> paths;
+  std::vector<char> chunk(1 << 20);
+  std::mt19937 rng(1);
+  for (uint32_t i = 0; i < file_count; i++)
+  {
+    const std::string path = (std::filesystem::path(directory) / ("file_" + std::to_string(i) + ".bin")).string();
+    paths.push_back(path);
+    if (std::filesystem::exists(path) && std::filesystem::file_size(path) == (uint64_t)file_mb << 20)
+      continue;
+    std::ofstream out(path, std::ios::binary);
+    for (uint32_t mb = 0; mb < file_mb; mb++)
+    {
+      for (char &byte : chunk)
+        byte = (char)rng();
+      out.write(chunk.data(), chunk.size());
+    }
+  }
+
+  std::vector<hades::IoFile> files(paths.size());
+  for (size_t i = 0; i < paths.size(); i++)
+    if (!files[i].open(paths[i]))
+    {
+      fprintf(stderr, "ERR: cannot open %s\n", paths[i].c_str());
+      return 1;
+    }
+
+  const uint32_t block = block_kb * 1024;
+  printf("%u files x %u MiB, %u KiB reads, depth %u, %s order\n", file_count, file_mb, block_kb, depth, shuffle ? "random" : "sequential");
+  printf("%-10s %-6s %10s %10s %10s\n", "backend", "cache", "MiB/s", "reads", "batches");
+  for (bool io_uring : {true, false})
+  {
+    hades::IoBufferPool pool(depth, block);
+    std::unique_ptr<hades::IoBackend> backend = io_uring ? hades::create_io_backend(&pool, depth, true)
+                                                         : std::make_unique<hades::PreadBackend>(&pool, depth, threads);
+    if (io_uring && std::string(backend->name()) != "io_uring")
+    {
+      printf("%-10s unavailable\n", "io_uring");
+      continue;
+    }
+    for (bool cold : {true, false})
+    {
+      if (cold)
+        drop_cache(paths);
+      const Run run = stream(*backend, files, block, shuffle);
+      printf("%-10s %-6s %10.1f %10" PRIu64 " %10" PRIu64 "%s\n", backend->name(), cold ? "cold" : "warm",
+             run.stats.bytes / (1024.0 * 1024.0) / run.seconds, run.stats.reads, run.stats.batches,
+             run.stats.failed > 0 ? " (failures)" : "");
+    }
+  }
+
+  if (!keep)
+    std::filesystem::remove_all(directory);
+  return 0;
+}
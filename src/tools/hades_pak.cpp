@@ -0,0 +1,56 @@
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../engine/core/vfs/pak_builder.hpp"
+
+// Packs a directory tree into a .hpak archive. Paths inside the archive are
+// relative to the input directory.
+int main(int argc, char **argv)
+{
+  CLI::App app{"Hades pak builder"};
+  std::string input_dir;
+  std::string output_path;
+  std::vector<std::string> store_extensions = {".jpg", ".jpeg", ".png", ".htex"};
+  app.add_option("input", input_dir, "Directory to pack")->required()->check(CLI::ExistingDirectory);
+  app.add_option("-o,--output", output_path, "Archive to write")->required();
+  app.add_option("--store", store_extensions, "Extensions kept uncompressed so they can be read in place");
+
+  CLI11_PARSE(app, argc, argv);
+
+  const auto start = std::chrono::steady_clock::now();
+  hades::vfs::PakBuilder builder;
+  std::vector<std::filesystem::path> files;
+  for (const auto &item : std::filesystem::recursive_directory_iterator(input_dir))
+    if (item.is_regular_file())
+      files.push_back(item.path());
+  std::sort(files.begin(), files.end());
+
+  for (const std::filesystem::path &file : files)
+  {
+    const std::string name = file.lexically_relative(input_dir).generic_string(); // relative() would resolve symlinks
+    const bool store = std::find(store_extensions.begin(), store_extensions.end(), file.extension().string()) != store_extensions.end();
+    if (!builder.add_file(file.string(), name, !store))
+    {
+      fprintf(stderr, "ERR: cannot add %s (unreadable or path hash collision)\n", file.string().c_str());
+      return 1;
+    }
+  }
+
+  hades::vfs::PakBuildReport report;
+  if (!builder.write(output_path, &report))
+  {
+    fprintf(stderr, "ERR: failed to write %s\n", output_path.c_str());
+    return 1;
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("%s: %u files (%u stored), %" PRIu64 " -> %" PRIu64 " bytes in %.2f s\n", output_path.c_str(), report.files, report.stored,
+         report.raw_bytes, report.payload_bytes, seconds);
+  return 0;
+}